@@ -0,0 +1,180 @@
+/** @file
+*
+*  Dump or reset the data path performance counters that network drivers
+*  expose through the Adapter Information Protocol.
+*
+*  Usage: NetPerfCounters [-r]
+*
+*    -r  Reset the counters of every adapter after dumping them
+*
+*  Copyright (c) 2026, ARM Ltd. All rights reserved.
+*
+*  SPDX-License-Identifier: BSD-2-Clause-Patent
+*
+**/
+
+#include <Uefi.h>
+
+#include <Guid/NetPerfCountersAdapterInfo.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DevicePathLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ShellLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+
+#include <Protocol/AdapterInformation.h>
+#include <Protocol/DevicePath.h>
+
+STATIC CONST SHELL_PARAM_ITEM mParamList[] = {
+  { L"-r", TypeFlag },
+  { NULL,  TypeMax  }
+};
+
+/**
+  Print Numerator / Denominator with two decimal places.
+
+**/
+STATIC
+VOID
+PrintRatio (
+  IN  CONST CHAR16  *Name,
+  IN  UINT64        Numerator,
+  IN  UINT64        Denominator
+  )
+{
+  UINT64  Hundredths;
+
+  if (Denominator == 0) {
+    Print (L"  %-24s -\n", Name);
+    return;
+  }
+
+  Hundredths = DivU64x64Remainder (MultU64x32 (Numerator, 100), Denominator, NULL);
+  Print (L"  %-24s %Lu.%02Lu\n", Name, DivU64x32 (Hundredths, 100),
+    ModU64x32 (Hundredths, 100));
+}
+
+STATIC
+VOID
+DumpCounters (
+  IN  CONST NET_PERF_COUNTERS_ADAPTER_INFO  *Counters
+  )
+{
+  Print (L"  %-24s %Lu\n", L"RX polls", Counters->RxPolls);
+  Print (L"  %-24s %Lu\n", L"RX packets", Counters->RxPackets);
+  PrintRatio (L"RX packets per poll", Counters->RxPackets, Counters->RxPolls);
+  Print (L"  %-24s %Lu\n", L"TX packets", Counters->TxPackets);
+  PrintRatio (L"TX ring occupancy (avg)", Counters->TxRingOccupancySum,
+    Counters->TxPackets);
+  Print (L"  %-24s %Lu\n", L"TX ring occupancy (max)",
+    Counters->TxRingOccupancyMax);
+  Print (L"  %-24s %Lu\n", L"GetStatus polls", Counters->StatusPolls);
+  Print (L"  %-24s %Lu\n", L"Busy-wait iterations", Counters->PollIterations);
+  Print (L"  %-24s %Lu\n", L"Copies", Counters->Copies);
+  Print (L"  %-24s %Lu\n", L"Bytes copied", Counters->CopyBytes);
+  Print (L"  %-24s %Lu\n", L"DMA maps", Counters->DmaMaps);
+  Print (L"  %-24s %Lu us\n", L"Time at raised TPL",
+    DivU64x32 (Counters->RaisedTplTime, 1000));
+}
+
+EFI_STATUS
+EFIAPI
+NetPerfCountersEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS                        Status;
+  LIST_ENTRY                        *CheckPackage;
+  CHAR16                            *ProblemParam;
+  BOOLEAN                           Reset;
+  EFI_HANDLE                        *Handles;
+  UINTN                             HandleCount;
+  UINTN                             Index;
+  UINTN                             Found;
+  EFI_ADAPTER_INFORMATION_PROTOCOL  *Aip;
+  EFI_DEVICE_PATH_PROTOCOL          *DevicePath;
+  CHAR16                            *DevicePathText;
+  NET_PERF_COUNTERS_ADAPTER_INFO    *Counters;
+  UINTN                             CountersSize;
+  NET_PERF_COUNTERS_ADAPTER_INFO    ResetBlock;
+
+  Status = ShellInitialize ();
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = ShellCommandLineParse (mParamList, &CheckPackage, &ProblemParam, TRUE);
+  if (EFI_ERROR (Status)) {
+    Print (L"NetPerfCounters: invalid argument '%s'\n", ProblemParam);
+    Print (L"Usage: NetPerfCounters [-r]\n");
+    return EFI_INVALID_PARAMETER;
+  }
+  Reset = ShellCommandLineGetFlag (CheckPackage, L"-r");
+  ShellCommandLineFreeVarList (CheckPackage);
+
+  ZeroMem (&ResetBlock, sizeof (ResetBlock));
+  ResetBlock.Revision = NET_PERF_COUNTERS_REVISION;
+
+  Status = gBS->LocateHandleBuffer (ByProtocol,
+                  &gEfiAdapterInformationProtocolGuid, NULL, &HandleCount,
+                  &Handles);
+  if (EFI_ERROR (Status)) {
+    Print (L"NetPerfCounters: no adapters found\n");
+    return EFI_NOT_FOUND;
+  }
+
+  Found = 0;
+  for (Index = 0; Index < HandleCount; Index++) {
+    Status = gBS->HandleProtocol (Handles[Index],
+                    &gEfiAdapterInformationProtocolGuid, (VOID **)&Aip);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Status = Aip->GetInformation (Aip, &gNetPerfCountersAdapterInfoGuid,
+                    (VOID **)&Counters, &CountersSize);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+    Found++;
+
+    DevicePathText = NULL;
+    Status = gBS->HandleProtocol (Handles[Index], &gEfiDevicePathProtocolGuid,
+                    (VOID **)&DevicePath);
+    if (!EFI_ERROR (Status)) {
+      DevicePathText = ConvertDevicePathToText (DevicePath, TRUE, TRUE);
+    }
+    Print (L"Adapter %lu: %s\n", (UINT64)Found,
+      DevicePathText != NULL ? DevicePathText : L"<no device path>");
+    if (DevicePathText != NULL) {
+      FreePool (DevicePathText);
+    }
+
+    if (CountersSize < sizeof (NET_PERF_COUNTERS_ADAPTER_INFO) ||
+        Counters->Revision != NET_PERF_COUNTERS_REVISION) {
+      Print (L"  Unsupported counter block (%lu bytes)\n", (UINT64)CountersSize);
+    } else {
+      DumpCounters (Counters);
+    }
+    FreePool (Counters);
+
+    if (Reset) {
+      Status = Aip->SetInformation (Aip, &gNetPerfCountersAdapterInfoGuid,
+                      &ResetBlock, sizeof (ResetBlock));
+      Print (L"  Reset: %r\n", Status);
+    }
+  }
+
+  FreePool (Handles);
+
+  if (Found == 0) {
+    Print (L"NetPerfCounters: no adapter exposes performance counters\n");
+    return EFI_NOT_FOUND;
+  }
+
+  return EFI_SUCCESS;
+}
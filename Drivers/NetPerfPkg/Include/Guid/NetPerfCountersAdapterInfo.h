@@ -0,0 +1,63 @@
+/** @file
+*
+*  Adapter Information Protocol information block exposing driver side
+*  performance counters of network controller drivers.
+*
+*  Copyright (c) 2026, ARM Ltd. All rights reserved.
+*
+*  SPDX-License-Identifier: BSD-2-Clause-Patent
+*
+**/
+
+#ifndef __NET_PERF_COUNTERS_ADAPTER_INFO_H__
+#define __NET_PERF_COUNTERS_ADAPTER_INFO_H__
+
+#define NET_PERF_COUNTERS_ADAPTER_INFO_GUID \
+  { \
+    0xf5a077af, 0x9ba8, 0x485a, { 0x83, 0xd7, 0x32, 0x1b, 0xa8, 0xe5, 0x6e, 0x07 } \
+  }
+
+#define NET_PERF_COUNTERS_REVISION    1
+
+//
+// Information block returned by EFI_ADAPTER_INFORMATION_PROTOCOL.GetInformation()
+// for gNetPerfCountersAdapterInfoGuid. Passing an information block of this
+// type to SetInformation() resets all counters to zero.
+//
+// Counters a driver has no way of measuring are left at zero.
+//
+typedef struct {
+  UINT32    Revision;
+  UINT32    Reserved;
+
+  // Number of calls to SNP.Receive(), and number of those that returned a packet
+  UINT64    RxPolls;
+  UINT64    RxPackets;
+
+  // Number of packets accepted by SNP.Transmit()
+  UINT64    TxPackets;
+
+  // TX ring entries in use, sampled each time a packet is queued
+  UINT64    TxRingOccupancySum;
+  UINT64    TxRingOccupancyMax;
+
+  // Number of calls to SNP.GetStatus()
+  UINT64    StatusPolls;
+
+  // Number of iterations spent busy waiting on the hardware
+  UINT64    PollIterations;
+
+  // Packet data copies performed by the driver, and the number of bytes copied
+  UINT64    Copies;
+  UINT64    CopyBytes;
+
+  // Number of DMA map operations performed by the driver
+  UINT64    DmaMaps;
+
+  // Time spent at raised TPL in the SNP data path, in nanoseconds
+  UINT64    RaisedTplTime;
+} NET_PERF_COUNTERS_ADAPTER_INFO;
+
+extern EFI_GUID gNetPerfCountersAdapterInfoGuid;
+
+#endif // __NET_PERF_COUNTERS_ADAPTER_INFO_H__
@@ -0,0 +1,83 @@
+/** @file
+*
+*  Adapter Information Protocol helpers shared by the network drivers that
+*  expose NET_PERF_COUNTERS_ADAPTER_INFO.
+*
+*  Copyright (c) 2026, ARM Limited. All rights reserved.
+*
+*  SPDX-License-Identifier: BSD-2-Clause-Patent
+*
+**/
+
+#ifndef __NET_PERF_ADAPTER_INFO_LIB_H__
+#define __NET_PERF_ADAPTER_INFO_LIB_H__
+
+#include <Guid/NetPerfCountersAdapterInfo.h>
+
+/**
+  Implement GetInformation() for gNetPerfCountersAdapterInfoGuid.
+
+  @param[in]  InformationType       The information type requested.
+  @param[in]  Counters              The counters maintained by the driver.
+  @param[in]  RaisedTplTicks        Performance counter ticks spent at raised
+                                    TPL, converted to RaisedTplTime.
+  @param[out] InformationBlock      Newly allocated copy of the counters.
+  @param[out] InformationBlockSize  Size of InformationBlock in bytes.
+
+  @retval EFI_SUCCESS           The counters were returned.
+  @retval EFI_UNSUPPORTED       InformationType is not the counters type; the
+                                caller should handle it.
+  @retval EFI_OUT_OF_RESOURCES  The information block could not be allocated.
+
+**/
+EFI_STATUS
+EFIAPI
+NetPerfAipGetInformation (
+  IN  EFI_GUID                              *InformationType,
+  IN  CONST NET_PERF_COUNTERS_ADAPTER_INFO  *Counters,
+  IN  UINT64                                RaisedTplTicks,
+  OUT VOID                                  **InformationBlock,
+  OUT UINTN                                 *InformationBlockSize
+  );
+
+/**
+  Implement SetInformation() for gNetPerfCountersAdapterInfoGuid, which resets
+  the counters.
+
+  @param[in]  InformationType  The information type being set.
+  @param[out] Counters         The counters maintained by the driver.
+  @param[out] RaisedTplTicks   The raised TPL tick count, or NULL if the driver
+                               does not keep one.
+
+  @retval EFI_SUCCESS          The counters were reset.
+  @retval EFI_UNSUPPORTED      InformationType is not the counters type; the
+                               caller should handle it.
+
+**/
+EFI_STATUS
+EFIAPI
+NetPerfAipSetInformation (
+  IN  EFI_GUID                        *InformationType,
+  OUT NET_PERF_COUNTERS_ADAPTER_INFO  *Counters,
+  OUT UINT64                          *RaisedTplTicks OPTIONAL
+  );
+
+/**
+  Implement GetSupportedTypes() for a driver reporting the media state and the
+  performance counters.
+
+  @param[out] InfoTypesBuffer       Newly allocated array of information types.
+  @param[out] InfoTypesBufferCount  Number of entries in InfoTypesBuffer.
+
+  @retval EFI_SUCCESS           The information types were returned.
+  @retval EFI_OUT_OF_RESOURCES  The array could not be allocated.
+
+**/
+EFI_STATUS
+EFIAPI
+NetPerfAipGetSupportedTypes (
+  OUT EFI_GUID  **InfoTypesBuffer,
+  OUT UINTN     *InfoTypesBufferCount
+  );
+
+#endif // __NET_PERF_ADAPTER_INFO_LIB_H__
@@ -11,9 +11,89 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiRuntimeServicesTableLib.h>
+#include <Library/UefiLib.h>
 #include <Library/IpmiCommandLib.h>
+#include <Protocol/IpmiAsync.h>
+#include <Protocol/BmcElogSel.h>
+#include <Guid/EventGroup.h>
+#include <Guid/VariableFormat.h>
+
+#define BMC_ELOG_SEL_FIRST_RECORD_ID        0x0000
+#define BMC_ELOG_SEL_LAST_RECORD_ID         0xFFFF
+#define BMC_ELOG_SEL_READ_ENTIRE_RECORD     0xFF
+#define BMC_ELOG_SEL_TIMESTAMP_UNSPECIFIED  0xFFFFFFFF
+
+#define BMC_ELOG_SEL_ERASE_INITIATE         0xAA
+#define BMC_ELOG_SEL_ERASE_GET_STATUS       0x00
+
+//
+// Erasure status polls before the erase is reported as failed, as in WaitTillErased ().
+//
+#define BMC_ELOG_SEL_ERASE_MAX_POLLS        0x200
+
+//
+// Delay between two erasure status polls, in 100ns units (10ms).
+//
+#define BMC_ELOG_SEL_ERASE_POLL_INTERVAL    100000
+
+//
+// Largest useful ring, the SEL has at most one record per record ID.
+//
+#define BMC_ELOG_SEL_RING_MAX_CAPACITY      (MAX_UINT16 + 1)
+
+//
+// The SEL ring is saved across boots in a state variable and in record variables
+// named BmcElogSelRecords00, BmcElogSelRecords01, ..., each holding up to
+// mSelRecordsPerVariable records, oldest first.
+//
+#define BMC_ELOG_SEL_STATE_VARIABLE_NAME    L"BmcElogSelState"
+#define BMC_ELOG_SEL_RECORDS_VARIABLE_NAME  L"BmcElogSelRecords00"
+#define BMC_ELOG_SEL_RECORDS_MAX_VARIABLES  0x100
+
+#define BMC_ELOG_SEL_STATE_SIGNATURE        SIGNATURE_32 ('B', 'E', 'S', 'S')
+
+typedef struct {
+  UINT32                      Signature;
+  UINT32                      AddTimeStamp;
+  UINT32                      EraseTimeStamp;
+  UINT16                      LastRecordId;
+  UINT16                      Reserved;
+  UINT32                      Capacity;
+  UINT32                      Count;
+  UINT32                      Overwritten;
+} BMC_ELOG_SEL_STATE;
+
+typedef enum {
+  SelEraseIdle,
+  SelEraseReserve,
+  SelEraseClear
+} SEL_ERASE_STATE;
+
+IPMI_GET_SEL_INFO_RESPONSE  mSelInfo;
+IPMI_ASYNC_TOKEN            mSelInfoToken;
+
+BMC_ELOG_SEL_RING           mSelRing;
+BOOLEAN                     mSelLastRecordValid;
+UINT16                      mSelLastRecordId;
+UINT32                      mSelAddTimeStamp;
+UINT32                      mSelEraseTimeStamp;
+BOOLEAN                     mSelStateLoaded;
+BOOLEAN                     mSelStateChanged;
+UINT32                      mSelRecordsPerVariable;
+
+SEL_ERASE_STATE             mSelEraseState;
+BOOLEAN                     mSelEraseSync;
+UINT32                      mSelErasePolls;
+EFI_EVENT                   mSelErasePollTimer;
+UINT8                       mSelReservationId[2];
+EFI_EVENT                   mSelEraseCallerEvent;
+EFI_STATUS                  *mSelEraseCallerStatus;
+IPMI_ASYNC_PROTOCOL         *mSelEraseIpmiAsync;
+IPMI_ASYNC_TOKEN            mSelEraseToken;
+UINT8                       mSelEraseResponse[sizeof (IPMI_RESERVE_SEL_RESPONSE) + sizeof (IPMI_CLEAR_SEL_RESPONSE)];
 
 EFI_STATUS
 EFIAPI
@@ -85,6 +165,11 @@ Returns:
     if (Counter == 0x0) {
       return EFI_NO_RESPONSE;
     }
+
+    //
+    // Give the BMC the same time per poll as the background erase.
+    //
+    gBS->Stall (BMC_ELOG_SEL_ERASE_POLL_INTERVAL / 10);
   }
 }
 
@@ -170,6 +255,830 @@ Returns:
   return EFI_SUCCESS;
 }
 
+VOID
+SelRingReset (
+  VOID
+  )
+/*++
+
+  Routine Description:
+    Drop all records of the SEL ring, the next read starts from the first SEL record.
+
+  Arguments:
+    None
+
+  Returns:
+    None
+
+--*/
+{
+  mSelRing.Count       = 0;
+  mSelRing.Head        = 0;
+  mSelRing.Overwritten = 0;
+  mSelLastRecordValid  = FALSE;
+  mSelStateChanged     = TRUE;
+}
+
+VOID
+SelRingAdd (
+  IN UINT8                              *Record
+  )
+/*++
+
+  Routine Description:
+    Append a record to the SEL ring, overwriting the oldest one when the ring is full.
+
+  Arguments:
+    Record - SEL record of BMC_ELOG_SEL_RECORD_SIZE bytes
+
+  Returns:
+    None
+
+--*/
+{
+  UINT32                                Index;
+
+  Index = (mSelRing.Head + mSelRing.Count) % mSelRing.Capacity;
+  if (mSelRing.Count == mSelRing.Capacity) {
+    mSelRing.Head = (mSelRing.Head + 1) % mSelRing.Capacity;
+    mSelRing.Overwritten++;
+  } else {
+    mSelRing.Count++;
+  }
+
+  CopyMem (mSelRing.Records + Index * BMC_ELOG_SEL_RECORD_SIZE, Record, BMC_ELOG_SEL_RECORD_SIZE);
+  mSelStateChanged = TRUE;
+}
+
+VOID
+SelSetRecordsVariableName (
+  OUT CHAR16                            *Name,
+  IN  UINT32                            Index
+  )
+/*++
+
+  Routine Description:
+    Build the name of a record variable of the saved SEL ring.
+
+  Arguments:
+    Name  - Buffer of sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME) bytes
+    Index - Index of the variable, below BMC_ELOG_SEL_RECORDS_MAX_VARIABLES
+
+  Returns:
+    None
+
+--*/
+{
+  STATIC CONST CHAR16                   HexDigits[] = L"0123456789ABCDEF";
+  UINTN                                 Length;
+
+  Length = sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME) / sizeof (CHAR16) - 1;
+  CopyMem (Name, BMC_ELOG_SEL_RECORDS_VARIABLE_NAME, sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME));
+  Name[Length - 2] = HexDigits[(Index >> 4) & 0xF];
+  Name[Length - 1] = HexDigits[Index & 0xF];
+}
+
+VOID
+SelStateLoad (
+  VOID
+  )
+/*++
+
+  Routine Description:
+    Restore the SEL ring saved by a previous boot, ReadSel () then only reads the
+    records added since. The ring is left empty when the saved copy is missing or
+    does not match the ring.
+
+  Arguments:
+    None
+
+  Returns:
+    None
+
+--*/
+{
+  EFI_STATUS                            Status;
+  BMC_ELOG_SEL_STATE                    State;
+  CHAR16                                Name[sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME) / sizeof (CHAR16)];
+  UINTN                                 Size;
+  UINT32                                Count;
+  UINT32                                Loaded;
+  UINT32                                Index;
+
+  if (mSelRecordsPerVariable == 0) {
+    return;
+  }
+
+  Size   = sizeof (State);
+  Status = gRT->GetVariable (BMC_ELOG_SEL_STATE_VARIABLE_NAME, &gBmcElogSelProtocolGuid, NULL, &Size, &State);
+  if (EFI_ERROR (Status) ||
+      (Size != sizeof (State)) ||
+      (State.Signature != BMC_ELOG_SEL_STATE_SIGNATURE) ||
+      (State.EraseTimeStamp == BMC_ELOG_SEL_TIMESTAMP_UNSPECIFIED) ||
+      (State.Capacity != mSelRing.Capacity) ||
+      (State.Count > mSelRing.Capacity)) {
+    return;
+  }
+
+  Loaded = 0;
+  for (Index = 0; Loaded < State.Count; Index++) {
+    Count = MIN (State.Count - Loaded, mSelRecordsPerVariable);
+    Size  = Count * BMC_ELOG_SEL_RECORD_SIZE;
+    SelSetRecordsVariableName (Name, Index);
+    Status = gRT->GetVariable (
+                    Name,
+                    &gBmcElogSelProtocolGuid,
+                    NULL,
+                    &Size,
+                    mSelRing.Records + Loaded * BMC_ELOG_SEL_RECORD_SIZE
+                    );
+    if (EFI_ERROR (Status) || (Size != Count * BMC_ELOG_SEL_RECORD_SIZE)) {
+      return;
+    }
+    Loaded += Count;
+  }
+
+  mSelRing.Head        = 0;
+  mSelRing.Count       = State.Count;
+  mSelRing.Overwritten = State.Overwritten;
+  mSelLastRecordId     = State.LastRecordId;
+  mSelLastRecordValid  = (BOOLEAN) (State.Count != 0);
+  mSelAddTimeStamp     = State.AddTimeStamp;
+  mSelEraseTimeStamp   = State.EraseTimeStamp;
+  mSelStateChanged     = FALSE;
+
+  DEBUG ((DEBUG_INFO, "BmcElog: %d SEL records restored\n", State.Count));
+}
+
+VOID
+SelStateSave (
+  VOID
+  )
+/*++
+
+  Routine Description:
+    Save the SEL ring for the next boot if it changed. A SEL without erase
+    timestamp is not saved, there is no way to detect that it was erased.
+
+  Arguments:
+    None
+
+  Returns:
+    None
+
+--*/
+{
+  EFI_STATUS                            Status;
+  BMC_ELOG_SEL_STATE                    State;
+  CHAR16                                Name[sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME) / sizeof (CHAR16)];
+  UINT8                                 *Records;
+  UINT32                                Count;
+  UINT32                                Saved;
+  UINT32                                Index;
+
+  if (!mSelStateChanged || (mSelRecordsPerVariable == 0)) {
+    return;
+  }
+  mSelStateChanged = FALSE;
+
+  //
+  // Delete the state first, the records of a partial save are never used.
+  //
+  gRT->SetVariable (BMC_ELOG_SEL_STATE_VARIABLE_NAME, &gBmcElogSelProtocolGuid, 0, 0, NULL);
+
+  if ((mSelEraseTimeStamp == BMC_ELOG_SEL_TIMESTAMP_UNSPECIFIED) ||
+      (mSelRing.Count > mSelRecordsPerVariable * BMC_ELOG_SEL_RECORDS_MAX_VARIABLES)) {
+    return;
+  }
+
+  Records = NULL;
+  if (mSelRing.Count != 0) {
+    Records = AllocatePool (mSelRing.Count * BMC_ELOG_SEL_RECORD_SIZE);
+    if (Records == NULL) {
+      return;
+    }
+  }
+
+  //
+  // Save the records oldest first.
+  //
+  for (Index = 0; Index < mSelRing.Count; Index++) {
+    CopyMem (
+      Records + Index * BMC_ELOG_SEL_RECORD_SIZE,
+      mSelRing.Records + ((mSelRing.Head + Index) % mSelRing.Capacity) * BMC_ELOG_SEL_RECORD_SIZE,
+      BMC_ELOG_SEL_RECORD_SIZE
+      );
+  }
+
+  Status = EFI_SUCCESS;
+  Saved  = 0;
+  for (Index = 0; Saved < mSelRing.Count; Index++) {
+    Count = MIN (mSelRing.Count - Saved, mSelRecordsPerVariable);
+    SelSetRecordsVariableName (Name, Index);
+    Status = gRT->SetVariable (
+                    Name,
+                    &gBmcElogSelProtocolGuid,
+                    EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                    Count * BMC_ELOG_SEL_RECORD_SIZE,
+                    Records + Saved * BMC_ELOG_SEL_RECORD_SIZE
+                    );
+    if (EFI_ERROR (Status)) {
+      break;
+    }
+    Saved += Count;
+  }
+
+  if (Records != NULL) {
+    FreePool (Records);
+  }
+
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "BmcElog: SEL records not saved - %r\n", Status));
+    return;
+  }
+
+  //
+  // Delete the record variables left by a larger ring.
+  //
+  for (; Index < BMC_ELOG_SEL_RECORDS_MAX_VARIABLES; Index++) {
+    SelSetRecordsVariableName (Name, Index);
+    if (gRT->SetVariable (Name, &gBmcElogSelProtocolGuid, 0, 0, NULL) == EFI_NOT_FOUND) {
+      break;
+    }
+  }
+
+  ZeroMem (&State, sizeof (State));
+  State.Signature      = BMC_ELOG_SEL_STATE_SIGNATURE;
+  State.AddTimeStamp   = mSelAddTimeStamp;
+  State.EraseTimeStamp = mSelEraseTimeStamp;
+  State.LastRecordId   = mSelLastRecordValid ? mSelLastRecordId : BMC_ELOG_SEL_LAST_RECORD_ID;
+  State.Capacity       = mSelRing.Capacity;
+  State.Count          = mSelRing.Count;
+  State.Overwritten    = mSelRing.Overwritten;
+  Status = gRT->SetVariable (
+                  BMC_ELOG_SEL_STATE_VARIABLE_NAME,
+                  &gBmcElogSelProtocolGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  sizeof (State),
+                  &State
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "BmcElog: SEL state not saved - %r\n", Status));
+  }
+}
+
+EFI_STATUS
+SelGetEntry (
+  IN  UINT16                            RecordId,
+  OUT IPMI_GET_SEL_ENTRY_RESPONSE       *GetSelEntryResponse
+  )
+/*++
+
+  Routine Description:
+    Read a whole SEL record. Reads from offset 0 need no reservation.
+
+  Arguments:
+    RecordId            - SEL record ID, BMC_ELOG_SEL_FIRST_RECORD_ID for the first record
+    GetSelEntryResponse - The record and the ID of the next one
+
+  Returns:
+    EFI_SUCCESS
+    EFI_DEVICE_ERROR
+
+--*/
+{
+  EFI_STATUS                            Status;
+  IPMI_GET_SEL_ENTRY_REQUEST            GetSelEntryRequest;
+  UINT32                                ResponseSize;
+
+  ZeroMem (&GetSelEntryRequest, sizeof (GetSelEntryRequest));
+  GetSelEntryRequest.SelRecID    = RecordId;
+  GetSelEntryRequest.Offset      = 0;
+  GetSelEntryRequest.BytesToRead = BMC_ELOG_SEL_READ_ENTIRE_RECORD;
+
+  ResponseSize = sizeof (*GetSelEntryResponse);
+  Status = IpmiGetSelEntry (&GetSelEntryRequest, GetSelEntryResponse, &ResponseSize);
+  if (EFI_ERROR (Status) ||
+      (GetSelEntryResponse->CompletionCode != 0) ||
+      (ResponseSize < sizeof (*GetSelEntryResponse))) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+BmcElogReadSel (
+  IN  BMC_ELOG_SEL_PROTOCOL             *This,
+  OUT CONST BMC_ELOG_SEL_RING           **Ring
+  )
+/*++
+
+  Routine Description:
+    Read the SEL records added since the last call into the ring.
+
+  Arguments:
+    This - This instance of the protocol
+    Ring - The ring, owned by the protocol
+
+  Returns:
+    EFI_SUCCESS
+    EFI_INVALID_PARAMETER
+    EFI_NOT_READY
+    EFI_DEVICE_ERROR
+
+--*/
+{
+  EFI_STATUS                            Status;
+  IPMI_GET_SEL_INFO_RESPONSE            SelInfo;
+  IPMI_GET_SEL_ENTRY_RESPONSE           GetSelEntryResponse;
+  UINT16                                RecordId;
+  UINT32                                Index;
+
+  if (Ring == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+  *Ring = &mSelRing;
+
+  //
+  // Records read now could be erased right after, and the ring is reset when the erase completes.
+  //
+  if (mSelEraseState != SelEraseIdle) {
+    return EFI_NOT_READY;
+  }
+
+  if (!mSelStateLoaded) {
+    mSelStateLoaded = TRUE;
+    SelStateLoad ();
+  }
+
+  Status = IpmiGetSelInfo (&SelInfo);
+  if (EFI_ERROR (Status) || (SelInfo.CompletionCode != 0)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  //
+  // Record IDs are reused after an erase. Without an erase timestamp an erase cannot
+  // be detected, so the whole SEL is read again.
+  //
+  if ((SelInfo.NoOfEntries == 0) ||
+      (SelInfo.RecentEraseTimeStamp == BMC_ELOG_SEL_TIMESTAMP_UNSPECIFIED) ||
+      (SelInfo.RecentEraseTimeStamp != mSelEraseTimeStamp)) {
+    SelRingReset ();
+  } else if (mSelLastRecordValid &&
+             (SelInfo.RecentAddTimeStamp == mSelAddTimeStamp) &&
+             (SelInfo.RecentAddTimeStamp != BMC_ELOG_SEL_TIMESTAMP_UNSPECIFIED)) {
+    //
+    // Nothing was added since the last call.
+    //
+    return EFI_SUCCESS;
+  }
+
+  RecordId = BMC_ELOG_SEL_FIRST_RECORD_ID;
+  if (SelInfo.NoOfEntries == 0) {
+    RecordId = BMC_ELOG_SEL_LAST_RECORD_ID;
+  } else if (mSelLastRecordValid) {
+    //
+    // Continue after the newest record in the ring, start over if it is gone.
+    //
+    Status = SelGetEntry (mSelLastRecordId, &GetSelEntryResponse);
+    if (EFI_ERROR (Status)) {
+      SelRingReset ();
+    } else {
+      RecordId = GetSelEntryResponse.NextSelRecordId;
+    }
+  }
+
+  for (Index = 0; (RecordId != BMC_ELOG_SEL_LAST_RECORD_ID) && (Index <= MAX_UINT16); Index++) {
+    Status = SelGetEntry (RecordId, &GetSelEntryResponse);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "BmcElog: Get SEL Entry 0x%x failed\n", RecordId));
+      return EFI_DEVICE_ERROR;
+    }
+
+    SelRingAdd ((UINT8 *) &GetSelEntryResponse.RecordData);
+    mSelLastRecordId    = ReadUnaligned16 ((UINT16 *) &GetSelEntryResponse.RecordData);
+    mSelLastRecordValid = TRUE;
+    RecordId            = GetSelEntryResponse.NextSelRecordId;
+  }
+
+  //
+  // Only remember the timestamps once all records are in the ring.
+  //
+  if ((mSelAddTimeStamp != SelInfo.RecentAddTimeStamp) || (mSelEraseTimeStamp != SelInfo.RecentEraseTimeStamp)) {
+    mSelStateChanged = TRUE;
+  }
+  mSelAddTimeStamp   = SelInfo.RecentAddTimeStamp;
+  mSelEraseTimeStamp = SelInfo.RecentEraseTimeStamp;
+
+  //
+  // The ring was saved at ReadyToBoot already, save what a later read added.
+  //
+  if (mSelEraseSync) {
+    SelStateSave ();
+  }
+
+  return EFI_SUCCESS;
+}
+
+VOID
+SelBuildClearRequest (
+  OUT IPMI_CLEAR_SEL_REQUEST            *ClearSel,
+  IN  UINT8                             *ResvId,
+  IN  UINT8                             Erase
+  )
+/*++
+
+  Routine Description:
+    Fill a Clear SEL request.
+
+  Arguments:
+    ClearSel - The request
+    ResvId   - Reservation ID
+    Erase    - BMC_ELOG_SEL_ERASE_INITIATE or BMC_ELOG_SEL_ERASE_GET_STATUS
+
+  Returns:
+    None
+
+--*/
+{
+  ZeroMem (ClearSel, sizeof (*ClearSel));
+  ClearSel->Reserve[0] = ResvId[0];
+  ClearSel->Reserve[1] = ResvId[1];
+  ClearSel->AscC       = 0x43;
+  ClearSel->AscL       = 0x4C;
+  ClearSel->AscR       = 0x52;
+  ClearSel->Erase      = Erase;
+}
+
+VOID
+SelEraseComplete (
+  IN EFI_STATUS                         Status
+  )
+/*++
+
+  Routine Description:
+    Report the end of a SEL erase to the caller of EraseSel ().
+
+  Arguments:
+    Status - Result of the erase
+
+  Returns:
+    None
+
+--*/
+{
+  DEBUG ((DEBUG_INFO, "BmcElog: SEL erase - %r\n", Status));
+
+  mSelEraseState = SelEraseIdle;
+  if (!EFI_ERROR (Status)) {
+    SelRingReset ();
+  }
+  if (mSelEraseCallerStatus != NULL) {
+    *mSelEraseCallerStatus = Status;
+  }
+  if (mSelEraseCallerEvent != NULL) {
+    gBS->SignalEvent (mSelEraseCallerEvent);
+  }
+}
+
+EFI_STATUS
+SelEraseSubmit (
+  IN UINT8                              Command,
+  IN UINT8                              *RequestData,
+  IN UINT32                             RequestDataSize,
+  IN UINT32                             ResponseDataSize
+  )
+/*++
+
+  Routine Description:
+    Queue the next command of the background SEL erase.
+
+  Arguments:
+    Command          - IPMI storage command
+    RequestData      - Command request data
+    RequestDataSize  - Size of the request data
+    ResponseDataSize - Size of the expected response
+
+  Returns:
+    EFI_STATUS
+
+--*/
+{
+  mSelEraseToken.ResponseData     = mSelEraseResponse;
+  mSelEraseToken.ResponseDataSize = ResponseDataSize;
+
+  return mSelEraseIpmiAsync->SubmitCommand (
+                               mSelEraseIpmiAsync,
+                               IPMI_NETFN_STORAGE,
+                               Command,
+                               RequestData,
+                               RequestDataSize,
+                               0,
+                               &mSelEraseToken
+                               );
+}
+
+VOID
+EFIAPI
+SelEraseNotify (
+  IN EFI_EVENT                          Event,
+  IN VOID                               *Context
+  )
+/*++
+
+  Routine Description:
+    Completion of a queued command of the background SEL erase. Reserve SEL is
+    followed by Clear SEL to initiate the erase, then the erasure status is
+    polled with one queued command every BMC_ELOG_SEL_ERASE_POLL_INTERVAL.
+
+  Arguments:
+    Event    - Event type
+    *Context - Context for the event
+
+  Returns:
+    None
+
+--*/
+{
+  EFI_STATUS                            Status;
+  IPMI_RESERVE_SEL_RESPONSE             *ReserveSelResponse;
+  IPMI_CLEAR_SEL_RESPONSE               *ClearSelResponse;
+  IPMI_CLEAR_SEL_REQUEST                ClearSel;
+
+  //
+  // The erase was finished at ReadyToBoot or abandoned at ExitBootServices.
+  //
+  if ((mSelEraseState == SelEraseIdle) || (mSelEraseToken.Status == EFI_NOT_READY)) {
+    return;
+  }
+
+  if (EFI_ERROR (mSelEraseToken.Status) || (mSelEraseResponse[0] != 0)) {
+    DEBUG ((
+      DEBUG_ERROR,
+      "BmcElog: SEL erase command failed - %r, completion code 0x%x\n",
+      mSelEraseToken.Status,
+      mSelEraseResponse[0]
+      ));
+    SelEraseComplete (EFI_DEVICE_ERROR);
+    return;
+  }
+
+  if (mSelEraseState == SelEraseReserve) {
+    ReserveSelResponse = (IPMI_RESERVE_SEL_RESPONSE *) mSelEraseResponse;
+    CopyMem (mSelReservationId, ReserveSelResponse->ReservationId, sizeof (mSelReservationId));
+    SelBuildClearRequest (&ClearSel, mSelReservationId, BMC_ELOG_SEL_ERASE_INITIATE);
+    mSelEraseState = SelEraseClear;
+  } else {
+    ClearSelResponse = (IPMI_CLEAR_SEL_RESPONSE *) mSelEraseResponse;
+    if ((ClearSelResponse->ErasureProgress & 0xf) == 1) {
+      SelEraseComplete (EFI_SUCCESS);
+      return;
+    }
+    if (++mSelErasePolls == BMC_ELOG_SEL_ERASE_MAX_POLLS) {
+      SelEraseComplete (EFI_NO_RESPONSE);
+      return;
+    }
+    Status = gBS->SetTimer (mSelErasePollTimer, TimerRelative, BMC_ELOG_SEL_ERASE_POLL_INTERVAL);
+    if (EFI_ERROR (Status)) {
+      SelEraseComplete (Status);
+    }
+    return;
+  }
+
+  Status = SelEraseSubmit (
+             IPMI_STORAGE_CLEAR_SEL,
+             (UINT8 *) &ClearSel,
+             sizeof (ClearSel),
+             sizeof (IPMI_CLEAR_SEL_RESPONSE)
+             );
+  if (EFI_ERROR (Status)) {
+    SelEraseComplete (Status);
+  }
+}
+
+VOID
+EFIAPI
+SelErasePollNotify (
+  IN EFI_EVENT                          Event,
+  IN VOID                               *Context
+  )
+/*++
+
+  Routine Description:
+    Queue the next erasure status poll of the background SEL erase.
+
+  Arguments:
+    Event    - Event type
+    *Context - Context for the event
+
+  Returns:
+    None
+
+--*/
+{
+  EFI_STATUS                            Status;
+  IPMI_CLEAR_SEL_REQUEST                ClearSel;
+
+  if (mSelEraseState != SelEraseClear) {
+    return;
+  }
+
+  SelBuildClearRequest (&ClearSel, mSelReservationId, BMC_ELOG_SEL_ERASE_GET_STATUS);
+  Status = SelEraseSubmit (
+             IPMI_STORAGE_CLEAR_SEL,
+             (UINT8 *) &ClearSel,
+             sizeof (ClearSel),
+             sizeof (IPMI_CLEAR_SEL_RESPONSE)
+             );
+  if (EFI_ERROR (Status)) {
+    SelEraseComplete (Status);
+  }
+}
+
+EFI_STATUS
+SelEraseSynchronous (
+  VOID
+  )
+/*++
+
+  Routine Description:
+    Erase the SEL and wait for the erase to complete.
+
+  Arguments:
+    None
+
+  Returns:
+    EFI_SUCCESS
+    EFI_NO_RESPONSE
+    EFI_DEVICE_ERROR
+
+--*/
+{
+  EFI_STATUS                            Status;
+  IPMI_RESERVE_SEL_RESPONSE             ReserveSel;
+  IPMI_CLEAR_SEL_REQUEST                ClearSel;
+  IPMI_CLEAR_SEL_RESPONSE               ClearSelResponse;
+
+  Status = IpmiReserveSel (&ReserveSel);
+  if (EFI_ERROR (Status) || (ReserveSel.CompletionCode != 0)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  SelBuildClearRequest (&ClearSel, ReserveSel.ReservationId, BMC_ELOG_SEL_ERASE_INITIATE);
+  Status = IpmiClearSel (&ClearSel, &ClearSelResponse);
+  if (EFI_ERROR (Status) || (ClearSelResponse.CompletionCode != 0)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  return WaitTillErased (ReserveSel.ReservationId);
+}
+
+VOID
+EFIAPI
+SelEraseReadyToBoot (
+  IN EFI_EVENT                          Event,
+  IN VOID                               *Context
+  )
+/*++
+
+  Routine Description:
+    Finish a pending background SEL erase and save the SEL ring for the next
+    boot. The command queue is not flushed again before ExitBootServices, so
+    erases started from now on complete before EraseSel () returns.
+
+  Arguments:
+    Event    - Event type
+    *Context - Context for the event
+
+  Returns:
+    None
+
+--*/
+{
+  EFI_STATUS                            Status;
+  SEL_ERASE_STATE                       State;
+
+  mSelEraseSync = TRUE;
+  if (mSelEraseState != SelEraseIdle) {
+    DEBUG ((DEBUG_INFO, "BmcElog: finishing SEL erase at ReadyToBoot\n"));
+    gBS->SetTimer (mSelErasePollTimer, TimerCancel, 0);
+
+    //
+    // Send the queued erase command. SelEraseNotify () runs once this handler
+    // has returned and the erase is over, so it ignores the completion.
+    //
+    State = mSelEraseState;
+    mSelEraseIpmiAsync->Flush (mSelEraseIpmiAsync);
+    if (State == SelEraseReserve) {
+      Status = SelEraseSynchronous ();
+    } else {
+      Status = WaitTillErased (mSelReservationId);
+    }
+
+    SelEraseComplete (Status);
+  }
+
+  SelStateSave ();
+}
+
+VOID
+EFIAPI
+SelEraseExitBootServices (
+  IN EFI_EVENT                          Event,
+  IN VOID                               *Context
+  )
+/*++
+
+  Routine Description:
+    Abandon a background SEL erase that is still pending, no command of it is
+    queued after ExitBootServices and the caller's event is not signaled.
+
+  Arguments:
+    Event    - Event type
+    *Context - Context for the event
+
+  Returns:
+    None
+
+--*/
+{
+  mSelEraseSync = TRUE;
+  if (mSelEraseState == SelEraseIdle) {
+    return;
+  }
+
+  gBS->SetTimer (mSelErasePollTimer, TimerCancel, 0);
+  mSelEraseState = SelEraseIdle;
+  if (mSelEraseCallerStatus != NULL) {
+    *mSelEraseCallerStatus = EFI_ABORTED;
+  }
+}
+
+EFI_STATUS
+EFIAPI
+BmcElogEraseSel (
+  IN  BMC_ELOG_SEL_PROTOCOL             *This,
+  IN  EFI_EVENT                         Event OPTIONAL,
+  OUT EFI_STATUS                        *EraseStatus OPTIONAL
+  )
+/*++
+
+  Routine Description:
+    Start erasing the SEL. Until ReadyToBoot the erase runs through the IPMI
+    asynchronous command queue when it is available, otherwise it completes
+    before returning.
+
+  Arguments:
+    This        - This instance of the protocol
+    Event       - Signaled when the erase has completed
+    EraseStatus - EFI_NOT_READY while the erase is in progress, its result afterwards
+
+  Returns:
+    EFI_SUCCESS
+    EFI_ALREADY_STARTED
+
+--*/
+{
+  EFI_STATUS                            Status;
+
+  if (mSelEraseState != SelEraseIdle) {
+    return EFI_ALREADY_STARTED;
+  }
+
+  mSelEraseCallerEvent  = Event;
+  mSelEraseCallerStatus = EraseStatus;
+  if (EraseStatus != NULL) {
+    *EraseStatus = EFI_NOT_READY;
+  }
+
+  if (!mSelEraseSync) {
+    Status = gBS->LocateProtocol (&gIpmiAsyncProtocolGuid, NULL, (VOID **) &mSelEraseIpmiAsync);
+    if (!EFI_ERROR (Status)) {
+      mSelErasePolls = 0;
+      mSelEraseState = SelEraseReserve;
+      Status = SelEraseSubmit (IPMI_STORAGE_RESERVE_SEL, NULL, 0, sizeof (IPMI_RESERVE_SEL_RESPONSE));
+      if (!EFI_ERROR (Status)) {
+        return EFI_SUCCESS;
+      }
+      mSelEraseState = SelEraseIdle;
+    }
+  }
+
+  //
+  // No command queue or past ReadyToBoot, erase synchronously.
+  //
+  SelEraseComplete (SelEraseSynchronous ());
+
+  return EFI_SUCCESS;
+}
+
+BMC_ELOG_SEL_PROTOCOL  mBmcElogSel = {
+  BmcElogReadSel,
+  BmcElogEraseSel
+};
+
 EFI_STATUS
 EFIAPI
 InitializeBmcElogLayer (
@@ -191,13 +1100,153 @@ Returns:
 
 --*/
 {
+  EFI_STATUS  Status;
+  EFI_HANDLE  Handle;
+  EFI_EVENT   Event;
+  UINT32      Overhead;
+
   SetElogRedirInstall ();
 
   CheckIfSelIsFull ();
 
+  mSelRing.Capacity = FixedPcdGet32 (PcdBmcElogSelRingSize);
+  if (mSelRing.Capacity == 0) {
+    return EFI_SUCCESS;
+  }
+  mSelRing.Capacity = MIN (mSelRing.Capacity, BMC_ELOG_SEL_RING_MAX_CAPACITY);
+  mSelRing.Records  = AllocateZeroPool (mSelRing.Capacity * BMC_ELOG_SEL_RECORD_SIZE);
+  if (mSelRing.Records == NULL) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Each record variable must fit in the largest variable the variable driver accepts.
+  //
+  Overhead = sizeof (AUTHENTICATED_VARIABLE_HEADER) + sizeof (BMC_ELOG_SEL_RECORDS_VARIABLE_NAME);
+  if (PcdGet32 (PcdMaxVariableSize) > Overhead) {
+    mSelRecordsPerVariable = (PcdGet32 (PcdMaxVariableSize) - Overhead) / BMC_ELOG_SEL_RECORD_SIZE;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SelEraseNotify,
+                  NULL,
+                  &mSelEraseToken.Event
+                  );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SelErasePollNotify,
+                  NULL,
+                  &mSelErasePollTimer
+                  );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  Status = EfiCreateEventReadyToBootEx (
+             TPL_CALLBACK,
+             SelEraseReadyToBoot,
+             NULL,
+             &Event
+             );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  SelEraseExitBootServices,
+                  NULL,
+                  &gEfiEventExitBootServicesGuid,
+                  &Event
+                  );
+  if (EFI_ERROR (Status)) {
+    return EFI_SUCCESS;
+  }
+
+  Handle = NULL;
+  Status = gBS->InstallProtocolInterface (
+                  &Handle,
+                  &gBmcElogSelProtocolGuid,
+                  EFI_NATIVE_INTERFACE,
+                  &mBmcElogSel
+                  );
+  ASSERT_EFI_ERROR (Status);
+
   return EFI_SUCCESS;
 }
 
+VOID
+ReportSelIsFull (
+  VOID
+  )
+/*++
+
+  Routine Description:
+    Report the SEL overflow flag of the Get SEL Info response in mSelInfo.
+
+  Arguments:
+    None
+
+  Returns:
+    None
+
+--*/
+{
+  UINT8                       SelIsFull;
+
+  //
+  // Check the Bit7 of the OperationByte if SEL is OverFlow.
+  //
+  SelIsFull = (mSelInfo.OperationSupport & 0x80);
+  DEBUG ((DEBUG_INFO, "SelIsFull - 0x%x\n", SelIsFull));
+}
+
+VOID
+EFIAPI
+SelInfoNotify (
+  IN EFI_EVENT        Event,
+  IN VOID             *Context
+  )
+/*++
+
+  Routine Description:
+    Completion of the queued Get SEL Info command.
+
+  Arguments:
+    Event    - Event type
+    *Context - Context for the event
+
+  Returns:
+    None
+
+--*/
+{
+  gBS->CloseEvent (Event);
+
+  if (EFI_ERROR (mSelInfoToken.Status)) {
+    DEBUG ((DEBUG_WARN, "Get SEL Info failed - %r\n", mSelInfoToken.Status));
+    return;
+  }
+
+  //
+  // OperationSupport is only valid in a complete response with a normal completion code.
+  //
+  if ((mSelInfoToken.ResponseDataSize < sizeof (mSelInfo)) || (mSelInfo.CompletionCode != 0)) {
+    DEBUG ((DEBUG_WARN, "Get SEL Info failed - CompletionCode 0x%x, size %d\n", mSelInfo.CompletionCode, mSelInfoToken.ResponseDataSize));
+    return;
+  }
+
+  ReportSelIsFull ();
+}
+
 EFI_STATUS
 EFIAPI
 CheckIfSelIsFull (
@@ -218,19 +1267,45 @@ CheckIfSelIsFull (
 --*/
 {
   EFI_STATUS                  Status;
-  UINT8                       SelIsFull;
-  IPMI_GET_SEL_INFO_RESPONSE  SelInfo;
+  IPMI_ASYNC_PROTOCOL         *IpmiAsync;
 
-  Status = IpmiGetSelInfo (&SelInfo);
-  if (EFI_ERROR (Status)) {
+  //
+  // The result is only reported, do not wait for the BMC when the command can be queued.
+  //
+  Status = gBS->LocateProtocol (&gIpmiAsyncProtocolGuid, NULL, (VOID **) &IpmiAsync);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->CreateEvent (
+                    EVT_NOTIFY_SIGNAL,
+                    TPL_CALLBACK,
+                    SelInfoNotify,
+                    NULL,
+                    &mSelInfoToken.Event
+                    );
+    if (!EFI_ERROR (Status)) {
+      mSelInfoToken.ResponseData     = (UINT8 *) &mSelInfo;
+      mSelInfoToken.ResponseDataSize = sizeof (mSelInfo);
+      Status = IpmiAsync->SubmitCommand (
+                            IpmiAsync,
+                            IPMI_NETFN_STORAGE,
+                            IPMI_STORAGE_GET_SEL_INFO,
+                            NULL,
+                            0,
+                            0,
+                            &mSelInfoToken
+                            );
+      if (!EFI_ERROR (Status)) {
+        return EFI_SUCCESS;
+      }
+      gBS->CloseEvent (mSelInfoToken.Event);
+    }
+  }
+
+  Status = IpmiGetSelInfo (&mSelInfo);
+  if (EFI_ERROR (Status) || (mSelInfo.CompletionCode != 0)) {
     return EFI_DEVICE_ERROR;
   }
 
-  //
-  // Check the Bit7 of the OperationByte if SEL is OverFlow.
-  //
-  SelIsFull = (SelInfo.OperationSupport & 0x80);
-  DEBUG ((DEBUG_INFO, "SelIsFull - 0x%x\n", SelIsFull));
+  ReportSelIsFull ();
 
   return EFI_SUCCESS;
 }
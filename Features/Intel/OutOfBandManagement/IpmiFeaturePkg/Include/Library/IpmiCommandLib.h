@@ -198,6 +198,12 @@ IpmiPartialAddSelEntry (
   OUT IPMI_PARTIAL_ADD_SEL_ENTRY_RESPONSE  *PartialAddSelEntryResponse
   );
 
+EFI_STATUS
+EFIAPI
+IpmiReserveSel (
+  OUT IPMI_RESERVE_SEL_RESPONSE  *ReserveSelResponse
+  );
+
 EFI_STATUS
 EFIAPI
 IpmiClearSel (
@@ -224,6 +230,13 @@ IpmiGetSdrRepositoryInfo (
   OUT IPMI_GET_SDR_REPOSITORY_INFO_RESPONSE  *GetSdrRepositoryInfoResp
   );
 
+EFI_STATUS
+EFIAPI
+IpmiReserveSdrRepository (
+  OUT UINT8                         *CompletionCode,
+  OUT UINT16                        *ReservationId
+  );
+
 EFI_STATUS
 EFIAPI
 IpmiGetSdr (
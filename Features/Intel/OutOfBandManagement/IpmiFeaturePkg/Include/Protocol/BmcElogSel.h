@@ -0,0 +1,93 @@
+/** @file
+  BMC System Event Log protocol.
+
+  Gives access to an in-memory copy of the BMC SEL that is updated
+  incrementally, and erases the SEL without blocking the caller.
+
+  The copy is saved in non-volatile variables at ReadyToBoot. The first
+  ReadSel () of the next boot only reads the records added since, none when
+  the SEL is unchanged. A BMC that does not report the erase timestamp gets
+  its whole SEL read by every ReadSel ().
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _BMC_ELOG_SEL_PROTOCOL_H_
+#define _BMC_ELOG_SEL_PROTOCOL_H_
+
+#define BMC_ELOG_SEL_PROTOCOL_GUID \
+  { \
+    0xde70dcc4, 0xb18e, 0x4cb2, { 0xbf, 0x41, 0xd4, 0x7f, 0x40, 0x55, 0x45, 0x87 } \
+  }
+
+typedef struct _BMC_ELOG_SEL_PROTOCOL BMC_ELOG_SEL_PROTOCOL;
+
+#define BMC_ELOG_SEL_RECORD_SIZE  16
+
+//
+// Ring of SEL records. Record N, 0 being the oldest one, is at
+// Records + ((Head + N) % Capacity) * BMC_ELOG_SEL_RECORD_SIZE.
+//
+typedef struct {
+  UINT32                      Capacity;       // Number of records the ring can hold
+  UINT32                      Count;          // Number of valid records
+  UINT32                      Head;           // Index of the oldest record
+  UINT32                      Overwritten;    // Records lost because the ring was full
+  UINT8                       *Records;
+} BMC_ELOG_SEL_RING;
+
+/**
+  Read the SEL records added since the last call into the ring.
+
+  @param[in]  This              This instance of the protocol.
+  @param[out] Ring              The ring, owned by the protocol.
+
+  @retval EFI_SUCCESS           The ring holds the newest records of the SEL.
+  @retval EFI_INVALID_PARAMETER Ring is NULL.
+  @retval EFI_NOT_READY         An erase is in progress, the ring was not updated.
+  @retval EFI_DEVICE_ERROR      The SEL could not be read, the ring holds the records read so far.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *BMC_ELOG_SEL_READ) (
+  IN  BMC_ELOG_SEL_PROTOCOL       *This,
+  OUT CONST BMC_ELOG_SEL_RING     **Ring
+  );
+
+/**
+  Start erasing the SEL.
+
+  The erase completes in the background when the IPMI asynchronous command
+  queue is available, otherwise before returning. A background erase still
+  in progress at ReadyToBoot is completed there, and erases started after
+  ReadyToBoot complete before returning. An erase that is still in progress
+  at ExitBootServices is abandoned: EraseStatus is set to EFI_ABORTED and
+  Event is not signaled.
+
+  @param[in]  This              This instance of the protocol.
+  @param[in]  Event             Signaled when the erase has completed.
+  @param[out] EraseStatus       EFI_NOT_READY while the erase is in progress, its result afterwards.
+                                Must stay valid until the erase has completed.
+
+  @retval EFI_SUCCESS           The erase was started or has completed.
+  @retval EFI_ALREADY_STARTED   An erase is in progress.
+  @retval Others                The erase could not be started.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *BMC_ELOG_SEL_ERASE) (
+  IN  BMC_ELOG_SEL_PROTOCOL       *This,
+  IN  EFI_EVENT                   Event OPTIONAL,
+  OUT EFI_STATUS                  *EraseStatus OPTIONAL
+  );
+
+struct _BMC_ELOG_SEL_PROTOCOL {
+  BMC_ELOG_SEL_READ               ReadSel;
+  BMC_ELOG_SEL_ERASE              EraseSel;
+};
+
+extern EFI_GUID gBmcElogSelProtocolGuid;
+
+#endif
@@ -0,0 +1,103 @@
+/** @file
+  IPMI asynchronous command protocol.
+
+  Commands submitted through this protocol are queued and sent to the BMC
+  later, at the end of a DXE dispatch round, at ReadyToBoot or when the
+  queue is flushed, so that the submitting driver does not wait for the BMC
+  round trip. Completion is reported through the optional token.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _IPMI_ASYNC_PROTOCOL_H_
+#define _IPMI_ASYNC_PROTOCOL_H_
+
+#define IPMI_ASYNC_PROTOCOL_GUID \
+  { \
+    0x69938500, 0xaf1c, 0x4022, { 0xa8, 0xd7, 0x8f, 0xe1, 0x4e, 0x79, 0x36, 0x62 } \
+  }
+
+typedef struct _IPMI_ASYNC_PROTOCOL IPMI_ASYNC_PROTOCOL;
+
+//
+// The command may be merged with an identical command that is still pending,
+// e.g. watchdog timer resets. Only valid for commands submitted without token.
+//
+#define IPMI_ASYNC_COALESCE   BIT0
+
+//
+// Maximum request data size of a queued command.
+//
+#define IPMI_ASYNC_MAX_REQUEST_DATA_SIZE  0x40
+
+typedef struct {
+  //
+  // Signaled when the command has completed, may be NULL when the caller polls Status.
+  // Not signaled for commands completed after ExitBootServices.
+  //
+  EFI_EVENT                   Event;
+  //
+  // EFI_NOT_READY while the command is pending, status of the BMC transfer afterwards.
+  //
+  EFI_STATUS                  Status;
+  //
+  // Buffer provided by the caller, must stay valid until the command has completed.
+  //
+  UINT8                       *ResponseData;
+  //
+  // IN: size of ResponseData, OUT: size of the response.
+  //
+  UINT32                      ResponseDataSize;
+} IPMI_ASYNC_TOKEN;
+
+/**
+  Queue an IPMI command.
+
+  @param[in]      This              This instance of the protocol.
+  @param[in]      NetFunction       Net function of the command.
+  @param[in]      Command           IPMI command number.
+  @param[in]      RequestData       Command request data, copied into the queue.
+  @param[in]      RequestDataSize   Size of the request data.
+  @param[in]      Flags             IPMI_ASYNC_xxx flags.
+  @param[in, out] Token             Completion token, NULL for a command whose response is not needed.
+
+  @retval EFI_SUCCESS               The command was queued or merged with a pending one.
+  @retval EFI_INVALID_PARAMETER     RequestDataSize is too large or Flags are invalid.
+  @retval EFI_OUT_OF_RESOURCES      The command could not be queued.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_ASYNC_SUBMIT_COMMAND) (
+  IN     IPMI_ASYNC_PROTOCOL          *This,
+  IN     UINT8                        NetFunction,
+  IN     UINT8                        Command,
+  IN     UINT8                        *RequestData OPTIONAL,
+  IN     UINT32                       RequestDataSize,
+  IN     UINT32                       Flags,
+  IN OUT IPMI_ASYNC_TOKEN             *Token OPTIONAL
+  );
+
+/**
+  Send all queued commands to the BMC and complete them before returning.
+
+  @param[in]      This              This instance of the protocol.
+
+  @retval EFI_SUCCESS               The queue is empty.
+  @retval EFI_ALREADY_STARTED       The queue is being processed by an interrupted caller.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_ASYNC_FLUSH) (
+  IN     IPMI_ASYNC_PROTOCOL          *This
+  );
+
+struct _IPMI_ASYNC_PROTOCOL {
+  IPMI_ASYNC_SUBMIT_COMMAND           SubmitCommand;
+  IPMI_ASYNC_FLUSH                    Flush;
+};
+
+extern EFI_GUID gIpmiAsyncProtocolGuid;
+
+#endif
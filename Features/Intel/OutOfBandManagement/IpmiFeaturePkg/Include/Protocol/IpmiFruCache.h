@@ -0,0 +1,85 @@
+/** @file
+  IPMI FRU and SDR cache protocol.
+
+  Provides the FRU inventory data of the BMC FRU device and the records of
+  the BMC SDR repository from memory. The SDR records are cached across
+  boots and are only read from the BMC again when the SDR repository
+  timestamps or record count change. The FRU data is read from the BMC on
+  the first ReadFruData() call of each boot.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _IPMI_FRU_CACHE_PROTOCOL_H_
+#define _IPMI_FRU_CACHE_PROTOCOL_H_
+
+#define IPMI_FRU_CACHE_PROTOCOL_GUID \
+  { \
+    0xef51b227, 0x119e, 0x43e5, { 0x94, 0xcf, 0x86, 0xda, 0xc1, 0x7f, 0x0a, 0xa1 } \
+  }
+
+typedef struct _IPMI_FRU_CACHE_PROTOCOL IPMI_FRU_CACHE_PROTOCOL;
+
+//
+// RecordId of the first SDR record and NextRecordId after the last record.
+//
+#define IPMI_SDR_FIRST_RECORD_ID  0x0000
+#define IPMI_SDR_LAST_RECORD_ID   0xFFFF
+
+/**
+  Read FRU inventory data.
+
+  @param[in]      This          This instance of the protocol.
+  @param[in]      DeviceId      FRU device ID.
+  @param[in]      Offset        Offset in the FRU inventory area.
+  @param[in]      Size          Number of bytes to read.
+  @param[out]     Buffer        The FRU data.
+
+  @retval EFI_SUCCESS           The data was read from the cache.
+  @retval EFI_INVALID_PARAMETER Buffer is NULL.
+  @retval EFI_NOT_FOUND         The device or the range is not cached, read it from the BMC.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_FRU_CACHE_READ_FRU_DATA) (
+  IN  IPMI_FRU_CACHE_PROTOCOL     *This,
+  IN  UINT8                       DeviceId,
+  IN  UINT16                      Offset,
+  IN  UINT32                      Size,
+  OUT VOID                        *Buffer
+  );
+
+/**
+  Get a complete SDR record, including the record header.
+
+  @param[in]      This          This instance of the protocol.
+  @param[in]      RecordId      ID of the record, IPMI_SDR_FIRST_RECORD_ID for the first one.
+  @param[out]     NextRecordId  ID of the next record, IPMI_SDR_LAST_RECORD_ID after the last one.
+  @param[in, out] RecordSize    IN: size of Record, OUT: size of the SDR record.
+  @param[out]     Record        The SDR record.
+
+  @retval EFI_SUCCESS           The record was returned.
+  @retval EFI_INVALID_PARAMETER NextRecordId or RecordSize is NULL.
+  @retval EFI_BUFFER_TOO_SMALL  Record is too small, RecordSize was updated.
+  @retval EFI_NOT_FOUND         The record is not cached, read it from the BMC.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *IPMI_FRU_CACHE_GET_SDR) (
+  IN     IPMI_FRU_CACHE_PROTOCOL  *This,
+  IN     UINT16                   RecordId,
+  OUT    UINT16                   *NextRecordId,
+  IN OUT UINT32                   *RecordSize,
+  OUT    VOID                     *Record
+  );
+
+struct _IPMI_FRU_CACHE_PROTOCOL {
+  IPMI_FRU_CACHE_READ_FRU_DATA    ReadFruData;
+  IPMI_FRU_CACHE_GET_SDR          GetSdr;
+};
+
+extern EFI_GUID gIpmiFruCacheProtocolGuid;
+
+#endif
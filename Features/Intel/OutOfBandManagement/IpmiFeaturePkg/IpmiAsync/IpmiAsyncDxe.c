@@ -0,0 +1,438 @@
+/** @file
+  IPMI asynchronous command queue.
+
+  Commands are queued by IPMI_ASYNC_PROTOCOL.SubmitCommand() and sent to the
+  BMC through IpmiLib at points where no other driver can be in the middle of
+  an IPMI transfer: at the end of each DXE dispatch round, at ReadyToBoot,
+  at ExitBootServices and on an explicit flush. Sending them from a timer
+  event would interrupt synchronous IpmiLib users in the middle of a transfer.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/IpmiLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/IpmiAsync.h>
+#include <Guid/EventGroup.h>
+
+#define IPMI_ASYNC_ENTRY_SIGNATURE  SIGNATURE_32 ('I', 'P', 'A', 'Q')
+
+//
+// Response buffer of commands submitted without token.
+//
+#define IPMI_ASYNC_MAX_RESPONSE_DATA_SIZE  0x100
+
+typedef struct {
+  UINT32                      Signature;
+  LIST_ENTRY                  Link;
+  UINT8                       NetFunction;
+  UINT8                       Command;
+  UINT32                      Flags;
+  IPMI_ASYNC_TOKEN            *Token;
+  UINT32                      RequestDataSize;
+  UINT8                       RequestData[IPMI_ASYNC_MAX_REQUEST_DATA_SIZE];
+} IPMI_ASYNC_ENTRY;
+
+#define IPMI_ASYNC_ENTRY_FROM_LINK(a)  CR (a, IPMI_ASYNC_ENTRY, Link, IPMI_ASYNC_ENTRY_SIGNATURE)
+
+EFI_STATUS
+EFIAPI
+IpmiAsyncSubmitCommand (
+  IN     IPMI_ASYNC_PROTOCOL          *This,
+  IN     UINT8                        NetFunction,
+  IN     UINT8                        Command,
+  IN     UINT8                        *RequestData OPTIONAL,
+  IN     UINT32                       RequestDataSize,
+  IN     UINT32                       Flags,
+  IN OUT IPMI_ASYNC_TOKEN             *Token OPTIONAL
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiAsyncFlush (
+  IN     IPMI_ASYNC_PROTOCOL          *This
+  );
+
+IPMI_ASYNC_PROTOCOL  mIpmiAsync = {
+  IpmiAsyncSubmitCommand,
+  IpmiAsyncFlush
+};
+
+LIST_ENTRY  mIpmiAsyncQueue = INITIALIZE_LIST_HEAD_VARIABLE (mIpmiAsyncQueue);
+BOOLEAN     mIpmiAsyncBusy;
+BOOLEAN     mIpmiAsyncExitBootServices;
+UINT32      mIpmiAsyncSubmitted;
+UINT32      mIpmiAsyncCoalesced;
+UINT8       mIpmiAsyncResponse[IPMI_ASYNC_MAX_RESPONSE_DATA_SIZE];
+
+/**
+  Send one command to the BMC and report its completion.
+
+  The token event is not signaled after ExitBootServices.
+
+  @param[in] Entry    The command.
+**/
+VOID
+IpmiAsyncSend (
+  IN IPMI_ASYNC_ENTRY         *Entry
+  )
+{
+  EFI_STATUS                  Status;
+  UINT32                      ResponseDataSize;
+
+  if (Entry->Token != NULL) {
+    ResponseDataSize = Entry->Token->ResponseDataSize;
+    Status = IpmiSubmitCommand (
+               Entry->NetFunction,
+               Entry->Command,
+               Entry->RequestData,
+               Entry->RequestDataSize,
+               Entry->Token->ResponseData,
+               &ResponseDataSize
+               );
+    Entry->Token->ResponseDataSize = ResponseDataSize;
+    Entry->Token->Status           = Status;
+    if ((Entry->Token->Event != NULL) && !mIpmiAsyncExitBootServices) {
+      gBS->SignalEvent (Entry->Token->Event);
+    }
+    return;
+  }
+
+  ResponseDataSize = sizeof (mIpmiAsyncResponse);
+  Status = IpmiSubmitCommand (
+             Entry->NetFunction,
+             Entry->Command,
+             Entry->RequestData,
+             Entry->RequestDataSize,
+             mIpmiAsyncResponse,
+             &ResponseDataSize
+             );
+  if (EFI_ERROR (Status) || ((ResponseDataSize != 0) && (mIpmiAsyncResponse[0] != 0))) {
+    DEBUG ((
+      DEBUG_WARN,
+      "IpmiAsync: NetFn 0x%x Cmd 0x%x failed - %r, completion code 0x%x\n",
+      Entry->NetFunction,
+      Entry->Command,
+      Status,
+      (ResponseDataSize != 0) ? mIpmiAsyncResponse[0] : 0
+      ));
+  }
+}
+
+/**
+  Remove the oldest command from the queue.
+
+  @return The command, NULL if the queue is empty.
+**/
+IPMI_ASYNC_ENTRY *
+IpmiAsyncDequeue (
+  VOID
+  )
+{
+  EFI_TPL                     OldTpl;
+  IPMI_ASYNC_ENTRY            *Entry;
+
+  Entry  = NULL;
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (!IsListEmpty (&mIpmiAsyncQueue)) {
+    Entry = IPMI_ASYNC_ENTRY_FROM_LINK (GetFirstNode (&mIpmiAsyncQueue));
+    RemoveEntryList (&Entry->Link);
+  }
+  gBS->RestoreTPL (OldTpl);
+
+  return Entry;
+}
+
+/**
+  Find a pending command an IPMI_ASYNC_COALESCE command can be merged with.
+
+  Only the last queued command of the same net function is considered, so
+  the merged command is never reordered with a related command, e.g. a
+  watchdog reset with a following set watchdog timer.
+
+  Must be called at TPL_NOTIFY.
+
+  @param[in] NetFunction      Net function of the command.
+  @param[in] Command          IPMI command number.
+  @param[in] RequestData      Command request data.
+  @param[in] RequestDataSize  Size of the request data.
+
+  @retval TRUE    An identical command is pending.
+  @retval FALSE   The command must be queued.
+**/
+BOOLEAN
+IpmiAsyncIsPending (
+  IN UINT8                    NetFunction,
+  IN UINT8                    Command,
+  IN UINT8                    *RequestData,
+  IN UINT32                   RequestDataSize
+  )
+{
+  LIST_ENTRY                  *Link;
+  IPMI_ASYNC_ENTRY            *Entry;
+
+  for (Link = GetPreviousNode (&mIpmiAsyncQueue, &mIpmiAsyncQueue);
+       !IsNull (&mIpmiAsyncQueue, Link);
+       Link = GetPreviousNode (&mIpmiAsyncQueue, Link)) {
+    Entry = IPMI_ASYNC_ENTRY_FROM_LINK (Link);
+    if (Entry->NetFunction != NetFunction) {
+      continue;
+    }
+    return (BOOLEAN) ((Entry->Command == Command) &&
+                      ((Entry->Flags & IPMI_ASYNC_COALESCE) != 0) &&
+                      (Entry->RequestDataSize == RequestDataSize) &&
+                      (CompareMem (Entry->RequestData, RequestData, RequestDataSize) == 0));
+  }
+
+  return FALSE;
+}
+
+/**
+  Queue an IPMI command.
+
+  @param[in]      This              This instance of the protocol.
+  @param[in]      NetFunction       Net function of the command.
+  @param[in]      Command           IPMI command number.
+  @param[in]      RequestData       Command request data, copied into the queue.
+  @param[in]      RequestDataSize   Size of the request data.
+  @param[in]      Flags             IPMI_ASYNC_xxx flags.
+  @param[in, out] Token             Completion token, NULL for a command whose response is not needed.
+
+  @retval EFI_SUCCESS               The command was queued or merged with a pending one.
+  @retval EFI_INVALID_PARAMETER     RequestDataSize is too large or Flags are invalid.
+  @retval EFI_OUT_OF_RESOURCES      The command could not be queued.
+**/
+EFI_STATUS
+EFIAPI
+IpmiAsyncSubmitCommand (
+  IN     IPMI_ASYNC_PROTOCOL          *This,
+  IN     UINT8                        NetFunction,
+  IN     UINT8                        Command,
+  IN     UINT8                        *RequestData OPTIONAL,
+  IN     UINT32                       RequestDataSize,
+  IN     UINT32                       Flags,
+  IN OUT IPMI_ASYNC_TOKEN             *Token OPTIONAL
+  )
+{
+  EFI_TPL                     OldTpl;
+  IPMI_ASYNC_ENTRY            *Entry;
+  IPMI_ASYNC_ENTRY            LocalEntry;
+
+  if ((RequestDataSize > IPMI_ASYNC_MAX_REQUEST_DATA_SIZE) ||
+      ((RequestData == NULL) && (RequestDataSize != 0)) ||
+      ((Flags & ~IPMI_ASYNC_COALESCE) != 0) ||
+      (((Flags & IPMI_ASYNC_COALESCE) != 0) && (Token != NULL)) ||
+      ((Token != NULL) && (Token->ResponseData == NULL))) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  //
+  // Nothing is dispatched after ExitBootServices, send the command right away.
+  //
+  Entry = &LocalEntry;
+  if (!mIpmiAsyncExitBootServices) {
+    Entry = AllocatePool (sizeof (*Entry));
+    if (Entry == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+  }
+
+  Entry->Signature       = IPMI_ASYNC_ENTRY_SIGNATURE;
+  Entry->NetFunction     = NetFunction;
+  Entry->Command         = Command;
+  Entry->Flags           = Flags;
+  Entry->Token           = Token;
+  Entry->RequestDataSize = RequestDataSize;
+  CopyMem (Entry->RequestData, RequestData, RequestDataSize);
+  if (Token != NULL) {
+    Token->Status = EFI_NOT_READY;
+  }
+
+  if (mIpmiAsyncExitBootServices) {
+    IpmiAsyncSend (Entry);
+    return EFI_SUCCESS;
+  }
+
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  mIpmiAsyncSubmitted++;
+  if (((Flags & IPMI_ASYNC_COALESCE) != 0) &&
+      IpmiAsyncIsPending (NetFunction, Command, Entry->RequestData, RequestDataSize)) {
+    mIpmiAsyncCoalesced++;
+    gBS->RestoreTPL (OldTpl);
+    FreePool (Entry);
+    return EFI_SUCCESS;
+  }
+  InsertTailList (&mIpmiAsyncQueue, &Entry->Link);
+  gBS->RestoreTPL (OldTpl);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Send all queued commands to the BMC and complete them before returning.
+
+  @param[in]      This              This instance of the protocol.
+
+  @retval EFI_SUCCESS               The queue is empty.
+  @retval EFI_ALREADY_STARTED       The queue is being processed by an interrupted caller.
+**/
+EFI_STATUS
+EFIAPI
+IpmiAsyncFlush (
+  IN     IPMI_ASYNC_PROTOCOL          *This
+  )
+{
+  EFI_TPL                     OldTpl;
+  IPMI_ASYNC_ENTRY            *Entry;
+
+  //
+  // Commands are sent right away after ExitBootServices, nothing is queued.
+  //
+  if (mIpmiAsyncExitBootServices) {
+    return EFI_SUCCESS;
+  }
+
+  //
+  // Commands completed from a higher TPL event must not start a transfer
+  // while the interrupted flush is in the middle of one.
+  //
+  OldTpl = gBS->RaiseTPL (TPL_NOTIFY);
+  if (mIpmiAsyncBusy) {
+    gBS->RestoreTPL (OldTpl);
+    return EFI_ALREADY_STARTED;
+  }
+  mIpmiAsyncBusy = TRUE;
+  gBS->RestoreTPL (OldTpl);
+
+  while ((Entry = IpmiAsyncDequeue ()) != NULL) {
+    IpmiAsyncSend (Entry);
+    FreePool (Entry);
+  }
+
+  mIpmiAsyncBusy = FALSE;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Send the queued commands at the end of a DXE dispatch round and at ReadyToBoot.
+
+  @param[in] Event    Event whose notification function is being invoked.
+  @param[in] Context  Pointer to the notification function's context.
+**/
+VOID
+EFIAPI
+IpmiAsyncFlushNotify (
+  IN EFI_EVENT                Event,
+  IN VOID                     *Context
+  )
+{
+  IpmiAsyncFlush (&mIpmiAsync);
+}
+
+/**
+  Send the queued commands and switch to synchronous operation at ExitBootServices.
+
+  The queue was flushed at ReadyToBoot, so only the commands queued since are
+  left. They are sent without being freed, memory must not be freed here.
+
+  @param[in] Event    Event whose notification function is being invoked.
+  @param[in] Context  Pointer to the notification function's context.
+**/
+VOID
+EFIAPI
+IpmiAsyncExitBootServicesNotify (
+  IN EFI_EVENT                Event,
+  IN VOID                     *Context
+  )
+{
+  IPMI_ASYNC_ENTRY            *Entry;
+
+  mIpmiAsyncBusy = TRUE;
+  while ((Entry = IpmiAsyncDequeue ()) != NULL) {
+    IpmiAsyncSend (Entry);
+  }
+  mIpmiAsyncExitBootServices = TRUE;
+  mIpmiAsyncBusy             = FALSE;
+
+  DEBUG ((
+    DEBUG_INFO,
+    "IpmiAsync: %d commands submitted, %d coalesced\n",
+    mIpmiAsyncSubmitted,
+    mIpmiAsyncCoalesced
+    ));
+}
+
+/**
+  The entry point of the IPMI asynchronous command queue driver.
+
+  @param[in] ImageHandle  The firmware allocated handle for the EFI image.
+  @param[in] SystemTable  A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS     The protocol was installed.
+  @retval Others          The events could not be created or the protocol could not be installed.
+**/
+EFI_STATUS
+EFIAPI
+IpmiAsyncEntryPoint (
+  IN EFI_HANDLE               ImageHandle,
+  IN EFI_SYSTEM_TABLE         *SystemTable
+  )
+{
+  EFI_STATUS                  Status;
+  EFI_EVENT                   Event;
+  EFI_HANDLE                  Handle;
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  IpmiAsyncFlushNotify,
+                  NULL,
+                  &gEfiEventDxeDispatchGuid,
+                  &Event
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = EfiCreateEventReadyToBootEx (
+             TPL_CALLBACK,
+             IpmiAsyncFlushNotify,
+             NULL,
+             &Event
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  IpmiAsyncExitBootServicesNotify,
+                  NULL,
+                  &gEfiEventExitBootServicesGuid,
+                  &Event
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  Handle = NULL;
+  Status = gBS->InstallProtocolInterface (
+                  &Handle,
+                  &gIpmiAsyncProtocolGuid,
+                  EFI_NATIVE_INTERFACE,
+                  &mIpmiAsync
+                  );
+  ASSERT_EFI_ERROR (Status);
+
+  return Status;
+}
@@ -1,6 +1,18 @@
 /** @file
   IPMI FRU Driver.
 
+  The FRU inventory data and the SDR repository records are provided through
+  the IPMI FRU cache protocol. The SDR records are kept in a non-volatile
+  variable and read from the BMC again only when the SDR repository
+  timestamps or the number of records change. The FRU data is read from the
+  BMC on the first ReadFruData() call of every boot: FRU writes change no
+  timestamp, and an edit that keeps the area size and checksums valid could
+  not be detected.
+
+  Reads are sized to what the BMC and the transport can return: the data size
+  of one command starts at IPMI_FRU_READ_MAX_CHUNK_SIZE and is halved whenever
+  a read fails or the BMC cannot return the requested number of bytes.
+
 Copyright (c) 2018 - 2019, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
@@ -8,11 +20,724 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include <Library/BaseLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseMemoryLib.h>
+#include <Library/PcdLib.h>
 #include <Library/IpmiCommandLib.h>
 #include <IndustryStandard/Ipmi.h>
+#include <Guid/VariableFormat.h>
+#include <Protocol/IpmiFruCache.h>
+
+#define IPMI_FRU_CACHE_VARIABLE_NAME  L"IpmiFruSdrCache"
+
+#define IPMI_FRU_CACHE_SIGNATURE      SIGNATURE_32 ('I', 'F', 'S', 'C')
+
+//
+// Larger FRU areas are cached partially. The SDR records are limited by the size of
+// the cache variable, larger SDR repositories are not cached.
+//
+#define IPMI_FRU_CACHE_MAX_FRU_SIZE   SIZE_4KB
+
+//
+// Data bytes of one Read FRU Data or partial Get SDR command. The smallest size fits
+// in any system interface.
+//
+#define IPMI_FRU_READ_MAX_CHUNK_SIZE  0x80
+#define IPMI_FRU_READ_MIN_CHUNK_SIZE  0x10
+
+//
+// Get FRU Inventory Area Info access type: offsets and counts are in words.
+//
+#define IPMI_FRU_ACCESS_BY_WORDS      BIT0
+
+#define IPMI_COMPLETION_CODE_RESERVATION_CANCELLED  0xC5
+#define IPMI_COMPLETION_CODE_CANNOT_RETURN_BYTES    0xCA
+
+#define IPMI_SDR_RECORD_HEADER_SIZE   5
+
+//
+// Timestamp value of an SDR repository that does not report additions or erases.
+//
+#define IPMI_SDR_TIMESTAMP_UNSPECIFIED  0xFFFFFFFF
+
+#define IPMI_FRU_CACHE_FRU_VALID      BIT0
+#define IPMI_FRU_CACHE_SDR_VALID      BIT1
+//
+// The SDR repository does not fit in a cache of SdrSize bytes.
+//
+#define IPMI_FRU_CACHE_SDR_TOO_LARGE  BIT2
+
+//
+// Cache layout: header, SdrSize bytes of SDR records. The FRU data is kept in mFruData.
+// The variable holds the header and the SDR records, the FRU fields of its header are not used.
+//
+typedef struct {
+  UINT32                      Signature;
+  UINT32                      Flags;
+  UINT32                      SdrMostRecentAddition;
+  UINT32                      SdrMostRecentErase;
+  UINT16                      SdrRecordCount;
+  UINT16                      FruAreaSize;
+  UINT8                       FruDeviceId;
+  UINT8                       FruAccessType;
+  UINT8                       Reserved[2];
+  UINT32                      FruSize;
+  UINT32                      SdrSize;
+} IPMI_FRU_CACHE_HEADER;
+
+EFI_STATUS
+EFIAPI
+IpmiFruCacheReadFruData (
+  IN  IPMI_FRU_CACHE_PROTOCOL     *This,
+  IN  UINT8                       DeviceId,
+  IN  UINT16                      Offset,
+  IN  UINT32                      Size,
+  OUT VOID                        *Buffer
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiFruCacheGetSdr (
+  IN     IPMI_FRU_CACHE_PROTOCOL  *This,
+  IN     UINT16                   RecordId,
+  OUT    UINT16                   *NextRecordId,
+  IN OUT UINT32                   *RecordSize,
+  OUT    VOID                     *Record
+  );
+
+IPMI_FRU_CACHE_PROTOCOL  mIpmiFruCache = {
+  IpmiFruCacheReadFruData,
+  IpmiFruCacheGetSdr
+};
+
+IPMI_FRU_CACHE_HEADER    *mFruCache;
+UINT8                    *mFruData;
+BOOLEAN                  mFruInventorySupport;
+BOOLEAN                  mFruRead;
+UINT32                   mMaxSdrSize;
+UINT8                    mReadChunkSize = IPMI_FRU_READ_MAX_CHUNK_SIZE;
+UINT16                   mSdrReservationId;
+
+VOID
+LoadFru (
+  VOID
+  );
+
+EFI_STATUS
+EFIAPI
+IpmiFruCacheReadFruData (
+  IN  IPMI_FRU_CACHE_PROTOCOL     *This,
+  IN  UINT8                       DeviceId,
+  IN  UINT16                      Offset,
+  IN  UINT32                      Size,
+  OUT VOID                        *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Read FRU inventory data from the cache. The first call reads the FRU data from
+  the BMC.
+
+Arguments:
+
+  This      - This instance of the protocol
+  DeviceId  - FRU device ID
+  Offset    - Offset in the FRU inventory area
+  Size      - Number of bytes to read
+  Buffer    - The FRU data
+
+Returns:
+
+  EFI_SUCCESS            - The data was read from the cache
+  EFI_INVALID_PARAMETER  - Buffer is NULL
+  EFI_NOT_FOUND          - The device or the range is not cached
+
+--*/
+{
+  if (Buffer == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if (DeviceId != mFruCache->FruDeviceId) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (!mFruRead) {
+    mFruRead = TRUE;
+    LoadFru ();
+  }
+
+  if (((mFruCache->Flags & IPMI_FRU_CACHE_FRU_VALID) == 0) ||
+      ((UINT32) Offset + Size > mFruCache->FruSize)) {
+    return EFI_NOT_FOUND;
+  }
+
+  CopyMem (Buffer, mFruData + Offset, Size);
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+EFIAPI
+IpmiFruCacheGetSdr (
+  IN     IPMI_FRU_CACHE_PROTOCOL  *This,
+  IN     UINT16                   RecordId,
+  OUT    UINT16                   *NextRecordId,
+  IN OUT UINT32                   *RecordSize,
+  OUT    VOID                     *Record
+  )
+/*++
+
+Routine Description:
+
+  Get a complete SDR record from the cache.
+
+Arguments:
+
+  This          - This instance of the protocol
+  RecordId      - ID of the record, IPMI_SDR_FIRST_RECORD_ID for the first one
+  NextRecordId  - ID of the next record, IPMI_SDR_LAST_RECORD_ID after the last one
+  RecordSize    - IN: size of Record, OUT: size of the SDR record
+  Record        - The SDR record
+
+Returns:
+
+  EFI_SUCCESS            - The record was returned
+  EFI_INVALID_PARAMETER  - NextRecordId or RecordSize is NULL
+  EFI_BUFFER_TOO_SMALL   - Record is too small, RecordSize was updated
+  EFI_NOT_FOUND          - The record is not cached
+
+--*/
+{
+  UINT8                       *Sdr;
+  UINT8                       *SdrEnd;
+  UINT32                      Size;
+
+  if ((NextRecordId == NULL) || (RecordSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  if ((mFruCache->Flags & IPMI_FRU_CACHE_SDR_VALID) == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  //
+  // Records are stored back to back in the order the BMC returned them.
+  //
+  Sdr    = (UINT8 *) (mFruCache + 1);
+  SdrEnd = Sdr + mFruCache->SdrSize;
+  while (Sdr < SdrEnd) {
+    Size = IPMI_SDR_RECORD_HEADER_SIZE + Sdr[4];
+    if ((RecordId == IPMI_SDR_FIRST_RECORD_ID) || (RecordId == ReadUnaligned16 ((UINT16 *) Sdr))) {
+      if (*RecordSize < Size) {
+        *RecordSize = Size;
+        return EFI_BUFFER_TOO_SMALL;
+      }
+      if (Record == NULL) {
+        return EFI_INVALID_PARAMETER;
+      }
+      CopyMem (Record, Sdr, Size);
+      *RecordSize   = Size;
+      *NextRecordId = (Sdr + Size < SdrEnd) ? ReadUnaligned16 ((UINT16 *) (Sdr + Size)) : IPMI_SDR_LAST_RECORD_ID;
+      return EFI_SUCCESS;
+    }
+    Sdr += Size;
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+BOOLEAN
+ReduceReadChunkSize (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Halve the data size of the following Read FRU Data and partial Get SDR commands,
+  after a read failed or the BMC could not return the requested number of bytes.
+
+Arguments:
+
+  None
+
+Returns:
+
+  TRUE   - The size was reduced, retry the read
+  FALSE  - The size is already the smallest one
+
+--*/
+{
+  if (mReadChunkSize <= IPMI_FRU_READ_MIN_CHUNK_SIZE) {
+    return FALSE;
+  }
+
+  mReadChunkSize /= 2;
+  DEBUG ((DEBUG_INFO, "IpmiFru: read size reduced to %d bytes\n", mReadChunkSize));
+  return TRUE;
+}
+
+EFI_STATUS
+ReadFruFromBmc (
+  IN  UINT8                   DeviceId,
+  IN  BOOLEAN                 WordAccess,
+  IN  UINT32                  Size,
+  OUT UINT8                   *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Read the beginning of the FRU inventory area from the BMC.
+
+Arguments:
+
+  DeviceId    - FRU device ID
+  WordAccess  - The device is accessed by words, Size is even
+  Size        - Number of bytes to read
+  Buffer      - The FRU data
+
+Returns:
+
+  EFI_SUCCESS       - The data was read
+  EFI_DEVICE_ERROR  - The BMC returned an error
+
+--*/
+{
+  EFI_STATUS                  Status;
+  IPMI_READ_FRU_DATA_REQUEST  ReadFruDataRequest;
+  IPMI_READ_FRU_DATA_RESPONSE *ReadFruDataResponse;
+  UINT8                       ResponseData[sizeof (IPMI_READ_FRU_DATA_RESPONSE) + IPMI_FRU_READ_MAX_CHUNK_SIZE];
+  UINT32                      ResponseSize;
+  UINT32                      Offset;
+  UINT32                      Count;
+  UINT32                      CountReturned;
+
+  ReadFruDataResponse = (IPMI_READ_FRU_DATA_RESPONSE *) ResponseData;
+
+  Offset = 0;
+  while (Offset < Size) {
+    Count = MIN (Size - Offset, mReadChunkSize);
+
+    //
+    // A device accessed by words takes its offset and counts in words.
+    //
+    ReadFruDataRequest.DeviceId        = DeviceId;
+    ReadFruDataRequest.InventoryOffset = (UINT16) (WordAccess ? Offset / 2 : Offset);
+    ReadFruDataRequest.CountToRead     = (UINT8) (WordAccess ? Count / 2 : Count);
+
+    ResponseSize = sizeof (ResponseData);
+    Status = IpmiReadFruData (&ReadFruDataRequest, ReadFruDataResponse, &ResponseSize);
+    if (!EFI_ERROR (Status) && (ReadFruDataResponse->CompletionCode == 0)) {
+      CountReturned = WordAccess ? ReadFruDataResponse->CountReturned * 2 : ReadFruDataResponse->CountReturned;
+      if ((CountReturned != 0) && (CountReturned <= Count) &&
+          (ResponseSize >= sizeof (IPMI_READ_FRU_DATA_RESPONSE) + CountReturned)) {
+        CopyMem (Buffer + Offset, ReadFruDataResponse->Data, CountReturned);
+        Offset += CountReturned;
+        continue;
+      }
+    }
+
+    if ((EFI_ERROR (Status) ||
+         (ReadFruDataResponse->CompletionCode == IPMI_COMPLETION_CODE_CANNOT_RETURN_BYTES)) &&
+        ReduceReadChunkSize ()) {
+      continue;
+    }
+
+    DEBUG ((DEBUG_ERROR, "!!! IpmiFru  IpmiReadFruData Offset=%x Status=%r\n", Offset, Status));
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+VOID
+LoadFru (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  Read the FRU data from the BMC into mFruData and mark it valid in mFruCache.
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS                                 Status;
+  IPMI_GET_FRU_INVENTORY_AREA_INFO_REQUEST   GetFruInventoryAreaInfoRequest;
+  IPMI_GET_FRU_INVENTORY_AREA_INFO_RESPONSE  GetFruInventoryAreaInfoResponse;
+  UINT32                                     FruSize;
+
+  if (!mFruInventorySupport) {
+    return;
+  }
+
+  GetFruInventoryAreaInfoRequest.DeviceId = mFruCache->FruDeviceId;
+  Status = IpmiGetFruInventoryAreaInfo (&GetFruInventoryAreaInfoRequest, &GetFruInventoryAreaInfoResponse);
+  if (EFI_ERROR (Status) || (GetFruInventoryAreaInfoResponse.CompletionCode != 0)) {
+    DEBUG((DEBUG_ERROR, "!!! IpmiFru  IpmiGetFruInventoryAreaInfo Status=%r\n", Status));
+    return;
+  }
+  DEBUG((DEBUG_ERROR, "!!! IpmiFru  InventoryAreaSize=%x\n", GetFruInventoryAreaInfoResponse.InventoryAreaSize));
+
+  FruSize = MIN (GetFruInventoryAreaInfoResponse.InventoryAreaSize, IPMI_FRU_CACHE_MAX_FRU_SIZE);
+  if ((GetFruInventoryAreaInfoResponse.AccessType & IPMI_FRU_ACCESS_BY_WORDS) != 0) {
+    FruSize &= ~BIT0;
+  }
+  if (FruSize == 0) {
+    return;
+  }
+
+  mFruData = AllocatePool (FruSize);
+  if (mFruData == NULL) {
+    return;
+  }
+
+  Status = ReadFruFromBmc (
+             mFruCache->FruDeviceId,
+             (GetFruInventoryAreaInfoResponse.AccessType & IPMI_FRU_ACCESS_BY_WORDS) != 0,
+             FruSize,
+             mFruData
+             );
+  if (EFI_ERROR (Status)) {
+    FreePool (mFruData);
+    mFruData = NULL;
+    return;
+  }
+
+  mFruCache->Flags        |= IPMI_FRU_CACHE_FRU_VALID;
+  mFruCache->FruAreaSize   = GetFruInventoryAreaInfoResponse.InventoryAreaSize;
+  mFruCache->FruAccessType = GetFruInventoryAreaInfoResponse.AccessType;
+  mFruCache->FruSize       = FruSize;
+}
+
+EFI_STATUS
+ReadSdrPartsFromBmc (
+  IN  UINT16                  RecordId,
+  IN  UINT8                   Offset,
+  IN  UINT32                  Count,
+  OUT UINT8                   *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Read part of an SDR record from the BMC under a reservation, in pieces that the
+  BMC and the transport can return.
+
+Arguments:
+
+  RecordId  - ID of the record
+  Offset    - Offset in the record
+  Count     - Number of bytes to read
+  Buffer    - The record data
+
+Returns:
+
+  EFI_SUCCESS       - The data was read
+  EFI_DEVICE_ERROR  - The BMC returned an error, or the range cannot be addressed
+
+--*/
+{
+  EFI_STATUS                  Status;
+  IPMI_GET_SDR_REQUEST        GetSdrRequest;
+  IPMI_GET_SDR_RESPONSE       *GetSdrResponse;
+  UINT8                       ResponseData[sizeof (IPMI_GET_SDR_RESPONSE) + IPMI_FRU_READ_MAX_CHUNK_SIZE];
+  UINT32                      ResponseSize;
+  UINT8                       CompletionCode;
+  UINT32                      Done;
+  BOOLEAN                     Retried;
+
+  //
+  // The offset in the record is one byte.
+  //
+  if ((UINT32) Offset + Count > MAX_UINT8 + 1) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  GetSdrResponse = (IPMI_GET_SDR_RESPONSE *) ResponseData;
+  Retried        = FALSE;
+
+  Done = 0;
+  while (Done < Count) {
+    if (mSdrReservationId == 0) {
+      Status = IpmiReserveSdrRepository (&CompletionCode, &mSdrReservationId);
+      if (EFI_ERROR (Status) || (CompletionCode != 0) || (mSdrReservationId == 0)) {
+        DEBUG ((DEBUG_ERROR, "!!! IpmiFru  IpmiReserveSdrRepository Status=%r\n", Status));
+        mSdrReservationId = 0;
+        return EFI_DEVICE_ERROR;
+      }
+    }
+
+    ZeroMem (&GetSdrRequest, sizeof (GetSdrRequest));
+    GetSdrRequest.ReservationId = mSdrReservationId;
+    GetSdrRequest.RecordId      = RecordId;
+    GetSdrRequest.RecordOffset  = (UINT8) (Offset + Done);
+    GetSdrRequest.BytesToRead   = (UINT8) MIN (Count - Done, mReadChunkSize);
+    ResponseSize = sizeof (ResponseData);
+    Status = IpmiGetSdr (&GetSdrRequest, GetSdrResponse, &ResponseSize);
+    if (!EFI_ERROR (Status) && (GetSdrResponse->CompletionCode == 0) &&
+        (ResponseSize >= sizeof (IPMI_GET_SDR_RESPONSE) + GetSdrRequest.BytesToRead)) {
+      CopyMem (Buffer + Done, GetSdrResponse + 1, GetSdrRequest.BytesToRead);
+      Done += GetSdrRequest.BytesToRead;
+      continue;
+    }
+
+    //
+    // The reservation is cancelled when the repository changes or another requester
+    // reserves it. Read the record again under a new one, once.
+    //
+    if (!EFI_ERROR (Status) && (GetSdrResponse->CompletionCode == IPMI_COMPLETION_CODE_RESERVATION_CANCELLED) &&
+        !Retried) {
+      Retried           = TRUE;
+      mSdrReservationId = 0;
+      Done              = 0;
+      continue;
+    }
+
+    if ((EFI_ERROR (Status) || (GetSdrResponse->CompletionCode == IPMI_COMPLETION_CODE_CANNOT_RETURN_BYTES)) &&
+        ReduceReadChunkSize ()) {
+      continue;
+    }
+
+    DEBUG ((DEBUG_ERROR, "!!! IpmiFru  IpmiGetSdr RecordId=%x Offset=%x Status=%r\n", RecordId, GetSdrRequest.RecordOffset, Status));
+    return EFI_DEVICE_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+ReadSdrFromBmc (
+  IN  UINT32                  MaxSize,
+  OUT UINT8                   *Buffer,
+  OUT UINT32                  *Size
+  )
+/*++
+
+Routine Description:
+
+  Read all records of the SDR repository from the BMC.
+
+Arguments:
+
+  MaxSize   - Size of Buffer
+  Buffer    - The SDR records
+  Size      - Number of bytes returned in Buffer
+
+Returns:
+
+  EFI_SUCCESS           - The records were read
+  EFI_BUFFER_TOO_SMALL  - The repository does not fit in Buffer
+  EFI_DEVICE_ERROR      - The BMC returned an error
+
+--*/
+{
+  EFI_STATUS                  Status;
+  IPMI_GET_SDR_REQUEST        GetSdrRequest;
+  IPMI_GET_SDR_RESPONSE       *GetSdrResponse;
+  UINT8                       ResponseData[sizeof (IPMI_GET_SDR_RESPONSE) + IPMI_FRU_READ_MAX_CHUNK_SIZE];
+  UINT32                      ResponseSize;
+  UINT16                      RecordId;
+  UINT16                      NextRecordId;
+  UINT32                      RecordSize;
+
+  GetSdrResponse = (IPMI_GET_SDR_RESPONSE *) ResponseData;
+  RecordId       = IPMI_SDR_FIRST_RECORD_ID;
+  *Size          = 0;
+
+  while (RecordId != IPMI_SDR_LAST_RECORD_ID) {
+    //
+    // Get the record header for its length. Reads from offset 0 need no reservation.
+    //
+    ZeroMem (&GetSdrRequest, sizeof (GetSdrRequest));
+    GetSdrRequest.RecordId    = RecordId;
+    GetSdrRequest.BytesToRead = IPMI_SDR_RECORD_HEADER_SIZE;
+    ResponseSize = sizeof (ResponseData);
+    Status = IpmiGetSdr (&GetSdrRequest, GetSdrResponse, &ResponseSize);
+    if (EFI_ERROR (Status) || (GetSdrResponse->CompletionCode != 0) ||
+        (ResponseSize < sizeof (IPMI_GET_SDR_RESPONSE) + IPMI_SDR_RECORD_HEADER_SIZE)) {
+      DEBUG ((DEBUG_ERROR, "!!! IpmiFru  IpmiGetSdr RecordId=%x Status=%r\n", RecordId, Status));
+      return EFI_DEVICE_ERROR;
+    }
+
+    RecordSize = IPMI_SDR_RECORD_HEADER_SIZE + ((UINT8 *) (GetSdrResponse + 1))[4];
+    if (*Size + RecordSize > MaxSize) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
+
+    CopyMem (Buffer + *Size, GetSdrResponse + 1, IPMI_SDR_RECORD_HEADER_SIZE);
+    NextRecordId = GetSdrResponse->NextRecordId;
+
+    //
+    // A record that fits in one command is read whole from offset 0. Otherwise, or when
+    // the BMC cannot return that many bytes, the record body is read in parts.
+    //
+    Status = EFI_DEVICE_ERROR;
+    if (RecordSize <= mReadChunkSize) {
+      GetSdrRequest.BytesToRead = (UINT8) RecordSize;
+      ResponseSize = sizeof (ResponseData);
+      Status = IpmiGetSdr (&GetSdrRequest, GetSdrResponse, &ResponseSize);
+      if (!EFI_ERROR (Status) && (GetSdrResponse->CompletionCode == 0) &&
+          (ResponseSize >= sizeof (IPMI_GET_SDR_RESPONSE) + RecordSize)) {
+        CopyMem (Buffer + *Size, GetSdrResponse + 1, RecordSize);
+      } else {
+        if (EFI_ERROR (Status) || (GetSdrResponse->CompletionCode == IPMI_COMPLETION_CODE_CANNOT_RETURN_BYTES)) {
+          ReduceReadChunkSize ();
+        }
+        Status = EFI_DEVICE_ERROR;
+      }
+    }
+
+    if (EFI_ERROR (Status)) {
+      Status = ReadSdrPartsFromBmc (
+                 RecordId,
+                 IPMI_SDR_RECORD_HEADER_SIZE,
+                 RecordSize - IPMI_SDR_RECORD_HEADER_SIZE,
+                 Buffer + *Size + IPMI_SDR_RECORD_HEADER_SIZE
+                 );
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
+    }
+
+    *Size   += RecordSize;
+    RecordId = NextRecordId;
+  }
+
+  return EFI_SUCCESS;
+}
+
+EFI_STATUS
+LoadSdrCache (
+  IN IPMI_FRU_CACHE_HEADER    *Key
+  )
+/*++
+
+Routine Description:
+
+  Load the cache variable into mFruCache and check it was created for the same
+  SDR repository contents.
+
+Arguments:
+
+  Key  - Header describing the current BMC contents
+
+Returns:
+
+  EFI_SUCCESS           - mFruCache holds the cached SDR records
+  EFI_BUFFER_TOO_SMALL  - The repository was found not to fit in the cache on an earlier boot
+  EFI_NOT_FOUND         - The records must be read from the BMC
+
+--*/
+{
+  EFI_STATUS                  Status;
+  UINTN                       Size;
+
+  //
+  // A repository without timestamps gives no way to detect a change.
+  //
+  if ((Key->SdrMostRecentAddition == IPMI_SDR_TIMESTAMP_UNSPECIFIED) ||
+      (Key->SdrMostRecentErase == IPMI_SDR_TIMESTAMP_UNSPECIFIED)) {
+    return EFI_NOT_FOUND;
+  }
+
+  Size   = sizeof (IPMI_FRU_CACHE_HEADER) + mMaxSdrSize;
+  Status = gRT->GetVariable (IPMI_FRU_CACHE_VARIABLE_NAME, &gIpmiFruCacheProtocolGuid, NULL, &Size, mFruCache);
+  if (EFI_ERROR (Status) ||
+      (Size < sizeof (IPMI_FRU_CACHE_HEADER)) ||
+      (mFruCache->Signature != Key->Signature) ||
+      (mFruCache->SdrMostRecentAddition != Key->SdrMostRecentAddition) ||
+      (mFruCache->SdrMostRecentErase != Key->SdrMostRecentErase) ||
+      (mFruCache->SdrRecordCount != Key->SdrRecordCount)) {
+    return EFI_NOT_FOUND;
+  }
+
+  if (((mFruCache->Flags & IPMI_FRU_CACHE_SDR_TOO_LARGE) != 0) &&
+      (mFruCache->SdrSize == mMaxSdrSize) &&
+      (Size == sizeof (IPMI_FRU_CACHE_HEADER))) {
+    return EFI_BUFFER_TOO_SMALL;
+  }
+
+  if (((mFruCache->Flags & IPMI_FRU_CACHE_SDR_VALID) != 0) &&
+      (Size == sizeof (IPMI_FRU_CACHE_HEADER) + (UINTN) mFruCache->SdrSize)) {
+    return EFI_SUCCESS;
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+VOID
+SaveSdrCache (
+  IN IPMI_FRU_CACHE_HEADER    *Key,
+  IN EFI_STATUS               ReadStatus
+  )
+/*++
+
+Routine Description:
+
+  Save the SDR records read from the BMC for the next boots. A repository that does
+  not fit in the cache is recorded as such, so that it is not read again until it
+  changes.
+
+Arguments:
+
+  Key         - Header describing the current BMC contents, the records follow mFruCache
+  ReadStatus  - Result of ReadSdrFromBmc()
+
+Returns:
+
+  None
+
+--*/
+{
+  EFI_STATUS                  Status;
+  UINTN                       Size;
+
+  //
+  // Only keep a copy that can be validated on the next boot.
+  //
+  if ((Key->SdrMostRecentAddition == IPMI_SDR_TIMESTAMP_UNSPECIFIED) ||
+      (Key->SdrMostRecentErase == IPMI_SDR_TIMESTAMP_UNSPECIFIED)) {
+    return;
+  }
+
+  CopyMem (mFruCache, Key, sizeof (*Key));
+  if (ReadStatus == EFI_BUFFER_TOO_SMALL) {
+    mFruCache->Flags   = (mFruCache->Flags & ~IPMI_FRU_CACHE_SDR_VALID) | IPMI_FRU_CACHE_SDR_TOO_LARGE;
+    mFruCache->SdrSize = mMaxSdrSize;
+    Size               = sizeof (IPMI_FRU_CACHE_HEADER);
+  } else if (!EFI_ERROR (ReadStatus)) {
+    Size = sizeof (IPMI_FRU_CACHE_HEADER) + Key->SdrSize;
+  } else {
+    return;
+  }
+
+  Status = gRT->SetVariable (
+                  IPMI_FRU_CACHE_VARIABLE_NAME,
+                  &gIpmiFruCacheProtocolGuid,
+                  EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                  Size,
+                  mFruCache
+                  );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "IpmiFru: SDR cache not saved, %d bytes - %r\n", Size, Status));
+  } else {
+    DEBUG ((DEBUG_INFO, "IpmiFru: SDR cache updated\n"));
+  }
+}
 
 EFI_STATUS
 EFIAPI
@@ -38,9 +763,11 @@ Returns:
 --*/
 {
   EFI_STATUS                                 Status;
+  EFI_HANDLE                                 Handle;
   IPMI_GET_DEVICE_ID_RESPONSE                ControllerInfo;
-  IPMI_GET_FRU_INVENTORY_AREA_INFO_REQUEST   GetFruInventoryAreaInfoRequest;
-  IPMI_GET_FRU_INVENTORY_AREA_INFO_RESPONSE  GetFruInventoryAreaInfoResponse;
+  IPMI_GET_SDR_REPOSITORY_INFO_RESPONSE      GetSdrRepositoryInfoResponse;
+  IPMI_FRU_CACHE_HEADER                      Key;
+  UINT32                                     Overhead;
 
   //
   //  Get all the SDR Records from BMC and retrieve the Record ID from the structure for future use.
@@ -53,15 +780,66 @@ Returns:
 
   DEBUG((DEBUG_ERROR, "!!! IpmiFru  FruInventorySupport %x\n", ControllerInfo.DeviceSupport.Bits.FruInventorySupport));
 
-  if (ControllerInfo.DeviceSupport.Bits.FruInventorySupport) {
-    GetFruInventoryAreaInfoRequest.DeviceId = 0;
-    Status = IpmiGetFruInventoryAreaInfo (&GetFruInventoryAreaInfoRequest, &GetFruInventoryAreaInfoResponse);
+  ZeroMem (&Key, sizeof (Key));
+  Key.Signature   = IPMI_FRU_CACHE_SIGNATURE;
+  Key.FruDeviceId = FixedPcdGet8 (PcdIpmiFruDeviceId);
+
+  //
+  // The FRU data is read on the first ReadFruData() call.
+  //
+  mFruInventorySupport = (BOOLEAN) (ControllerInfo.DeviceSupport.Bits.FruInventorySupport != 0);
+
+  //
+  // The cache variable must fit in the largest variable the variable driver accepts.
+  //
+  Overhead    = sizeof (AUTHENTICATED_VARIABLE_HEADER) + sizeof (IPMI_FRU_CACHE_VARIABLE_NAME) + sizeof (IPMI_FRU_CACHE_HEADER);
+  mMaxSdrSize = 0;
+  if (PcdGet32 (PcdMaxVariableSize) > Overhead) {
+    mMaxSdrSize = PcdGet32 (PcdMaxVariableSize) - Overhead;
+  }
+
+  if (ControllerInfo.DeviceSupport.Bits.SdrRepositorySupport && (mMaxSdrSize != 0)) {
+    Status = IpmiGetSdrRepositoryInfo (&GetSdrRepositoryInfoResponse);
+    if (!EFI_ERROR (Status) && (GetSdrRepositoryInfoResponse.CompletionCode == 0)) {
+      Key.Flags                |= IPMI_FRU_CACHE_SDR_VALID;
+      Key.SdrMostRecentAddition = GetSdrRepositoryInfoResponse.MostRecentAddition;
+      Key.SdrMostRecentErase    = GetSdrRepositoryInfoResponse.MostRecentErase;
+      Key.SdrRecordCount        = GetSdrRepositoryInfoResponse.RecordCount;
+    }
+  }
+
+  mFruCache = AllocateZeroPool (sizeof (IPMI_FRU_CACHE_HEADER) + mMaxSdrSize);
+  if (mFruCache == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  if ((Key.Flags & IPMI_FRU_CACHE_SDR_VALID) != 0) {
+    Status = LoadSdrCache (&Key);
+    if (Status == EFI_NOT_FOUND) {
+      Status = ReadSdrFromBmc (mMaxSdrSize, (UINT8 *) (mFruCache + 1), &Key.SdrSize);
+      SaveSdrCache (&Key, Status);
+    } else if (!EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_INFO, "IpmiFru: SDR cache is up to date\n"));
+      Key.SdrSize = mFruCache->SdrSize;
+    }
+
     if (EFI_ERROR (Status)) {
-      DEBUG((DEBUG_ERROR, "!!! IpmiFru  IpmiGetFruInventoryAreaInfo Status=%x\n", Status));
-      return Status;
+      DEBUG ((DEBUG_WARN, "IpmiFru: SDR repository not cached - %r\n", Status));
+      Key.Flags  &= ~IPMI_FRU_CACHE_SDR_VALID;
+      Key.SdrSize = 0;
     }
-    DEBUG((DEBUG_ERROR, "!!! IpmiFru  InventoryAreaSize=%x\n", GetFruInventoryAreaInfoResponse.InventoryAreaSize));
   }
 
-  return EFI_SUCCESS;
+  CopyMem (mFruCache, &Key, sizeof (Key));
+
+  Handle = NULL;
+  Status = gBS->InstallProtocolInterface (
+                  &Handle,
+                  &gIpmiFruCacheProtocolGuid,
+                  EFI_NATIVE_INTERFACE,
+                  &mIpmiFruCache
+                  );
+  ASSERT_EFI_ERROR (Status);
+
+  return Status;
 }
@@ -167,6 +167,27 @@ IpmiPartialAddSelEntry (
   return Status;
 }
 
+EFI_STATUS
+EFIAPI
+IpmiReserveSel (
+  OUT IPMI_RESERVE_SEL_RESPONSE  *ReserveSelResponse
+  )
+{
+  EFI_STATUS                   Status;
+  UINT32                       DataSize;
+
+  DataSize = sizeof(*ReserveSelResponse);
+  Status = IpmiSubmitCommand (
+             IPMI_NETFN_STORAGE,
+             IPMI_STORAGE_RESERVE_SEL,
+             NULL,
+             0,
+             (VOID *)ReserveSelResponse,
+             &DataSize
+             );
+  return Status;
+}
+
 EFI_STATUS
 EFIAPI
 IpmiClearSel (
@@ -253,6 +274,41 @@ IpmiGetSdrRepositoryInfo (
   return Status;
 }
 
+EFI_STATUS
+EFIAPI
+IpmiReserveSdrRepository (
+  OUT UINT8                         *CompletionCode,
+  OUT UINT16                        *ReservationId
+  )
+{
+  EFI_STATUS                   Status;
+  UINT8                        ResponseData[3];
+  UINT32                       DataSize;
+
+  //
+  // Response: completion code, reservation ID (LS byte first).
+  //
+  DataSize = sizeof(ResponseData);
+  Status = IpmiSubmitCommand (
+             IPMI_NETFN_STORAGE,
+             IPMI_STORAGE_RESERVE_SDR_REPOSITORY,
+             NULL,
+             0,
+             (VOID *)ResponseData,
+             &DataSize
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  *CompletionCode = ResponseData[0];
+  *ReservationId  = 0;
+  if ((*CompletionCode == 0) && (DataSize >= sizeof(ResponseData))) {
+    *ReservationId = (UINT16) (ResponseData[1] | (ResponseData[2] << 8));
+  }
+  return Status;
+}
+
 EFI_STATUS
 EFIAPI
 IpmiGetSdr (
@@ -0,0 +1,124 @@
+/** @file
+  Shell application printing the BMC SEL ring of BmcElog.
+
+  Usage: SelDump [-e]
+    -e  Erase the SEL.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/BmcElogSel.h>
+#include <Protocol/ShellParameters.h>
+
+EFI_STATUS
+SelDumpErase (
+  IN BMC_ELOG_SEL_PROTOCOL  *BmcElogSel
+  )
+/*++
+
+Routine Description:
+
+  Erase the SEL. The shell runs after ReadyToBoot, where the erase completes
+  before EraseSel () returns.
+
+Arguments:
+
+  BmcElogSel  - BMC SEL protocol
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+{
+  EFI_STATUS                Status;
+  EFI_STATUS                EraseStatus;
+
+  Status = BmcElogSel->EraseSel (BmcElogSel, NULL, &EraseStatus);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return EraseStatus;
+}
+
+EFI_STATUS
+EFIAPI
+SelDumpEntryPoint (
+  IN EFI_HANDLE             ImageHandle,
+  IN EFI_SYSTEM_TABLE       *SystemTable
+  )
+/*++
+
+Routine Description:
+
+  Print the SEL records or erase the SEL.
+
+Arguments:
+
+  ImageHandle - ImageHandle of the loaded application
+  SystemTable - Pointer to the System Table
+
+Returns:
+
+  EFI_STATUS
+
+--*/
+{
+  EFI_STATUS                     Status;
+  BMC_ELOG_SEL_PROTOCOL          *BmcElogSel;
+  EFI_SHELL_PARAMETERS_PROTOCOL  *ShellParameters;
+  CONST BMC_ELOG_SEL_RING        *Ring;
+  UINT8                          *Record;
+  UINT32                         Index;
+
+  Status = gBS->LocateProtocol (&gBmcElogSelProtocolGuid, NULL, (VOID **) &BmcElogSel);
+  if (EFI_ERROR (Status)) {
+    Print (L"BMC SEL protocol not found - %r\n", Status);
+    return Status;
+  }
+
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiShellParametersProtocolGuid, (VOID **) &ShellParameters);
+  if (!EFI_ERROR (Status) && (ShellParameters->Argc > 1)) {
+    if (StrCmp (ShellParameters->Argv[1], L"-e") != 0) {
+      Print (L"Usage: SelDump [-e]\n");
+      return EFI_INVALID_PARAMETER;
+    }
+    Status = SelDumpErase (BmcElogSel);
+    Print (L"SEL erase - %r\n", Status);
+    return Status;
+  }
+
+  Status = BmcElogSel->ReadSel (BmcElogSel, &Ring);
+  if (EFI_ERROR (Status)) {
+    Print (L"SEL read failed - %r, showing the records read so far\n", Status);
+  }
+
+  Print (L"SEL records: %d, overwritten: %d\n", Ring->Count, Ring->Overwritten);
+  Print (L"ID   Type Timestamp GenId Rev SensorType Sensor EventType Data\n");
+  for (Index = 0; Index < Ring->Count; Index++) {
+    Record = Ring->Records + ((Ring->Head + Index) % Ring->Capacity) * BMC_ELOG_SEL_RECORD_SIZE;
+    Print (
+      L"%04x %02x   %08x  %04x  %02x  %02x         %02x     %02x        %02x %02x %02x\n",
+      ReadUnaligned16 ((UINT16 *) &Record[0]),
+      Record[2],
+      ReadUnaligned32 ((UINT32 *) &Record[3]),
+      ReadUnaligned16 ((UINT16 *) &Record[7]),
+      Record[9],
+      Record[10],
+      Record[11],
+      Record[12],
+      Record[13],
+      Record[14],
+      Record[15]
+      );
+  }
+
+  return EFI_SUCCESS;
+}
@@ -92,6 +92,10 @@ Lan9118DxeEntry (
   Snp->Transmit = SnpTransmit;
   Snp->Receive = SnpReceive;
 
+  LanDriver->Aip.GetInformation = AipGetInformation;
+  LanDriver->Aip.SetInformation = AipSetInformation;
+  LanDriver->Aip.GetSupportedTypes = AipGetSupportedTypes;
+
   // Start completing simple network mode structure
   SnpMode->State = EfiSimpleNetworkStopped;
   SnpMode->HwAddressSize = NET_ETHER_ADDR_LEN; // HW address is 6 bytes
@@ -157,6 +161,7 @@ Lan9118DxeEntry (
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &ControllerHandle,
                   &gEfiSimpleNetworkProtocolGuid, Snp,
+                  &gEfiAdapterInformationProtocolGuid, &LanDriver->Aip,
                   &gEfiDevicePathProtocolGuid, Lan9118Path,
                   NULL
                   );
@@ -989,6 +994,8 @@ SnpGetStatus (
     return EFI_NOT_STARTED;
   }
 
+  LanDriver->PerfCounters.StatusPolls++;
+
   // Check and acknowledge TX Status interrupt (this will happen if the
   // consumer of SNP does not call GetStatus.)
   // TODO will we lose TxStatuses if this happens? Maybe in SnpTransmit we
@@ -1121,12 +1128,12 @@ SnpTransmit (
   LAN9118_DRIVER *LanDriver;
   UINT32 TxFreeSpace;
   UINT32 TxStatusSpace;
-  INT32 Count;
   UINT32 CommandA;
   UINT32 CommandB;
   UINT16 LocalProtocol;
   UINT32 *LocalData;
   UINT16 PacketTag;
+  UINT32 TxHeader[8];
 
 #if defined(EVAL_PERFORMANCE)
   UINT64 Perf;
@@ -1219,46 +1226,40 @@ SnpTransmit (
     CommandA = TX_CMD_A_FIRST_SEGMENT | TX_CMD_A_BUFF_SIZE (HdrSize);
     CommandB = TX_CMD_B_PACKET_TAG (PacketTag) | TX_CMD_B_PACKET_LENGTH (BuffSize);
 
-    // Write the commands first
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandA);
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandB);
-
-    // Write the destination address
-    Lan9118MmioWrite32 (LAN9118_TX_DATA,
-               (DstAddr->Addr[0]) |
-               (DstAddr->Addr[1] << 8) |
-               (DstAddr->Addr[2] << 16) |
-               (DstAddr->Addr[3] << 24)
-               );
-
-    Lan9118MmioWrite32 (LAN9118_TX_DATA,
-               (DstAddr->Addr[4]) |
-               (DstAddr->Addr[5] << 8) |
-               (SrcAddr->Addr[0] << 16) | // Write the Source Address
-               (SrcAddr->Addr[1] << 24)
-               );
-
-    Lan9118MmioWrite32 (LAN9118_TX_DATA,
-               (SrcAddr->Addr[2]) |
-               (SrcAddr->Addr[3] << 8) |
-               (SrcAddr->Addr[4] << 16) |
-               (SrcAddr->Addr[5] << 24)
-               );
-
-    // Write the Protocol
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, (UINT32)(HTONS (LocalProtocol)));
+    // Assemble the commands and the header so they can be written in one burst
+    TxHeader[0] = CommandA;
+    TxHeader[1] = CommandB;
+
+    // The destination address
+    TxHeader[2] = (DstAddr->Addr[0]) |
+                  (DstAddr->Addr[1] << 8) |
+                  (DstAddr->Addr[2] << 16) |
+                  (DstAddr->Addr[3] << 24);
+
+    TxHeader[3] = (DstAddr->Addr[4]) |
+                  (DstAddr->Addr[5] << 8) |
+                  (SrcAddr->Addr[0] << 16) | // The Source Address
+                  (SrcAddr->Addr[1] << 24);
+
+    TxHeader[4] = (SrcAddr->Addr[2]) |
+                  (SrcAddr->Addr[3] << 8) |
+                  (SrcAddr->Addr[4] << 16) |
+                  (SrcAddr->Addr[5] << 24);
+
+    // The Protocol
+    TxHeader[5] = (UINT32)(HTONS (LocalProtocol));
 
     // Next buffer is the payload
     CommandA = TX_CMD_A_LAST_SEGMENT | TX_CMD_A_BUFF_SIZE (BuffSize - HdrSize) | TX_CMD_A_COMPLETION_INT | TX_CMD_A_DATA_START_OFFSET (2); // 2 bytes beginning offset
 
-    // Write the commands
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandA);
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandB);
+    // The commands for the payload
+    TxHeader[6] = CommandA;
+    TxHeader[7] = CommandB;
+
+    Lan9118WriteTxFifo (TxHeader, ARRAY_SIZE (TxHeader));
 
     // Write the payload
-    for (Count = 0; Count < ((BuffSize + 3) >> 2) - 3; Count++) {
-      Lan9118MmioWrite32 (LAN9118_TX_DATA, LocalData[Count + 3]);
-    }
+    Lan9118WriteTxFifo (&LocalData[3], ((BuffSize + 3) >> 2) - 3);
   } else {
     // Format pointer
     LocalData = (UINT32*) Data;
@@ -1268,13 +1269,12 @@ SnpTransmit (
     CommandB = TX_CMD_B_PACKET_TAG (PacketTag) | TX_CMD_B_PACKET_LENGTH (BuffSize);
 
     // Write the commands first
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandA);
-    Lan9118MmioWrite32 (LAN9118_TX_DATA, CommandB);
+    TxHeader[0] = CommandA;
+    TxHeader[1] = CommandB;
+    Lan9118WriteTxFifo (TxHeader, 2);
 
     // Write all the data
-    for (Count = 0; Count < ((BuffSize + 3) >> 2); Count++) {
-      Lan9118MmioWrite32 (LAN9118_TX_DATA, LocalData[Count]);
-    }
+    Lan9118WriteTxFifo (LocalData, (BuffSize + 3) >> 2);
   }
 
   // Save the address of the submitted packet so we can notify the consumer that
@@ -1289,6 +1289,10 @@ SnpTransmit (
 
   LanDriver->Stats.TxGoodFrames += 1;
 
+  LanDriver->PerfCounters.TxPackets++;
+  LanDriver->PerfCounters.Copies++;
+  LanDriver->PerfCounters.CopyBytes += BuffSize;
+
   return EFI_SUCCESS;
 }
 
@@ -1316,7 +1320,6 @@ SnpReceive (
   UINT32          RxCfgValue;
   UINT32          PLength; // Packet length
   UINT32          ReadLimit;
-  UINT32          Count;
   UINT32          Padding;
   UINT32          *RawData;
   EFI_MAC_ADDRESS Dst;
@@ -1370,6 +1373,8 @@ SnpReceive (
   DroppedFrames = Lan9118MmioRead32 (LAN9118_RX_DROP);
   LanDriver->Stats.RxDroppedFrames += DroppedFrames;
 
+  LanDriver->PerfCounters.RxPolls++;
+
   NumPackets = RxStatusUsedSpace (0, Snp) / 4;
   if (!NumPackets) {
     return EFI_NOT_READY;
@@ -1469,9 +1474,10 @@ SnpReceive (
   RawData = (UINT32*)Data;
 
   // Read Rx Packet
-  for (Count = 0; Count < ReadLimit; Count++) {
-    RawData[Count] = Lan9118MmioRead32 (LAN9118_RX_DATA);
-  }
+  Lan9118ReadRxFifo (RawData, ReadLimit);
+
+  LanDriver->PerfCounters.Copies++;
+  LanDriver->PerfCounters.CopyBytes += ReadLimit * sizeof (UINT32);
 
   // Get the destination address
   if (DstAddr != NULL) {
@@ -1535,5 +1541,107 @@ SnpReceive (
 
   LanDriver->Stats.RxGoodFrames += 1;
 
+  LanDriver->PerfCounters.RxPackets++;
+
   return EFI_SUCCESS;
 }
+
+
+/*
+ *  UEFI GetInformation() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipGetInformation (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+  IN        EFI_GUID *InformationType,
+      OUT   VOID **InformationBlock,
+      OUT   UINTN *InformationBlockSize
+  )
+{
+  LAN9118_DRIVER                  *LanDriver;
+  EFI_ADAPTER_INFO_MEDIA_STATE    *MediaState;
+  EFI_STATUS                      Status;
+
+  if ((Aip == NULL) || (InformationBlock == NULL) || (InformationBlockSize == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  LanDriver = INSTANCE_FROM_AIP_THIS (Aip);
+
+  // The driver never raises the TPL, so RaisedTplTime is left at zero
+  Status = NetPerfAipGetInformation (InformationType, &LanDriver->PerfCounters, 0, InformationBlock, InformationBlockSize);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
+  if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
+    MediaState = AllocateZeroPool (sizeof (EFI_ADAPTER_INFO_MEDIA_STATE));
+    if (MediaState == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    MediaState->MediaState = LanDriver->SnpMode.MediaPresent ? EFI_SUCCESS : EFI_NOT_READY;
+
+    *InformationBlock = MediaState;
+    *InformationBlockSize = sizeof (EFI_ADAPTER_INFO_MEDIA_STATE);
+    return EFI_SUCCESS;
+  }
+
+  return EFI_UNSUPPORTED;
+}
+
+
+/*
+ *  UEFI SetInformation() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipSetInformation (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+  IN        EFI_GUID *InformationType,
+  IN        VOID *InformationBlock,
+  IN        UINTN InformationBlockSize
+  )
+{
+  LAN9118_DRIVER *LanDriver;
+  EFI_STATUS Status;
+
+  if ((Aip == NULL) || (InformationBlock == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  // Setting the performance counters resets them
+  LanDriver = INSTANCE_FROM_AIP_THIS (Aip);
+  Status = NetPerfAipSetInformation (InformationType, &LanDriver->PerfCounters, NULL);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
+  if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
+    return EFI_WRITE_PROTECTED;
+  }
+
+  return EFI_UNSUPPORTED;
+}
+
+
+/*
+ *  UEFI GetSupportedTypes() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipGetSupportedTypes (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+      OUT   EFI_GUID **InfoTypesBuffer,
+      OUT   UINTN *InfoTypesBufferCount
+  )
+{
+  if ((Aip == NULL) || (InfoTypesBuffer == NULL) || (InfoTypesBufferCount == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return NetPerfAipGetSupportedTypes (InfoTypesBuffer, InfoTypesBufferCount);
+}
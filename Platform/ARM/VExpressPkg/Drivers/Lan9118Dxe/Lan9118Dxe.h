@@ -21,11 +21,14 @@
 #include <Base.h>
 
 // Protocols used by this driver
+#include <Protocol/AdapterInformation.h>
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ComponentName2.h>
 #include <Protocol/PxeBaseCode.h>
 #include <Protocol/DevicePath.h>
 
+#include <Guid/NetPerfCountersAdapterInfo.h>
+
 // Libraries used by this driver
 #include <Library/UefiLib.h>
 #include <Library/DebugLib.h>
@@ -34,6 +37,7 @@
 #include <Library/IoLib.h>
 #include <Library/PcdLib.h>
 #include <Library/NetLib.h>
+#include <Library/NetPerfAdapterInfoLib.h>
 #include <Library/DevicePathLib.h>
 
 #include "Lan9118DxeUtil.h"
@@ -67,6 +71,11 @@ typedef struct {
   // EFI Snp statistics instance
   EFI_NETWORK_STATISTICS Stats;
 
+  // Adapter Information protocol, and the data path performance counters
+  // it exposes
+  EFI_ADAPTER_INFORMATION_PROTOCOL Aip;
+  NET_PERF_COUNTERS_ADAPTER_INFO PerfCounters;
+
   // Saved transmitted buffers so we can notify consumers when packets have been sent.
   UINT16  NextPacketTag;
   VOID    *TxRing[LAN9118_TX_RING_NUM_ENTRIES];
@@ -74,6 +83,7 @@ typedef struct {
 
 #define LAN9118_SIGNATURE                       SIGNATURE_32('l', 'a', 'n', '9')
 #define INSTANCE_FROM_SNP_THIS(a)               CR(a, LAN9118_DRIVER, Snp, LAN9118_SIGNATURE)
+#define INSTANCE_FROM_AIP_THIS(a)               CR(a, LAN9118_DRIVER, Aip, LAN9118_SIGNATURE)
 
 
 /*---------------------------------------------------------------------------------------------------------------------
@@ -258,6 +268,53 @@ SnpReceive (
   );
 
 
+/*---------------------------------------------------------------------------------------------------------------------
+
+  UEFI-Compliant functions for EFI_ADAPTER_INFORMATION_PROTOCOL
+
+  Refer to the Adapter Information Protocol section (11.12) in the UEFI 2.6 Specification for related definitions
+
+---------------------------------------------------------------------------------------------------------------------*/
+
+/*
+ *  UEFI GetInformation() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipGetInformation (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+  IN        EFI_GUID *InformationType,
+      OUT   VOID **InformationBlock,
+      OUT   UINTN *InformationBlockSize
+  );
+
+/*
+ *  UEFI SetInformation() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipSetInformation (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+  IN        EFI_GUID *InformationType,
+  IN        VOID *InformationBlock,
+  IN        UINTN InformationBlockSize
+  );
+
+/*
+ *  UEFI GetSupportedTypes() function
+ *
+ */
+EFI_STATUS
+EFIAPI
+AipGetSupportedTypes (
+  IN        EFI_ADAPTER_INFORMATION_PROTOCOL *Aip,
+      OUT   EFI_GUID **InfoTypesBuffer,
+      OUT   UINTN *InfoTypesBufferCount
+  );
+
+
 /*---------------------------------------------------------------------------------------------------------------------
 
   UEFI-Compliant functions for EFI_COMPONENT_NAME2_PROTOCOL
@@ -31,6 +31,10 @@
 #define LAN9118_TX_STATUS                     (0x00000048 + LAN9118_BA)
 #define LAN9118_TX_STATUS_PEEK                (0x0000004C + LAN9118_BA)
 
+// The RX and TX data FIFO ports are aliased over a window of 8 DWORDs to allow
+// them to be accessed with incrementing addresses by burst capable masters.
+#define LAN9118_DATA_FIFO_ALIAS_NUM           8
+
 /* ------------- System Control and Status Registers -------------------------*/
 #define LAN9118_ID_REV                        (0x00000050 + LAN9118_BA)    // Chip ID and Revision
 #define LAN9118_IRQ_CFG                       (0x00000054 + LAN9118_BA)    // Interrupt Configuration
@@ -17,6 +17,18 @@
 
 STATIC EFI_MAC_ADDRESS mZeroMac = { { 0 } };
 
+//
+// Shadow copies of the MAC CSRs that are only ever modified by this driver.
+// Every indirect MAC CSR access costs several MMIO accesses and busy waits, so
+// serve reads of these registers from the shadow copy once it has been
+// populated. The shadow copy is discarded whenever the device is reset.
+//
+#define MAC_CSR_IS_CACHEABLE(Index) \
+  (((Index) >= INDIRECT_MAC_INDEX_CR) && ((Index) <= INDIRECT_MAC_INDEX_HASHL))
+
+STATIC UINT32 mMacCsrCache[INDIRECT_MAC_INDEX_HASHL + 1];
+STATIC UINT32 mMacCsrCacheValid;
+
 /**
   This internal function reverses bits for 32bit data.
 
@@ -98,6 +110,11 @@ IndirectMACRead32 (
   // Check index is in the range
   ASSERT(Index <= 12);
 
+  // Serve the read from the shadow copy if we have one
+  if (MAC_CSR_IS_CACHEABLE (Index) && (mMacCsrCacheValid & (1U << Index)) != 0) {
+    return mMacCsrCache[Index];
+  }
+
   // Wait until CSR busy bit is cleared
   while ((Lan9118MmioRead32 (LAN9118_MAC_CSR_CMD) & MAC_CSR_BUSY) == MAC_CSR_BUSY);
 
@@ -113,7 +130,23 @@ IndirectMACRead32 (
   while ((Lan9118MmioRead32 (LAN9118_MAC_CSR_CMD) & MAC_CSR_BUSY) == MAC_CSR_BUSY);
 
   // Now read from data register to get read value
-  return Lan9118MmioRead32 (LAN9118_MAC_CSR_DATA);
+  MacCSR = Lan9118MmioRead32 (LAN9118_MAC_CSR_DATA);
+
+  if (MAC_CSR_IS_CACHEABLE (Index)) {
+    mMacCsrCache[Index] = MacCSR;
+    mMacCsrCacheValid |= 1U << Index;
+  }
+
+  return MacCSR;
+}
+
+// Discard the shadow copies of the MAC CSRs
+VOID
+InvalidateMacCsrCache (
+  VOID
+  )
+{
+  mMacCsrCacheValid = 0;
 }
 
 /*
@@ -194,9 +227,59 @@ IndirectMACWrite32 (
   // Wait until CSR busy bit is cleared
   while ((Lan9118MmioRead32 (LAN9118_MAC_CSR_CMD) & MAC_CSR_BUSY) == MAC_CSR_BUSY);
 
+  if (MAC_CSR_IS_CACHEABLE (Index)) {
+    mMacCsrCache[Index] = ValueWritten;
+    mMacCsrCacheValid |= 1U << Index;
+  }
+
   return ValueWritten;
 }
 
+/*
+ * Read a burst of DWORDs from the RX data FIFO.
+ *
+ * Back-to-back reads of the RX data FIFO are not subject to the read-after-read
+ * timing restrictions, so rather than waiting after each read as
+ * Lan9118MmioRead32 () does, perform the whole burst through the aliased FIFO
+ * window and only wait once at the end.
+ */
+VOID
+Lan9118ReadRxFifo (
+  OUT UINT32  *Buffer,
+  IN  UINTN   Count
+  )
+{
+  UINTN   FifoBase;
+  UINTN   Index;
+
+  FifoBase = LAN9118_RX_DATA;
+  for (Index = 0; Index < Count; Index++) {
+    Buffer[Index] = MmioRead32 (FifoBase +
+                                (Index % LAN9118_DATA_FIFO_ALIAS_NUM) * 4);
+  }
+  WaitDummyReads (LAN9118_RX_DATA_RD_DELAY);
+}
+
+/*
+ * Write a burst of DWORDs to the TX data FIFO through the aliased FIFO window.
+ */
+VOID
+Lan9118WriteTxFifo (
+  IN  CONST UINT32  *Buffer,
+  IN  UINTN         Count
+  )
+{
+  UINTN   FifoBase;
+  UINTN   Index;
+
+  FifoBase = LAN9118_TX_DATA;
+  for (Index = 0; Index < Count; Index++) {
+    MmioWrite32 (FifoBase + (Index % LAN9118_DATA_FIFO_ALIAS_NUM) * 4,
+                 Buffer[Index]);
+  }
+  WaitDummyReads (LAN9118_TX_DATA_WR_DELAY);
+}
+
 // Function to read from MII register (PHY Access)
 UINT32
 IndirectPHYRead32 (
@@ -336,6 +419,9 @@ IndirectEEPROMWrite32 (
   // Wait until operation has completed
   while (Lan9118MmioRead32 (LAN9118_E2P_CMD) & E2P_EPC_BUSY);
 
+  // EEPROM commands may reload the MAC address registers
+  InvalidateMacCsrCache ();
+
   // Check that operation didn't time out
   if (Lan9118MmioRead32 (LAN9118_E2P_CMD) & E2P_EPC_TIMEOUT) {
     DEBUG ((EFI_D_ERROR, "EEPROM Operation Timed out: Write command at memloc 0x%x, with value 0x%x\n",Index, Value));
@@ -405,6 +491,9 @@ Lan9118Initialize (
   UINTN  Retries;
   UINT64 DefaultMacAddress;
 
+  // The MAC CSRs may have been reloaded from EEPROM behind our back
+  InvalidateMacCsrCache ();
+
   // Attempt to wake-up the device if it is in a lower power state
   if (((Lan9118MmioRead32 (LAN9118_PMT_CTRL) & MPTCTRL_PM_MODE_MASK) >> 12) != 0) {
     DEBUG ((DEBUG_NET, "Waking from reduced power state.\n"));
@@ -510,6 +599,9 @@ SoftReset (
   // Check that EEPROM isn't active
   while (Lan9118MmioRead32 (LAN9118_E2P_CMD) & E2P_EPC_BUSY);
 
+  // The reset returned all MAC CSRs to their default values
+  InvalidateMacCsrCache ();
+
   // TODO we probably need to re-set the mac address here.
 
   // Clear and acknowledge all interrupts
@@ -72,6 +72,28 @@ IndirectMACWrite32 (
   UINT32 Value
   );
 
+// Discard the cached copies of the MAC CSRs
+VOID
+InvalidateMacCsrCache (
+  VOID
+  );
+
+/* --------------- Data FIFO Access -------------------- */
+
+// Read a burst of DWORDs from the RX data FIFO
+VOID
+Lan9118ReadRxFifo (
+  OUT UINT32  *Buffer,
+  IN  UINTN   Count
+  );
+
+// Write a burst of DWORDs to the TX data FIFO
+VOID
+Lan9118WriteTxFifo (
+  IN  CONST UINT32  *Buffer,
+  IN  UINTN         Count
+  );
+
 
 /* --------------- PHY Registers Access ---------------- */
 
@@ -23,6 +23,8 @@
 #include <Library/IpmiLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/PcdLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Protocol/IpmiFruCache.h>
 
 #include "IpmiFruInfo.h"
 
@@ -281,9 +283,21 @@ InternalReadFruData (
   UINT32                      ResponseSize;
   UINT16                      Offset;
   UINT16                      Finish;
+  IPMI_FRU_CACHE_PROTOCOL     *FruCache;
 
   ASSERT (Data != NULL);
 
+  //
+  // Use the FRU data cached by the IpmiFru driver if it is available
+  //
+  Status = gBS->LocateProtocol (&gIpmiFruCacheProtocolGuid, NULL, (VOID **)&FruCache);
+  if (!EFI_ERROR (Status)) {
+    Status = FruCache->ReadFruData (FruCache, FRU_DEVICE_ID_DEFAULT, AreaOffset, Length, Data);
+    if (!EFI_ERROR (Status)) {
+      return EFI_SUCCESS;
+    }
+  }
+
   Offset = AreaOffset;
   Finish = Offset + Length;
 
@@ -6,6 +6,8 @@
 
 **/
 
+#include <Uefi/UefiBaseType.h>
+
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/GpioLib.h>
@@ -14,7 +16,8 @@
 //
 // Platform Specific
 //
-#define BMC_READY_GPIO  (FixedPcdGet8 (PcdBmcReadyGpio))
+#define BMC_READY_GPIO      (FixedPcdGet8 (PcdBmcReadyGpio))
+#define BMC_SSIF_ALERT_GPIO (FixedPcdGet8 (PcdBmcSsifAlertGpio))
 
 /**
   This function check BMC ready via GPIO
@@ -30,3 +33,31 @@ PlatformBmcReady (
 {
   return GpioReadBit (BMC_READY_GPIO) == 0x1;
 }
+
+/**
+  This function check the SSIF SMBALERT# signal of BMC, which the BMC
+  asserts when a response is ready to be read.
+
+  @param[out]  Asserted          TRUE if SMBALERT# is asserted.
+
+  @retval EFI_SUCCESS            Asserted is valid.
+  @retval EFI_UNSUPPORTED        SMBALERT# of BMC is not connected on this platform.
+
+**/
+EFI_STATUS
+EFIAPI
+PlatformBmcSsifAlert (
+  OUT BOOLEAN  *Asserted
+  )
+{
+  if (BMC_SSIF_ALERT_GPIO == 0xFF) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // SMBALERT# is active low
+  //
+  *Asserted = (GpioReadBit (BMC_SSIF_ALERT_GPIO) == 0x0);
+
+  return EFI_SUCCESS;
+}
@@ -47,13 +47,12 @@ PeiFspMiscUpdUpdatePreMem (
   //
   VariableSize = 0;
   MemorySavedData = NULL;
-  Status = PeiGetVariable (
-             L"MemoryConfig",
+  Status = PeiGetMemoryConfig (
              &gFspNonVolatileStorageHobGuid,
              &MemorySavedData,
              &VariableSize
              );
-  DEBUG ((DEBUG_INFO, "Get L\"MemoryConfig\" gFspNonVolatileStorageHobGuid - %r\n", Status));
+  DEBUG ((DEBUG_INFO, "Get MemoryConfig gFspNonVolatileStorageHobGuid - %r\n", Status));
   DEBUG ((DEBUG_INFO, "MemoryConfig Size - 0x%x\n", VariableSize));
   FspmUpd->FspmArchUpd.NvsBufferPtr = MemorySavedData;
 
@@ -107,6 +107,41 @@ FvbGetVolumeAttributes (
   return FvbInstance->FvHeader.Attributes;
 }
 
+/**
+  Check whether a FV can be read through the memory mapped flash window.
+
+  The window is the flash area described by PcdFlashAreaBaseAddress and
+  PcdFlashAreaSize, which must lie below 4GB. The FV must be fully inside it.
+
+  @param[in]  FvBase      The base address of the FV.
+  @param[in]  FvLength    The length of the FV.
+
+  @retval     TRUE        Reads of the FV may be served by a memory copy.
+  @retval     FALSE       Reads of the FV must use SpiFlashRead().
+
+**/
+BOOLEAN
+FvbIsMemoryMapped (
+  IN EFI_PHYSICAL_ADDRESS          FvBase,
+  IN UINT64                        FvLength
+  )
+{
+  UINT64                                  WindowBase;
+  UINT64                                  WindowEnd;
+
+  if (!FeaturePcdGet (PcdFlashMemoryMappedReadEnable)) {
+    return FALSE;
+  }
+
+  WindowBase = PcdGet32 (PcdFlashAreaBaseAddress);
+  WindowEnd  = WindowBase + PcdGet32 (PcdFlashAreaSize);
+  if ((WindowBase == WindowEnd) || (WindowEnd > BASE_4GB)) {
+    return FALSE;
+  }
+
+  return (BOOLEAN) ((FvBase >= WindowBase) && (FvLength <= WindowEnd - FvBase));
+}
+
 /**
   Retrieves the starting address of an LBA in an FV. It also
   return a few other attribut of the FV.
@@ -254,7 +289,15 @@ FvbReadBlock (
     BadBufferSize = TRUE;
   }
 
-  Status = SpiFlashRead (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
+  if (FvbInstance->MemoryMapped) {
+    //
+    // Writes and erases invalidate the cached range, the window is coherent
+    //
+    CopyMem (Buffer, (VOID *) (LbaAddress + BlockOffset), *NumBytes);
+    Status = EFI_SUCCESS;
+  } else {
+    Status = SpiFlashRead (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
+  }
 
   if (!EFI_ERROR (Status) && BadBufferSize) {
     return EFI_BAD_BUFFER_SIZE;
@@ -337,6 +380,12 @@ FvbWriteBlock (
   }
 
   Status = SpiFlashWrite (LbaAddress + BlockOffset, (UINT32 *)NumBytes, Buffer);
+
+  //
+  // A failed write may still have changed part of the range, so the cached
+  // copy is invalidated before any status is returned.
+  //
+  WriteBackInvalidateDataCacheRange ((VOID *) (LbaAddress + BlockOffset), *NumBytes);
   if (EFI_ERROR (Status)) {
     return Status;
   }
@@ -346,8 +395,6 @@ FvbWriteBlock (
     return Status;
   }
 
-  WriteBackInvalidateDataCacheRange ((VOID *) (LbaAddress + BlockOffset), *NumBytes);
-
   if (!EFI_ERROR (Status) && BadBufferSize) {
     return EFI_BAD_BUFFER_SIZE;
   } else {
@@ -401,17 +448,16 @@ FvbEraseBlock (
   }
 
   Status = SpiFlashBlockErase (LbaAddress, &LbaLength);
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
 
-  Status = SpiFlashLock ();
+  //
+  // Invalidate the cached copy of the block, even when the erase failed
+  //
+  WriteBackInvalidateDataCacheRange ((VOID *) LbaAddress, LbaLength);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
-  WriteBackInvalidateDataCacheRange ((VOID *) LbaAddress, LbaLength);
-
+  Status = SpiFlashLock ();
   return Status;
 }
 
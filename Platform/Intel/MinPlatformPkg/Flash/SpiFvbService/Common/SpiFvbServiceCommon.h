@@ -49,6 +49,7 @@ typedef struct {
   UINT32                                Signature;
   UINTN                                 FvBase;
   UINTN                                 NumOfBlocks;
+  BOOLEAN                               MemoryMapped;
   EFI_DEVICE_PATH_PROTOCOL              *DevicePath;
   EFI_FIRMWARE_VOLUME_BLOCK_PROTOCOL    FvbProtocol;
   EFI_FIRMWARE_VOLUME_HEADER            FvHeader;
@@ -145,6 +146,12 @@ IsFvHeaderValid (
   IN CONST EFI_FIRMWARE_VOLUME_HEADER    *FwVolHeader
   );
 
+BOOLEAN
+FvbIsMemoryMapped (
+  IN EFI_PHYSICAL_ADDRESS          FvBase,
+  IN UINT64                        FvLength
+  );
+
 EFI_STATUS
 GetFvbInfo (
   IN  EFI_PHYSICAL_ADDRESS         FvBaseAddress,
@@ -244,6 +244,8 @@ FvbInitialize (
 
       FvHeader = &(FvbInstance->FvHeader);
       FvbInstance->FvBase = (UINTN)BaseAddress;
+      FvbInstance->MemoryMapped = FvbIsMemoryMapped (BaseAddress, FvHeader->FvLength);
+      DEBUG ((DEBUG_INFO, "FV at 0x%lx is read %a\n", BaseAddress, FvbInstance->MemoryMapped ? "memory mapped" : "through SPI"));
 
       //
       // Process the block map for each FV
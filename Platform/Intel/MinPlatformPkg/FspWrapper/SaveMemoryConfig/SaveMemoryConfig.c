@@ -18,6 +18,191 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseMemoryLib.h>
 #include <Protocol/VariableLock.h>
 
+/**
+  Read the storage header saved by a previous boot.
+
+  @param[out] Header    The storage header.
+
+  @retval TRUE          A valid storage header was read.
+  @retval FALSE         There is no valid storage header.
+**/
+BOOLEAN
+GetMemoryConfigHeader (
+  OUT MEMORY_CONFIG_STORAGE_HEADER  *Header
+  )
+{
+  EFI_STATUS  Status;
+  UINTN       Size;
+
+  Size   = sizeof (*Header);
+  Status = gRT->GetVariable (
+                  MEMORY_CONFIG_HEADER_VARIABLE_NAME,
+                  &gFspNonVolatileStorageHobGuid,
+                  NULL,
+                  &Size,
+                  Header
+                  );
+  if (EFI_ERROR (Status) || (Size != sizeof (*Header)) ||
+      (Header->Signature != MEMORY_CONFIG_STORAGE_SIGNATURE) ||
+      (Header->Version != MEMORY_CONFIG_STORAGE_VERSION) ||
+      (Header->ChunkCount > MEMORY_CONFIG_MAX_CHUNK_COUNT)) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+  Save the memory configuration data as compressed chunks.
+
+  Every chunk is compressed and compared with the variable saved by the
+  previous boot, only the chunks that differ are written. The header is
+  written last, and only when it changed.
+
+  @param[in]  Data          The memory configuration data.
+  @param[in]  DataSize      The size of Data.
+  @param[out] ChunkCount    The number of chunk variables used for Data.
+
+  @retval EFI_SUCCESS           The data was saved.
+  @retval EFI_BAD_BUFFER_SIZE   The data needs more than MEMORY_CONFIG_MAX_CHUNK_COUNT chunks.
+  @retval EFI_OUT_OF_RESOURCES  Memory allocation failed.
+  @retval Others                Compression or SetVariable() failed.
+**/
+EFI_STATUS
+SaveMemoryConfigData (
+  IN  UINT8    *Data,
+  IN  UINTN    DataSize,
+  OUT UINTN    *ChunkCount
+  )
+{
+  EFI_STATUS                    Status;
+  MEMORY_CONFIG_STORAGE_HEADER  Header;
+  MEMORY_CONFIG_STORAGE_HEADER  OldHeader;
+  UINTN                         OldChunkCount;
+  CHAR16                        Name[MEMORY_CONFIG_CHUNK_VARIABLE_NAME_LENGTH];
+  UINT8                         *CompressedData;
+  UINT8                         *VariableData;
+  UINT64                        CompressedSize;
+  UINTN                         VariableSize;
+  UINTN                         Index;
+  UINTN                         Offset;
+  UINTN                         Length;
+  UINTN                         WrittenChunks;
+  UINTN                         WrittenSize;
+
+  *ChunkCount = (DataSize + MEMORY_CONFIG_CHUNK_SIZE - 1) / MEMORY_CONFIG_CHUNK_SIZE;
+  if (*ChunkCount > MEMORY_CONFIG_MAX_CHUNK_COUNT) {
+    DEBUG ((DEBUG_ERROR, "Memory config data is too large: 0x%x\n", DataSize));
+    return EFI_BAD_BUFFER_SIZE;
+  }
+
+  ZeroMem (&Header, sizeof (Header));
+  Header.Signature  = MEMORY_CONFIG_STORAGE_SIGNATURE;
+  Header.Version    = MEMORY_CONFIG_STORAGE_VERSION;
+  Header.DataSize   = (UINT32) DataSize;
+  Header.ChunkSize  = MEMORY_CONFIG_CHUNK_SIZE;
+  Header.ChunkCount = (UINT32) *ChunkCount;
+  Header.DataCrc32  = CalculateCrc32 (Data, DataSize);
+
+  OldChunkCount = 0;
+  if (GetMemoryConfigHeader (&OldHeader)) {
+    OldChunkCount = OldHeader.ChunkCount;
+  }
+
+  CompressedData = AllocatePool (MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE);
+  VariableData   = AllocatePool (MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE);
+  if ((CompressedData == NULL) || (VariableData == NULL)) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  WrittenChunks = 0;
+  WrittenSize   = 0;
+  for (Index = 0, Offset = 0; Index < *ChunkCount; Index++, Offset += Length) {
+    Length = MIN (MEMORY_CONFIG_CHUNK_SIZE, DataSize - Offset);
+
+    CompressedSize = MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE;
+    Status = CompressEx (&Data[Offset], Length, CompressedData, &CompressedSize, CompressLevelBest);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "Compress memory config chunk %d - %r\n", Index, Status));
+      goto Done;
+    }
+
+    UnicodeSPrint (Name, sizeof (Name), MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT, Index);
+    VariableSize = MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE;
+    Status = gRT->GetVariable (
+                    Name,
+                    &gFspNonVolatileStorageHobGuid,
+                    NULL,
+                    &VariableSize,
+                    VariableData
+                    );
+    if (!EFI_ERROR (Status) && (VariableSize == CompressedSize) &&
+        (CompareMem (VariableData, CompressedData, VariableSize) == 0)) {
+      continue;
+    }
+
+    Status = gRT->SetVariable (
+                    Name,
+                    &gFspNonVolatileStorageHobGuid,
+                    (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS),
+                    (UINTN) CompressedSize,
+                    CompressedData
+                    );
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "Save memory config chunk %d - %r\n", Index, Status));
+      goto Done;
+    }
+
+    WrittenChunks++;
+    WrittenSize += (UINTN) CompressedSize;
+  }
+
+  //
+  // Remove the chunks the data does not use anymore
+  //
+  for (Index = *ChunkCount; Index < OldChunkCount; Index++) {
+    UnicodeSPrint (Name, sizeof (Name), MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT, Index);
+    gRT->SetVariable (Name, &gFspNonVolatileStorageHobGuid, 0, 0, NULL);
+  }
+
+  Status = EFI_SUCCESS;
+  if ((OldChunkCount == 0) || (CompareMem (&OldHeader, &Header, sizeof (Header)) != 0)) {
+    Status = gRT->SetVariable (
+                    MEMORY_CONFIG_HEADER_VARIABLE_NAME,
+                    &gFspNonVolatileStorageHobGuid,
+                    (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS),
+                    sizeof (Header),
+                    &Header
+                    );
+    ASSERT_EFI_ERROR (Status);
+  }
+
+  //
+  // The uncompressed variable of older firmware is not used anymore
+  //
+  gRT->SetVariable (MEMORY_CONFIG_LEGACY_VARIABLE_NAME, &gFspNonVolatileStorageHobGuid, 0, 0, NULL);
+
+  DEBUG ((
+    DEBUG_INFO,
+    "Memory config size is 0x%x, %d of %d chunks updated (0x%x bytes)\n",
+    DataSize,
+    WrittenChunks,
+    *ChunkCount,
+    WrittenSize
+    ));
+
+Done:
+  if (CompressedData != NULL) {
+    FreePool (CompressedData);
+  }
+  if (VariableData != NULL) {
+    FreePool (VariableData);
+  }
+  CompressFreeScratch ();
+  return Status;
+}
+
 /**
   This is the standard EFI driver point that detects whether there is a
   MemoryConfigurationData HOB and, if so, saves its data to nvRAM.
@@ -37,13 +222,13 @@ SaveMemoryConfigEntryPoint (
   EFI_STATUS        Status;
   EFI_HOB_GUID_TYPE *GuidHob;
   VOID              *HobData;
-  VOID              *VariableData;
   UINTN             DataSize;
-  UINTN             BufferSize;
+  UINTN             ChunkCount;
+  UINTN             Index;
+  CHAR16            Name[MEMORY_CONFIG_CHUNK_VARIABLE_NAME_LENGTH];
   EDKII_VARIABLE_LOCK_PROTOCOL        *VariableLock;
 
   DataSize     = 0;
-  VariableData = NULL;
   GuidHob      = NULL;
   HobData      = NULL;
 
@@ -59,58 +244,24 @@ SaveMemoryConfigEntryPoint (
       //
       // Use the HOB to save Memory Configuration Data
       //
-      BufferSize = DataSize;
-      VariableData = AllocatePool (BufferSize);
-      if (VariableData == NULL) {
+      Status = SaveMemoryConfigData (HobData, DataSize, &ChunkCount);
+      if (EFI_ERROR (Status)) {
         return EFI_UNSUPPORTED;
       }
-      Status = gRT->GetVariable (
-                      L"MemoryConfig",
-                      &gFspNonVolatileStorageHobGuid,
-                      NULL,
-                      &BufferSize,
-                      VariableData
-                      );
-
-      if (Status == EFI_BUFFER_TOO_SMALL) {
-        FreePool (VariableData);
-        VariableData = AllocatePool (BufferSize);
-        if (VariableData == NULL) {
-          return EFI_UNSUPPORTED;
-        }
-
-        Status = gRT->GetVariable (
-                        L"MemoryConfig",
-                        &gFspNonVolatileStorageHobGuid,
-                        NULL,
-                        &BufferSize,
-                        VariableData
-                        );
-      }
-
-      if ( (EFI_ERROR(Status)) || BufferSize != DataSize || 0 != CompareMem (HobData, VariableData, DataSize)) {
-        Status = gRT->SetVariable (
-                        L"MemoryConfig",
-                        &gFspNonVolatileStorageHobGuid,
-                        (EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS),
-                        DataSize,
-                        HobData
-                        );
-        ASSERT_EFI_ERROR (Status);
-
-        DEBUG((DEBUG_INFO, "Restored Size is 0x%x\n", DataSize));
-      }
 
       //
       // Mark MemoryConfig to read-only if the Variable Lock protocol exists
       //
       Status = gBS->LocateProtocol(&gEdkiiVariableLockProtocolGuid, NULL, (VOID **)&VariableLock);
       if (!EFI_ERROR(Status)) {
-        Status = VariableLock->RequestToLock(VariableLock, L"MemoryConfig", &gFspNonVolatileStorageHobGuid);
+        Status = VariableLock->RequestToLock(VariableLock, MEMORY_CONFIG_HEADER_VARIABLE_NAME, &gFspNonVolatileStorageHobGuid);
         ASSERT_EFI_ERROR(Status);
+        for (Index = 0; Index < ChunkCount; Index++) {
+          UnicodeSPrint (Name, sizeof (Name), MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT, Index);
+          Status = VariableLock->RequestToLock(VariableLock, Name, &gFspNonVolatileStorageHobGuid);
+          ASSERT_EFI_ERROR(Status);
+        }
       }
-
-      FreePool (VariableData);
     } else {
       DEBUG((DEBUG_INFO, "Memory save size is %d\n", DataSize));
     }
@@ -9,9 +9,23 @@
 #ifndef _EFI_COMPRESS_LIB_H_
 #define _EFI_COMPRESS_LIB_H_
 
+///
+/// Compression levels. Every level produces the EFI compressed format that the
+/// standard UEFI decompressor accepts, they only differ in the match finder.
+///
+typedef enum {
+  CompressLevelDefault,   ///< Patricia tree match finder, the output of Compress()
+  CompressLevelFast,      ///< Short hash chains, greedy matching
+  CompressLevelBest,      ///< Long hash chains, lazy matching
+  CompressLevelMax
+} COMPRESS_LEVEL;
+
 /**
   The compression routine.
 
+  The scratch buffers are freed before returning, including the ones kept by
+  earlier CompressEx() calls.
+
   @param[in]       SrcBuffer     The buffer containing the source data.
   @param[in]       SrcSize       Number of bytes in SrcBuffer.
   @param[in]       DstBuffer     The buffer to put the compressed image in.
@@ -30,5 +44,42 @@ Compress (
   IN OUT  UINT64  *DstSize
   );
 
+/**
+  The compression routine, with a selectable speed/ratio trade-off.
+
+  The scratch buffers of a level are allocated by its first call and are kept
+  for the following calls, until CompressFreeScratch() is called.
+
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       Number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                 return the number of bytes placed in DstBuffer.
+  @param[in]       Level         The compression level.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Level is not a valid compression level.
+  @retval EFI_OUT_OF_RESOURCES  The scratch buffers could not be allocated.
+**/
+EFI_STATUS
+EFIAPI
+CompressEx (
+  IN      VOID            *SrcBuffer,
+  IN      UINT64          SrcSize,
+  IN      VOID            *DstBuffer,
+  IN OUT  UINT64          *DstSize,
+  IN      COMPRESS_LEVEL  Level
+  );
+
+/**
+  Free the scratch buffers kept by CompressEx().
+**/
+VOID
+EFIAPI
+CompressFreeScratch (
+  VOID
+  );
+
 #endif
 
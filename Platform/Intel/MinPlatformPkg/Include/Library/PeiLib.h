@@ -38,6 +38,32 @@ PeiGetVariable (
   OUT UINTN          *Size
   );
 
+/**
+  Returns the memory configuration data saved by the SaveMemoryConfig driver,
+  decompressed into a single buffer.
+
+  The returned buffer is allocated using AllocatePool(). The caller is
+  responsible for freeing this buffer with FreePool().
+
+  @param[in]  Guid  The GUID the variables are saved under.
+  @param[out] Data  The memory configuration data.
+  @param[out] Size  The size of the memory configuration data.
+
+  @return EFI_SUCCESS               The data was read.
+  @return EFI_NOT_FOUND             No memory configuration data was saved.
+  @return EFI_COMPROMISED_DATA      The saved data is incomplete or corrupted.
+  @return EFI_OUT_OF_RESOURCES      Allocate buffer failed.
+  @return Others Errors             Return errors from call to GetVariable.
+
+**/
+EFI_STATUS
+EFIAPI
+PeiGetMemoryConfig (
+  IN CONST EFI_GUID  *Guid,
+  OUT VOID           **Data,
+  OUT UINTN          *Size
+  );
+
 /**
   Finds the file in any FV and gets file Address and Size
   
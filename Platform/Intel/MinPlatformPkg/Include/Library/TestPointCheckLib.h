@@ -454,6 +454,61 @@ TestPointReadyToBootEsrtTableFunctional (
   VOID
   );
 
+/**
+  This service verifies the boot phase durations are within budget.
+
+  Test subject: Boot performance.
+  Test overview: Verify the SEC, memory init, DXE and BDS phases and the whole
+                 boot up to Ready To Boot take no longer than their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the boot phase durations.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootBootPhaseWithinBudget (
+  VOID
+  );
+
+/**
+  This service verifies the driver dispatch durations are within budget.
+
+  Test subject: Driver dispatch performance.
+  Test overview: Verify no PEIM or DXE driver entry point takes longer than
+                 PcdTestPointDriverDispatchBudget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the slowest drivers.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootDriverDispatchWithinBudget (
+  VOID
+  );
+
+/**
+  This service verifies the HOB list and UEFI memory map sizes are within budget.
+
+  Test subject: HOB list and UEFI memory map.
+  Test overview: Verify the HOB list size and the number of UEFI memory map
+                 descriptors, and their growth over the baseline recorded
+                 on the first boot, do not exceed their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the HOB list and UEFI memory map sizes and growth.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootHobAndMemoryMapWithinBudget (
+  VOID
+  );
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
@@ -769,6 +824,17 @@ TestPointSmmExitBootServices (
 #define   TEST_POINT_BYTE8_READY_TO_BOOT_HSTI_TABLE_FUNCTIONAL_ERROR_CODE                        L"0x08010000"
 #define   TEST_POINT_BYTE8_READY_TO_BOOT_HSTI_TABLE_FUNCTIONAL_ERROR_STRING                      L"No HSTI\r\n"
 
+// Byte 9 - Performance
+#define TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET                             BIT0
+#define TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET                        BIT1
+#define TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET                     BIT2
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_CODE                     L"0x09000000"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_STRING                   L"Boot phase over budget\r\n"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET_ERROR_CODE                L"0x09010000"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET_ERROR_STRING              L"Driver dispatch over budget\r\n"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_CODE             L"0x09020000"
+#define   TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_STRING           L"HOB list or memory map over budget\r\n"
+
 #pragma pack (1)
 
 typedef struct {
@@ -0,0 +1,57 @@
+/** @file
+  Definitions of the non-volatile storage used for the FSP memory
+  configuration data (the FSP_NON_VOLATILE_STORAGE_HOB data).
+
+  The data is split into MEMORY_CONFIG_CHUNK_SIZE chunks, each one is EFI
+  compressed on its own and saved to its own variable, named with
+  MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT and the chunk index. Only the
+  chunks that changed since the previous boot are written again.
+
+  The header variable describes the chunks and is written last, with a CRC32
+  of the uncompressed data, so a partially updated set of chunks is detected.
+
+  All the variables are saved under gFspNonVolatileStorageHobGuid.
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __MEMORY_CONFIG_STORAGE_H__
+#define __MEMORY_CONFIG_STORAGE_H__
+
+///
+/// The variable that held the uncompressed data before the chunked storage.
+///
+#define MEMORY_CONFIG_LEGACY_VARIABLE_NAME       L"MemoryConfig"
+
+#define MEMORY_CONFIG_HEADER_VARIABLE_NAME       L"MemoryConfigHeader"
+#define MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT L"MemoryConfig%04x"
+#define MEMORY_CONFIG_CHUNK_VARIABLE_NAME_LENGTH (sizeof (L"MemoryConfig0000") / sizeof (CHAR16))
+
+#define MEMORY_CONFIG_STORAGE_SIGNATURE          SIGNATURE_32 ('M', 'C', 'F', 'G')
+#define MEMORY_CONFIG_STORAGE_VERSION            1
+
+#define MEMORY_CONFIG_CHUNK_SIZE                 SIZE_4KB
+#define MEMORY_CONFIG_MAX_CHUNK_COUNT            0x100
+
+///
+/// Worst case size of one compressed chunk.
+///
+#define MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE  (MEMORY_CONFIG_CHUNK_SIZE + MEMORY_CONFIG_CHUNK_SIZE / 8 + 64)
+
+///
+/// Upper bound of the scratch size the UEFI decompressor needs for a chunk.
+///
+#define MEMORY_CONFIG_DECOMPRESS_SCRATCH_SIZE    SIZE_16KB
+
+typedef struct {
+  UINT32    Signature;    ///< MEMORY_CONFIG_STORAGE_SIGNATURE
+  UINT32    Version;      ///< MEMORY_CONFIG_STORAGE_VERSION
+  UINT32    DataSize;     ///< Size of the uncompressed data
+  UINT32    ChunkSize;    ///< Uncompressed size of every chunk but the last one
+  UINT32    ChunkCount;   ///< Number of chunk variables
+  UINT32    DataCrc32;    ///< CRC32 of the uncompressed data
+} MEMORY_CONFIG_STORAGE_HEADER;
+
+#endif
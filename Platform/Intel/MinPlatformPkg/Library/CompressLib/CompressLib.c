@@ -15,6 +15,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/CompressLib.h>
 #include <Uefi/UefiBaseType.h>
 
 #define SHELL_FREE_NON_NULL(Pointer)  \
@@ -60,6 +61,27 @@ typedef INT16             NODE;
 #else
   #define                 NPT NP
 #endif
+
+//
+// Hash chain match finder, used by the fast and best levels. Chain links are
+// kept for the last WNDSIZ positions, 0 marks the end of a chain.
+//
+#define HASH_CHAIN_BIT    15
+#define HASH_CHAIN_SIZE   (1U << HASH_CHAIN_BIT)
+#define HASH_CHAIN_MASK   (HASH_CHAIN_SIZE - 1)
+#define HASH3(Ptr)        ((((UINT32) (Ptr)[0] << 10) ^ ((UINT32) (Ptr)[1] << 5) ^ (Ptr)[2]) & HASH_CHAIN_MASK)
+
+typedef struct {
+  UINT32    MaxChain;     // Chain entries visited per search
+  UINT32    NiceLength;   // Stop searching at a match this long
+  BOOLEAN   Lazy;         // Look one position ahead before taking a match
+} HASH_CHAIN_LEVEL;
+
+STATIC CONST HASH_CHAIN_LEVEL mHashChainLevel[CompressLevelMax] = {
+  { 0,    0,        FALSE },  // CompressLevelDefault: Patricia tree
+  { 8,    32,       FALSE },  // CompressLevelFast
+  { 1024, MAXMATCH, TRUE  }   // CompressLevelBest
+};
 //
 // Function Prototypes
 //
@@ -125,6 +147,9 @@ STATIC NODE   *mPrev;
 STATIC NODE   *mNext = NULL;
 INT32         mHuffmanDepth = 0;
 
+STATIC UINT32 *mHashHead = NULL;
+STATIC UINT32 *mHashPrev = NULL;
+
 /**
   Make a CRC table.
 
@@ -186,41 +211,81 @@ PutDword (
 /**
   Allocate memory spaces for data structures used in compression process.
 
+  Buffers left by a previous call are reused. They are cleared the way a
+  fresh allocation would be, so the output does not depend on earlier calls.
+
+  @param[in] Level    The compression level the buffers are needed for.
+
   @retval EFI_SUCCESS           Memory was allocated successfully.
   @retval EFI_OUT_OF_RESOURCES  A memory allocation failed.
 **/
 EFI_STATUS
 EFIAPI
 AllocateMemory (
-  VOID
+  IN COMPRESS_LEVEL  Level
   )
 {
-  mText       = AllocateZeroPool (WNDSIZ * 2 + MAXMATCH);
-  mLevel      = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mLevel));
-  mChildCount = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mChildCount));
-  mPosition   = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mPosition));
-  mParent     = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mParent));
-  mPrev       = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mPrev));
-  mNext       = AllocateZeroPool ((MAX_HASH_VAL + 1) * sizeof (*mNext));
-
-  mBufSiz     = BLKSIZ;
-  mBuf        = AllocateZeroPool (mBufSiz);
-  while (mBuf == NULL) {
-    mBufSiz = (mBufSiz / 10U) * 9U;
-    if (mBufSiz < 4 * 1024U) {
+  if (mBuf == NULL) {
+    mBufSiz     = BLKSIZ;
+    mBuf        = AllocateZeroPool (mBufSiz);
+    while (mBuf == NULL) {
+      mBufSiz = (mBufSiz / 10U) * 9U;
+      if (mBufSiz < 4 * 1024U) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+
+      mBuf = AllocateZeroPool (mBufSiz);
+    }
+  }
+
+  mBuf[0] = 0;
+
+  if (Level != CompressLevelDefault) {
+    if (mHashHead == NULL) {
+      mHashHead = AllocatePool (HASH_CHAIN_SIZE * sizeof (*mHashHead));
+    }
+    if (mHashPrev == NULL) {
+      mHashPrev = AllocatePool (WNDSIZ * sizeof (*mHashPrev));
+    }
+    if ((mHashHead == NULL) || (mHashPrev == NULL)) {
       return EFI_OUT_OF_RESOURCES;
     }
 
-    mBuf = AllocateZeroPool (mBufSiz);
+    //
+    // Links are only followed from heads set by this call
+    //
+    ZeroMem (mHashHead, HASH_CHAIN_SIZE * sizeof (*mHashHead));
+    return EFI_SUCCESS;
+  }
+
+  if (mText == NULL) {
+    mText       = AllocateZeroPool (WNDSIZ * 2 + MAXMATCH);
+    mLevel      = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mLevel));
+    mChildCount = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mChildCount));
+    mPosition   = AllocateZeroPool ((WNDSIZ + MAX_UINT8 + 1) * sizeof (*mPosition));
+    mParent     = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mParent));
+    mPrev       = AllocateZeroPool (WNDSIZ * 2 * sizeof (*mPrev));
+    mNext       = AllocateZeroPool ((MAX_HASH_VAL + 1) * sizeof (*mNext));
+  } else {
+    ZeroMem (mText, WNDSIZ * 2 + MAXMATCH);
+    ZeroMem (mLevel, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*mLevel));
+    ZeroMem (mChildCount, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*mChildCount));
+    ZeroMem (mPosition, (WNDSIZ + MAX_UINT8 + 1) * sizeof (*mPosition));
+    ZeroMem (mParent, WNDSIZ * 2 * sizeof (*mParent));
+    ZeroMem (mPrev, WNDSIZ * 2 * sizeof (*mPrev));
+    ZeroMem (mNext, (MAX_HASH_VAL + 1) * sizeof (*mNext));
   }
 
-  mBuf[0] = 0;
+  if ((mText == NULL) || (mLevel == NULL) || (mChildCount == NULL) || (mPosition == NULL) ||
+      (mParent == NULL) || (mPrev == NULL) || (mNext == NULL)) {
+    return EFI_OUT_OF_RESOURCES;
+  }
 
   return EFI_SUCCESS;
 }
 
 /**
-  Called when compression is completed to free memory previously allocated.
+  Free the memory previously allocated for the compression process.
 
 **/
 VOID
@@ -237,6 +302,8 @@ FreeMemory (
   SHELL_FREE_NON_NULL (mPrev);
   SHELL_FREE_NON_NULL (mNext);
   SHELL_FREE_NON_NULL (mBuf);
+  SHELL_FREE_NON_NULL (mHashHead);
+  SHELL_FREE_NON_NULL (mHashPrev);
 }
 
 /**
@@ -624,18 +691,14 @@ GetNextMatch (
   )
 {
   INT32 LoopVar8;
-  VOID  *Temp;
 
   mRemainder--;
   mPos++;
   if (mPos == WNDSIZ * 2) {
-    Temp = AllocateZeroPool (WNDSIZ + MAXMATCH);
-    if (Temp == NULL) {
-      return (FALSE);
-    }
-    CopyMem (Temp, &mText[WNDSIZ], WNDSIZ + MAXMATCH);
-    CopyMem (&mText[0], Temp, WNDSIZ + MAXMATCH);
-    FreePool (Temp);
+    //
+    // CopyMem () handles the overlap, slide the window in place
+    //
+    CopyMem (&mText[0], &mText[WNDSIZ], WNDSIZ + MAXMATCH);
     LoopVar8 = FreadCrc (&mText[WNDSIZ + MAXMATCH], WNDSIZ);
     mRemainder += LoopVar8;
     mPos = WNDSIZ;
@@ -1274,28 +1337,176 @@ HufEncodeEnd (
   PutBits (UINT8_BIT - 1, 0);
 }
 
+/**
+  Add a source position to the hash chains.
+
+  @param[in] Pos    The offset of the position in the source buffer.
+**/
+VOID
+EFIAPI
+HashChainInsert (
+  IN UINT32 Pos
+  )
+{
+  UINT32  Hash;
+
+  if (Pos + THRESHOLD > mOrigSize) {
+    return;
+  }
+
+  Hash                            = HASH3 (&mSrc[Pos]);
+  mHashPrev[Pos & (WNDSIZ - 1)]   = mHashHead[Hash];
+  mHashHead[Hash]                 = Pos + 1;
+}
+
+/**
+  Find the longest earlier match for a source position.
+
+  @param[in]  Pos       The offset of the position in the source buffer.
+  @param[in]  Config    The search limits of the compression level.
+  @param[out] Distance  The distance back to the match, when one was found.
+
+  @return The match length, less than THRESHOLD when there is no usable match.
+**/
+UINT32
+EFIAPI
+HashChainLongestMatch (
+  IN  UINT32                  Pos,
+  IN  CONST HASH_CHAIN_LEVEL  *Config,
+  OUT UINT32                  *Distance
+  )
+{
+  UINT32  Avail;
+  UINT32  Candidate;
+  UINT32  Chain;
+  UINT32  BestLen;
+  UINT32  Len;
+
+  Avail = mOrigSize - Pos;
+  if (Avail > MAXMATCH) {
+    Avail = MAXMATCH;
+  }
+  if (Avail < THRESHOLD) {
+    return 0;
+  }
+
+  BestLen   = THRESHOLD - 1;
+  Candidate = mHashHead[HASH3 (&mSrc[Pos])];
+  for (Chain = Config->MaxChain; Candidate != 0 && Chain > 0; Chain--) {
+    Candidate--;
+    if (Pos - Candidate > WNDSIZ) {
+      break;
+    }
+
+    //
+    // Check the byte that would make this candidate better first
+    //
+    if (mSrc[Candidate + BestLen] == mSrc[Pos + BestLen] && mSrc[Candidate] == mSrc[Pos]) {
+      for (Len = 0; Len < Avail && mSrc[Candidate + Len] == mSrc[Pos + Len]; Len++) {
+      }
+
+      if (Len > BestLen) {
+        BestLen   = Len;
+        *Distance = Pos - Candidate;
+        if (Len >= Config->NiceLength || Len == Avail) {
+          break;
+        }
+      }
+    }
+
+    Candidate = mHashPrev[Candidate & (WNDSIZ - 1)];
+  }
+
+  return BestLen;
+}
+
+/**
+  The compression loop of the hash chain levels. Matches are searched in the
+  source buffer directly, so no sliding window copy is needed.
+
+  @param[in] Config   The search limits of the compression level.
+**/
+VOID
+EFIAPI
+HashChainEncode (
+  IN CONST HASH_CHAIN_LEVEL  *Config
+  )
+{
+  UINT32  Pos;
+  UINT32  Len;
+  UINT32  Distance;
+  UINT32  NextLen;
+  UINT32  NextDistance;
+
+  Distance = 0;
+  Pos      = 0;
+  while (Pos < mOrigSize) {
+    Len = HashChainLongestMatch (Pos, Config, &Distance);
+    HashChainInsert (Pos);
+
+    //
+    // Lazy matching: emit a literal while the next position matches longer
+    //
+    if (Config->Lazy) {
+      while (Len >= THRESHOLD && Len < Config->NiceLength && Pos + 1 < mOrigSize) {
+        NextLen = HashChainLongestMatch (Pos + 1, Config, &NextDistance);
+        if (NextLen <= Len) {
+          break;
+        }
+
+        CompressOutput (mSrc[Pos], 0);
+        Pos++;
+        HashChainInsert (Pos);
+        Len      = NextLen;
+        Distance = NextDistance;
+      }
+    }
+
+    if (Len < THRESHOLD) {
+      CompressOutput (mSrc[Pos], 0);
+      Pos++;
+      continue;
+    }
+
+    CompressOutput (Len + (MAX_UINT8 + 1 - THRESHOLD), Distance - 1);
+    for (Pos++, Len--; Len > 0; Pos++, Len--) {
+      HashChainInsert (Pos);
+    }
+  }
+}
+
 /**
   The main controlling routine for compression process.
 
+  @param[in] Level    The compression level.
+
   @retval EFI_SUCCESS           The compression is successful.
   @retval EFI_OUT_0F_RESOURCES  Not enough memory for compression process.
 **/
 EFI_STATUS
 EFIAPI
 Encode (
-  VOID
+  IN COMPRESS_LEVEL  Level
   )
 {
   EFI_STATUS  Status;
   INT32       LastMatchLen;
   NODE        LastMatchPos;
 
-  Status = AllocateMemory ();
+  Status = AllocateMemory (Level);
   if (EFI_ERROR (Status)) {
     FreeMemory ();
     return Status;
   }
 
+  if (Level != CompressLevelDefault) {
+    mOrigSize = (UINT32) (mSrcUpperLimit - mSrc);
+    HufEncodeStart ();
+    HashChainEncode (&mHashChainLevel[Level]);
+    HufEncodeEnd ();
+    return EFI_SUCCESS;
+  }
+
   InitSlide ();
 
   HufEncodeStart ();
@@ -1347,46 +1558,49 @@ Encode (
   }
 
   HufEncodeEnd ();
-  FreeMemory ();
+  if (EFI_ERROR (Status)) {
+    FreeMemory ();
+  }
   return (Status);
 }
 
 /**
-  The compression routine.
+  The compression routine, with a selectable speed/ratio trade-off.
+
+  The scratch buffers of a level are allocated by its first call and are kept
+  for the following calls, until CompressFreeScratch() is called.
 
   @param[in]       SrcBuffer     The buffer containing the source data.
   @param[in]       SrcSize       The number of bytes in SrcBuffer.
   @param[in]       DstBuffer     The buffer to put the compressed image in.
   @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
                                 return the number of bytes placed in DstBuffer.
+  @param[in]       Level         The compression level.
 
   @retval EFI_SUCCESS           The compression was sucessful.
   @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+  @retval EFI_INVALID_PARAMETER Level is not a valid compression level.
+  @retval EFI_OUT_OF_RESOURCES  The scratch buffers could not be allocated.
 **/
 EFI_STATUS
 EFIAPI
-Compress (
-  IN       VOID   *SrcBuffer,
-  IN       UINT64 SrcSize,
-  IN       VOID   *DstBuffer,
-  IN OUT   UINT64 *DstSize
+CompressEx (
+  IN       VOID           *SrcBuffer,
+  IN       UINT64         SrcSize,
+  IN       VOID           *DstBuffer,
+  IN OUT   UINT64         *DstSize,
+  IN       COMPRESS_LEVEL Level
   )
 {
   EFI_STATUS  Status;
 
+  if (Level >= CompressLevelMax) {
+    return EFI_INVALID_PARAMETER;
+  }
+
   //
   // Initializations
   //
-  mBufSiz         = 0;
-  mBuf            = NULL;
-  mText           = NULL;
-  mLevel          = NULL;
-  mChildCount     = NULL;
-  mPosition       = NULL;
-  mParent         = NULL;
-  mPrev           = NULL;
-  mNext           = NULL;
-
   mSrc            = SrcBuffer;
   mSrcUpperLimit  = mSrc + SrcSize;
   mDst            = DstBuffer;
@@ -1403,7 +1617,7 @@ Compress (
   //
   // Compress it
   //
-  Status = Encode ();
+  Status = Encode (Level);
   if (EFI_ERROR (Status)) {
     return EFI_OUT_OF_RESOURCES;
   }
@@ -1433,3 +1647,45 @@ Compress (
 
 }
 
+/**
+  The compression routine.
+
+  The scratch buffers are freed before returning, including the ones kept by
+  earlier CompressEx() calls.
+
+  @param[in]       SrcBuffer     The buffer containing the source data.
+  @param[in]       SrcSize       The number of bytes in SrcBuffer.
+  @param[in]       DstBuffer     The buffer to put the compressed image in.
+  @param[in, out]  DstSize       On input the size (in bytes) of DstBuffer, on
+                                return the number of bytes placed in DstBuffer.
+
+  @retval EFI_SUCCESS           The compression was sucessful.
+  @retval EFI_BUFFER_TOO_SMALL  The buffer was too small.  DstSize is required.
+**/
+EFI_STATUS
+EFIAPI
+Compress (
+  IN       VOID   *SrcBuffer,
+  IN       UINT64 SrcSize,
+  IN       VOID   *DstBuffer,
+  IN OUT   UINT64 *DstSize
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = CompressEx (SrcBuffer, SrcSize, DstBuffer, DstSize, CompressLevelDefault);
+  FreeMemory ();
+  return Status;
+}
+
+/**
+  Free the scratch buffers kept by CompressEx().
+**/
+VOID
+EFIAPI
+CompressFreeScratch (
+  VOID
+  )
+{
+  FreeMemory ();
+}
@@ -8,6 +8,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Uefi.h>
 #include <PiPei.h>
 #include <Library/PeiServicesTablePointerLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/HobVariableLib.h>
@@ -396,10 +397,173 @@ Returns:
   // Update Variable Storage Size
   //
   VarStoreHeader->Size = (UINT32) ((UINTN) VariablePtr - (UINTN) VarStoreHeader);
-  
+
+  BuildVariableIndexHob (VarStoreHeader);
+
   return EFI_SUCCESS;
 }
 
+/**
+  Hash a variable name and vendor GUID with FNV-1a.
+
+  @param  VariableName  Pointer to the variable name.
+  @param  NameSize      Size of the variable name in bytes, including the
+                        null terminator.
+  @param  VendorGuid    Pointer to the variable vendor GUID.
+
+  @return Hash of the variable name and vendor GUID.
+
+**/
+STATIC
+UINT32
+HobVariableHash (
+  IN CONST CHAR16               *VariableName,
+  IN UINTN                      NameSize,
+  IN CONST EFI_GUID             *VendorGuid
+  )
+{
+  CONST UINT8                   *Bytes;
+  UINT32                        Hash;
+  UINTN                         Index;
+
+  Hash  = 0x811C9DC5;
+  Bytes = (CONST UINT8 *) VariableName;
+  for (Index = 0; Index < NameSize; Index++) {
+    Hash = (Hash ^ Bytes[Index]) * 0x01000193;
+  }
+  Bytes = (CONST UINT8 *) VendorGuid;
+  for (Index = 0; Index < sizeof (EFI_GUID); Index++) {
+    Hash = (Hash ^ Bytes[Index]) * 0x01000193;
+  }
+
+  return Hash;
+}
+
+/**
+  Build the hash index HOB of the variables in a variable store GUID HOB.
+
+  The index is an optimization only, if it cannot be built the variables are
+  found by walking the variable store.
+
+  @param  VarStoreHeader  Pointer to the variable store in the GUID HOB.
+
+**/
+VOID
+BuildVariableIndexHob (
+  IN VARIABLE_STORE_HEADER      *VarStoreHeader
+  )
+{
+  BOOLEAN                       AuthFlag;
+  AUTHENTICATED_VARIABLE_HEADER *StartPtr;
+  AUTHENTICATED_VARIABLE_HEADER *EndPtr;
+  AUTHENTICATED_VARIABLE_HEADER *CurrPtr;
+  HOB_VARIABLE_INDEX_HEADER     *IndexHeader;
+  UINT32                        *Bucket;
+  HOB_VARIABLE_INDEX_ENTRY      *Entry;
+  UINT32                        EntryCount;
+  UINT32                        BucketCount;
+  UINT32                        BucketIndex;
+  UINT32                        Index;
+  UINTN                         IndexSize;
+
+  AuthFlag = CompareGuid (&VarStoreHeader->Signature, &gEfiAuthenticatedVariableGuid);
+  StartPtr = GetStartPointer (VarStoreHeader);
+  EndPtr   = GetEndPointer (VarStoreHeader);
+
+  EntryCount = 0;
+  for ( CurrPtr = StartPtr
+      ; (CurrPtr < EndPtr) && IsValidVariableHeader (CurrPtr)
+      ; CurrPtr = GetNextVariablePtr (CurrPtr, AuthFlag)
+      ) {
+    if (CurrPtr->State == VAR_ADDED && NameSizeOfVariable (CurrPtr, AuthFlag) != 0) {
+      EntryCount++;
+    }
+  }
+  if (EntryCount == 0) {
+    return;
+  }
+
+  BucketCount = HOB_VARIABLE_INDEX_MIN_BUCKET_COUNT;
+  while (BucketCount < EntryCount) {
+    BucketCount <<= 1;
+  }
+  IndexSize = sizeof (HOB_VARIABLE_INDEX_HEADER) +
+              BucketCount * sizeof (UINT32) +
+              EntryCount * sizeof (HOB_VARIABLE_INDEX_ENTRY);
+  if (IndexSize > MAX_UINT16 - sizeof (EFI_HOB_GUID_TYPE)) {
+    DEBUG ((DEBUG_INFO, "HobVariableLib: %d variables are too many to index\n", EntryCount));
+    return;
+  }
+
+  IndexHeader = (HOB_VARIABLE_INDEX_HEADER *) BuildGuidHob (&gHobVariableIndexGuid, IndexSize);
+  if (IndexHeader == NULL) {
+    return;
+  }
+  CopyGuid (&IndexHeader->StoreSignature, &VarStoreHeader->Signature);
+  IndexHeader->StoreSize   = VarStoreHeader->Size;
+  IndexHeader->BucketCount = BucketCount;
+  IndexHeader->EntryCount  = EntryCount;
+  Bucket = (UINT32 *) (IndexHeader + 1);
+  Entry  = (HOB_VARIABLE_INDEX_ENTRY *) (Bucket + BucketCount);
+  ZeroMem (Bucket, BucketCount * sizeof (UINT32));
+
+  Index = 0;
+  for ( CurrPtr = StartPtr
+      ; (CurrPtr < EndPtr) && IsValidVariableHeader (CurrPtr)
+      ; CurrPtr = GetNextVariablePtr (CurrPtr, AuthFlag)
+      ) {
+    if (CurrPtr->State == VAR_ADDED && NameSizeOfVariable (CurrPtr, AuthFlag) != 0) {
+      Entry[Index].Hash   = HobVariableHash (
+                              GetVariableNamePtr (CurrPtr, AuthFlag),
+                              NameSizeOfVariable (CurrPtr, AuthFlag),
+                              GetVendorGuidPtr (CurrPtr, AuthFlag)
+                              );
+      Entry[Index].Offset = (UINT32) ((UINTN) CurrPtr - (UINTN) VarStoreHeader);
+      Index++;
+    }
+  }
+
+  //
+  // Link the entries from the last one, so every chain keeps the store order.
+  //
+  for (Index = EntryCount; Index > 0; Index--) {
+    BucketIndex            = Entry[Index - 1].Hash & (BucketCount - 1);
+    Entry[Index - 1].Next  = Bucket[BucketIndex];
+    Bucket[BucketIndex]    = Index;
+  }
+}
+
+/**
+  Get the hash index HOB built for a variable store GUID HOB.
+
+  @param  VarStoreHeader  Pointer to the variable store in the GUID HOB.
+
+  @return Pointer to the index, or NULL if the variable store is not indexed.
+
+**/
+STATIC
+HOB_VARIABLE_INDEX_HEADER *
+GetVariableIndexHob (
+  IN VARIABLE_STORE_HEADER      *VarStoreHeader
+  )
+{
+  EFI_HOB_GUID_TYPE             *GuidHob;
+  HOB_VARIABLE_INDEX_HEADER     *IndexHeader;
+
+  for ( GuidHob = GetFirstGuidHob (&gHobVariableIndexGuid)
+      ; GuidHob != NULL
+      ; GuidHob = GetNextGuidHob (&gHobVariableIndexGuid, GET_NEXT_HOB (GuidHob))
+      ) {
+    IndexHeader = (HOB_VARIABLE_INDEX_HEADER *) GET_GUID_HOB_DATA (GuidHob);
+    if (CompareGuid (&IndexHeader->StoreSignature, &VarStoreHeader->Signature) &&
+        IndexHeader->StoreSize == VarStoreHeader->Size) {
+      return IndexHeader;
+    }
+  }
+
+  return NULL;
+}
+
 EFI_PEI_NOTIFY_DESCRIPTOR mMemoryNotifyList = {
   (EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK | EFI_PEI_PPI_DESCRIPTOR_TERMINATE_LIST),
   &gEfiPeiMemoryDiscoveredPpiGuid,
@@ -430,6 +594,12 @@ FindVariableFromHob (
   AUTHENTICATED_VARIABLE_HEADER *EndPtr;
   AUTHENTICATED_VARIABLE_HEADER *CurrPtr;
   VOID                          *Point;
+  HOB_VARIABLE_INDEX_HEADER     *IndexHeader;
+  UINT32                        *Bucket;
+  HOB_VARIABLE_INDEX_ENTRY      *Entry;
+  UINT32                        EntryIndex;
+  UINT32                        Hash;
+  UINTN                         NameSize;
 
   VariableStoreHeader = NULL;
 
@@ -449,6 +619,30 @@ FindVariableFromHob (
     return NULL;
   }
 
+  IndexHeader = GetVariableIndexHob (VariableStoreHeader);
+  if (IndexHeader != NULL) {
+    NameSize = StrSize (VariableName);
+    Hash     = HobVariableHash (VariableName, NameSize, VendorGuid);
+    Bucket   = (UINT32 *) (IndexHeader + 1);
+    Entry    = (HOB_VARIABLE_INDEX_ENTRY *) (Bucket + IndexHeader->BucketCount);
+    for ( EntryIndex = Bucket[Hash & (IndexHeader->BucketCount - 1)]
+        ; EntryIndex != 0
+        ; EntryIndex = Entry[EntryIndex - 1].Next
+        ) {
+      if (Entry[EntryIndex - 1].Hash != Hash) {
+        continue;
+      }
+      CurrPtr = (AUTHENTICATED_VARIABLE_HEADER *) ((UINT8 *) VariableStoreHeader + Entry[EntryIndex - 1].Offset);
+      if (CurrPtr->State == VAR_ADDED &&
+          NameSizeOfVariable (CurrPtr, *AuthFlag) == NameSize &&
+          CompareGuid (VendorGuid, GetVendorGuidPtr (CurrPtr, *AuthFlag)) &&
+          CompareMem (VariableName, GetVariableNamePtr (CurrPtr, *AuthFlag), NameSize) == 0) {
+        return CurrPtr;
+      }
+    }
+    return NULL;
+  }
+
   StartPtr = GetStartPointer (VariableStoreHeader);
   EndPtr   = GetEndPointer (VariableStoreHeader);
   for ( CurrPtr = StartPtr
@@ -307,6 +307,8 @@ Returns:
   //
   VarStoreHeader->Size = (UINT32) ((UINTN) VariablePtr - (UINTN) VarStoreHeader);
 
+  BuildVariableIndexHob (VarStoreHeader);
+
   return EFI_SUCCESS;
 }
 
@@ -445,6 +447,8 @@ CreateDefaultVariableHob (
   //
   VarStoreHeaderHob->Size = VarStoreHeader->Size - VarDataOffset + VarHobDataOffset;
 
+  BuildVariableIndexHob (VarStoreHeaderHob);
+
   //
   // On recovery boot mode, emulation variable driver will be used.
   // But, Emulation variable only knows normal variable data format. 
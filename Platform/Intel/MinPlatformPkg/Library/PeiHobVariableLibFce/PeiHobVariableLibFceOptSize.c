@@ -184,6 +184,11 @@ CreateDefaultVariableHob (
     return EFI_NOT_FOUND;
   }
 
+  //
+  // Index the variables once all the delta settings are applied.
+  //
+  BuildVariableIndexHob (VarStoreHeaderHob);
+
   //
   // On recovery boot mode, emulation variable driver will be used.
   // But, Emulation variable only knows normal variable data format. 
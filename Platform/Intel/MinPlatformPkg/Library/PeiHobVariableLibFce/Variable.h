@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 extern EFI_GUID gEfiVariableGuid;
 extern EFI_GUID gEfiAuthenticatedVariableGuid;
+extern EFI_GUID gHobVariableIndexGuid;
 
 ///
 /// Alignment of variable name and data, according to the architecture:
@@ -169,4 +170,44 @@ typedef struct {
 
 #pragma pack()
 
+///
+/// Hash index of the VAR_ADDED variables in a variable store GUID HOB, saved
+/// in a gHobVariableIndexGuid HOB right after the store HOB is built.
+/// It only records offsets from the variable store header, so it is still
+/// valid after the HOB list is migrated to permanent memory.
+///
+/// The header is followed by UINT32 Bucket[BucketCount], the 1-based index of
+/// the first entry of every hash chain (0 for an empty chain), and by
+/// HOB_VARIABLE_INDEX_ENTRY Entry[EntryCount]. Every chain keeps the order of
+/// the variable store, so the first match is the same one a linear walk finds.
+///
+typedef struct {
+  EFI_GUID    StoreSignature;   ///< Signature of the indexed variable store
+  UINT32      StoreSize;        ///< Size of the indexed variable store
+  UINT32      BucketCount;      ///< Number of hash chains, a power of 2
+  UINT32      EntryCount;       ///< Number of indexed variables
+} HOB_VARIABLE_INDEX_HEADER;
+
+typedef struct {
+  UINT32      Hash;             ///< Hash of the variable name and vendor GUID
+  UINT32      Offset;           ///< Offset of the variable header from the store header
+  UINT32      Next;             ///< 1-based index of the next entry in the chain, 0 for none
+} HOB_VARIABLE_INDEX_ENTRY;
+
+#define HOB_VARIABLE_INDEX_MIN_BUCKET_COUNT  16
+
+/**
+  Build the hash index HOB of the variables in a variable store GUID HOB.
+
+  The index is an optimization only, if it cannot be built the variables are
+  found by walking the variable store.
+
+  @param  VarStoreHeader  Pointer to the variable store in the GUID HOB.
+
+**/
+VOID
+BuildVariableIndexHob (
+  IN VARIABLE_STORE_HEADER  *VarStoreHeader
+  );
+
 #endif
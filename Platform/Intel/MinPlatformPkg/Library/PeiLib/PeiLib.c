@@ -9,7 +9,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/PeiServicesLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UefiDecompressLib.h>
 #include <Ppi/ReadOnlyVariable2.h>
+#include <MemoryConfigStorage.h>
 
 /**
   Returns the status whether get the variable success. The function retrieves 
@@ -285,3 +290,137 @@ PeiGetSectionFromAnyFv  (
   
   return EFI_SUCCESS;
 }
+
+/**
+  Returns the memory configuration data saved by the SaveMemoryConfig driver,
+  decompressed into a single buffer.
+
+  The chunks described by the storage header are read and decompressed in
+  turn, and the result is checked against the CRC32 in the header. When there
+  is no storage header, the uncompressed variable of older firmware is read.
+
+  The returned buffer is allocated using AllocatePool(). The caller is
+  responsible for freeing this buffer with FreePool(). The compressed chunks
+  and the decompression scratch buffer are kept on the stack, so that no
+  other pool memory is used before permanent memory is installed.
+
+  @param[in]  Guid  The GUID the variables are saved under.
+  @param[out] Data  The memory configuration data.
+  @param[out] Size  The size of the memory configuration data.
+
+  @return EFI_SUCCESS               The data was read.
+  @return EFI_NOT_FOUND             No memory configuration data was saved.
+  @return EFI_COMPROMISED_DATA      The saved data is incomplete or corrupted.
+  @return EFI_OUT_OF_RESOURCES      Allocate buffer failed.
+  @return Others Errors             Return errors from call to GetVariable.
+
+**/
+EFI_STATUS
+EFIAPI
+PeiGetMemoryConfig (
+  IN CONST EFI_GUID  *Guid,
+  OUT VOID           **Data,
+  OUT UINTN          *Size
+  )
+{
+  EFI_STATUS                    Status;
+  MEMORY_CONFIG_STORAGE_HEADER  Header;
+  VOID                          *HeaderPtr;
+  UINTN                         HeaderSize;
+  CHAR16                        Name[MEMORY_CONFIG_CHUNK_VARIABLE_NAME_LENGTH];
+  UINT8                         *Buffer;
+  UINT8                         Chunk[MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE];
+  VOID                          *ChunkPtr;
+  UINTN                         ChunkSize;
+  UINT8                         Scratch[MEMORY_CONFIG_DECOMPRESS_SCRATCH_SIZE];
+  UINT32                        ScratchSize;
+  UINT32                        DestinationSize;
+  UINT32                        Length;
+  UINTN                         Index;
+  UINTN                         Offset;
+
+  ASSERT (Guid != NULL);
+  ASSERT (Data != NULL);
+  ASSERT (Size != NULL);
+
+  *Data = NULL;
+  *Size = 0;
+
+  HeaderPtr  = &Header;
+  HeaderSize = sizeof (Header);
+  Status = PeiGetVariable (MEMORY_CONFIG_HEADER_VARIABLE_NAME, Guid, &HeaderPtr, &HeaderSize);
+  if (Status == EFI_NOT_FOUND) {
+    return PeiGetVariable (MEMORY_CONFIG_LEGACY_VARIABLE_NAME, Guid, Data, Size);
+  }
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((HeaderSize != sizeof (Header)) ||
+      (Header.Signature != MEMORY_CONFIG_STORAGE_SIGNATURE) ||
+      (Header.Version != MEMORY_CONFIG_STORAGE_VERSION) ||
+      (Header.DataSize == 0) ||
+      (Header.ChunkSize == 0) || (Header.ChunkSize > MEMORY_CONFIG_CHUNK_SIZE) ||
+      (Header.ChunkCount > MEMORY_CONFIG_MAX_CHUNK_COUNT) ||
+      (Header.ChunkCount != (Header.DataSize + Header.ChunkSize - 1) / Header.ChunkSize)) {
+    DEBUG ((DEBUG_ERROR, "Invalid memory config storage header\n"));
+    return EFI_COMPROMISED_DATA;
+  }
+
+  Buffer = AllocatePool (Header.DataSize);
+  if (Buffer == NULL) {
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Done;
+  }
+
+  ChunkPtr = Chunk;
+
+  for (Index = 0, Offset = 0; Index < Header.ChunkCount; Index++, Offset += Length) {
+    Length = (UINT32) MIN (Header.ChunkSize, Header.DataSize - Offset);
+
+    UnicodeSPrint (Name, sizeof (Name), MEMORY_CONFIG_CHUNK_VARIABLE_NAME_FORMAT, Index);
+    ChunkSize = MEMORY_CONFIG_MAX_COMPRESSED_CHUNK_SIZE;
+    Status = PeiGetVariable (Name, Guid, &ChunkPtr, &ChunkSize);
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "Get memory config chunk %d - %r\n", Index, Status));
+      goto Done;
+    }
+
+    Status = UefiDecompressGetInfo (Chunk, (UINT32) ChunkSize, &DestinationSize, &ScratchSize);
+    if (EFI_ERROR (Status) || (DestinationSize != Length)) {
+      Status = EFI_COMPROMISED_DATA;
+      goto Done;
+    }
+
+    if (ScratchSize > sizeof (Scratch)) {
+      DEBUG ((DEBUG_ERROR, "Memory config decompression needs 0x%x bytes of scratch\n", ScratchSize));
+      Status = EFI_BUFFER_TOO_SMALL;
+      goto Done;
+    }
+
+    Status = UefiDecompress (Chunk, &Buffer[Offset], Scratch);
+    if (EFI_ERROR (Status)) {
+      Status = EFI_COMPROMISED_DATA;
+      goto Done;
+    }
+  }
+
+  if (CalculateCrc32 (Buffer, Header.DataSize) != Header.DataCrc32) {
+    Status = EFI_COMPROMISED_DATA;
+    goto Done;
+  }
+
+  *Data  = Buffer;
+  *Size  = Header.DataSize;
+  Buffer = NULL;
+  Status = EFI_SUCCESS;
+
+Done:
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Get memory config - %r\n", Status));
+  }
+  if (Buffer != NULL) {
+    FreePool (Buffer);
+  }
+  return Status;
+}
@@ -154,6 +154,10 @@ OnReadyToBootLater (
   TestPointReadyToBootTcgTrustedBootEnabled ();
   TestPointReadyToBootTcgMorEnabled ();
   TestPointReadyToBootEsrtTableFunctional ();
+
+  TestPointReadyToBootBootPhaseWithinBudget ();
+  TestPointReadyToBootDriverDispatchWithinBudget ();
+  TestPointReadyToBootHobAndMemoryMapWithinBudget ();
 }
 
 /**
@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/HobLib.h>
 #include <Library/PcdLib.h>
 #include <Library/TimerLib.h>
+#include <Library/PerformanceLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/PeiServicesLib.h>
 #include <Library/ReportFvLib.h>
@@ -376,6 +377,8 @@ MemoryDiscoveredPpiNotifyCallback (
   EFI_STATUS                    Status;
   EFI_BOOT_MODE                 BootMode;
 
+  PERF_CROSSMODULE_END ("MemoryInit");
+
   Status = BoardInitAfterMemoryInit ();
   ASSERT_EFI_ERROR (Status);
 
@@ -490,6 +493,12 @@ PlatformInitPreMem (
   Status = BoardInitBeforeMemoryInit ();
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // Memory init is measured up to the memory discovered notification, see
+  // TestPointReadyToBootBootPhaseWithinBudget().
+  //
+  PERF_CROSSMODULE_BEGIN ("MemoryInit");
+
   Status = PeiServicesInstallPpi (&mPlatformInitTempRamExitPpiDesc);
   ASSERT_EFI_ERROR (Status);
 
@@ -0,0 +1,639 @@
+/** @file
+
+Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <PiDxe.h>
+#include <Library/TestPointCheckLib.h>
+#include <Library/TestPointLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HobLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/PrintLib.h>
+#include <Library/TimerLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiRuntimeServicesTableLib.h>
+#include <IndustryStandard/Acpi.h>
+#include <Guid/ExtendedFirmwarePerformance.h>
+
+#define TEST_POINT_SLOWEST_DRIVER_COUNT  8
+#define TEST_POINT_ERROR_STRING_LENGTH   128
+
+typedef struct {
+  CHAR8     *Token;
+  CHAR8     *Name;
+  UINT32    Budget;
+  UINT64    Start;
+  UINT64    End;
+} TEST_POINT_BOOT_PHASE;
+
+typedef struct {
+  EFI_GUID  Guid;
+  UINT64    Start;
+  BOOLEAN   Ended;
+} TEST_POINT_DRIVER_START;
+
+typedef struct {
+  EFI_GUID  Guid;
+  UINT64    Duration;
+} TEST_POINT_DRIVER_DURATION;
+
+#define TEST_POINT_HOB_AND_MEMORY_MAP_BASELINE_NAME  L"TestPointHobAndMemoryMapBaseline"
+
+typedef struct {
+  UINT64    HobListSize;
+  UINT64    DescriptorCount;
+} TEST_POINT_HOB_AND_MEMORY_MAP_BASELINE;
+
+VOID *
+TestPointGetAcpi (
+  IN UINT32  Signature
+  );
+
+/**
+  Get the current time in nanoseconds, on the time base of the performance records.
+
+  The performance libraries convert the raw performance counter value of each
+  record with GetTimeInNanoSecond(), so the same is done here.
+
+  @return The current time in nanoseconds.
+**/
+UINT64
+TestPointGetCurrentTime (
+  VOID
+  )
+{
+  return GetTimeInNanoSecond (GetPerformanceCounter ());
+}
+
+/**
+  Get the Firmware Basic Boot Performance Table (FBPT) reported in the FPDT.
+
+  @return The FBPT header, or NULL if the FPDT is not installed.
+**/
+EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER *
+TestPointGetBootPerformanceTable (
+  VOID
+  )
+{
+  EFI_ACPI_DESCRIPTION_HEADER                              *Fpdt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER              *Record;
+  EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_POINTER_RECORD  *BootPointer;
+  EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER          *Fbpt;
+
+  Fpdt = TestPointGetAcpi (EFI_ACPI_5_0_FIRMWARE_PERFORMANCE_DATA_TABLE_SIGNATURE);
+  if (Fpdt == NULL) {
+    return NULL;
+  }
+
+  Record = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *) (Fpdt + 1);
+  while ((UINTN) Record + sizeof (*Record) <= (UINTN) Fpdt + Fpdt->Length) {
+    if (Record->Length < sizeof (*Record)) {
+      break;
+    }
+    if (Record->Type == EFI_ACPI_5_0_FPDT_RECORD_TYPE_FIRMWARE_BASIC_BOOT_POINTER) {
+      BootPointer = (EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_POINTER_RECORD *) Record;
+      Fbpt = (EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER *) (UINTN) BootPointer->BootPerformanceTablePointer;
+      if ((Fbpt == NULL) || (Fbpt->Signature != EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_SIGNATURE)) {
+        return NULL;
+      }
+      return Fbpt;
+    }
+    Record = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *) ((UINT8 *) Record + Record->Length);
+  }
+
+  return NULL;
+}
+
+/**
+  Get the next performance record in the FBPT.
+
+  @param[in]  Fbpt    The FBPT header.
+  @param[in]  Record  The current record, NULL to get the first one.
+
+  @return The next record, or NULL if there is no more record.
+**/
+EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *
+TestPointGetNextPerformanceRecord (
+  IN EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER  *Fbpt,
+  IN EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER      *Record OPTIONAL
+  )
+{
+  if (Record == NULL) {
+    Record = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *) (Fbpt + 1);
+  } else {
+    Record = (EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER *) ((UINT8 *) Record + Record->Length);
+  }
+
+  if (((UINTN) Record + sizeof (*Record) > (UINTN) Fbpt + Fbpt->Length) ||
+      (Record->Length < sizeof (*Record)) ||
+      ((UINTN) Record + Record->Length > (UINTN) Fbpt + Fbpt->Length)) {
+    return NULL;
+  }
+
+  return Record;
+}
+
+/**
+  Check if a performance record is one of the extended event records, which
+  all start like FPDT_GUID_EVENT_RECORD.
+
+  @param[in]  Record  The performance record.
+
+  @retval TRUE   The record is an extended event record.
+  @retval FALSE  The record is not an extended event record.
+**/
+BOOLEAN
+TestPointIsEventRecord (
+  IN EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *Record
+  )
+{
+  switch (Record->Type) {
+  case FPDT_GUID_EVENT_TYPE:
+  case FPDT_DYNAMIC_STRING_EVENT_TYPE:
+  case FPDT_DUAL_GUID_STRING_EVENT_TYPE:
+  case FPDT_GUID_QWORD_EVENT_TYPE:
+  case FPDT_GUID_QWORD_STRING_EVENT_TYPE:
+    return (BOOLEAN) (Record->Length >= sizeof (FPDT_GUID_EVENT_RECORD));
+  default:
+    return FALSE;
+  }
+}
+
+/**
+  Check if a dynamic string event record carries a given token.
+
+  @param[in]  Record  The performance record.
+  @param[in]  Token   The token to match.
+
+  @retval TRUE   The record carries the token.
+  @retval FALSE  The record does not carry the token.
+**/
+BOOLEAN
+TestPointIsTokenRecord (
+  IN EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER  *Record,
+  IN CHAR8                                        *Token
+  )
+{
+  FPDT_DYNAMIC_STRING_EVENT_RECORD  *StringRecord;
+  UINTN                             StringSize;
+
+  if ((Record->Type != FPDT_DYNAMIC_STRING_EVENT_TYPE) ||
+      (Record->Length < sizeof (FPDT_DYNAMIC_STRING_EVENT_RECORD))) {
+    return FALSE;
+  }
+
+  StringRecord = (FPDT_DYNAMIC_STRING_EVENT_RECORD *) Record;
+  StringSize   = Record->Length - sizeof (FPDT_DYNAMIC_STRING_EVENT_RECORD);
+  if (AsciiStrSize (Token) > StringSize) {
+    return FALSE;
+  }
+
+  return (BOOLEAN) (AsciiStrCmp (StringRecord->String, Token) == 0);
+}
+
+/**
+  Append a formatted error string to the test point table.
+
+  @param[in]  ErrorCode    The error code string.
+  @param[in]  Format       The format of the error detail.
+  @param[in]  ...          The arguments of the format.
+**/
+VOID
+TestPointAppendPerformanceErrorString (
+  IN CHAR16  *ErrorCode,
+  IN CHAR16  *Format,
+  ...
+  )
+{
+  CHAR16   ErrorString[TEST_POINT_ERROR_STRING_LENGTH];
+  CHAR16   Detail[TEST_POINT_ERROR_STRING_LENGTH];
+  VA_LIST  Marker;
+
+  VA_START (Marker, Format);
+  UnicodeVSPrint (Detail, sizeof (Detail), Format, Marker);
+  VA_END (Marker);
+
+  UnicodeSPrint (
+    ErrorString,
+    sizeof (ErrorString),
+    L"%s%s%s\r\n",
+    ErrorCode,
+    TEST_POINT_READY_TO_BOOT,
+    Detail
+    );
+  TestPointLibAppendErrorString (
+    PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+    NULL,
+    ErrorString
+    );
+}
+
+EFI_STATUS
+TestPointCheckBootPhasePerformance (
+  VOID
+  )
+{
+  EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER  *Fbpt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER      *Record;
+  FPDT_GUID_EVENT_RECORD                           *EventRecord;
+  TEST_POINT_BOOT_PHASE                            Phase[4];
+  UINTN                                            Index;
+  UINT64                                           Now;
+  UINT64                                           BootStart;
+  UINT64                                           Duration;
+  EFI_STATUS                                       Status;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckBootPhasePerformance - Enter\n"));
+
+  Now = TestPointGetCurrentTime ();
+
+  Fbpt = TestPointGetBootPerformanceTable ();
+  if (Fbpt == NULL) {
+    DEBUG ((DEBUG_ERROR, "No boot performance table\n"));
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_CODE \
+        TEST_POINT_READY_TO_BOOT \
+        TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_STRING
+      );
+    return EFI_NOT_FOUND;
+  }
+
+  ZeroMem (Phase, sizeof (Phase));
+  Phase[0].Token  = "SEC";
+  Phase[0].Name   = "SEC";
+  Phase[0].Budget = PcdGet32 (PcdTestPointSecPhaseBudget);
+  Phase[1].Token  = "MemoryInit";
+  Phase[1].Name   = "Memory Init";
+  Phase[1].Budget = PcdGet32 (PcdTestPointMemoryInitBudget);
+  Phase[2].Token  = "DXE";
+  Phase[2].Name   = "DXE";
+  Phase[2].Budget = PcdGet32 (PcdTestPointDxePhaseBudget);
+  Phase[3].Token  = "BDS";
+  Phase[3].Name   = "BDS";
+  Phase[3].Budget = PcdGet32 (PcdTestPointBdsPhaseBudget);
+
+  for (Record = TestPointGetNextPerformanceRecord (Fbpt, NULL);
+       Record != NULL;
+       Record = TestPointGetNextPerformanceRecord (Fbpt, Record)) {
+    if (!TestPointIsEventRecord (Record)) {
+      continue;
+    }
+    EventRecord = (FPDT_GUID_EVENT_RECORD *) Record;
+    if ((EventRecord->ProgressID != PERF_CROSSMODULE_START_ID) &&
+        (EventRecord->ProgressID != PERF_CROSSMODULE_END_ID)) {
+      continue;
+    }
+    for (Index = 0; Index < ARRAY_SIZE (Phase); Index++) {
+      if (!TestPointIsTokenRecord (Record, Phase[Index].Token)) {
+        continue;
+      }
+      if (EventRecord->ProgressID == PERF_CROSSMODULE_START_ID) {
+        Phase[Index].Start = EventRecord->Timestamp;
+      } else {
+        Phase[Index].End = EventRecord->Timestamp;
+      }
+    }
+  }
+
+  //
+  // BDS is still running at Ready To Boot.
+  //
+  if ((Phase[3].Start != 0) && (Phase[3].End == 0)) {
+    Phase[3].End = Now;
+  }
+
+  Status = EFI_SUCCESS;
+  DEBUG ((DEBUG_INFO, "Phase        Duration(us)  Budget(us)\n"));
+  for (Index = 0; Index < ARRAY_SIZE (Phase); Index++) {
+    if ((Phase[Index].End == 0) || (Phase[Index].End < Phase[Index].Start)) {
+      DEBUG ((DEBUG_INFO, "%-12a not recorded\n", Phase[Index].Name));
+      continue;
+    }
+    Duration = DivU64x32 (Phase[Index].End - Phase[Index].Start, 1000);
+    DEBUG ((DEBUG_INFO, "%-12a %12ld  %10d\n", Phase[Index].Name, Duration, Phase[Index].Budget));
+    if ((Phase[Index].Budget != 0) && (Duration > Phase[Index].Budget)) {
+      DEBUG ((DEBUG_ERROR, "%a phase over budget\n", Phase[Index].Name));
+      TestPointAppendPerformanceErrorString (
+        TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_CODE,
+        L"%a phase %ldus over budget %dus",
+        Phase[Index].Name,
+        Duration,
+        Phase[Index].Budget
+        );
+      Status = EFI_INVALID_PARAMETER;
+    }
+  }
+
+  //
+  // The performance counter starts at reset, use the SEC start when it is recorded.
+  //
+  BootStart = Phase[0].Start;
+  Duration  = DivU64x32 (Now - BootStart, 1000);
+  DEBUG ((DEBUG_INFO, "%-12a %12ld  %10d\n", "Total", Duration, PcdGet32 (PcdTestPointReadyToBootBudget)));
+  if ((PcdGet32 (PcdTestPointReadyToBootBudget) != 0) && (Duration > PcdGet32 (PcdTestPointReadyToBootBudget))) {
+    DEBUG ((DEBUG_ERROR, "Ready To Boot over budget\n"));
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET_ERROR_CODE,
+      L"Ready To Boot %ldus over budget %dus",
+      Duration,
+      PcdGet32 (PcdTestPointReadyToBootBudget)
+      );
+    Status = EFI_INVALID_PARAMETER;
+  }
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckBootPhasePerformance - Exit\n"));
+  return Status;
+}
+
+/**
+  Keep a driver in the list of the slowest drivers, sorted by duration.
+
+  @param[in, out]  Slowest   The slowest drivers.
+  @param[in]       Guid      The driver file GUID.
+  @param[in]       Duration  The driver dispatch duration.
+**/
+VOID
+TestPointRecordSlowDriver (
+  IN OUT TEST_POINT_DRIVER_DURATION  *Slowest,
+  IN     EFI_GUID                    *Guid,
+  IN     UINT64                      Duration
+  )
+{
+  UINTN  Index;
+
+  if (Duration <= Slowest[TEST_POINT_SLOWEST_DRIVER_COUNT - 1].Duration) {
+    return;
+  }
+
+  Index = TEST_POINT_SLOWEST_DRIVER_COUNT - 1;
+  while ((Index > 0) && (Slowest[Index - 1].Duration < Duration)) {
+    CopyMem (&Slowest[Index], &Slowest[Index - 1], sizeof (Slowest[Index]));
+    Index--;
+  }
+  CopyGuid (&Slowest[Index].Guid, Guid);
+  Slowest[Index].Duration = Duration;
+}
+
+EFI_STATUS
+TestPointCheckDriverDispatchPerformance (
+  VOID
+  )
+{
+  EFI_ACPI_5_0_FPDT_BOOT_PERFORMANCE_TABLE_HEADER  *Fbpt;
+  EFI_ACPI_5_0_FPDT_PERFORMANCE_RECORD_HEADER      *Record;
+  FPDT_GUID_EVENT_RECORD                           *EventRecord;
+  TEST_POINT_DRIVER_START                          *DriverStart;
+  UINTN                                            DriverStartCount;
+  TEST_POINT_DRIVER_DURATION                       Slowest[TEST_POINT_SLOWEST_DRIVER_COUNT];
+  UINT32                                           OverBudgetCount;
+  UINT32                                           Budget;
+  UINT64                                           Duration;
+  UINTN                                            Index;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckDriverDispatchPerformance - Enter\n"));
+
+  Fbpt = TestPointGetBootPerformanceTable ();
+  if (Fbpt == NULL) {
+    DEBUG ((DEBUG_ERROR, "No boot performance table\n"));
+    TestPointLibAppendErrorString (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET_ERROR_CODE \
+        TEST_POINT_READY_TO_BOOT \
+        TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET_ERROR_STRING
+      );
+    return EFI_NOT_FOUND;
+  }
+
+  DriverStartCount = 0;
+  for (Record = TestPointGetNextPerformanceRecord (Fbpt, NULL);
+       Record != NULL;
+       Record = TestPointGetNextPerformanceRecord (Fbpt, Record)) {
+    if (TestPointIsEventRecord (Record) &&
+        (((FPDT_GUID_EVENT_RECORD *) Record)->ProgressID == MODULE_START_ID)) {
+      DriverStartCount++;
+    }
+  }
+  if (DriverStartCount == 0) {
+    DEBUG ((DEBUG_INFO, "No driver dispatch record\n"));
+    DEBUG ((DEBUG_INFO, "==== TestPointCheckDriverDispatchPerformance - Exit\n"));
+    return EFI_SUCCESS;
+  }
+
+  DriverStart = AllocateZeroPool (DriverStartCount * sizeof (*DriverStart));
+  if (DriverStart == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Match every module end record with the latest unmatched start record of
+  // the same module.
+  //
+  ZeroMem (Slowest, sizeof (Slowest));
+  Budget           = PcdGet32 (PcdTestPointDriverDispatchBudget);
+  OverBudgetCount  = 0;
+  DriverStartCount = 0;
+  for (Record = TestPointGetNextPerformanceRecord (Fbpt, NULL);
+       Record != NULL;
+       Record = TestPointGetNextPerformanceRecord (Fbpt, Record)) {
+    if (!TestPointIsEventRecord (Record)) {
+      continue;
+    }
+    EventRecord = (FPDT_GUID_EVENT_RECORD *) Record;
+    if (EventRecord->ProgressID == MODULE_START_ID) {
+      CopyGuid (&DriverStart[DriverStartCount].Guid, &EventRecord->Guid);
+      DriverStart[DriverStartCount].Start = EventRecord->Timestamp;
+      DriverStartCount++;
+    } else if (EventRecord->ProgressID == MODULE_END_ID) {
+      for (Index = DriverStartCount; Index > 0; Index--) {
+        if (!DriverStart[Index - 1].Ended && CompareGuid (&DriverStart[Index - 1].Guid, &EventRecord->Guid)) {
+          break;
+        }
+      }
+      if ((Index == 0) || (EventRecord->Timestamp < DriverStart[Index - 1].Start)) {
+        continue;
+      }
+      DriverStart[Index - 1].Ended = TRUE;
+      Duration = DivU64x32 (EventRecord->Timestamp - DriverStart[Index - 1].Start, 1000);
+      TestPointRecordSlowDriver (Slowest, &EventRecord->Guid, Duration);
+      if ((Budget != 0) && (Duration > Budget)) {
+        DEBUG ((DEBUG_ERROR, "Driver %g dispatch %ldus over budget\n", &EventRecord->Guid, Duration));
+        OverBudgetCount++;
+      }
+    }
+  }
+  FreePool (DriverStart);
+
+  DEBUG ((DEBUG_INFO, "Slowest drivers (budget %dus):\n", Budget));
+  for (Index = 0; Index < TEST_POINT_SLOWEST_DRIVER_COUNT; Index++) {
+    if (Slowest[Index].Duration == 0) {
+      break;
+    }
+    DEBUG ((DEBUG_INFO, "  %g %12ldus\n", &Slowest[Index].Guid, Slowest[Index].Duration));
+  }
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckDriverDispatchPerformance - Exit\n"));
+
+  if (OverBudgetCount != 0) {
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET_ERROR_CODE,
+      L"%d driver(s) over budget %dus, slowest %g %ldus",
+      OverBudgetCount,
+      Budget,
+      &Slowest[0].Guid,
+      Slowest[0].Duration
+      );
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Check the growth of the HOB list and UEFI memory map over the baseline
+  recorded on the first boot. The baseline is recorded when it is missing.
+
+  @param[in]  HobListSize      The current HOB list size.
+  @param[in]  DescriptorCount  The current UEFI memory map descriptor count.
+
+  @retval EFI_SUCCESS            The growth is within budget, or the baseline is recorded.
+  @retval EFI_INVALID_PARAMETER  The growth is over budget.
+**/
+EFI_STATUS
+TestPointCheckHobAndMemoryMapGrowth (
+  IN UINTN  HobListSize,
+  IN UINTN  DescriptorCount
+  )
+{
+  TEST_POINT_HOB_AND_MEMORY_MAP_BASELINE  Baseline;
+  UINTN                                   Size;
+  UINT64                                  HobListGrowth;
+  UINT64                                  DescriptorGrowth;
+  EFI_STATUS                              Status;
+
+  Size = sizeof (Baseline);
+  Status = gRT->GetVariable (
+                  TEST_POINT_HOB_AND_MEMORY_MAP_BASELINE_NAME,
+                  &gAdapterInfoPlatformTestPointGuid,
+                  NULL,
+                  &Size,
+                  &Baseline
+                  );
+  if (EFI_ERROR (Status) || (Size != sizeof (Baseline))) {
+    Baseline.HobListSize     = HobListSize;
+    Baseline.DescriptorCount = DescriptorCount;
+    Status = gRT->SetVariable (
+                    TEST_POINT_HOB_AND_MEMORY_MAP_BASELINE_NAME,
+                    &gAdapterInfoPlatformTestPointGuid,
+                    EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+                    sizeof (Baseline),
+                    &Baseline
+                    );
+    DEBUG ((DEBUG_INFO, "Record HOB list and memory map baseline - %r\n", Status));
+    return EFI_SUCCESS;
+  }
+
+  HobListGrowth    = (HobListSize > Baseline.HobListSize) ? HobListSize - Baseline.HobListSize : 0;
+  DescriptorGrowth = (DescriptorCount > Baseline.DescriptorCount) ? DescriptorCount - Baseline.DescriptorCount : 0;
+
+  DEBUG ((DEBUG_INFO, "HOB list growth        - 0x%lx over 0x%lx (budget 0x%x)\n", HobListGrowth, Baseline.HobListSize, PcdGet32 (PcdTestPointHobListGrowthBudget)));
+  DEBUG ((DEBUG_INFO, "Memory map growth      - %ld over %ld (budget %d)\n", DescriptorGrowth, Baseline.DescriptorCount, PcdGet32 (PcdTestPointMemoryMapGrowthBudget)));
+
+  Status = EFI_SUCCESS;
+  if ((PcdGet32 (PcdTestPointHobListGrowthBudget) != 0) && (HobListGrowth > PcdGet32 (PcdTestPointHobListGrowthBudget))) {
+    DEBUG ((DEBUG_ERROR, "HOB list growth over budget\n"));
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_CODE,
+      L"HOB list grew 0x%lx bytes over budget 0x%x",
+      HobListGrowth,
+      PcdGet32 (PcdTestPointHobListGrowthBudget)
+      );
+    Status = EFI_INVALID_PARAMETER;
+  }
+  if ((PcdGet32 (PcdTestPointMemoryMapGrowthBudget) != 0) && (DescriptorGrowth > PcdGet32 (PcdTestPointMemoryMapGrowthBudget))) {
+    DEBUG ((DEBUG_ERROR, "Memory map growth over budget\n"));
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_CODE,
+      L"Memory map grew %ld descriptors over budget %d",
+      DescriptorGrowth,
+      PcdGet32 (PcdTestPointMemoryMapGrowthBudget)
+      );
+    Status = EFI_INVALID_PARAMETER;
+  }
+
+  return Status;
+}
+
+EFI_STATUS
+TestPointCheckHobAndMemoryMapSize (
+  VOID
+  )
+{
+  EFI_PEI_HOB_POINTERS  Hob;
+  UINTN                 HobListSize;
+  UINTN                 MemoryMapSize;
+  UINTN                 MapKey;
+  UINTN                 DescriptorSize;
+  UINT32                DescriptorVersion;
+  UINTN                 DescriptorCount;
+  EFI_STATUS            Status;
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckHobAndMemoryMapSize - Enter\n"));
+
+  Hob.Raw = GetHobList ();
+  while (!END_OF_HOB_LIST (Hob)) {
+    Hob.Raw = GET_NEXT_HOB (Hob);
+  }
+  HobListSize = (UINTN) Hob.Raw + sizeof (EFI_HOB_GENERIC_HEADER) - (UINTN) GetHobList ();
+
+  MemoryMapSize = 0;
+  DescriptorSize = 0;
+  Status = gBS->GetMemoryMap (&MemoryMapSize, NULL, &MapKey, &DescriptorSize, &DescriptorVersion);
+  if ((Status != EFI_BUFFER_TOO_SMALL) || (DescriptorSize == 0)) {
+    DEBUG ((DEBUG_ERROR, "GetMemoryMap - %r\n", Status));
+    DEBUG ((DEBUG_INFO, "==== TestPointCheckHobAndMemoryMapSize - Exit\n"));
+    return EFI_NOT_FOUND;
+  }
+  DescriptorCount = MemoryMapSize / DescriptorSize;
+
+  DEBUG ((DEBUG_INFO, "HOB list size          - 0x%lx (budget 0x%x)\n", (UINT64) HobListSize, PcdGet32 (PcdTestPointHobListSizeBudget)));
+  DEBUG ((DEBUG_INFO, "Memory map descriptors - %ld (budget %d)\n", (UINT64) DescriptorCount, PcdGet32 (PcdTestPointMemoryMapDescriptorBudget)));
+
+  Status = EFI_SUCCESS;
+  if ((PcdGet32 (PcdTestPointHobListSizeBudget) != 0) && (HobListSize > PcdGet32 (PcdTestPointHobListSizeBudget))) {
+    DEBUG ((DEBUG_ERROR, "HOB list over budget\n"));
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_CODE,
+      L"HOB list 0x%lx bytes over budget 0x%x",
+      (UINT64) HobListSize,
+      PcdGet32 (PcdTestPointHobListSizeBudget)
+      );
+    Status = EFI_INVALID_PARAMETER;
+  }
+  if ((PcdGet32 (PcdTestPointMemoryMapDescriptorBudget) != 0) && (DescriptorCount > PcdGet32 (PcdTestPointMemoryMapDescriptorBudget))) {
+    DEBUG ((DEBUG_ERROR, "Memory map over budget\n"));
+    TestPointAppendPerformanceErrorString (
+      TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET_ERROR_CODE,
+      L"Memory map %ld descriptors over budget %d",
+      (UINT64) DescriptorCount,
+      PcdGet32 (PcdTestPointMemoryMapDescriptorBudget)
+      );
+    Status = EFI_INVALID_PARAMETER;
+  }
+  if (EFI_ERROR (TestPointCheckHobAndMemoryMapGrowth (HobListSize, DescriptorCount))) {
+    Status = EFI_INVALID_PARAMETER;
+  }
+
+  DEBUG ((DEBUG_INFO, "==== TestPointCheckHobAndMemoryMapSize - Exit\n"));
+  return Status;
+}
@@ -142,6 +142,21 @@ TestPointCheckTcgMor (
   VOID
   );
 
+EFI_STATUS
+TestPointCheckBootPhasePerformance (
+  VOID
+  );
+
+EFI_STATUS
+TestPointCheckDriverDispatchPerformance (
+  VOID
+  );
+
+EFI_STATUS
+TestPointCheckHobAndMemoryMapSize (
+  VOID
+  );
+
 EFI_STATUS
 TestPointVtdEngine (
   VOID
@@ -1049,6 +1064,144 @@ TestPointReadyToBootEsrtTableFunctional (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies the boot phase durations are within budget.
+
+  Test subject: Boot performance.
+  Test overview: Verify the SEC, memory init, DXE and BDS phases and the whole
+                 boot up to Ready To Boot take no longer than their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the boot phase durations.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootBootPhaseWithinBudget (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Result;
+
+  if ((mFeatureImplemented[9] & TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootBootPhaseWithinBudget - Enter\n"));
+
+  Result = TRUE;
+  Status = TestPointCheckBootPhasePerformance ();
+  if (EFI_ERROR(Status)) {
+    Result = FALSE;
+  }
+
+  if (Result) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      9,
+      TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET
+      );
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootBootPhaseWithinBudget - Exit\n"));
+  return EFI_SUCCESS;
+}
+
+/**
+  This service verifies the driver dispatch durations are within budget.
+
+  Test subject: Driver dispatch performance.
+  Test overview: Verify no PEIM or DXE driver entry point takes longer than
+                 PcdTestPointDriverDispatchBudget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the slowest drivers.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootDriverDispatchWithinBudget (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Result;
+
+  if ((mFeatureImplemented[9] & TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootDriverDispatchWithinBudget - Enter\n"));
+
+  Result = TRUE;
+  Status = TestPointCheckDriverDispatchPerformance ();
+  if (EFI_ERROR(Status)) {
+    Result = FALSE;
+  }
+
+  if (Result) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      9,
+      TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET
+      );
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootDriverDispatchWithinBudget - Exit\n"));
+  return EFI_SUCCESS;
+}
+
+/**
+  This service verifies the HOB list and UEFI memory map sizes are within budget.
+
+  Test subject: HOB list and UEFI memory map.
+  Test overview: Verify the HOB list size and the number of UEFI memory map
+                 descriptors do not exceed their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the HOB list and UEFI memory map sizes.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootHobAndMemoryMapWithinBudget (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Result;
+
+  if ((mFeatureImplemented[9] & TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET) == 0) {
+    return EFI_SUCCESS;
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootHobAndMemoryMapWithinBudget - Enter\n"));
+
+  Result = TRUE;
+  Status = TestPointCheckHobAndMemoryMapSize ();
+  if (EFI_ERROR(Status)) {
+    Result = FALSE;
+  }
+
+  if (Result) {
+    TestPointLibSetFeaturesVerified (
+      PLATFORM_TEST_POINT_ROLE_PLATFORM_IBV,
+      NULL,
+      9,
+      TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET
+      );
+  }
+
+  DEBUG ((DEBUG_INFO, "======== TestPointReadyToBootHobAndMemoryMapWithinBudget - Exit\n"));
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
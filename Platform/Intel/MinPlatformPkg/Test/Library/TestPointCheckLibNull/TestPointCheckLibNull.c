@@ -516,6 +516,69 @@ TestPointReadyToBootEsrtTableFunctional (
   return EFI_SUCCESS;
 }
 
+/**
+  This service verifies the boot phase durations are within budget.
+
+  Test subject: Boot performance.
+  Test overview: Verify the SEC, memory init, DXE and BDS phases and the whole
+                 boot up to Ready To Boot take no longer than their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the boot phase durations.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootBootPhaseWithinBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  This service verifies the driver dispatch durations are within budget.
+
+  Test subject: Driver dispatch performance.
+  Test overview: Verify no PEIM or DXE driver entry point takes longer than
+                 PcdTestPointDriverDispatchBudget.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the slowest drivers.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootDriverDispatchWithinBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
+/**
+  This service verifies the HOB list and UEFI memory map sizes are within budget.
+
+  Test subject: HOB list and UEFI memory map.
+  Test overview: Verify the HOB list size and the number of UEFI memory map
+                 descriptors do not exceed their budget PCDs.
+  Reporting mechanism: Set ADAPTER_INFO_PLATFORM_TEST_POINT_STRUCT.
+                       Dumps the HOB list and UEFI memory map sizes.
+
+  @retval EFI_SUCCESS         The test point check was performed successfully.
+  @retval EFI_UNSUPPORTED     The test point check is not supported on this platform.
+**/
+EFI_STATUS
+EFIAPI
+TestPointReadyToBootHobAndMemoryMapWithinBudget (
+  VOID
+  )
+{
+  return EFI_SUCCESS;
+}
+
 /**
   This service verifies UEFI Secure Boot is enabled.
 
@@ -13,8 +13,61 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/UefiLib.h>
 #include <Library/TestPointLib.h>
+#include <Library/TestPointCheckLib.h>
 #include <Protocol/AdapterInformation.h>
 
+#define TEST_POINT_PERFORMANCE_BYTE  9
+
+typedef struct {
+  UINT8   BitMask;
+  CHAR16  *Name;
+} TEST_POINT_FEATURE_NAME;
+
+GLOBAL_REMOVE_IF_UNREFERENCED TEST_POINT_FEATURE_NAME  mPerformanceFeatureName[] = {
+  {TEST_POINT_BYTE9_READY_TO_BOOT_BOOT_PHASE_WITHIN_BUDGET,         L"Boot Phase Budget"},
+  {TEST_POINT_BYTE9_READY_TO_BOOT_DRIVER_DISPATCH_WITHIN_BUDGET,    L"Driver Dispatch Budget"},
+  {TEST_POINT_BYTE9_READY_TO_BOOT_HOB_AND_MEMORY_MAP_WITHIN_BUDGET, L"HOB And Memory Map Budget"},
+};
+
+/**
+  Dump the result of the implemented performance test points of the
+  MinPlatform DXE test point table.
+
+  @param[in]  TestPoint  The test point table.
+**/
+VOID
+DumpTestPointPerformance (
+  IN ADAPTER_INFO_PLATFORM_TEST_POINT  *TestPoint
+  )
+{
+  UINT8  *FeaturesImplemented;
+  UINT8  *FeaturesVerified;
+  UINTN  Index;
+
+  if ((StrCmp (TestPoint->ImplementationID, TEST_POINT_IMPLEMENTATION_ID_PLATFORM_DXE) != 0) ||
+      (TestPoint->FeaturesSize <= TEST_POINT_PERFORMANCE_BYTE)) {
+    return;
+  }
+
+  FeaturesImplemented = (UINT8 *)(TestPoint + 1);
+  FeaturesVerified    = FeaturesImplemented + TestPoint->FeaturesSize;
+  if (FeaturesImplemented[TEST_POINT_PERFORMANCE_BYTE] == 0) {
+    return;
+  }
+
+  Print (L"  Performance\n");
+  for (Index = 0; Index < ARRAY_SIZE (mPerformanceFeatureName); Index++) {
+    if ((FeaturesImplemented[TEST_POINT_PERFORMANCE_BYTE] & mPerformanceFeatureName[Index].BitMask) == 0) {
+      continue;
+    }
+    Print (
+      L"    %-26s - %s\n",
+      mPerformanceFeatureName[Index].Name,
+      ((FeaturesVerified[TEST_POINT_PERFORMANCE_BYTE] & mPerformanceFeatureName[Index].BitMask) != 0) ? L"PASS" : L"FAIL"
+      );
+  }
+}
+
 VOID
 DumpTestPoint (
   IN VOID                     *TestPointData
@@ -62,6 +115,8 @@ DumpTestPoint (
     CopyMem (&ErrorChar, ErrorString, sizeof(ErrorChar));
   }
   Print (L"\"\n");
+
+  DumpTestPointPerformance (TestPoint);
 }
 
 VOID
@@ -0,0 +1,349 @@
+/** @file
+  Host based unit tests of CompressLib.
+
+  Every compression level compresses a set of inputs, and the output is
+  decompressed with the standard UEFI decompressor and compared with the
+  input.
+
+  Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/DebugLib.h>
+#include <Library/PrintLib.h>
+#include <Library/UnitTestLib.h>
+#include <Library/CompressLib.h>
+#include <Library/UefiDecompressLib.h>
+
+#define UNIT_TEST_APP_NAME     "CompressLib Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+//
+// Size of the sliding window of the compressor, inputs larger than this
+// exercise the window slide.
+//
+#define COMPRESS_WINDOW_SIZE   (1U << 13)
+
+typedef enum {
+  InputPatternText,     // Repeated text with small variations, compressible
+  InputPatternRandom,   // Pseudo random bytes, incompressible
+  InputPatternZero      // Zero filled, longest matches
+} INPUT_PATTERN;
+
+typedef struct {
+  UINT32           Size;
+  INPUT_PATTERN    Pattern;
+} ROUND_TRIP_INPUT;
+
+typedef struct {
+  COMPRESS_LEVEL            Level;      // CompressLevelMax for Compress()
+  CONST ROUND_TRIP_INPUT    *Input;
+} ROUND_TRIP_CONTEXT;
+
+STATIC CONST CHAR8  *mLevelName[CompressLevelMax + 1] = {
+  "Default",
+  "Fast",
+  "Best",
+  "Compress"
+};
+
+STATIC CONST ROUND_TRIP_INPUT  mInputs[] = {
+  { 0,                            InputPatternText   },
+  { 1,                            InputPatternText   },
+  { 1,                            InputPatternRandom },
+  { 0x1000,                       InputPatternRandom },
+  { 0x1000,                       InputPatternText   },
+  { COMPRESS_WINDOW_SIZE,         InputPatternText   },
+  { COMPRESS_WINDOW_SIZE * 5 + 7, InputPatternText   },
+  { COMPRESS_WINDOW_SIZE * 5 + 7, InputPatternRandom },
+  { COMPRESS_WINDOW_SIZE * 8,     InputPatternZero   }
+};
+
+STATIC CONST CHAR8  *mInputName[] = {
+  "Text",
+  "Random",
+  "Zero"
+};
+
+STATIC CONST CHAR8  mText[] =
+  "The compression algorithm is a mixture of LZ77 and Huffman coding. ";
+
+STATIC ROUND_TRIP_CONTEXT  mContext[ARRAY_SIZE (mInputs) * (CompressLevelMax + 1)];
+STATIC CHAR8               mDescription[ARRAY_SIZE (mContext)][64];
+
+/**
+  Fill a buffer with the input pattern.
+
+  @param[out] Buffer    The buffer to fill.
+  @param[in]  Input     The input to generate.
+**/
+STATIC
+VOID
+FillInput (
+  OUT UINT8                   *Buffer,
+  IN  CONST ROUND_TRIP_INPUT  *Input
+  )
+{
+  UINT32  Index;
+  UINT32  Seed;
+
+  Seed = 0x12345678;
+  for (Index = 0; Index < Input->Size; Index++) {
+    Seed = Seed * 1103515245 + 12345;
+    switch (Input->Pattern) {
+      case InputPatternText:
+        Buffer[Index] = mText[Index % (sizeof (mText) - 1)];
+        if ((Seed >> 16) % 61 == 0) {
+          Buffer[Index] = (UINT8)(Seed >> 24);
+        }
+        break;
+
+      case InputPatternRandom:
+        Buffer[Index] = (UINT8)(Seed >> 24);
+        break;
+
+      default:
+        Buffer[Index] = 0;
+        break;
+    }
+  }
+}
+
+/**
+  Compress the input, decompress the result and compare it with the input.
+
+  The size of the compressed data is first queried with an empty destination
+  buffer, then the input is compressed into a buffer of exactly that size.
+
+  @param[in]  Context    ROUND_TRIP_CONTEXT of the test.
+
+  @retval UNIT_TEST_PASSED               The data survived the round trip.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    A step of the round trip failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+RoundTripTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  ROUND_TRIP_CONTEXT  *RoundTrip;
+  EFI_STATUS          Status;
+  UINT8               *Source;
+  UINT8               *Compressed;
+  UINT8               *Decompressed;
+  UINT8               *Scratch;
+  UINT64              CompressedSize;
+  UINT32              DecompressedSize;
+  UINT32              ScratchSize;
+
+  RoundTrip = (ROUND_TRIP_CONTEXT *)Context;
+
+  //
+  // One extra byte so that empty inputs still get a buffer
+  //
+  Source = AllocatePool (RoundTrip->Input->Size + 1);
+  UT_ASSERT_NOT_NULL (Source);
+  FillInput (Source, RoundTrip->Input);
+
+  CompressedSize = 0;
+  if (RoundTrip->Level == CompressLevelMax) {
+    Status = Compress (Source, RoundTrip->Input->Size, NULL, &CompressedSize);
+  } else {
+    Status = CompressEx (Source, RoundTrip->Input->Size, NULL, &CompressedSize, RoundTrip->Level);
+  }
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_BUFFER_TOO_SMALL);
+  UT_ASSERT_TRUE (CompressedSize >= 8);
+
+  Compressed = AllocatePool ((UINTN)CompressedSize);
+  UT_ASSERT_NOT_NULL (Compressed);
+  if (RoundTrip->Level == CompressLevelMax) {
+    Status = Compress (Source, RoundTrip->Input->Size, Compressed, &CompressedSize);
+  } else {
+    Status = CompressEx (Source, RoundTrip->Input->Size, Compressed, &CompressedSize, RoundTrip->Level);
+  }
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  Status = UefiDecompressGetInfo (Compressed, (UINT32)CompressedSize, &DecompressedSize, &ScratchSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (DecompressedSize, RoundTrip->Input->Size);
+
+  Decompressed = AllocatePool (DecompressedSize + 1);
+  Scratch      = AllocatePool (ScratchSize);
+  UT_ASSERT_NOT_NULL (Decompressed);
+  UT_ASSERT_NOT_NULL (Scratch);
+  Status = UefiDecompress (Compressed, Decompressed, Scratch);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_MEM_EQUAL (Decompressed, Source, DecompressedSize);
+
+  FreePool (Scratch);
+  FreePool (Decompressed);
+  FreePool (Compressed);
+  FreePool (Source);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Check that CompressEx() rejects invalid levels, and that the default level
+  produces the same output as Compress() while keeping its scratch buffers.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED               The checks passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED    A check failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+DefaultLevelTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  STATIC CONST ROUND_TRIP_INPUT  Input = { COMPRESS_WINDOW_SIZE * 3, InputPatternText };
+  EFI_STATUS                     Status;
+  UINT8                          *Source;
+  UINT8                          *Compressed;
+  UINT8                          *CompressedEx;
+  UINT64                         CompressedSize;
+  UINT64                         CompressedExSize;
+
+  Source       = AllocatePool (Input.Size);
+  Compressed   = AllocatePool (Input.Size * 2);
+  CompressedEx = AllocatePool (Input.Size * 2);
+  UT_ASSERT_NOT_NULL (Source);
+  UT_ASSERT_NOT_NULL (Compressed);
+  UT_ASSERT_NOT_NULL (CompressedEx);
+  FillInput (Source, &Input);
+
+  CompressedExSize = Input.Size * 2;
+  Status           = CompressEx (Source, Input.Size, CompressedEx, &CompressedExSize, CompressLevelMax);
+  UT_ASSERT_STATUS_EQUAL (Status, EFI_INVALID_PARAMETER);
+
+  //
+  // A second call reuses the scratch buffers of the first one
+  //
+  Status = CompressEx (Source, Input.Size, CompressedEx, &CompressedExSize, CompressLevelDefault);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  CompressedExSize = Input.Size * 2;
+  Status           = CompressEx (Source, Input.Size, CompressedEx, &CompressedExSize, CompressLevelDefault);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+
+  CompressedSize = Input.Size * 2;
+  Status         = Compress (Source, Input.Size, Compressed, &CompressedSize);
+  UT_ASSERT_NOT_EFI_ERROR (Status);
+  UT_ASSERT_EQUAL (CompressedSize, CompressedExSize);
+  UT_ASSERT_MEM_EQUAL (Compressed, CompressedEx, (UINTN)CompressedSize);
+
+  FreePool (CompressedEx);
+  FreePool (Compressed);
+  FreePool (Source);
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Free the scratch buffers kept by CompressEx() after each test.
+
+  @param[in]  Context    Unused.
+**/
+STATIC
+VOID
+EFIAPI
+FreeScratch (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CompressFreeScratch ();
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for CompressLib
+  and run them.
+
+  @retval EFI_SUCCESS           All test cases were dispatched.
+  @retval EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      RoundTripSuite;
+  UNIT_TEST_SUITE_HANDLE      LevelSuite;
+  UINTN                       Level;
+  UINTN                       Index;
+  UINTN                       Test;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&RoundTripSuite, Framework, "Compress Round Trip Tests", "MinPlatformPkg.CompressLib.RoundTrip", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for round trip tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  Test = 0;
+  for (Level = 0; Level <= CompressLevelMax; Level++) {
+    for (Index = 0; Index < ARRAY_SIZE (mInputs); Index++, Test++) {
+      mContext[Test].Level = (COMPRESS_LEVEL)Level;
+      mContext[Test].Input = &mInputs[Index];
+      AsciiSPrint (
+        mDescription[Test],
+        sizeof (mDescription[Test]),
+        "%a, %a input of %d bytes",
+        mLevelName[Level],
+        mInputName[mInputs[Index].Pattern],
+        mInputs[Index].Size
+        );
+      AddTestCase (RoundTripSuite, mDescription[Test], "RoundTrip", RoundTripTest, NULL, FreeScratch, &mContext[Test]);
+    }
+  }
+
+  Status = CreateUnitTestSuite (&LevelSuite, Framework, "Compress Level Tests", "MinPlatformPkg.CompressLib.Level", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for level tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (LevelSuite, "Default level matches Compress()", "DefaultLevel", DefaultLevelTest, NULL, FreeScratch, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
@@ -240,19 +240,23 @@ PostInstallMemory (
 
   Do memory initialisation for QNC DDR3 SDRAM Controller
 
-  @param  FfsHeader    Not used.
+  The memory test is left running when MRC returns, MemoryInitComplete()
+  has to be called before the memory is used. Work that does not access
+  memory can be done in between.
+
   @param  PeiServices  General purpose services available to every PEIM.
+  @param  MrcData      MRC configuration and results, passed to MemoryInitComplete().
 
-  @return EFI_SUCCESS  Memory initialisation completed successfully.
+  @return EFI_SUCCESS  Memory initialisation started successfully.
           All other error conditions encountered result in an ASSERT.
 
 **/
 EFI_STATUS
 MemoryInit (
-  IN EFI_PEI_SERVICES          **PeiServices
+  IN  EFI_PEI_SERVICES         **PeiServices,
+  OUT MRC_PARAMS               *MrcData
   )
 {
-  MRC_PARAMS                                 MrcData;
   EFI_BOOT_MODE                               BootMode;
   EFI_STATUS                                  Status;
   EFI_PEI_READ_ONLY_VARIABLE2_PPI             *VariableServices;
@@ -270,7 +274,7 @@ MemoryInit (
   // properly initialized.  By initializing these to zero, all flags indicating
   // that the SPD is present or the row should be configured are set to false.
   //
-  ZeroMem (&MrcData, sizeof(MrcData));
+  ZeroMem (MrcData, sizeof(*MrcData));
 
   //
   // Get necessary PPI
@@ -310,31 +314,31 @@ MemoryInit (
   switch (BootMode) {
   case BOOT_ON_S3_RESUME:
   case BOOT_ON_FLASH_UPDATE:
-    MrcData.boot_mode = bmS3;
+    MrcData->boot_mode = bmS3;
     break;
   case BOOT_ASSUMING_NO_CONFIGURATION_CHANGES:
-    MrcData.boot_mode = bmFast;
+    MrcData->boot_mode = bmFast;
     break;
   default:
-    MrcData.boot_mode = bmCold;
+    MrcData->boot_mode = bmCold;
     break;
   }
 
   //
   // Configure MRC input parameters.
   //
-  Status = MrcConfigureFromMcFuses (&MrcData);
+  Status = MrcConfigureFromMcFuses (MrcData);
   ASSERT_EFI_ERROR (Status);
-  Status = MrcConfigureFromInfoHob (&MrcData);
+  Status = MrcConfigureFromInfoHob (MrcData);
   ASSERT_EFI_ERROR (Status);
-  MrcUartConfig(&MrcData);
+  MrcUartConfig(MrcData);
 
   if (BootMode == BOOT_IN_RECOVERY_MODE) {
     //
     // Always do bmCold on recovery.
     //
     DEBUG ((DEBUG_INFO, "MemoryInit:Force bmCold on Recovery\n"));
-    MrcData.boot_mode = bmCold;
+    MrcData->boot_mode = bmCold;
   } else {
 
     //
@@ -343,7 +347,7 @@ MemoryInit (
     Status = LoadConfig (
                PeiServices,
                VariableServices,
-               &MrcData
+               MrcData
                );
 
     if (EFI_ERROR (Status)) {
@@ -359,7 +363,7 @@ MemoryInit (
         break;
 
       default:
-        MrcData.boot_mode = bmCold;
+        MrcData->boot_mode = bmCold;
         break;
       }
     }
@@ -379,30 +383,102 @@ MemoryInit (
   PmswAdr = (UINT16)(LpcPciCfg32 (R_QNC_LPC_GPE0BLK) & 0xFFFF) + R_QNC_GPE0BLK_PMSW;
   if( IoRead32 (PmswAdr) & B_QNC_GPE0BLK_PMSW_DRAM_INIT) {
     // MRC did not complete last execution, force cold boot path
-    MrcData.boot_mode = bmCold;
+    MrcData->boot_mode = bmCold;
   }
 
   // Mark MRC pending
   IoOr32 (PmswAdr, (UINT32)B_QNC_GPE0BLK_PMSW_DRAM_INIT);
 
   //
-  // Call Memory Reference Code's Routines
+  // Call Memory Reference Code's Routines, the memory test completes
+  // in MemoryInitComplete()
+  //
+  MrcData->async_mem_init = 1;
+  QncMemoryInitPpi->MrcStart (MrcData);
+
+  return EFI_SUCCESS;
+}
+
+/**
+
+  Complete memory initialisation started by MemoryInit(), install the
+  memory and save the MRC configuration.
+
+  @param  PeiServices  General purpose services available to every PEIM.
+  @param  MrcData      MRC configuration and results from MemoryInit().
+
+  @return EFI_SUCCESS  Memory initialisation completed successfully.
+          All other error conditions encountered result in an ASSERT.
+
+**/
+EFI_STATUS
+MemoryInitComplete (
+  IN     EFI_PEI_SERVICES      **PeiServices,
+  IN OUT MRC_PARAMS            *MrcData
+  )
+{
+  EFI_BOOT_MODE                               BootMode;
+  EFI_STATUS                                  Status;
+  EFI_PEI_READ_ONLY_VARIABLE2_PPI             *VariableServices;
+  EFI_STATUS_CODE_VALUE                       ErrorCodeValue;
+  PEI_QNC_MEMORY_INIT_PPI                     *QncMemoryInitPpi;
+  UINT16                                      PmswAdr;
+
+  Status = PeiServicesLocatePpi (
+             &gEfiPeiReadOnlyVariable2PpiGuid,           // GUID
+             0,                                          // INSTANCE
+             NULL,                                       // EFI_PEI_PPI_DESCRIPTOR
+             (VOID **)&VariableServices                  // PPI
+             );
+  ASSERT_EFI_ERROR (Status);
+
+  Status = PeiServicesGetBootMode (&BootMode);
+  ASSERT_EFI_ERROR (Status);
+
+  if (BootMode == BOOT_ON_S3_RESUME) {
+    ErrorCodeValue = EFI_COMPUTING_UNIT_MEMORY + EFI_CU_MEMORY_EC_S3_RESUME_FAIL;
+  } else {
+    ErrorCodeValue = EFI_COMPUTING_UNIT_MEMORY;
+  }
+
+  Status = PeiServicesLocatePpi (
+             &gQNCMemoryInitPpiGuid,        // GUID
+             0,                             // INSTANCE
+             NULL,                          // EFI_PEI_PPI_DESCRIPTOR
+             (VOID **)&QncMemoryInitPpi     // PPI
+             );
+  ASSERT_EFI_ERROR (Status);
+
+  //
+  // Wait for the memory test left running by MrcStart()
   //
-  QncMemoryInitPpi->MrcStart (&MrcData);
+  QncMemoryInitPpi->MrcComplete (MrcData);
 
-  // Mark MRC completed
-  IoAnd32 (PmswAdr, ~(UINT32)B_QNC_GPE0BLK_PMSW_DRAM_INIT);
+  PmswAdr = (UINT16)(LpcPciCfg32 (R_QNC_LPC_GPE0BLK) & 0xFFFF) + R_QNC_GPE0BLK_PMSW;
+  if (MrcData->status != MRC_SUCCESS) {
+    //
+    // Leave MRC marked pending so the next boot retrains on the cold path
+    //
+    DEBUG ((EFI_D_ERROR, "MemoryInit: MRC status %d\n", MrcData->status));
+    REPORT_STATUS_CODE (
+      EFI_ERROR_CODE + EFI_ERROR_MAJOR,
+      EFI_COMPUTING_UNIT_MEMORY + EFI_CU_MEMORY_EC_UNCORRECTABLE
+      );
+  } else {
+    // Mark MRC completed
+    IoAnd32 (PmswAdr, ~(UINT32)B_QNC_GPE0BLK_PMSW_DRAM_INIT);
+  }
 
 
   //
   // Note emulation platform has to read actual memory size
-  // MrcData.mem_size from PcdGet32 (PcdMemorySize);
+  // MrcData->mem_size from PcdGet32 (PcdMemorySize);
 
   if (BootMode == BOOT_ON_S3_RESUME) {
 
     DEBUG ((EFI_D_INFO, "Following BOOT_ON_S3_RESUME boot path.\n"));
 
-    Status = InstallS3Memory (PeiServices, VariableServices, MrcData.mem_size);
+    Status = InstallS3Memory (PeiServices, VariableServices, MrcData->mem_size);
     if (EFI_ERROR (Status)) {
       REPORT_STATUS_CODE (
         EFI_ERROR_CODE + EFI_ERROR_UNRECOVERED,
@@ -410,7 +486,7 @@ MemoryInit (
       );
       PeiServicesResetSystem ();
     }
-    PostInstallMemory (&MrcData, TRUE);
+    PostInstallMemory (MrcData, TRUE);
     return EFI_SUCCESS;
   }
 
@@ -423,18 +499,18 @@ MemoryInit (
              PeiServices,
              VariableServices,
              BootMode,
-             MrcData.mem_size
+             MrcData->mem_size
              );
   ASSERT_EFI_ERROR (Status);
 
-  PostInstallMemory (&MrcData, FALSE);
+  PostInstallMemory (MrcData, FALSE);
 
   //
   // Save current configuration into Hob and will save into Variable later in DXE
   //
   DEBUG ((EFI_D_INFO, "SaveConfig.\n"));
   Status = SaveConfig (
-             &MrcData
+             MrcData
              );
   ASSERT_EFI_ERROR (Status);
 
@@ -160,7 +160,14 @@ InstallS3Memory (
 
 EFI_STATUS
 MemoryInit (
-  IN EFI_PEI_SERVICES                       **PeiServices
+  IN  EFI_PEI_SERVICES                      **PeiServices,
+  OUT MRC_PARAMS                            *MrcData
+  );
+
+EFI_STATUS
+MemoryInitComplete (
+  IN     EFI_PEI_SERVICES                   **PeiServices,
+  IN OUT MRC_PARAMS                         *MrcData
   );
 
 
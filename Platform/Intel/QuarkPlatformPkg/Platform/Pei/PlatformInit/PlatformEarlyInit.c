@@ -472,6 +472,7 @@ PeiInitPlatform (
   EFI_PEI_PPI_DESCRIPTOR                  *StallPeiPpiDescriptor;
   EFI_FV_FILE_INFO                        FileInfo;
   EFI_PLATFORM_TYPE                       PlatformType;
+  MRC_PARAMS                              MrcData;
 
   PlatformType = (EFI_PLATFORM_TYPE)PcdGet16 (PcdPlatformType);
 
@@ -551,7 +552,11 @@ PeiInitPlatform (
   }
 
   DEBUG ((EFI_D_INFO, "MRC Entry\n"));
-  MemoryInit ((EFI_PEI_SERVICES**)PeiServices);
+  MemoryInit ((EFI_PEI_SERVICES**)PeiServices, &MrcData);
+
+  //
+  // The steps below do not access memory and overlap the MRC memory test
+  //
 
   //
   // Do Early PCIe init.
@@ -569,6 +574,9 @@ PeiInitPlatform (
   DEBUG ((EFI_D_INFO, "EarlyPlatformConfigGpioExpanders ()\n"));
   EarlyPlatformConfigGpioExpanders (PlatformType, BootMode);
 
+  DEBUG ((EFI_D_INFO, "MRC Complete\n"));
+  MemoryInitComplete ((EFI_PEI_SERVICES**)PeiServices, &MrcData);
+
   //
   // Now that all of the pre-permanent memory activities have
   // been taken care of, post a call-back for the permanent-memory
@@ -11,6 +11,8 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef __PLATFORM_EARLY_INIT_H__
 #define __PLATFORM_EARLY_INIT_H__
 
+#include <Ppi/QNCMemoryInit.h>
+
 #define PEI_STALL_RESOLUTION            1
 #define STALL_PEIM_SIGNATURE   SIGNATURE_32('p','p','u','s')
 
@@ -133,20 +135,38 @@ PeimInitializeRecovery (
   IN EFI_PEI_SERVICES     **PeiServices
   );
 
+/**
+  This function calls MRC to initialize memory, the memory test is
+  left running.
+
+  @param  PeiServices Pointer to the PEI Service Table
+  @param  MrcData     MRC configuration and results, passed to MemoryInitComplete().
+
+  @retval EFI_SUCCESS If it completes successfully.
+
+**/
+EFI_STATUS
+MemoryInit (
+  IN  EFI_PEI_SERVICES         **PeiServices,
+  OUT MRC_PARAMS               *MrcData
+  );
+
 /**
   This function
-    1. Calling MRC to initialize memory.
+    1. Waits for the MRC memory test started by MemoryInit().
     2. Install EFI Memory.
     3. Create HOB of system memory.
 
   @param  PeiServices Pointer to the PEI Service Table
+  @param  MrcData     MRC configuration and results from MemoryInit().
 
   @retval EFI_SUCCESS If it completes successfully.
 
 **/
 EFI_STATUS
-MemoryInit (
-  IN EFI_PEI_SERVICES          **PeiServices
+MemoryInitComplete (
+  IN     EFI_PEI_SERVICES      **PeiServices,
+  IN OUT MRC_PARAMS            *MrcData
   );
 
 /** Return info derived from Installing Memory by MemoryInit.
@@ -64,6 +64,13 @@ TCG2_EVENT_INFO_STRUCT mTcg2EventInfo[] = {
 
 #define TCG_EVENT_LOG_AREA_COUNT_MAX   2
 
+//
+// Smallest log entry, the TCG_PCR_EVENT2 header with an empty digest list.
+// Sizing the event index with it means the index cannot fill up before the
+// log area does.
+//
+#define TCG_EVENT_LOG_MIN_EVENT_SIZE   16
+
 typedef struct {
   EFI_TCG2_EVENT_LOG_FORMAT EventLogFormat;
   EFI_PHYSICAL_ADDRESS      Lasa;
@@ -73,6 +80,11 @@ typedef struct {
   BOOLEAN                   EventLogStarted;
   BOOLEAN                   EventLogTruncated;
   UINTN                     Next800155EventOffset;
+  UINTN                     Next800155EventIndex;
+  UINT32                    *EventOffset;       // Offset of each event from Lasa
+  UINTN                     EventCount;
+  UINTN                     EventIndexSize;     // Entries allocated in EventOffset
+  UINTN                     DumpedEventCount;   // Events already printed by DumpEventLog
 } TCG_EVENT_LOG_AREA_STRUCT;
 
 typedef struct _TCG_DXE_DATA {
@@ -474,123 +486,71 @@ DumpEvent2 (
 }
 
 /**
-  This function returns size of TCG PCR event 2.
-
-  @param[in]  TcgPcrEvent2     TCG PCR event 2 structure.
+  This function dump the events of an event log area which have not been
+  dumped yet.
 
-  @return size of TCG PCR event 2.
+  @param[in]      EventLogFormat      The type of the event log.
+  @param[in, out] EventLogAreaStruct  The event log area data structure.
+  @param[in]      HasSpecIdEvent      The first event of the area is the TCG_PCR_EVENT
+                                      carrying TCG_EfiSpecIDEventStruct.
 **/
-UINTN
-GetPcrEvent2Size (
-  IN TCG_PCR_EVENT2 *TcgPcrEvent2
+VOID
+DumpEventLogArea (
+  IN     EFI_TCG2_EVENT_LOG_FORMAT EventLogFormat,
+  IN OUT TCG_EVENT_LOG_AREA_STRUCT *EventLogAreaStruct,
+  IN     BOOLEAN                   HasSpecIdEvent
   )
 {
-  UINT32        DigestIndex;
-  UINT32        DigestCount;
-  TPMI_ALG_HASH HashAlgo;
-  UINT32        DigestSize;
-  UINT8         *DigestBuffer;
-  UINT32        EventSize;
-  UINT8         *EventBuffer;
+  UINTN             Index;
+  TCG_PCR_EVENT_HDR *EventHdr;
 
-  DigestCount = TcgPcrEvent2->Digest.count;
-  HashAlgo = TcgPcrEvent2->Digest.digests[0].hashAlg;
-  DigestBuffer = (UINT8 *)&TcgPcrEvent2->Digest.digests[0].digest;
-  for (DigestIndex = 0; DigestIndex < DigestCount; DigestIndex++) {
-    DigestSize = GetHashSizeFromAlgo (HashAlgo);
-    //
-    // Prepare next
-    //
-    CopyMem (&HashAlgo, DigestBuffer + DigestSize, sizeof (TPMI_ALG_HASH));
-    DigestBuffer = DigestBuffer + DigestSize + sizeof (TPMI_ALG_HASH);
+  for (Index = EventLogAreaStruct->DumpedEventCount; Index < EventLogAreaStruct->EventCount; Index++) {
+    EventHdr = (TCG_PCR_EVENT_HDR *)(UINTN)(EventLogAreaStruct->Lasa + EventLogAreaStruct->EventOffset[Index]);
+    if (EventLogFormat == EFI_TCG2_EVENT_LOG_FORMAT_TCG_1_2) {
+      DumpEvent (EventHdr);
+    } else if (HasSpecIdEvent && (Index == 0)) {
+      DumpEvent (EventHdr);
+      DumpTcgEfiSpecIdEventStruct ((TCG_EfiSpecIDEventStruct *)(EventHdr + 1));
+    } else {
+      DumpEvent2 ((TCG_PCR_EVENT2 *)EventHdr);
+    }
   }
-  DigestBuffer = DigestBuffer - sizeof (TPMI_ALG_HASH);
-
-  CopyMem (&EventSize, DigestBuffer, sizeof (TcgPcrEvent2->EventSize));
-  EventBuffer = DigestBuffer + sizeof (TcgPcrEvent2->EventSize);
 
-  return (UINTN)EventBuffer + EventSize - (UINTN)TcgPcrEvent2;
+  EventLogAreaStruct->DumpedEventCount = EventLogAreaStruct->EventCount;
 }
 
 /**
   This function dump event log.
 
-  @param[in]  EventLogFormat     The type of the event log for which the information is requested.
-  @param[in]  EventLogLocation   A pointer to the memory address of the event log.
-  @param[in]  EventLogLastEntry  If the Event Log contains more than one entry, this is a pointer to the
-                                 address of the start of the last entry in the event log in memory.
-  @param[in]  FinalEventsTable   A pointer to the memory address of the final event table.
+  The events are located through the event index of the log areas, events
+  printed by an earlier call are skipped.
+
+  @param[in]      EventLogFormat           The type of the event log for which the information is requested.
+  @param[in, out] EventLogAreaStruct       The event log area data structure.
+  @param[in, out] FinalEventLogAreaStruct  The final event log area data structure.
+  @param[in]      FinalEventsTable         A pointer to the memory address of the final event table.
 **/
 VOID
 DumpEventLog (
-  IN EFI_TCG2_EVENT_LOG_FORMAT   EventLogFormat,
-  IN EFI_PHYSICAL_ADDRESS        EventLogLocation,
-  IN EFI_PHYSICAL_ADDRESS        EventLogLastEntry,
-  IN EFI_TCG2_FINAL_EVENTS_TABLE *FinalEventsTable
+  IN     EFI_TCG2_EVENT_LOG_FORMAT   EventLogFormat,
+  IN OUT TCG_EVENT_LOG_AREA_STRUCT   *EventLogAreaStruct,
+  IN OUT TCG_EVENT_LOG_AREA_STRUCT   *FinalEventLogAreaStruct,
+  IN     EFI_TCG2_FINAL_EVENTS_TABLE *FinalEventsTable
   )
 {
-  TCG_PCR_EVENT_HDR        *EventHdr;
-  TCG_PCR_EVENT2           *TcgPcrEvent2;
-  TCG_EfiSpecIDEventStruct *TcgEfiSpecIdEventStruct;
-  UINTN                    NumberOfEvents;
-
   DEBUG ((DEBUG_INFO, "EventLogFormat: (0x%x)\n", EventLogFormat));
 
-  switch (EventLogFormat) {
-  case EFI_TCG2_EVENT_LOG_FORMAT_TCG_1_2:
-    EventHdr = (TCG_PCR_EVENT_HDR *)(UINTN)EventLogLocation;
-    while ((UINTN)EventHdr <= EventLogLastEntry) {
-      DumpEvent (EventHdr);
-      EventHdr = (TCG_PCR_EVENT_HDR *)((UINTN)EventHdr + sizeof (TCG_PCR_EVENT_HDR) + EventHdr->EventSize);
-    }
-    if (FinalEventsTable == NULL) {
-      DEBUG ((DEBUG_INFO, "FinalEventsTable: NOT FOUND\n"));
-    } else {
-      DEBUG ((DEBUG_INFO, "FinalEventsTable:    (0x%x)\n", FinalEventsTable));
-      DEBUG ((DEBUG_INFO, "  Version:           (0x%x)\n", FinalEventsTable->Version));
-      DEBUG ((DEBUG_INFO, "  NumberOfEvents:    (0x%x)\n", FinalEventsTable->NumberOfEvents));
-
-      EventHdr = (TCG_PCR_EVENT_HDR *)(UINTN)(FinalEventsTable + 1);
-      for (NumberOfEvents = 0; NumberOfEvents < FinalEventsTable->NumberOfEvents; NumberOfEvents++) {
-        DumpEvent (EventHdr);
-        EventHdr = (TCG_PCR_EVENT_HDR *)((UINTN)EventHdr + sizeof (TCG_PCR_EVENT_HDR) + EventHdr->EventSize);
-      }
-    }
-    break;
+  DumpEventLogArea (EventLogFormat, EventLogAreaStruct, TRUE);
 
-  case EFI_TCG2_EVENT_LOG_FORMAT_TCG_2:
-    //
-    // Dump first event
-    //
-    EventHdr = (TCG_PCR_EVENT_HDR *)(UINTN)EventLogLocation;
-    DumpEvent (EventHdr);
-
-    TcgEfiSpecIdEventStruct = (TCG_EfiSpecIDEventStruct *)(EventHdr + 1);
-    DumpTcgEfiSpecIdEventStruct (TcgEfiSpecIdEventStruct);
-
-    TcgPcrEvent2 = (TCG_PCR_EVENT2 *)((UINTN)TcgEfiSpecIdEventStruct + GetTcgEfiSpecIdEventStructSize (TcgEfiSpecIdEventStruct));
-    while ((UINTN)TcgPcrEvent2 <= EventLogLastEntry) {
-      DumpEvent2 (TcgPcrEvent2);
-      TcgPcrEvent2 = (TCG_PCR_EVENT2 *)((UINTN)TcgPcrEvent2 + GetPcrEvent2Size (TcgPcrEvent2));
-    }
+  if (FinalEventsTable == NULL) {
+    DEBUG ((DEBUG_INFO, "FinalEventsTable: NOT FOUND\n"));
+  } else {
+    DEBUG ((DEBUG_INFO, "FinalEventsTable:    (0x%x)\n", FinalEventsTable));
+    DEBUG ((DEBUG_INFO, "  Version:           (0x%x)\n", FinalEventsTable->Version));
+    DEBUG ((DEBUG_INFO, "  NumberOfEvents:    (0x%x)\n", FinalEventsTable->NumberOfEvents));
 
-    if (FinalEventsTable == NULL) {
-      DEBUG ((DEBUG_INFO, "FinalEventsTable: NOT FOUND\n"));
-    } else {
-      DEBUG ((DEBUG_INFO, "FinalEventsTable:    (0x%x)\n", FinalEventsTable));
-      DEBUG ((DEBUG_INFO, "  Version:           (0x%x)\n", FinalEventsTable->Version));
-      DEBUG ((DEBUG_INFO, "  NumberOfEvents:    (0x%x)\n", FinalEventsTable->NumberOfEvents));
-
-      TcgPcrEvent2 = (TCG_PCR_EVENT2 *)(UINTN)(FinalEventsTable + 1);
-      for (NumberOfEvents = 0; NumberOfEvents < FinalEventsTable->NumberOfEvents; NumberOfEvents++) {
-        DumpEvent2 (TcgPcrEvent2);
-        TcgPcrEvent2 = (TCG_PCR_EVENT2 *)((UINTN)TcgPcrEvent2 + GetPcrEvent2Size (TcgPcrEvent2));
-      }
-    }
-    break;
+    DumpEventLogArea (EventLogFormat, FinalEventLogAreaStruct, FALSE);
   }
-
-  return;
 }
 
 /**
@@ -678,7 +638,12 @@ Tcg2GetEventLog (
 
   // Dump Event Log for debug purpose
   if ((EventLogLocation != NULL) && (EventLogLastEntry != NULL)) {
-    DumpEventLog (EventLogFormat, *EventLogLocation, *EventLogLastEntry, mTcgDxeData.FinalEventsTable[Index]);
+    DumpEventLog (
+      EventLogFormat,
+      &mTcgDxeData.EventLogAreaStruct[Index],
+      &mTcgDxeData.FinalEventLogAreaStruct[Index],
+      mTcgDxeData.FinalEventsTable[Index]
+      );
   }
 
   //
@@ -747,6 +712,7 @@ TcgCommLogEvent (
 {
   UINTN   NewLogSize;
   BOOLEAN Record800155Event;
+  UINTN   Index;
 
   if (NewEventSize > MAX_ADDRESS -  NewEventHdrSize) {
     return EFI_OUT_OF_RESOURCES;
@@ -766,6 +732,11 @@ TcgCommLogEvent (
     return EFI_OUT_OF_RESOURCES;
   }
 
+  if (EventLogAreaStruct->EventCount >= EventLogAreaStruct->EventIndexSize) {
+    DEBUG ((DEBUG_INFO, "TcgCommLogEvent - event index full\n"));
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   //
   // Check 800-155 event
   // Record to 800-155 event offset only.
@@ -791,6 +762,21 @@ TcgCommLogEvent (
         NewEventSize
         );
 
+      //
+      // Insert the event into the index, the events behind it moved by NewLogSize.
+      //
+      CopyMem (
+        &EventLogAreaStruct->EventOffset[EventLogAreaStruct->Next800155EventIndex + 1],
+        &EventLogAreaStruct->EventOffset[EventLogAreaStruct->Next800155EventIndex],
+        (EventLogAreaStruct->EventCount - EventLogAreaStruct->Next800155EventIndex) * sizeof (UINT32)
+        );
+      EventLogAreaStruct->EventOffset[EventLogAreaStruct->Next800155EventIndex] = (UINT32)EventLogAreaStruct->Next800155EventOffset;
+      EventLogAreaStruct->EventCount++;
+      for (Index = EventLogAreaStruct->Next800155EventIndex + 1; Index < EventLogAreaStruct->EventCount; Index++) {
+        EventLogAreaStruct->EventOffset[Index] += (UINT32)NewLogSize;
+      }
+      EventLogAreaStruct->Next800155EventIndex++;
+
       EventLogAreaStruct->Next800155EventOffset += NewLogSize;
       EventLogAreaStruct->LastEvent += NewLogSize;
       EventLogAreaStruct->EventLogSize += NewLogSize;
@@ -798,6 +784,7 @@ TcgCommLogEvent (
     return EFI_SUCCESS;
   }
 
+  EventLogAreaStruct->EventOffset[EventLogAreaStruct->EventCount++] = (UINT32)EventLogAreaStruct->EventLogSize;
   EventLogAreaStruct->LastEvent = (UINT8 *)(UINTN)EventLogAreaStruct->Lasa + EventLogAreaStruct->EventLogSize;
   EventLogAreaStruct->EventLogSize += NewLogSize;
   CopyMem (EventLogAreaStruct->LastEvent, NewEventHdr, NewEventHdrSize);
@@ -1381,6 +1368,35 @@ EFI_TCG2_PROTOCOL mTcg2Protocol = {
   Tcg2GetResultOfSetActivePcrBanks,
 };
 
+/**
+  Allocate the event index of an event log area.
+
+  The index holds the offset of every event in the area, so locating an
+  event never needs to walk the log from its start.
+
+  @param[in, out] EventLogAreaStruct  The event log area data structure, Laml must be set.
+
+  @retval EFI_SUCCESS           The index was allocated.
+  @retval EFI_OUT_OF_RESOURCES  Out of memory.
+**/
+EFI_STATUS
+CreateEventLogIndex (
+  IN OUT TCG_EVENT_LOG_AREA_STRUCT *EventLogAreaStruct
+  )
+{
+  EventLogAreaStruct->EventIndexSize       = (UINTN)DivU64x32 (EventLogAreaStruct->Laml, TCG_EVENT_LOG_MIN_EVENT_SIZE);
+  EventLogAreaStruct->EventCount           = 0;
+  EventLogAreaStruct->DumpedEventCount     = 0;
+  EventLogAreaStruct->Next800155EventIndex = 0;
+  EventLogAreaStruct->EventOffset          = AllocatePool (EventLogAreaStruct->EventIndexSize * sizeof (UINT32));
+  if (EventLogAreaStruct->EventOffset == NULL) {
+    EventLogAreaStruct->EventIndexSize = 0;
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Initialize the Event Log and log events passed from the PEI phase.
 
@@ -1443,6 +1459,10 @@ SetupEventLog (
       mTcgDxeData.EventLogAreaStruct[Index].Lasa = Lasa;
       mTcgDxeData.EventLogAreaStruct[Index].Laml = PcdGet32 (PcdTcgLogAreaMinLen);
       mTcgDxeData.EventLogAreaStruct[Index].Next800155EventOffset = 0;
+      Status = CreateEventLogIndex (&mTcgDxeData.EventLogAreaStruct[Index]);
+      if (EFI_ERROR (Status)) {
+        return Status;
+      }
 
       if ((PcdGet8 (PcdTpm2AcpiTableRev) >= 4) ||
           (mTcg2EventInfo[Index].LogFormat == EFI_TCG2_EVENT_LOG_FORMAT_TCG_2))
@@ -1540,6 +1560,8 @@ SetupEventLog (
         //
         mTcgDxeData.EventLogAreaStruct[Index].Next800155EventOffset = \
           mTcgDxeData.EventLogAreaStruct[Index].EventLogSize;
+        mTcgDxeData.EventLogAreaStruct[Index].Next800155EventIndex = \
+          mTcgDxeData.EventLogAreaStruct[Index].EventCount;
 
         //
         // Tcg800155PlatformIdEvent. Event format is TCG_PCR_EVENT2
@@ -1595,6 +1617,10 @@ SetupEventLog (
         mTcgDxeData.FinalEventLogAreaStruct[Index].EventLogStarted = FALSE;
         mTcgDxeData.FinalEventLogAreaStruct[Index].EventLogTruncated = FALSE;
         mTcgDxeData.FinalEventLogAreaStruct[Index].Next800155EventOffset = 0;
+        Status = CreateEventLogIndex (&mTcgDxeData.FinalEventLogAreaStruct[Index]);
+        if (EFI_ERROR (Status)) {
+          return Status;
+        }
 
         //
         // Install to configuration table for EFI_TCG2_EVENT_LOG_FORMAT_TCG_2
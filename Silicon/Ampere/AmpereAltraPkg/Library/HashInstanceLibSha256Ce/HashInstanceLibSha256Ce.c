@@ -0,0 +1,278 @@
+/** @file
+  SHA-256 hash instance of the HashLib router using the ARMv8 Cryptographic
+  Extension. Falls back to BaseCryptLib when the CPU lacks the SHA2 instructions.
+
+  Copyright (c) 2026, Ampere Computing LLC. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiPei.h>
+
+#include <Library/BaseCryptLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HashLib.h>
+#include <Library/MemoryAllocationLib.h>
+
+#define SHA256_BLOCK_SIZE  64
+
+typedef struct {
+  BOOLEAN    UseCe;
+  UINT32     State[8];
+  UINT8      Buffer[SHA256_BLOCK_SIZE];
+  UINTN      BufferSize;
+  UINT64     Length;
+  VOID       *CryptCtx;
+} SHA256_CE_CONTEXT;
+
+STATIC CONST UINT32  mSha256InitialState[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+  0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+/**
+  Check whether the CPU implements the SHA-256 instructions.
+
+  @retval TRUE    ID_AA64ISAR0_EL1.SHA2 is not zero.
+  @retval FALSE   The SHA-256 instructions are not implemented.
+**/
+BOOLEAN
+Sha256CeIsSupported (
+  VOID
+  );
+
+/**
+  Run the SHA-256 compression function over whole message blocks.
+
+  @param[in, out] State       The eight SHA-256 working variables.
+  @param[in]      Data        The message blocks.
+  @param[in]      BlockCount  Number of 64-byte blocks in Data.
+**/
+VOID
+Sha256CeTransform (
+  IN OUT UINT32       *State,
+  IN     CONST UINT8  *Data,
+  IN     UINTN        BlockCount
+  );
+
+/**
+  The function set SHA256 to digest list.
+
+  @param DigestList   digest list
+  @param Sha256Digest SHA256 digest
+**/
+VOID
+Tpm2SetSha256ToDigestList (
+  IN TPML_DIGEST_VALUES  *DigestList,
+  IN UINT8               *Sha256Digest
+  )
+{
+  DigestList->count              = 1;
+  DigestList->digests[0].hashAlg = TPM_ALG_SHA256;
+  CopyMem (
+    DigestList->digests[0].digest.sha256,
+    Sha256Digest,
+    SHA256_DIGEST_SIZE
+    );
+}
+
+/**
+  Start hash sequence.
+
+  @param HashHandle Hash handle.
+
+  @retval EFI_SUCCESS          Hash sequence start and HandleHandle returned.
+  @retval EFI_OUT_OF_RESOURCES No enough resource to start hash.
+**/
+EFI_STATUS
+EFIAPI
+Sha256CeHashInit (
+  OUT HASH_HANDLE  *HashHandle
+  )
+{
+  SHA256_CE_CONTEXT  *Context;
+
+  Context = AllocateZeroPool (sizeof (*Context));
+  if (Context == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  Context->UseCe = Sha256CeIsSupported ();
+  if (Context->UseCe) {
+    CopyMem (Context->State, mSha256InitialState, sizeof (Context->State));
+  } else {
+    Context->CryptCtx = AllocatePool (Sha256GetContextSize ());
+    if (Context->CryptCtx == NULL) {
+      FreePool (Context);
+      return EFI_OUT_OF_RESOURCES;
+    }
+
+    Sha256Init (Context->CryptCtx);
+  }
+
+  *HashHandle = (HASH_HANDLE)Context;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Update hash sequence data.
+
+  @param HashHandle    Hash handle.
+  @param DataToHash    Data to be hashed.
+  @param DataToHashLen Data size.
+
+  @retval EFI_SUCCESS     Hash sequence updated.
+**/
+EFI_STATUS
+EFIAPI
+Sha256CeHashUpdate (
+  IN HASH_HANDLE  HashHandle,
+  IN VOID         *DataToHash,
+  IN UINTN        DataToHashLen
+  )
+{
+  SHA256_CE_CONTEXT  *Context;
+  CONST UINT8        *Data;
+  UINTN              Size;
+  UINTN              Blocks;
+
+  Context = (SHA256_CE_CONTEXT *)HashHandle;
+  if (!Context->UseCe) {
+    Sha256Update (Context->CryptCtx, DataToHash, DataToHashLen);
+    return EFI_SUCCESS;
+  }
+
+  Data             = DataToHash;
+  Context->Length += DataToHashLen;
+
+  if (Context->BufferSize != 0) {
+    Size = MIN (DataToHashLen, SHA256_BLOCK_SIZE - Context->BufferSize);
+    CopyMem (&Context->Buffer[Context->BufferSize], Data, Size);
+    Context->BufferSize += Size;
+    Data                += Size;
+    DataToHashLen       -= Size;
+    if (Context->BufferSize < SHA256_BLOCK_SIZE) {
+      return EFI_SUCCESS;
+    }
+
+    Sha256CeTransform (Context->State, Context->Buffer, 1);
+    Context->BufferSize = 0;
+  }
+
+  //
+  // Hash the whole blocks straight from the caller's buffer.
+  //
+  Blocks = DataToHashLen / SHA256_BLOCK_SIZE;
+  if (Blocks != 0) {
+    Sha256CeTransform (Context->State, Data, Blocks);
+    Data          += Blocks * SHA256_BLOCK_SIZE;
+    DataToHashLen -= Blocks * SHA256_BLOCK_SIZE;
+  }
+
+  CopyMem (Context->Buffer, Data, DataToHashLen);
+  Context->BufferSize = DataToHashLen;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Complete hash sequence complete.
+
+  @param HashHandle    Hash handle.
+  @param DigestList    Digest list.
+
+  @retval EFI_SUCCESS     Hash sequence complete and DigestList is returned.
+**/
+EFI_STATUS
+EFIAPI
+Sha256CeHashFinal (
+  IN HASH_HANDLE          HashHandle,
+  OUT TPML_DIGEST_VALUES  *DigestList
+  )
+{
+  SHA256_CE_CONTEXT  *Context;
+  UINT8              Digest[SHA256_DIGEST_SIZE];
+  UINT64             BitLength;
+  UINTN              Index;
+
+  Context = (SHA256_CE_CONTEXT *)HashHandle;
+  if (!Context->UseCe) {
+    Sha256Final (Context->CryptCtx, Digest);
+    FreePool (Context->CryptCtx);
+  } else {
+    //
+    // Append 0x80, pad with zeros and end with the message length in bits,
+    // big-endian.
+    //
+    Context->Buffer[Context->BufferSize++] = 0x80;
+    if (Context->BufferSize > SHA256_BLOCK_SIZE - sizeof (BitLength)) {
+      ZeroMem (
+        &Context->Buffer[Context->BufferSize],
+        SHA256_BLOCK_SIZE - Context->BufferSize
+        );
+      Sha256CeTransform (Context->State, Context->Buffer, 1);
+      Context->BufferSize = 0;
+    }
+
+    ZeroMem (
+      &Context->Buffer[Context->BufferSize],
+      SHA256_BLOCK_SIZE - sizeof (BitLength) - Context->BufferSize
+      );
+    BitLength = SwapBytes64 (LShiftU64 (Context->Length, 3));
+    CopyMem (
+      &Context->Buffer[SHA256_BLOCK_SIZE - sizeof (BitLength)],
+      &BitLength,
+      sizeof (BitLength)
+      );
+    Sha256CeTransform (Context->State, Context->Buffer, 1);
+
+    for (Index = 0; Index < ARRAY_SIZE (Context->State); Index++) {
+      WriteUnaligned32 (
+        (UINT32 *)&Digest[Index * sizeof (UINT32)],
+        SwapBytes32 (Context->State[Index])
+        );
+    }
+  }
+
+  ZeroMem (Context, sizeof (*Context));
+  FreePool (Context);
+
+  Tpm2SetSha256ToDigestList (DigestList, Digest);
+
+  return EFI_SUCCESS;
+}
+
+HASH_INTERFACE  mSha256CeHashInstance = {
+  HASH_ALGORITHM_SHA256_GUID,
+  Sha256CeHashInit,
+  Sha256CeHashUpdate,
+  Sha256CeHashFinal,
+};
+
+/**
+  The function register SHA256 instance.
+
+  @retval EFI_SUCCESS   SHA256 instance is registered, or system does not support register SHA256 instance
+**/
+EFI_STATUS
+EFIAPI
+HashInstanceLibSha256CeConstructor (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+
+  Status = RegisterHashInterfaceLib (&mSha256CeHashInstance);
+  if ((Status == EFI_SUCCESS) || (Status == EFI_UNSUPPORTED)) {
+    //
+    // Unsupported means platform policy does not need this instance enabled.
+    //
+    return EFI_SUCCESS;
+  }
+
+  return Status;
+}
@@ -0,0 +1,278 @@
+/** @file
+  Host based known answer tests of the ARMv8 Crypto Extension SHA-256 hash
+  instance.
+
+  The digests are checked against the FIPS 180-2 examples and against
+  Sha256HashAll() of BaseCryptLib, for message lengths around the block and
+  padding boundaries and for data fed in chunks of various sizes. The CE
+  transform is used when the host CPU implements the SHA-256 instructions,
+  the BaseCryptLib fallback otherwise.
+
+  Copyright (c) 2026, Ampere Computing LLC. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseCryptLib.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/HashLib.h>
+#include <Library/UnitTestLib.h>
+
+#define UNIT_TEST_APP_NAME     "HashInstanceLibSha256Ce Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+#define TEST_MESSAGE_SIZE  1024
+
+typedef struct {
+  CONST CHAR8    *Message;
+  UINT8          Digest[SHA256_DIGEST_SIZE];
+} SHA256_KNOWN_ANSWER;
+
+STATIC CONST SHA256_KNOWN_ANSWER  mKnownAnswers[] = {
+  {
+    "",
+    {
+      0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14,
+      0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+      0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c,
+      0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+    }
+  },
+  {
+    "abc",
+    {
+      0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea,
+      0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+      0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c,
+      0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad
+    }
+  },
+  {
+    "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+    {
+      0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8,
+      0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+      0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67,
+      0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1
+    }
+  }
+};
+
+//
+// Message lengths around the 64 byte block and the 56 byte padding limit.
+//
+STATIC CONST UINTN  mMessageSizes[] = {
+  1, 55, 56, 57, 63, 64, 65, 119, 120, 127, 128, 129, 1000, TEST_MESSAGE_SIZE
+};
+
+//
+// Sizes of the chunks a message is fed in.
+//
+STATIC CONST UINTN  mChunkSizes[] = {
+  1, 3, 63, 64, 65, 200, TEST_MESSAGE_SIZE
+};
+
+STATIC UINT8  mMessage[TEST_MESSAGE_SIZE];
+
+EFI_STATUS
+EFIAPI
+Sha256CeHashInit (
+  OUT HASH_HANDLE  *HashHandle
+  );
+
+EFI_STATUS
+EFIAPI
+Sha256CeHashUpdate (
+  IN HASH_HANDLE  HashHandle,
+  IN VOID         *DataToHash,
+  IN UINTN        DataToHashLen
+  );
+
+EFI_STATUS
+EFIAPI
+Sha256CeHashFinal (
+  IN HASH_HANDLE          HashHandle,
+  OUT TPML_DIGEST_VALUES  *DigestList
+  );
+
+/**
+  Hash a message with the hash instance, feeding it in chunks.
+
+  @param[in]  Message      The message.
+  @param[in]  MessageSize  Size of the message.
+  @param[in]  ChunkSize    Size of the chunks passed to Sha256CeHashUpdate().
+  @param[out] Digest       The SHA-256 digest.
+
+  @retval TRUE   The message was hashed.
+  @retval FALSE  The hash instance failed.
+**/
+STATIC
+BOOLEAN
+HashInChunks (
+  IN  CONST UINT8  *Message,
+  IN  UINTN        MessageSize,
+  IN  UINTN        ChunkSize,
+  OUT UINT8        *Digest
+  )
+{
+  HASH_HANDLE         HashHandle;
+  TPML_DIGEST_VALUES  DigestList;
+  UINTN               Offset;
+  UINTN               Size;
+
+  if (EFI_ERROR (Sha256CeHashInit (&HashHandle))) {
+    return FALSE;
+  }
+
+  for (Offset = 0; Offset < MessageSize; Offset += Size) {
+    Size = MIN (ChunkSize, MessageSize - Offset);
+    if (EFI_ERROR (Sha256CeHashUpdate (HashHandle, (VOID *)&Message[Offset], Size))) {
+      return FALSE;
+    }
+  }
+
+  ZeroMem (&DigestList, sizeof (DigestList));
+  if (EFI_ERROR (Sha256CeHashFinal (HashHandle, &DigestList))) {
+    return FALSE;
+  }
+
+  if ((DigestList.count != 1) || (DigestList.digests[0].hashAlg != TPM_ALG_SHA256)) {
+    return FALSE;
+  }
+
+  CopyMem (Digest, DigestList.digests[0].digest.sha256, SHA256_DIGEST_SIZE);
+  return TRUE;
+}
+
+/**
+  The FIPS 180-2 example messages give the published digests.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+KnownAnswerTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+  UINT8  Digest[SHA256_DIGEST_SIZE];
+
+  for (Index = 0; Index < ARRAY_SIZE (mKnownAnswers); Index++) {
+    UT_ASSERT_TRUE (
+      HashInChunks (
+        (CONST UINT8 *)mKnownAnswers[Index].Message,
+        AsciiStrLen (mKnownAnswers[Index].Message),
+        TEST_MESSAGE_SIZE,
+        Digest
+        )
+      );
+    UT_ASSERT_MEM_EQUAL (Digest, mKnownAnswers[Index].Digest, SHA256_DIGEST_SIZE);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Messages around the block boundaries, fed in chunks of various sizes, give
+  the digest of BaseCryptLib.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+BaseCryptLibMatchTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  Index;
+  UINTN  SizeIndex;
+  UINTN  ChunkIndex;
+  UINT8  Expected[SHA256_DIGEST_SIZE];
+  UINT8  Digest[SHA256_DIGEST_SIZE];
+
+  for (Index = 0; Index < TEST_MESSAGE_SIZE; Index++) {
+    mMessage[Index] = (UINT8)(Index * 7 + (Index >> 8));
+  }
+
+  for (SizeIndex = 0; SizeIndex < ARRAY_SIZE (mMessageSizes); SizeIndex++) {
+    UT_ASSERT_TRUE (Sha256HashAll (mMessage, mMessageSizes[SizeIndex], Expected));
+    for (ChunkIndex = 0; ChunkIndex < ARRAY_SIZE (mChunkSizes); ChunkIndex++) {
+      UT_ASSERT_TRUE (HashInChunks (mMessage, mMessageSizes[SizeIndex], mChunkSizes[ChunkIndex], Digest));
+      UT_ASSERT_MEM_EQUAL (Digest, Expected, SHA256_DIGEST_SIZE);
+    }
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests and run them.
+
+  @retval EFI_SUCCESS           All test cases were dispatched.
+  @retval EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                initialize the unit tests.
+**/
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      Sha256Suite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&Sha256Suite, Framework, "SHA-256 Tests", "Ampere.HashInstanceLibSha256Ce", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for SHA-256 tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (Sha256Suite, "FIPS 180-2 examples give the published digests", "KnownAnswer", KnownAnswerTest, NULL, NULL, NULL);
+  AddTestCase (Sha256Suite, "Chunked messages match BaseCryptLib", "BaseCryptLib", BaseCryptLibMatchTest, NULL, NULL, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
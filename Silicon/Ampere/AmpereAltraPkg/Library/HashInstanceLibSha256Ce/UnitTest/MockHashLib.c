@@ -0,0 +1,29 @@
+/** @file
+  HashLib instance for the host based unit tests of HashInstanceLibSha256Ce.
+  It only accepts the registration done by the library constructor, the
+  tests call the hash instance directly.
+
+  Copyright (c) 2026, Ampere Computing LLC. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/HashLib.h>
+
+/**
+  This service registers a hash interface.
+
+  @param HashInterface  Hash interface
+
+  @retval EFI_SUCCESS   The hash interface is registered.
+**/
+EFI_STATUS
+EFIAPI
+RegisterHashInterfaceLib (
+  IN HASH_INTERFACE  *HashInterface
+  )
+{
+  return EFI_SUCCESS;
+}
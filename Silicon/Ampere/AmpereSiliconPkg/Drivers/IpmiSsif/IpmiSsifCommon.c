@@ -7,6 +7,7 @@
 
 **/
 
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -17,6 +18,175 @@
 
 #include "IpmiSsifCommon.h"
 
+IPMI_SSIF_CMD_STATS  mIpmiSsifCmdStats[IPMI_SSIF_CMD_STATS_MAX];
+UINTN                mIpmiSsifCmdStatsCount;
+
+/**
+  Check whether the platform connects SMBALERT# of BMC.
+
+  @retval TRUE    Responses can be waited for with SMBALERT#.
+  @retval FALSE   Responses must be polled.
+**/
+BOOLEAN
+IpmiSsifAlertDetect (
+  VOID
+  )
+{
+  BOOLEAN  Asserted;
+
+  return !EFI_ERROR (PlatformBmcSsifAlert (&Asserted));
+}
+
+/**
+  Wait before the next retry. The delay doubles on each call up to MaxInterval.
+
+  @param[in, out]  Interval     Delay in microseconds, updated for the next retry.
+  @param[in]       MaxInterval  Upper limit of the delay in microseconds.
+
+  @return The time waited in microseconds.
+**/
+UINT32
+SsifRetryDelay (
+  IN OUT UINT32  *Interval,
+  IN     UINT32  MaxInterval
+  )
+{
+  UINT32  Delay;
+
+  Delay = *Interval;
+  MicroSecondDelay (Delay);
+
+  *Interval = (Delay > MaxInterval / 2) ? MaxInterval : Delay * 2;
+
+  return Delay;
+}
+
+/**
+  Wait for BMC to assert SMBALERT#, signaling that the response is ready.
+
+  @param[in]   Timeout           Time to wait in microseconds.
+
+  @retval EFI_SUCCESS            SMBALERT# is asserted.
+  @retval EFI_TIMEOUT            SMBALERT# is not asserted within Timeout.
+  @retval EFI_UNSUPPORTED        SMBALERT# is not available.
+**/
+EFI_STATUS
+SsifWaitForAlert (
+  IN UINT64  Timeout
+  )
+{
+  EFI_STATUS  Status;
+  BOOLEAN     Asserted;
+  UINT64      Waited;
+
+  for (Waited = 0; Waited < Timeout; Waited += IPMI_SSIF_ALERT_POLL_INTERVAL) {
+    Status = PlatformBmcSsifAlert (&Asserted);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
+    if (Asserted) {
+      return EFI_SUCCESS;
+    }
+
+    MicroSecondDelay (IPMI_SSIF_ALERT_POLL_INTERVAL);
+  }
+
+  return EFI_TIMEOUT;
+}
+
+/**
+  Get the performance counter in microseconds.
+
+  @return The current time in microseconds.
+**/
+UINT64
+SsifGetTimeUs (
+  VOID
+  )
+{
+  return DivU64x32 (GetTimeInNanoSecond (GetPerformanceCounter ()), 1000);
+}
+
+/**
+  Account one IPMI command in the latency counters.
+
+  @param[in]   NetFunction       Net function of the command.
+  @param[in]   Command           IPMI Command.
+  @param[in]   Status            Status of the command.
+  @param[in]   Retries           Number of write and read retries.
+  @param[in]   TimeUs            Latency of the command in microseconds.
+**/
+VOID
+SsifRecordCmdStats (
+  IN UINT8       NetFunction,
+  IN UINT8       Command,
+  IN EFI_STATUS  Status,
+  IN UINT32      Retries,
+  IN UINT64      TimeUs
+  )
+{
+  IPMI_SSIF_CMD_STATS  *Stats;
+  UINTN                Index;
+
+  for (Index = 0; Index < mIpmiSsifCmdStatsCount; Index++) {
+    if (  (mIpmiSsifCmdStats[Index].NetFunction == NetFunction)
+       && (mIpmiSsifCmdStats[Index].Command == Command))
+    {
+      break;
+    }
+  }
+
+  if (Index == mIpmiSsifCmdStatsCount) {
+    if (mIpmiSsifCmdStatsCount == IPMI_SSIF_CMD_STATS_MAX) {
+      return;
+    }
+
+    mIpmiSsifCmdStatsCount++;
+    Stats = &mIpmiSsifCmdStats[Index];
+    ZeroMem (Stats, sizeof (*Stats));
+    Stats->NetFunction = NetFunction;
+    Stats->Command     = Command;
+  }
+
+  Stats = &mIpmiSsifCmdStats[Index];
+  Stats->Count++;
+  Stats->Retries     += Retries;
+  Stats->TotalTimeUs += TimeUs;
+  Stats->MaxTimeUs    = MAX (Stats->MaxTimeUs, TimeUs);
+  if (EFI_ERROR (Status)) {
+    Stats->Errors++;
+  }
+}
+
+/**
+  Print the latency counters of all IPMI commands sent so far.
+**/
+VOID
+IpmiSsifDumpCmdStats (
+  VOID
+  )
+{
+  IPMI_SSIF_CMD_STATS  *Stats;
+  UINTN                Index;
+
+  DEBUG ((DEBUG_INFO, "SSIF command latency (us): NetFn Cmd Count Errors Retries Average Max\n"));
+  for (Index = 0; Index < mIpmiSsifCmdStatsCount; Index++) {
+    Stats = &mIpmiSsifCmdStats[Index];
+    DEBUG ((
+      DEBUG_INFO,
+      "  0x%02x 0x%02x %d %d %d %ld %ld\n",
+      Stats->NetFunction,
+      Stats->Command,
+      Stats->Count,
+      Stats->Errors,
+      Stats->Retries,
+      DivU64x32 (Stats->TotalTimeUs, Stats->Count),
+      Stats->MaxTimeUs
+      ));
+  }
+}
+
 /**
   Write SSIF request to BMC.
 
@@ -272,10 +442,17 @@ IpmiSsifCommonCmd (
   EFI_STATUS  Status;
   UINT32      TempLength;
   UINT8       *RequestTemp;
-  UINT8       RetryCount;
+  UINT32      Retries;
+  UINT32      Interval;
+  UINT64      Waited;
+  UINT64      Timeout;
+  UINT64      StartTime;
 
   DEBUG ((DEBUG_INFO, "%a Entry\n", __FUNCTION__));
 
+  StartTime = SsifGetTimeUs ();
+  Retries   = 0;
+
   ASSERT (NetFunction <= IPMI_MAX_NETFUNCTION);
   ASSERT (IPMI_LUN_NUMBER <= IPMI_MAX_LUN);
 
@@ -324,50 +501,64 @@ IpmiSsifCommonCmd (
   //
   // Write Request
   //
-  RetryCount = 1;
+  Interval = MIN (IPMI_SSIF_MIN_RETRY_INTERVAL, IPMI_SSIF_REQUEST_RETRY_INTERVAL);
+  Timeout  = MultU64x32 (IPMI_SSIF_REQUEST_RETRY_COUNT, IPMI_SSIF_REQUEST_RETRY_INTERVAL);
+  Waited   = 0;
   while (TRUE) {
-    DEBUG ((DEBUG_INFO, "%a: Write Request count = %d\n", __FUNCTION__, RetryCount));
+    DEBUG ((DEBUG_INFO, "%a: Write Request retry = %d\n", __FUNCTION__, Retries));
     Status = SsifWriteRequest (RequestTemp, TempLength);
     if (!EFI_ERROR (Status)) {
       break;
     }
 
-    if (++RetryCount > IPMI_SSIF_REQUEST_RETRY_COUNT) {
+    if (Waited >= Timeout) {
       DEBUG ((DEBUG_ERROR, "%a: Write Request error %r\n", __FUNCTION__, Status));
       goto Cleanup;
     }
 
-    MicroSecondDelay (IPMI_SSIF_REQUEST_RETRY_INTERVAL);
+    Waited += SsifRetryDelay (&Interval, IPMI_SSIF_REQUEST_RETRY_INTERVAL);
+    Retries++;
   }
 
-  //
-  // TODO: Check for Alert
-  //
-
   //
   // Read Response
   //
   TempLength = *ResponseDataSize; // Keep original DataSize
+  Interval   = MIN (IPMI_SSIF_MIN_RETRY_INTERVAL, IPMI_SSIF_RESPONSE_RETRY_INTERVAL);
+  Timeout    = MultU64x32 (IPMI_SSIF_RESPONSE_RETRY_COUNT, IPMI_SSIF_RESPONSE_RETRY_INTERVAL);
+  Waited     = 0;
+
+  if (mAlertSupport) {
+    //
+    // Do not poll BMC over SMBus, it asserts SMBALERT# once the response is ready.
+    // A BMC not driving SMBALERT# falls back to polling for good.
+    //
+    if (EFI_ERROR (SsifWaitForAlert (Timeout))) {
+      DEBUG ((DEBUG_WARN, "%a: No SMBALERT# from BMC, polling for responses\n", __FUNCTION__));
+      mAlertSupport = FALSE;
+    }
+  }
 
-  RetryCount = 1;
   while (TRUE) {
-    DEBUG ((DEBUG_INFO, "%a: Read Response count = %d\n", __FUNCTION__, RetryCount));
+    DEBUG ((DEBUG_INFO, "%a: Read Response retry = %d\n", __FUNCTION__, Retries));
     Status = SsifReadResponse (ResponseData, ResponseDataSize);
     if (!EFI_ERROR (Status)) {
       break;
     }
 
-    if (++RetryCount > IPMI_SSIF_RESPONSE_RETRY_COUNT) {
+    if (Waited >= Timeout) {
       DEBUG ((DEBUG_ERROR, "%a: Read Response error %r\n", __FUNCTION__, Status));
       *ResponseDataSize = 0;
       goto Cleanup;
     }
 
     *ResponseDataSize = TempLength;
-    MicroSecondDelay (IPMI_SSIF_RESPONSE_RETRY_INTERVAL);
+    Waited           += SsifRetryDelay (&Interval, IPMI_SSIF_RESPONSE_RETRY_INTERVAL);
+    Retries++;
   }
 
 Cleanup:
+  SsifRecordCmdStats (NetFunction, Command, Status, Retries, SsifGetTimeUs () - StartTime);
   FreePool (RequestTemp);
 
   return Status;
@@ -41,10 +41,33 @@
 #define IPMI_SSIF_RESPONSE_RETRY_COUNT     (FixedPcdGet32 (PcdIpmiSsifResponseRetryCount))
 #define IPMI_SSIF_RESPONSE_RETRY_INTERVAL  (FixedPcdGet32 (PcdIpmiSsifResponseRetryInterval))
 
+//
+// Retries start with a short delay which doubles up to the retry interval,
+// the worst case time is still retry count * retry interval.
+//
+#define IPMI_SSIF_MIN_RETRY_INTERVAL       (FixedPcdGet32 (PcdIpmiSsifMinRetryInterval))
+
+#define IPMI_SSIF_ALERT_POLL_INTERVAL      50     // 50us, SMBALERT# is a GPIO read
+
+#define IPMI_SSIF_CMD_STATS_MAX            32
+
 #define SSIF_SINGLE_PART_RW  0x0
 #define SSIF_START_END_RW    0x1
 #define SSIF_MULTI_PART_RW   0x2
 
+//
+// Latency counters of one IPMI command
+//
+typedef struct {
+  UINT8     NetFunction;
+  UINT8     Command;
+  UINT32    Count;
+  UINT32    Errors;
+  UINT32    Retries;            // Write and read retries
+  UINT64    TotalTimeUs;
+  UINT64    MaxTimeUs;
+} IPMI_SSIF_CMD_STATS;
+
 //
 // Initialize SSIF Interface capability
 //
@@ -52,6 +75,26 @@ extern BOOLEAN  mPecSupport;
 extern UINT8    mMaxRequestSize;
 extern UINT8    mMaxResponseSize;
 extern UINT8    mTransactionSupport;
+extern BOOLEAN  mAlertSupport;
+
+/**
+  Check whether the platform connects SMBALERT# of BMC.
+
+  @retval TRUE    Responses can be waited for with SMBALERT#.
+  @retval FALSE   Responses must be polled.
+**/
+BOOLEAN
+IpmiSsifAlertDetect (
+  VOID
+  );
+
+/**
+  Print the latency counters of all IPMI commands sent so far.
+**/
+VOID
+IpmiSsifDumpCmdStats (
+  VOID
+  );
 
 /**
   This function enables submitting Ipmi command via Ssif interface.
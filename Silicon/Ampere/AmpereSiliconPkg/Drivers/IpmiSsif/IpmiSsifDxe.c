@@ -9,6 +9,7 @@
 
 #include <Uefi.h>
 
+#include <Guid/EventGroup.h>
 #include <IndustryStandard/IpmiNetFnApp.h>
 #include <IndustryStandard/IpmiNetFnAppExt.h>
 #include <Library/DebugLib.h>
@@ -25,6 +26,7 @@ BOOLEAN  mPecSupport         = FALSE;
 UINT8    mMaxRequestSize     = IPMI_SSIF_BLOCK_LEN;
 UINT8    mMaxResponseSize    = IPMI_SSIF_BLOCK_LEN;
 UINT8    mTransactionSupport = SSIF_SINGLE_PART_RW;
+BOOLEAN  mAlertSupport       = FALSE;
 
 //
 // Handle to install SMBus Host Controller protocol.
@@ -70,6 +72,22 @@ IpmiSsifCmd (
   return Status;
 }
 
+/**
+  Print the IPMI command latency counters when leaving boot services.
+
+  @param[in]  Event     Event whose notification function is being invoked.
+  @param[in]  Context   Pointer to the notification function's context.
+**/
+VOID
+EFIAPI
+IpmiSsifExitBootServicesNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  IpmiSsifDumpCmdStats ();
+}
+
 //
 // Interface defintion of IPMI Protocol.
 //
@@ -95,10 +113,13 @@ SsifEntry (
   )
 {
   EFI_STATUS                                            Status;
+  EFI_EVENT                                             ExitBootServicesEvent;
   IPMI_GET_SYSTEM_INTERFACE_CAPABILITIES_REQUEST        Request;
   IPMI_GET_SYSTEM_INTERFACE_SSIF_CAPABILITIES_RESPONSE  SsifCap;
   UINT32                                                ResponseSize;
 
+  mAlertSupport = IpmiSsifAlertDetect ();
+
   Request.Uint8 = IPMI_GET_SYSTEM_INTERFACE_CAPABILITIES_INTERFACE_TYPE_SSIF;
   ResponseSize  = sizeof (SsifCap);
 
@@ -125,18 +146,15 @@ SsifEntry (
 
     DEBUG ((
       DEBUG_INFO,
-      "SSIF Capabilities transaction %d, insize %d, outsize %d, pec %d\n",
+      "SSIF Capabilities transaction %d, insize %d, outsize %d, pec %d, alert %d\n",
       mTransactionSupport,
       mMaxRequestSize,
       mMaxResponseSize,
-      mPecSupport
+      mPecSupport,
+      mAlertSupport
       ));
   }
 
-  //
-  // TODO: Get global settings, check for Alert support.
-  //
-
   if (EFI_ERROR (Status)) {
     return EFI_UNSUPPORTED;
   }
@@ -152,5 +170,17 @@ SsifEntry (
                   );
   ASSERT_EFI_ERROR (Status);
 
+  //
+  // TPL_CALLBACK runs after the TPL_NOTIFY users of the protocol (e.g. SMBIOS blob transfer)
+  //
+  gBS->CreateEventEx (
+         EVT_NOTIFY_SIGNAL,
+         TPL_CALLBACK,
+         IpmiSsifExitBootServicesNotify,
+         NULL,
+         &gEfiEventExitBootServicesGuid,
+         &ExitBootServicesEvent
+         );
+
   return Status;
 }
@@ -25,6 +25,7 @@ BOOLEAN  mPecSupport         = FALSE;
 UINT8    mMaxRequestSize     = IPMI_SSIF_BLOCK_LEN;
 UINT8    mMaxResponseSize    = IPMI_SSIF_BLOCK_LEN;
 UINT8    mTransactionSupport = SSIF_SINGLE_PART_RW;
+BOOLEAN  mAlertSupport       = FALSE;
 
 /**
   This function enables submitting Ipmi command via Ssif interface.
@@ -78,6 +79,34 @@ CONST EFI_PEI_PPI_DESCRIPTOR  mIpmiSsifPpiList = {
   &mIpmiSsifPpi
 };
 
+/**
+  Print the IPMI command latency counters at the end of PEI.
+
+  @param[in] PeiServices          An indirect pointer to the EFI_PEI_SERVICES table published by the PEI Foundation.
+  @param[in] NotifyDescriptor     Address of the notification descriptor data structure.
+  @param[in] Ppi                  Address of the PPI that was installed.
+
+  @retval EFI_SUCCESS             Always.
+**/
+EFI_STATUS
+EFIAPI
+IpmiSsifEndOfPeiNotify (
+  IN EFI_PEI_SERVICES          **PeiServices,
+  IN EFI_PEI_NOTIFY_DESCRIPTOR *NotifyDescriptor,
+  IN VOID                      *Ppi
+  )
+{
+  IpmiSsifDumpCmdStats ();
+
+  return EFI_SUCCESS;
+}
+
+CONST EFI_PEI_NOTIFY_DESCRIPTOR  mIpmiSsifEndOfPeiNotifyList = {
+  (EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK | EFI_PEI_PPI_DESCRIPTOR_TERMINATE_LIST),
+  &gEfiEndOfPeiSignalPpiGuid,
+  IpmiSsifEndOfPeiNotify
+};
+
 /**
   The user Entry Point for the Ssif driver.
 
@@ -100,6 +129,8 @@ InitializeSsifPeim (
   IPMI_GET_SYSTEM_INTERFACE_SSIF_CAPABILITIES_RESPONSE  SsifCap;
   UINT32                                                ResponseSize;
 
+  mAlertSupport = IpmiSsifAlertDetect ();
+
   Request.Uint8 = IPMI_GET_SYSTEM_INTERFACE_CAPABILITIES_INTERFACE_TYPE_SSIF;
   ResponseSize  = sizeof (SsifCap);
 
@@ -126,23 +157,22 @@ InitializeSsifPeim (
 
     DEBUG ((
       DEBUG_INFO,
-      "SSIF Capabilities transaction %d, insize %d, outsize %d, pec %d\n",
+      "SSIF Capabilities transaction %d, insize %d, outsize %d, pec %d, alert %d\n",
       mTransactionSupport,
       mMaxRequestSize,
       mMaxResponseSize,
-      mPecSupport
+      mPecSupport,
+      mAlertSupport
       ));
   }
 
-  //
-  // TODO: Get global settings, check for Alert support.
-  //
-
   //
   // Install IPMI Ppi
   //
   Status = PeiServicesInstallPpi (&mIpmiSsifPpiList);
   ASSERT_EFI_ERROR (Status);
 
+  PeiServicesNotifyPpi (&mIpmiSsifEndOfPeiNotifyList);
+
   return Status;
 }
@@ -10,6 +10,7 @@
 
 #include <Guid/SmbiosBlobsTransfer.h>
 #include <IndustryStandard/SmBios.h>
+#include <Library/BaseCryptLib.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
@@ -25,6 +26,15 @@
 #define RETRY_COUNTER                  10
 #define SMBIOS_BLOBS_ID                "/smbios"
 #define SMBIOS_BLOB_TRANSFER_VAR_NAME  L"SmbiosBlobTransfer"
+#define SMBIOS_BLOB_DIGEST_VAR_NAME    L"SmbiosBlobDigest"
+
+//
+// Digest of the last blob the BMC committed, saved in SMBIOS_BLOB_DIGEST_VAR_NAME
+//
+typedef struct {
+  UINT32    BlobSize;
+  UINT8     Digest[SHA256_DIGEST_SIZE];
+} SMBIOS_BLOB_DIGEST;
 
 UINT8  OpenBmcIanaNumber[IANA_OEM_NUMBER_SIZE] = { 0xcf, 0xc2, 0x00 };
 
@@ -33,6 +43,12 @@ STATIC UINT8  *mIanaNumber[] = {
   NULL
 };
 
+//
+// SHA-256 context, allocated at entry as no memory may be allocated
+// from the ExitBootServices notify which computes the digest
+//
+STATIC VOID  *mHashContext;
+
 EFI_STATUS
 GetSmbiosTable (
   OUT UINT8  **TableEntry,
@@ -68,6 +84,117 @@ GetSmbiosTable (
   return EFI_SUCCESS;
 }
 
+/**
+  Compute the digest of the blob which is transferred to the BMC,
+  the SMBIOS structures followed by the entry point structure.
+
+  @param[out]  BlobDigest  Size and SHA-256 digest of the blob.
+
+  @retval EFI_SUCCESS      The digest was computed.
+  @retval Others           The SMBIOS table is not found or hashing failed.
+**/
+EFI_STATUS
+GetSmbiosBlobDigest (
+  OUT SMBIOS_BLOB_DIGEST  *BlobDigest
+  )
+{
+  EFI_STATUS  Status;
+  UINT8       *SmbiosTableAddress;
+  UINT8       *SmbiosTableEntry;
+  UINTN       SmbiosTableEntrySize;
+  UINTN       SmbiosTableSize;
+  BOOLEAN     HashStatus;
+
+  if (mHashContext == NULL) {
+    return EFI_NOT_READY;
+  }
+
+  Status = GetSmbiosTable (
+             &SmbiosTableEntry,
+             &SmbiosTableEntrySize,
+             &SmbiosTableAddress,
+             &SmbiosTableSize
+             );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  HashStatus = Sha256Init (mHashContext)
+               && Sha256Update (mHashContext, SmbiosTableAddress, SmbiosTableSize)
+               && Sha256Update (mHashContext, SmbiosTableEntry, SmbiosTableEntrySize)
+               && Sha256Final (mHashContext, BlobDigest->Digest);
+  if (!HashStatus) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  BlobDigest->BlobSize = (UINT32)(SmbiosTableSize + SmbiosTableEntrySize);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Check whether the BMC already holds the blob described by BlobDigest.
+
+  The /smbios blob cannot be read back, so the digest saved after the last
+  successful commit stands for the BMC copy: it must match the digest of the
+  current blob. The BMC must also still report a blob of the same
+  size, so a BMC which lost its copy (e.g. after a factory reset) gets the
+  table again.
+
+  @param[in]  IanaNumber  IANA number of the blob service.
+  @param[in]  BlobDigest  Size and digest of the current blob.
+
+  @retval TRUE            The transfer can be skipped.
+  @retval FALSE           The table needs to be transferred.
+**/
+BOOLEAN
+IsSmbiosBlobOnBmc (
+  IN UINT8               *IanaNumber,
+  IN SMBIOS_BLOB_DIGEST  *BlobDigest
+  )
+{
+  EFI_STATUS          Status;
+  SMBIOS_BLOB_DIGEST  SavedDigest;
+  UINTN               SavedDigestSize;
+  UINT16              BlobStatistics;
+  UINT32              BlobSize;
+
+  SavedDigestSize = sizeof (SavedDigest);
+  Status          = gRT->GetVariable (
+                           SMBIOS_BLOB_DIGEST_VAR_NAME,
+                           &gSmbiosBlobsTransferGuid,
+                           NULL,
+                           &SavedDigestSize,
+                           &SavedDigest
+                           );
+  if (EFI_ERROR (Status) || (SavedDigestSize != sizeof (SavedDigest))) {
+    return FALSE;
+  }
+
+  if (  (SavedDigest.BlobSize != BlobDigest->BlobSize)
+     || (CompareMem (SavedDigest.Digest, BlobDigest->Digest, SHA256_DIGEST_SIZE) != 0))
+  {
+    return FALSE;
+  }
+
+  BlobStatistics = 0;
+  BlobSize       = 0;
+  Status         = IpmiBlobGetStatistics (
+                     IanaNumber,
+                     (VOID *)SMBIOS_BLOBS_ID,
+                     sizeof (SMBIOS_BLOBS_ID),
+                     &BlobStatistics,
+                     &BlobSize,
+                     NULL,
+                     NULL
+                     );
+  if (EFI_ERROR (Status) || (BlobSize != SavedDigest.BlobSize)) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 EFI_STATUS
 SmbiosBlobsDiscover (
   OUT UINT8  *IanaNumber
@@ -236,7 +363,7 @@ WriteSmbiosDataToBmc (
     return Status;
   }
 
-  return EFI_UNSUPPORTED;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -255,16 +382,29 @@ SmbiosBlobTransfer (
   IN VOID       *Context
   )
 {
-  EFI_STATUS  Status;
-  UINT16      SessionId;
-  UINT8       IanaNumber[IANA_OEM_NUMBER_SIZE];
-  UINTN       SessionIdSize;
+  EFI_STATUS          Status;
+  UINT16              SessionId;
+  UINT8               IanaNumber[IANA_OEM_NUMBER_SIZE];
+  UINTN               SessionIdSize;
+  SMBIOS_BLOB_DIGEST  BlobDigest;
+  BOOLEAN             BlobDigestValid;
 
   Status = SmbiosBlobsDiscover (IanaNumber);
   if (EFI_ERROR (Status)) {
     return;
   }
 
+  //
+  // Transferring the table over SSIF takes seconds, skip it when the
+  // BMC already holds the same data.
+  //
+  Status          = GetSmbiosBlobDigest (&BlobDigest);
+  BlobDigestValid = !EFI_ERROR (Status);
+  if (BlobDigestValid && IsSmbiosBlobOnBmc (IanaNumber, &BlobDigest)) {
+    DEBUG ((DEBUG_INFO, "SMBIOS Transfer: BMC is up to date, skip transfer\n"));
+    return;
+  }
+
   Status = IpmiBlobOpen (
              IanaNumber,
              IPMI_BLOB_OPEN_TO_WRITE,
@@ -315,11 +455,39 @@ SmbiosBlobTransfer (
          &SessionId
          );
 
-  WriteSmbiosDataToBmc (IanaNumber, SessionId);
+  Status = WriteSmbiosDataToBmc (IanaNumber, SessionId);
+  if (!EFI_ERROR (Status)) {
+    Status = CommitSmbiosData (IanaNumber, SessionId);
+  }
 
-  Status = CommitSmbiosData (IanaNumber, SessionId);
   if (!EFI_ERROR (Status)) {
     DEBUG ((DEBUG_INIT, "SMBIOS Transfer successfully executes\n"));
+
+    //
+    // Save the digest of the committed data for the next boot
+    //
+    if (BlobDigestValid) {
+      gRT->SetVariable (
+             SMBIOS_BLOB_DIGEST_VAR_NAME,
+             &gSmbiosBlobsTransferGuid,
+             EFI_VARIABLE_NON_VOLATILE | EFI_VARIABLE_BOOTSERVICE_ACCESS,
+             sizeof (BlobDigest),
+             &BlobDigest
+             );
+    }
+  } else {
+    DEBUG ((DEBUG_ERROR, "SMBIOS Transfer: %r\n", Status));
+
+    //
+    // The BMC copy is in an unknown state, force a transfer on next boot
+    //
+    gRT->SetVariable (
+           SMBIOS_BLOB_DIGEST_VAR_NAME,
+           &gSmbiosBlobsTransferGuid,
+           0,
+           0,
+           NULL
+           );
   }
 
   //
@@ -345,6 +513,15 @@ SmbiosBlobsTransferEntryPoint (
   EFI_EVENT   SmbiosBlobTransferEvent;
   EFI_STATUS  Status;
 
+  //
+  // Without a context the digest is not computed and the table is always
+  // transferred.
+  //
+  mHashContext = AllocatePool (Sha256GetContextSize ());
+  if (mHashContext == NULL) {
+    DEBUG ((DEBUG_WARN, "SMBIOS Transfer: no hash context, transfer on every boot\n"));
+  }
+
   Status = gBS->CreateEventEx (
                   EVT_NOTIFY_SIGNAL,
                   TPL_NOTIFY,
@@ -21,4 +21,20 @@ PlatformBmcReady (
   VOID
   );
 
+/**
+  This function check the SSIF SMBALERT# signal of BMC, which the BMC
+  asserts when a response is ready to be read.
+
+  @param[out]  Asserted          TRUE if SMBALERT# is asserted.
+
+  @retval EFI_SUCCESS            Asserted is valid.
+  @retval EFI_UNSUPPORTED        SMBALERT# of BMC is not connected on this platform.
+
+**/
+EFI_STATUS
+EFIAPI
+PlatformBmcSsifAlert (
+  OUT BOOLEAN  *Asserted
+  );
+
 #endif /* PLATFORM_BMC_READY_LIB_H_ */
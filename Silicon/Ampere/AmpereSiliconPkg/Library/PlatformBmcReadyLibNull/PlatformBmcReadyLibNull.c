@@ -6,6 +6,8 @@
 
 **/
 
+#include <Uefi/UefiBaseType.h>
+
 /**
   This function check BMC ready via GPIO
 
@@ -21,3 +23,22 @@ PlatformBmcReady (
   // Set BMC always ready
   return TRUE;
 }
+
+/**
+  This function check the SSIF SMBALERT# signal of BMC, which the BMC
+  asserts when a response is ready to be read.
+
+  @param[out]  Asserted          TRUE if SMBALERT# is asserted.
+
+  @retval EFI_SUCCESS            Asserted is valid.
+  @retval EFI_UNSUPPORTED        SMBALERT# of BMC is not connected on this platform.
+
+**/
+EFI_STATUS
+EFIAPI
+PlatformBmcSsifAlert (
+  OUT BOOLEAN  *Asserted
+  )
+{
+  return EFI_UNSUPPORTED;
+}
@@ -10,6 +10,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/NetPerfAdapterInfoLib.h>
 
 #include "BcmGenetDxe.h"
 
@@ -23,14 +24,23 @@ GenetAipGetInformation (
   OUT UINTN                             *InformationBlockSize
   )
 {
-  EFI_ADAPTER_INFO_MEDIA_STATE  *AdapterInfo;
-  GENET_PRIVATE_DATA            *Genet;
+  EFI_ADAPTER_INFO_MEDIA_STATE    *AdapterInfo;
+  GENET_PRIVATE_DATA              *Genet;
+  EFI_STATUS                      Status;
 
   if (This == NULL || InformationBlock == NULL ||
       InformationBlockSize == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  Genet = GENET_PRIVATE_DATA_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipGetInformation (InformationType, &Genet->PerfCounters,
+             Genet->RaisedTplTicks, InformationBlock, InformationBlockSize);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (!CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_UNSUPPORTED;
   }
@@ -43,7 +53,6 @@ GenetAipGetInformation (
   *InformationBlock = AdapterInfo;
   *InformationBlockSize = sizeof (EFI_ADAPTER_INFO_MEDIA_STATE);
 
-  Genet = GENET_PRIVATE_DATA_FROM_AIP_THIS (This);
   AdapterInfo->MediaState = GenericPhyUpdateConfig (&Genet->Phy);
 
   return EFI_SUCCESS;
@@ -59,10 +68,21 @@ GenetAipSetInformation (
   IN  UINTN                             InformationBlockSize
   )
 {
+  GENET_PRIVATE_DATA  *Genet;
+  EFI_STATUS          Status;
+
   if (This == NULL || InformationBlock == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  Genet = GENET_PRIVATE_DATA_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipSetInformation (InformationType, &Genet->PerfCounters,
+             &Genet->RaisedTplTicks);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_WRITE_PROTECTED;
   }
@@ -79,24 +99,12 @@ GenetAipGetSupportedTypes (
   OUT UINTN                             *InfoTypesBufferCount
   )
 {
-  EFI_GUID    *Guid;
-
   if (This == NULL || InfoTypesBuffer == NULL ||
       InfoTypesBufferCount == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Guid = AllocatePool (sizeof *Guid);
-  if (Guid == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyGuid (Guid, &gEfiAdapterInfoMediaStateGuid);
-
-  *InfoTypesBuffer      = Guid;
-  *InfoTypesBufferCount = 1;
-
-  return EFI_SUCCESS;
+  return NetPerfAipGetSupportedTypes (InfoTypesBuffer, InfoTypesBufferCount);
 }
 
 CONST EFI_ADAPTER_INFORMATION_PROTOCOL gGenetAdapterInfoTemplate = {
@@ -12,6 +12,7 @@
 #define BCM_GENET_DXE_H__
 
 #include <Uefi.h>
+#include <Guid/NetPerfCountersAdapterInfo.h>
 #include <Library/UefiLib.h>
 #include <Protocol/BcmGenetPlatformDevice.h>
 #include <Protocol/AdapterInformation.h>
@@ -231,6 +232,9 @@ typedef struct {
   GENET_PHY_MODE                      PhyMode;
 
   UINTN                               RegBase;
+
+  NET_PERF_COUNTERS_ADAPTER_INFO      PerfCounters;
+  UINT64                              RaisedTplTicks;
 } GENET_PRIVATE_DATA;
 
 extern EFI_COMPONENT_NAME_PROTOCOL            gGenetComponentName;
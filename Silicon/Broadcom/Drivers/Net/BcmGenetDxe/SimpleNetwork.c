@@ -13,10 +13,30 @@
 #include <Library/DebugLib.h>
 #include <Library/DmaLib.h>
 #include <Library/NetLib.h>
+#include <Library/TimerLib.h>
 #include <Protocol/SimpleNetwork.h>
 
 #include "BcmGenetDxe.h"
 
+/**
+  Releases the driver lock, accounting the time spent holding it (and thus
+  running at raised TPL) in the performance counters.
+
+  @param  Genet     The driver instance.
+  @param  LockTicks Value of the performance counter when the lock was taken.
+
+**/
+STATIC
+VOID
+GenetReleaseLock (
+  IN GENET_PRIVATE_DATA *Genet,
+  IN UINT64             LockTicks
+  )
+{
+  Genet->RaisedTplTicks += GetPerformanceCounter () - LockTicks;
+  EfiReleaseLock (&Genet->Lock);
+}
+
 /**
   Changes the state of a network interface from "stopped" to "started".
 
@@ -497,6 +517,8 @@ GenetSimpleNetworkGetStatus (
     return EFI_DEVICE_ERROR;
   }
 
+  Genet->PerfCounters.StatusPolls++;
+
   Status = GenericPhyUpdateConfig (&Genet->Phy);
   if (EFI_ERROR (Status)) {
     Genet->SnpMode.MediaPresent = FALSE;
@@ -573,6 +595,7 @@ GenetSimpleNetworkTransmit (
   UINT8               Desc;
   PHYSICAL_ADDRESS    DmaDeviceAddress;
   UINTN               DmaNumberOfBytes;
+  UINT64              LockTicks;
 
   if (This == NULL || Buffer == NULL) {
     DEBUG ((DEBUG_ERROR, "%a: Invalid parameter (missing handle or buffer)\n",
@@ -620,9 +643,10 @@ GenetSimpleNetworkTransmit (
     DEBUG ((DEBUG_ERROR, "%a: Couldn't get lock: %r\n", __FUNCTION__, Status));
     return EFI_ACCESS_DENIED;
   }
+  LockTicks = GetPerformanceCounter ();
 
   if (Genet->TxQueued == GENET_DMA_DESC_COUNT - 1) {
-    EfiReleaseLock (&Genet->Lock);
+    GenetReleaseLock (Genet, LockTicks);
 
     DEBUG ((DEBUG_ERROR, "%a: Queue full\n", __FUNCTION__));
     return EFI_NOT_READY;
@@ -647,7 +671,7 @@ GenetSimpleNetworkTransmit (
                    &Genet->TxBufferMap[Desc]);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: DmaMap failed: %r\n", __FUNCTION__, Status));
-    EfiReleaseLock (&Genet->Lock);
+    GenetReleaseLock (Genet, LockTicks);
     return Status;
   }
 
@@ -655,7 +679,13 @@ GenetSimpleNetworkTransmit (
   GenetDmaTriggerTx (Genet, Desc, DmaDeviceAddress, DmaNumberOfBytes);
   Genet->TxQueued++;
 
-  EfiReleaseLock (&Genet->Lock);
+  Genet->PerfCounters.DmaMaps++;
+  Genet->PerfCounters.TxPackets++;
+  Genet->PerfCounters.TxRingOccupancySum += Genet->TxQueued;
+  Genet->PerfCounters.TxRingOccupancyMax = MAX (Genet->PerfCounters.TxRingOccupancyMax,
+                                                Genet->TxQueued);
+
+  GenetReleaseLock (Genet, LockTicks);
 
   return EFI_SUCCESS;
 }
@@ -709,6 +739,7 @@ GenetSimpleNetworkReceive (
   UINT8               DescIndex;
   UINT8               *Frame;
   UINTN               FrameLength;
+  UINT64              LockTicks;
 
   if (This == NULL || Buffer == NULL) {
     DEBUG ((DEBUG_ERROR, "%a: Invalid parameter (missing handle or buffer)\n",
@@ -729,10 +760,13 @@ GenetSimpleNetworkReceive (
     DEBUG ((DEBUG_ERROR, "%a: Couldn't get lock: %r\n", __FUNCTION__, Status));
     return EFI_ACCESS_DENIED;
   }
+  LockTicks = GetPerformanceCounter ();
+
+  Genet->PerfCounters.RxPolls++;
 
   Status = GenetRxIntr (Genet, &DescIndex, &FrameLength);
   if (EFI_ERROR (Status)) {
-    EfiReleaseLock (&Genet->Lock);
+    GenetReleaseLock (Genet, LockTicks);
     return Status;
   }
 
@@ -771,6 +805,10 @@ GenetSimpleNetworkReceive (
     CopyMem (Buffer, Frame, FrameLength);
     *BufferSize = FrameLength;
 
+    Genet->PerfCounters.RxPackets++;
+    Genet->PerfCounters.Copies++;
+    Genet->PerfCounters.CopyBytes += FrameLength;
+
     Status = EFI_SUCCESS;
   } else {
     DEBUG ((DEBUG_ERROR, "%a: Short packet (FrameLength 0x%X)",
@@ -779,6 +817,7 @@ GenetSimpleNetworkReceive (
   }
 
 out:
+  Genet->PerfCounters.DmaMaps++;
   Status = GenetDmaMapRxDescriptor (Genet, DescIndex);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a: Failed to remap RX descriptor!\n", __FUNCTION__));
@@ -786,7 +825,7 @@ out:
 
   GenetRxComplete (Genet);
 
-  EfiReleaseLock (&Genet->Lock);
+  GenetReleaseLock (Genet, LockTicks);
   return Status;
 }
 
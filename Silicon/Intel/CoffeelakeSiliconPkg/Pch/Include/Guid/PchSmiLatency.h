@@ -0,0 +1,83 @@
+/** @file
+  Definitions of the SMM communicate interface used to read the SMI latency
+  histograms collected by the PCH SMI dispatcher.
+
+  The dispatcher counts every dispatched source and every child handler it
+  calls. Time is measured in TSC ticks and is accumulated in a log2 histogram,
+  bucket N counts samples which took [2^N, 2^(N+1)) ticks.
+
+  The interface is read only, the data is collected only if
+  PcdSmiLatencyHistogramEnable is TRUE.
+
+  Copyright (c) 2026 Intel Corporation. All rights reserved. <BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#ifndef _PCH_SMI_LATENCY_H_
+#define _PCH_SMI_LATENCY_H_
+
+#define PCH_SMI_LATENCY_GUID \
+  { \
+    0xed27d550, 0x4ad1, 0x4aed, { 0xbd, 0xf2, 0x5c, 0x94, 0x9e, 0xe9, 0x41, 0xa5 } \
+  }
+
+extern EFI_GUID gPchSmiLatencyGuid;
+
+#define PCH_SMI_LATENCY_COMMAND_GET_INFO      0x1
+#define PCH_SMI_LATENCY_COMMAND_GET_DATA      0x2
+
+#define PCH_SMI_LATENCY_MAX_ENTRIES           64
+#define PCH_SMI_LATENCY_HISTOGRAM_BUCKETS     32
+
+///
+/// Kind of the latency entry
+///
+#define PCH_SMI_LATENCY_KIND_SOURCE           0x1   ///< Time from source detection to source clear, Id is the source status bit
+#define PCH_SMI_LATENCY_KIND_HANDLER          0x2   ///< Time spent in one child handler, Id is the handler address
+
+///
+/// Id of a PCH_SMI_LATENCY_KIND_SOURCE entry, built from the status bit description of the source
+///
+#define PCH_SMI_LATENCY_SOURCE_ID(AddrType, Address, Bit) \
+  (LShiftU64 ((UINT8) (AddrType), 48) | LShiftU64 ((UINT32) (Address), 8) | (UINT8) (Bit))
+
+typedef struct {
+  UINT32                    Kind;
+  UINT32                    ProtocolType;           ///< PCH_SMM_PROTOCOL_TYPE of the record
+  UINT64                    Id;
+  UINT64                    Count;
+  UINT64                    TotalTicks;
+  UINT64                    MaxTicks;
+  UINT32                    Histogram[PCH_SMI_LATENCY_HISTOGRAM_BUCKETS];
+} PCH_SMI_LATENCY_ENTRY;
+
+typedef struct {
+  UINT32                    Command;
+  UINT32                    Reserved;
+  UINT64                    ReturnStatus;
+} PCH_SMI_LATENCY_PARAMETER_HEADER;
+
+///
+/// PCH_SMI_LATENCY_COMMAND_GET_INFO
+///
+typedef struct {
+  PCH_SMI_LATENCY_PARAMETER_HEADER  Header;
+  UINT32                            EntryCount;     ///< Number of entries in use
+  UINT32                            DroppedCount;   ///< Samples not recorded because the table was full
+} PCH_SMI_LATENCY_PARAMETER_GET_INFO;
+
+///
+/// PCH_SMI_LATENCY_COMMAND_GET_DATA
+/// On input FirstEntry is the index of the first entry to return and EntryCount is the number
+/// of entries which fit in the buffer after this structure. On output EntryCount is the number
+/// of entries returned.
+///
+typedef struct {
+  PCH_SMI_LATENCY_PARAMETER_HEADER  Header;
+  UINT32                            FirstEntry;
+  UINT32                            EntryCount;
+//PCH_SMI_LATENCY_ENTRY             Entries[EntryCount];
+} PCH_SMI_LATENCY_PARAMETER_GET_DATA;
+
+#endif
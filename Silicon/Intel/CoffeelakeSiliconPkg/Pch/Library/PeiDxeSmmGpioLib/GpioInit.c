@@ -66,27 +66,42 @@ GpioDwRegValueFromGpioConfig (
     return;
   }
   //
-  // Update value to be programmed in HOSTSW_OWN register
+  // Records of one group are merged in table order, so the pad bit is
+  // cleared before a record sets it: a later record for the same pad
+  // replaces the value of an earlier one instead of being OR-ed into it.
   //
-  GroupDwData[DwNum].HostSoftOwnRegMask |= (GpioConfig->HostSoftPadOwn & 0x1) << PadBitPosition;
-  GroupDwData[DwNum].HostSoftOwnReg |= (GpioConfig->HostSoftPadOwn >> 0x1) << PadBitPosition;
 
   //
-  // Update value to be programmed in GPI_GPE_EN register
+  // Update value to be programmed in HOSTSW_OWN register
   //
-  GroupDwData[DwNum].GpiGpeEnRegMask |= (GpioConfig->InterruptConfig & 0x1) << PadBitPosition;
-  GroupDwData[DwNum].GpiGpeEnReg |= ((GpioConfig->InterruptConfig & GpioIntSci) >> 3) << PadBitPosition;
+  if ((GpioConfig->HostSoftPadOwn & 0x1) != 0) {
+    GroupDwData[DwNum].HostSoftOwnRegMask |= 0x1 << PadBitPosition;
+    GroupDwData[DwNum].HostSoftOwnReg &= ~(0x1 << PadBitPosition);
+    GroupDwData[DwNum].HostSoftOwnReg |= (GpioConfig->HostSoftPadOwn >> 0x1) << PadBitPosition;
+  }
 
-  //
-  // Update value to be programmed in GPI_NMI_EN register
-  //
-  GroupDwData[DwNum].GpiNmiEnRegMask |= (GpioConfig->InterruptConfig & 0x1) << PadBitPosition;
-  GroupDwData[DwNum].GpiNmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntNmi) >> 1) << PadBitPosition;
+  if ((GpioConfig->InterruptConfig & 0x1) != 0) {
+    //
+    // Update value to be programmed in GPI_GPE_EN register
+    //
+    GroupDwData[DwNum].GpiGpeEnRegMask |= 0x1 << PadBitPosition;
+    GroupDwData[DwNum].GpiGpeEnReg &= ~(0x1 << PadBitPosition);
+    GroupDwData[DwNum].GpiGpeEnReg |= ((GpioConfig->InterruptConfig & GpioIntSci) >> 3) << PadBitPosition;
 
-  //
-  // Update value to be programmed in GPI_SMI_EN register
-  GroupDwData[DwNum].GpiSmiEnRegMask |= (GpioConfig->InterruptConfig & 0x1) << PadBitPosition;
-  GroupDwData[DwNum].GpiSmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntSmi) >> 2) << PadBitPosition;
+    //
+    // Update value to be programmed in GPI_NMI_EN register
+    //
+    GroupDwData[DwNum].GpiNmiEnRegMask |= 0x1 << PadBitPosition;
+    GroupDwData[DwNum].GpiNmiEnReg &= ~(0x1 << PadBitPosition);
+    GroupDwData[DwNum].GpiNmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntNmi) >> 1) << PadBitPosition;
+
+    //
+    // Update value to be programmed in GPI_SMI_EN register
+    //
+    GroupDwData[DwNum].GpiSmiEnRegMask |= 0x1 << PadBitPosition;
+    GroupDwData[DwNum].GpiSmiEnReg &= ~(0x1 << PadBitPosition);
+    GroupDwData[DwNum].GpiSmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntSmi) >> 2) << PadBitPosition;
+  }
   if ((GpioConfig->InterruptConfig & GpioIntSmi) == GpioIntSmi) {
     GroupDwData[DwNum].HostSoftOwnRegMask |= 1 << PadBitPosition;
     GroupDwData[DwNum].HostSoftOwnReg |= 1 << PadBitPosition;
@@ -112,23 +127,53 @@ GpioDwRegValueFromGpioConfig (
   }
 }
 
+/**
+  Program GPIO register with masked value.
+  Register is not accessed at all if there is nothing to change in it and
+  it is written without a read if all bits are to be changed.
+
+  @param[in] Address        Register address
+  @param[in] Mask           Bitmask of register bits to be changed
+  @param[in] Value          Value for register bits set in Mask
+
+  @retval None
+**/
+STATIC
+VOID
+GpioWriteRegMasked (
+  IN UINTN                  Address,
+  IN UINT32                 Mask,
+  IN UINT32                 Value
+  )
+{
+  if ((Mask == 0) && (Value == 0)) {
+    return;
+  }
+
+  if (Mask == MAX_UINT32) {
+    MmioWrite32 (Address, Value);
+  } else {
+    MmioAndThenOr32 (Address, ~Mask, Value);
+  }
+}
+
 /**
   This internal procedure will scan GPIO initialization table and unlock
-  all pads present in it
+  all pads present in it which belong to given group
 
   @param[in] NumberOfItem               Number of GPIO pad records in table
   @param[in] GpioInitTableAddress       GPIO initialization table
-  @param[in] Index                      Index of GPIO Initialization table record
+  @param[in] GroupIndex                 GPIO group index
 
   @retval EFI_SUCCESS                   The function completed successfully
-  @retval EFI_INVALID_PARAMETER         Invalid group or pad number
+  @retval EFI_UNSUPPORTED               Pad number is out of supported range
 **/
 STATIC
 EFI_STATUS
 GpioUnlockPadsForAGroup (
   IN UINT32                    NumberOfItems,
   IN GPIO_INIT_CONFIG          *GpioInitTableAddress,
-  IN UINT32                    Index
+  IN UINT32                    GroupIndex
   )
 {
   UINT32                 PadsToUnlock[GPIO_GROUP_DW_NUMBER];
@@ -138,39 +183,26 @@ GpioUnlockPadsForAGroup (
   UINT32                 GpioGroupInfoLength;
   CONST GPIO_INIT_CONFIG *GpioData;
   GPIO_GROUP             Group;
-  UINT32                 GroupIndex;
+  UINT32                 Index;
   UINT32                 PadNumber;
 
   GpioGroupInfo = GpioGetGroupInfoTable (&GpioGroupInfoLength);
-
-  GpioData   = &GpioInitTableAddress[Index];
-  Group      = GpioGetGroupFromGpioPad (GpioData->GpioPad);
-  GroupIndex = GpioGetGroupIndexFromGpioPad (GpioData->GpioPad);
+  Group         = GpioGetGroupFromGroupIndex (GroupIndex);
 
   ZeroMem (PadsToUnlock, sizeof (PadsToUnlock));
   //
-  // Loop through pads for one group. If pad belongs to a different group then
-  // break and move to register programming.
+  // Collect all pads of this group, regardless of their position in the table
   //
-  while (Index < NumberOfItems) {
+  for (Index = 0; Index < NumberOfItems; Index++) {
 
     GpioData   = &GpioInitTableAddress[Index];
     if (GroupIndex != GpioGetGroupIndexFromGpioPad (GpioData->GpioPad)) {
-      //if next pad is from different group then break loop
-      break;
-    }
-
-    PadNumber  = GpioGetPadNumberFromGpioPad (GpioData->GpioPad);
-    //
-    // Check if legal pin number
-    //
-    if (PadNumber >= GpioGroupInfo[GroupIndex].PadPerGroup) {
-      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Pin number (%d) exceeds possible range for group %d\n", PadNumber, GroupIndex));
-      return EFI_INVALID_PARAMETER;
+      continue;
     }
 
+    PadNumber      = GpioGetPadNumberFromGpioPad (GpioData->GpioPad);
     PadBitPosition = GPIO_GET_PAD_POSITION (PadNumber);
-    DwNum = GPIO_GET_DW_NUM (PadNumber);
+    DwNum          = GPIO_GET_DW_NUM (PadNumber);
 
     if (DwNum >= GPIO_GROUP_DW_NUMBER) {
       ASSERT (FALSE);
@@ -180,9 +212,6 @@ GpioUnlockPadsForAGroup (
     // Update pads which need to be unlocked
     //
     PadsToUnlock[DwNum] |= 0x1 << PadBitPosition;
-
-    //Move to next item
-    Index++;
   }
 
   for (DwNum = 0; DwNum <= GPIO_GET_DW_NUM (GpioGroupInfo[GroupIndex].PadPerGroup); DwNum++) {
@@ -201,6 +230,14 @@ GpioUnlockPadsForAGroup (
 /**
   This procedure will initialize multiple PCH GPIO pins
 
+  The whole table is first checked without writing any register, then the
+  groups it uses are programmed in the order they first appear in the table.
+  Each group is programmed in one go: its pads are unlocked, all its PADCFG
+  registers are written and its HOSTSW_OWN, GPE_EN, NMI_EN and SMI_EN
+  registers are written once. Pads of one group do not need to be adjacent
+  in the table; records of a group are applied in table order so a later
+  record for the same pad still overrides an earlier one.
+
   @param[in] NumberofItem               Number of GPIO pads to be updated
   @param[in] GpioInitTableAddress       GPIO initialization table
 
@@ -225,19 +262,31 @@ GpioConfigurePch (
   GPIO_PAD_OWN           PadOwnVal;
   CONST GPIO_INIT_CONFIG *GpioData;
   UINT32                 GroupIndex;
+  UINT32                 GroupsToConfigure;
+  UINT32                 GroupOrder[32];
+  UINT32                 GroupCount;
+  UINT32                 GroupOrderIndex;
+  UINT32                 PadsNotOwned[32][GPIO_GROUP_DW_NUMBER];
   UINT32                 PadNumber;
   PCH_SBI_PID            GpioCom;
 
   PadOwnVal = GpioPadOwnHost;
 
   GpioGroupInfo = GpioGetGroupInfoTable (&GpioGroupInfoLength);
+  ASSERT (GpioGroupInfoLength <= 32);
 
-  Index = 0;
-  while (Index < NumberOfItems) {
+  //
+  // Validate the whole table before any register is touched and
+  // collect groups which are going to be configured, in table order
+  //
+  GroupsToConfigure = 0;
+  GroupCount        = 0;
+  ZeroMem (PadsNotOwned, sizeof (PadsNotOwned));
+  for (Index = 0; Index < NumberOfItems; Index++) {
 
     GpioData   = &GpioInitTableAddress[Index];
     GroupIndex = GpioGetGroupIndexFromGpioPad (GpioData->GpioPad);
-    GpioCom    = GpioGroupInfo[GroupIndex].Community;
+    PadNumber  = GpioGetPadNumberFromGpioPad (GpioData->GpioPad);
 
     DEBUG_CODE_BEGIN();
     if (!GpioIsCorrectPadForThisChipset (GpioData->GpioPad)) {
@@ -247,6 +296,59 @@ GpioConfigurePch (
     }
     DEBUG_CODE_END ();
 
+    //
+    // Check if legal group and pin number
+    //
+    if (GroupIndex >= GpioGroupInfoLength) {
+      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Group argument (%d) exceeds GPIO group range\n", GroupIndex));
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (PadNumber >= GpioGroupInfo[GroupIndex].PadPerGroup) {
+      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Pin number (%d) exceeds possible range for group %d\n", PadNumber, GroupIndex));
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (GPIO_GET_DW_NUM (PadNumber) >= GPIO_GROUP_DW_NUMBER) {
+      ASSERT (FALSE);
+      return EFI_UNSUPPORTED;
+    }
+
+    DEBUG_CODE_BEGIN ();
+    //
+    // Check if selected GPIO Pad is not owned by CSME/ISH
+    //
+    GpioGetPadOwnership (GpioData->GpioPad, &PadOwnVal);
+
+    if (PadOwnVal != GpioPadOwnHost) {
+      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Accessing pad not owned by host (Group=%d, Pad=%d)!\n", GroupIndex, PadNumber));
+      DEBUG ((DEBUG_ERROR, "** Please make sure the GPIO usage in sync between CSME and BIOS configuration. \n"));
+      DEBUG ((DEBUG_ERROR, "** All the GPIO occupied by CSME should not do any configuration by BIOS.\n"));
+      PadsNotOwned[GroupIndex][GPIO_GET_DW_NUM (PadNumber)] |= 0x1 << GPIO_GET_PAD_POSITION (PadNumber);
+    } else {
+      //
+      // Check if Pad enabled for SCI is to be in unlocked state
+      //
+      if (((GpioData->GpioConfig.InterruptConfig & GpioIntSci) == GpioIntSci) &&
+          ((GpioData->GpioConfig.LockConfig & B_GPIO_LOCK_CONFIG_PAD_CONF_LOCK_MASK) != GpioPadConfigUnlock)){
+        DEBUG ((DEBUG_ERROR, "GPIO ERROR: %a used for SCI is not unlocked!\n", GpioName (GpioData->GpioPad)));
+        ASSERT (FALSE);
+        return EFI_INVALID_PARAMETER;
+      }
+    }
+    DEBUG_CODE_END ();
+
+    if ((GroupsToConfigure & (0x1 << GroupIndex)) == 0) {
+      GroupsToConfigure |= 0x1 << GroupIndex;
+      GroupOrder[GroupCount++] = GroupIndex;
+    }
+  }
+
+  for (GroupOrderIndex = 0; GroupOrderIndex < GroupCount; GroupOrderIndex++) {
+
+    GroupIndex = GroupOrder[GroupOrderIndex];
+    GpioCom    = GpioGroupInfo[GroupIndex].Community;
+
     //
     // Unlock pads for a given group which are going to be reconfigured
     //
@@ -257,57 +359,29 @@ GpioConfigurePch (
     // PadRstCfg != Powergood GpioPad will have its configuration locked despite it being not the
     // one desired by BIOS. Before reconfiguring all pads they will get unlocked.
     //
-    GpioUnlockPadsForAGroup (NumberOfItems, GpioInitTableAddress, Index);
+    GpioUnlockPadsForAGroup (NumberOfItems, GpioInitTableAddress, GroupIndex);
 
     ZeroMem (GroupDwData, sizeof (GroupDwData));
     //
-    // Loop through pads for one group. If pad belongs to a different group then
-    // break and move to register programming.
+    // Loop through all pads of one group and program their PADCFG registers.
+    // DW registers values are accumulated and programmed after that.
     //
-    while (Index < NumberOfItems) {
+    for (Index = 0; Index < NumberOfItems; Index++) {
 
       GpioData   = &GpioInitTableAddress[Index];
       if (GroupIndex != GpioGetGroupIndexFromGpioPad (GpioData->GpioPad)) {
-        //if next pad is from different group then break loop
-        break;
+        continue;
       }
 
       PadNumber  = GpioGetPadNumberFromGpioPad (GpioData->GpioPad);
 
-      DEBUG_CODE_BEGIN ();
       //
-      // Check if legal pin number
+      // Skip pads found not owned by host while validating the table
       //
-      if (PadNumber >= GpioGroupInfo[GroupIndex].PadPerGroup) {
-        DEBUG ((DEBUG_ERROR, "GPIO ERROR: Pin number (%d) exceeds possible range for group %d\n", PadNumber, GroupIndex));
-        return EFI_INVALID_PARAMETER;
-      }
-
-      //
-      // Check if selected GPIO Pad is not owned by CSME/ISH
-      //
-      GpioGetPadOwnership (GpioData->GpioPad, &PadOwnVal);
-
-      if (PadOwnVal != GpioPadOwnHost) {
-        DEBUG ((DEBUG_ERROR, "GPIO ERROR: Accessing pad not owned by host (Group=%d, Pad=%d)!\n", GroupIndex, PadNumber));
-        DEBUG ((DEBUG_ERROR, "** Please make sure the GPIO usage in sync between CSME and BIOS configuration. \n"));
-        DEBUG ((DEBUG_ERROR, "** All the GPIO occupied by CSME should not do any configuration by BIOS.\n"));
-        //Move to next item
-        Index++;
+      if ((PadsNotOwned[GroupIndex][GPIO_GET_DW_NUM (PadNumber)] & (0x1 << GPIO_GET_PAD_POSITION (PadNumber))) != 0) {
         continue;
       }
 
-      //
-      // Check if Pad enabled for SCI is to be in unlocked state
-      //
-      if (((GpioData->GpioConfig.InterruptConfig & GpioIntSci) == GpioIntSci) &&
-          ((GpioData->GpioConfig.LockConfig & B_GPIO_LOCK_CONFIG_PAD_CONF_LOCK_MASK) != GpioPadConfigUnlock)){
-        DEBUG ((DEBUG_ERROR, "GPIO ERROR: %a used for SCI is not unlocked!\n", GpioName (GpioData->GpioPad)));
-        ASSERT (FALSE);
-        return EFI_INVALID_PARAMETER;
-      }
-      DEBUG_CODE_END ();
-
       ZeroMem (PadCfgDwReg, sizeof (PadCfgDwReg));
       ZeroMem (PadCfgDwRegMask, sizeof (PadCfgDwRegMask));
       //
@@ -326,31 +400,11 @@ GpioConfigurePch (
       PadCfgReg = S_GPIO_PCR_PADCFG * PadNumber + GpioGroupInfo[GroupIndex].PadCfgOffset;
 
       //
-      // Write PADCFG DW0 register
+      // Write PADCFG DW0, DW1 and DW2 registers
       //
-      MmioAndThenOr32 (
-        PCH_PCR_ADDRESS (GpioCom, PadCfgReg),
-        ~PadCfgDwRegMask[0],
-        PadCfgDwReg[0]
-        );
-
-      //
-      // Write PADCFG DW1 register
-      //
-      MmioAndThenOr32 (
-        PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x4),
-        ~PadCfgDwRegMask[1],
-        PadCfgDwReg[1]
-        );
-
-      //
-      // Write PADCFG DW2 register
-      //
-      MmioAndThenOr32 (
-        PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x8),
-        ~PadCfgDwRegMask[2],
-        PadCfgDwReg[2]
-        );
+      GpioWriteRegMasked (PCH_PCR_ADDRESS (GpioCom, PadCfgReg), PadCfgDwRegMask[0], PadCfgDwReg[0]);
+      GpioWriteRegMasked (PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x4), PadCfgDwRegMask[1], PadCfgDwReg[1]);
+      GpioWriteRegMasked (PCH_PCR_ADDRESS (GpioCom, PadCfgReg + 0x8), PadCfgDwRegMask[2], PadCfgDwReg[2]);
 
       //
       // Get GPIO DW register values from GPIO config data
@@ -360,9 +414,6 @@ GpioConfigurePch (
         &GpioData->GpioConfig,
         GroupDwData
         );
-
-      //Move to next item
-      Index++;
     }
 
     for (DwNum = 0; DwNum <= GPIO_GET_DW_NUM (GpioGroupInfo[GroupIndex].PadPerGroup); DwNum++) {
@@ -370,9 +421,9 @@ GpioConfigurePch (
       // Write HOSTSW_OWN registers
       //
       if (GpioGroupInfo[GroupIndex].HostOwnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].HostOwnOffset + DwNum * 0x4),
-          ~GroupDwData[DwNum].HostSoftOwnRegMask,
+          GroupDwData[DwNum].HostSoftOwnRegMask,
           GroupDwData[DwNum].HostSoftOwnReg
           );
       }
@@ -381,9 +432,9 @@ GpioConfigurePch (
       // Write GPI_GPE_EN registers
       //
       if (GpioGroupInfo[GroupIndex].GpiGpeEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].GpiGpeEnOffset + DwNum * 0x4),
-          ~GroupDwData[DwNum].GpiGpeEnRegMask,
+          GroupDwData[DwNum].GpiGpeEnRegMask,
           GroupDwData[DwNum].GpiGpeEnReg
           );
       }
@@ -392,9 +443,9 @@ GpioConfigurePch (
       // Write GPI_NMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].NmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].NmiEnOffset + DwNum * 0x4),
-          ~GroupDwData[DwNum].GpiNmiEnRegMask,
+          GroupDwData[DwNum].GpiNmiEnRegMask,
           GroupDwData[DwNum].GpiNmiEnReg
           );
       } else if (GroupDwData[DwNum].GpiNmiEnReg != 0x0) {
@@ -406,9 +457,9 @@ GpioConfigurePch (
       // Write GPI_SMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].SmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioCom, GpioGroupInfo[GroupIndex].SmiEnOffset + DwNum * 0x4),
-          ~GroupDwData[DwNum].GpiSmiEnRegMask,
+          GroupDwData[DwNum].GpiSmiEnRegMask,
           GroupDwData[DwNum].GpiSmiEnReg
           );
       } else if (GroupDwData[DwNum].GpiSmiEnReg != 0x0) {
@@ -528,8 +579,8 @@ GpioClearAllGpioInterrupts (
   Pad not configured using GPIO_INIT_CONFIG will be left with hardware default values.
   Separate fields could be set to hardware default if it does not matter, except
   GpioPad and PadMode.
-  Function will work in most efficient way if pads which belong to the same group are
-  placed in adjacent records of the table.
+  Pads which belong to the same group are programmed together, so records in the table
+  do not need to be ordered by group.
   Although function can enable pads for Native mode, such programming is done
   by reference code when enabling related silicon feature.
 
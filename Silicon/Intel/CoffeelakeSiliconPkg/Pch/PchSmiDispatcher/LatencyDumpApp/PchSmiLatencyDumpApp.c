@@ -0,0 +1,321 @@
+/** @file
+  Shell application dumping the SMI latency histograms collected by the PCH
+  SMI dispatcher when PcdSmiLatencyHistogramEnable is TRUE.
+
+  For every SMI source and child handler it prints the number of calls and the
+  mean, p99 and max latency in microseconds. The p99 value is the upper bound
+  of the log2 histogram bucket holding the 99th percentile, so it is an upper
+  estimate within a factor of two.
+
+  Copyright (c) 2026 Intel Corporation. All rights reserved. <BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/DebugLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Library/UefiLib.h>
+#include <Protocol/SmmCommunication.h>
+#include <Guid/PiSmmCommunicationRegionTable.h>
+#include <Guid/PchSmiLatency.h>
+
+///
+/// Names of PCH_SMM_PROTOCOL_TYPE values
+///
+GLOBAL_REMOVE_IF_UNREFERENCED CHAR16 *mProtocolTypeName[] = {
+  L"Usb",
+  L"Sx",
+  L"Sw",
+  L"Gpi",
+  L"PowerButton",
+  L"PeriodicTimer",
+  L"PchSmi"
+};
+
+/**
+  Measure the TSC frequency.
+
+  @retval TSC frequency in Hz
+**/
+UINT64
+GetTscFrequency (
+  VOID
+  )
+{
+  UINT64                          StartTsc;
+  UINT64                          EndTsc;
+
+  StartTsc = AsmReadTsc ();
+  gBS->Stall (10000);
+  EndTsc = AsmReadTsc ();
+
+  return MultU64x32 (EndTsc - StartTsc, 100);
+}
+
+/**
+  Convert TSC ticks to microseconds.
+
+  @param[in] Ticks                TSC ticks
+  @param[in] Frequency            TSC frequency in Hz
+
+  @retval Number of microseconds
+**/
+UINT64
+TicksToMicroseconds (
+  IN UINT64                       Ticks,
+  IN UINT64                       Frequency
+  )
+{
+  return DivU64x64Remainder (MultU64x32 (Ticks, 1000000), Frequency, NULL);
+}
+
+/**
+  Get the 99th percentile latency of one entry from its histogram.
+
+  @param[in] Entry                Latency entry
+
+  @retval Upper bound of the bucket holding the 99th percentile, in ticks
+**/
+UINT64
+GetP99Ticks (
+  IN PCH_SMI_LATENCY_ENTRY        *Entry
+  )
+{
+  UINT64                          Target;
+  UINT64                          Sum;
+  UINTN                           Index;
+  UINT64                          UpperBound;
+
+  Target = DivU64x32 (MultU64x32 (Entry->Count, 99) + 99, 100);
+  Sum    = 0;
+  for (Index = 0; Index < PCH_SMI_LATENCY_HISTOGRAM_BUCKETS; Index++) {
+    Sum += Entry->Histogram[Index];
+    if (Sum >= Target) {
+      UpperBound = LShiftU64 (1, Index + 1);
+      return MIN (UpperBound, Entry->MaxTicks);
+    }
+  }
+
+  //
+  // The histogram counters saturated, fall back to the max
+  //
+  return Entry->MaxTicks;
+}
+
+/**
+  Send one request to the SMI latency communicate handler.
+
+  @param[in] SmmCommunication     SMM communication protocol
+  @param[in] CommBuffer           Communicate buffer, the request follows the communicate header
+  @param[in] MessageLength        Size of the request
+
+  @retval EFI_SUCCESS             The request is handled.
+  @retval others                  The request failed.
+**/
+EFI_STATUS
+SendLatencyRequest (
+  IN EFI_SMM_COMMUNICATION_PROTOCOL  *SmmCommunication,
+  IN UINT8                           *CommBuffer,
+  IN UINTN                           MessageLength
+  )
+{
+  EFI_STATUS                         Status;
+  EFI_SMM_COMMUNICATE_HEADER         *CommHeader;
+  PCH_SMI_LATENCY_PARAMETER_HEADER   *Header;
+  UINTN                              CommSize;
+
+  CommHeader = (EFI_SMM_COMMUNICATE_HEADER *) CommBuffer;
+  CopyMem (&CommHeader->HeaderGuid, &gPchSmiLatencyGuid, sizeof (gPchSmiLatencyGuid));
+  CommHeader->MessageLength = MessageLength;
+
+  Header = (PCH_SMI_LATENCY_PARAMETER_HEADER *) &CommBuffer[OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data)];
+  Header->ReturnStatus = (UINT64) -1;
+
+  CommSize = OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data) + MessageLength;
+  Status = SmmCommunication->Communicate (SmmCommunication, CommBuffer, &CommSize);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (Header->ReturnStatus != 0) {
+    return EFI_PROTOCOL_ERROR;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Print one latency entry.
+
+  @param[in] Entry                Latency entry
+  @param[in] Frequency            TSC frequency in Hz
+**/
+VOID
+DumpLatencyEntry (
+  IN PCH_SMI_LATENCY_ENTRY        *Entry,
+  IN UINT64                       Frequency
+  )
+{
+  CHAR16                          *TypeName;
+  UINT64                          MeanTicks;
+
+  if (Entry->Count == 0) {
+    return;
+  }
+
+  TypeName = L"Unknown";
+  if (Entry->ProtocolType < ARRAY_SIZE (mProtocolTypeName)) {
+    TypeName = mProtocolTypeName[Entry->ProtocolType];
+  }
+
+  MeanTicks = DivU64x64Remainder (Entry->TotalTicks, Entry->Count, NULL);
+
+  Print (
+    L"%-8s %-14s 0x%016lx %10ld %10ld %10ld %10ld\n",
+    (Entry->Kind == PCH_SMI_LATENCY_KIND_SOURCE) ? L"Source" : L"Handler",
+    TypeName,
+    Entry->Id,
+    Entry->Count,
+    TicksToMicroseconds (MeanTicks, Frequency),
+    TicksToMicroseconds (GetP99Ticks (Entry), Frequency),
+    TicksToMicroseconds (Entry->MaxTicks, Frequency)
+    );
+}
+
+/**
+  Read the SMI latency data and print it.
+
+  @param[in] ImageHandle          The firmware allocated handle for the EFI image.
+  @param[in] SystemTable          A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS             The data is dumped.
+  @retval others                  The data is not available.
+**/
+EFI_STATUS
+EFIAPI
+PchSmiLatencyDumpAppEntryPoint (
+  IN EFI_HANDLE                   ImageHandle,
+  IN EFI_SYSTEM_TABLE             *SystemTable
+  )
+{
+  EFI_STATUS                                Status;
+  EFI_SMM_COMMUNICATION_PROTOCOL            *SmmCommunication;
+  EDKII_PI_SMM_COMMUNICATION_REGION_TABLE   *PiSmmCommunicationRegionTable;
+  EFI_MEMORY_DESCRIPTOR                     *Entry;
+  UINT32                                    Index;
+  UINTN                                     Size;
+  UINTN                                     MinimalSizeNeeded;
+  UINT8                                     *CommBuffer;
+  PCH_SMI_LATENCY_PARAMETER_GET_INFO        *CommGetInfo;
+  PCH_SMI_LATENCY_PARAMETER_GET_DATA        *CommGetData;
+  PCH_SMI_LATENCY_ENTRY                     *LatencyEntries;
+  UINT32                                    EntryCount;
+  UINT32                                    DroppedCount;
+  UINT32                                    EntriesPerRequest;
+  UINT32                                    EntryIndex;
+  UINT64                                    Frequency;
+
+  Status = gBS->LocateProtocol (&gEfiSmmCommunicationProtocolGuid, NULL, (VOID **) &SmmCommunication);
+  if (EFI_ERROR (Status)) {
+    Print (L"PchSmiLatencyDump: Locate SmmCommunication protocol - %r\n", Status);
+    return Status;
+  }
+
+  //
+  // The communicate buffer must hold the GET_DATA request and at least one entry
+  //
+  MinimalSizeNeeded = OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data) +
+                      sizeof (PCH_SMI_LATENCY_PARAMETER_GET_DATA) +
+                      sizeof (PCH_SMI_LATENCY_ENTRY);
+
+  Status = EfiGetSystemConfigurationTable (
+             &gEdkiiPiSmmCommunicationRegionTableGuid,
+             (VOID **) &PiSmmCommunicationRegionTable
+             );
+  if (EFI_ERROR (Status)) {
+    Print (L"PchSmiLatencyDump: Get PiSmmCommunicationRegionTable - %r\n", Status);
+    return Status;
+  }
+
+  Entry = (EFI_MEMORY_DESCRIPTOR *) (PiSmmCommunicationRegionTable + 1);
+  Size  = 0;
+  for (Index = 0; Index < PiSmmCommunicationRegionTable->NumberOfEntries; Index++) {
+    if (Entry->Type == EfiConventionalMemory) {
+      Size = EFI_PAGES_TO_SIZE ((UINTN) Entry->NumberOfPages);
+      if (Size >= MinimalSizeNeeded) {
+        break;
+      }
+    }
+    Entry = (EFI_MEMORY_DESCRIPTOR *) ((UINT8 *) Entry + PiSmmCommunicationRegionTable->DescriptorSize);
+  }
+  if (Index == PiSmmCommunicationRegionTable->NumberOfEntries) {
+    Print (L"PchSmiLatencyDump: No communicate buffer large enough\n");
+    return EFI_OUT_OF_RESOURCES;
+  }
+  CommBuffer = (UINT8 *) (UINTN) Entry->PhysicalStart;
+
+  //
+  // Get the number of entries
+  //
+  CommGetInfo = (PCH_SMI_LATENCY_PARAMETER_GET_INFO *) &CommBuffer[OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data)];
+  ZeroMem (CommGetInfo, sizeof (*CommGetInfo));
+  CommGetInfo->Header.Command = PCH_SMI_LATENCY_COMMAND_GET_INFO;
+  Status = SendLatencyRequest (SmmCommunication, CommBuffer, sizeof (*CommGetInfo));
+  if (EFI_ERROR (Status)) {
+    Print (L"PchSmiLatencyDump: GetInfo - %r, is PcdSmiLatencyHistogramEnable set?\n", Status);
+    return Status;
+  }
+  EntryCount   = CommGetInfo->EntryCount;
+  DroppedCount = CommGetInfo->DroppedCount;
+
+  LatencyEntries = AllocateZeroPool (MAX (EntryCount, 1) * sizeof (PCH_SMI_LATENCY_ENTRY));
+  if (LatencyEntries == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // Get the entries, as many as fit in the communicate buffer per request
+  //
+  EntriesPerRequest = (UINT32) ((Size - OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data) - sizeof (PCH_SMI_LATENCY_PARAMETER_GET_DATA)) /
+                                sizeof (PCH_SMI_LATENCY_ENTRY));
+  CommGetData = (PCH_SMI_LATENCY_PARAMETER_GET_DATA *) &CommBuffer[OFFSET_OF (EFI_SMM_COMMUNICATE_HEADER, Data)];
+  EntryIndex  = 0;
+  while (EntryIndex < EntryCount) {
+    ZeroMem (CommGetData, sizeof (*CommGetData));
+    CommGetData->Header.Command = PCH_SMI_LATENCY_COMMAND_GET_DATA;
+    CommGetData->FirstEntry     = EntryIndex;
+    CommGetData->EntryCount     = MIN (EntriesPerRequest, EntryCount - EntryIndex);
+    Status = SendLatencyRequest (
+               SmmCommunication,
+               CommBuffer,
+               sizeof (*CommGetData) + CommGetData->EntryCount * sizeof (PCH_SMI_LATENCY_ENTRY)
+               );
+    if (EFI_ERROR (Status) || (CommGetData->EntryCount == 0)) {
+      break;
+    }
+    CopyMem (
+      &LatencyEntries[EntryIndex],
+      CommGetData + 1,
+      CommGetData->EntryCount * sizeof (PCH_SMI_LATENCY_ENTRY)
+      );
+    EntryIndex += CommGetData->EntryCount;
+  }
+
+  Frequency = GetTscFrequency ();
+
+  Print (L"PCH SMI latency, TSC frequency %ld Hz, times in microseconds\n", Frequency);
+  Print (L"%-8s %-14s %-18s %10s %10s %10s %10s\n", L"Kind", L"Type", L"Id", L"Count", L"Mean", L"P99", L"Max");
+  for (Index = 0; Index < EntryIndex; Index++) {
+    DumpLatencyEntry (&LatencyEntries[Index], Frequency);
+  }
+  if (DroppedCount != 0) {
+    Print (L"%d samples dropped, the latency table is full\n", DroppedCount);
+  }
+
+  FreePool (LatencyEntries);
+  return Status;
+}
@@ -9,6 +9,7 @@
 #include "PchSmmHelpers.h"
 #include <Library/SmiHandlerProfileLib.h>
 #include <Private/Library/PmcPrivateLib.h>
+#include <Guid/PchSmiLatency.h>
 #include <Register/PchRegs.h>
 #include <Register/PchRegsPcr.h>
 #include <Register/PchRegsPmc.h>
@@ -2197,9 +2198,19 @@ PchSmiTypeCallbackDispatcher (
   PCH_SMI_TYPES                         PchSmiType;
   UINTN                                 RpIndex;
   PCH_PCIE_SMI_RP_CONTEXT               RpContext;
+  UINT64                                StartTsc;
+  UINT64                                HandlerId;
 
   PchSmiType = Record->PchSmiType;
   Status     = EFI_SUCCESS;
+  StartTsc   = 0;
+  //
+  // The record might be unregistered by its callback, keep what is needed to account the call
+  //
+  HandlerId  = (UINT64) (UINTN) Record->PchSmiCallback;
+  if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+    StartTsc = AsmReadTsc ();
+  }
 
   switch (PchSmiType) {
     case PchTcoSmiMchType:
@@ -2243,6 +2254,10 @@ PchSmiTypeCallbackDispatcher (
       break;
   }
 
+  if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+    PchSmmLatencyRecord (PCH_SMI_LATENCY_KIND_HANDLER, PchSmiDispatchType, HandlerId, StartTsc);
+  }
+
   return Status;
 }
 
@@ -29,6 +29,7 @@
 #include <Library/SmmServicesTableLib.h>
 #include <Library/ReportStatusCodeLib.h>
 #include <Library/PerformanceLib.h>
+#include <Library/PcdLib.h>
 #include <Protocol/SmmReadyToLock.h>
 #include <IndustryStandard/Pci30.h>
 #include <Library/PchCycleDecodingLib.h>
@@ -415,6 +416,15 @@ struct _DATABASE_RECORD {
   LIST_ENTRY                    Link;
   BOOLEAN                       Processed;
   ///
+  /// Link and index of the SMI_STS bucket the record is kept in
+  ///
+  LIST_ENTRY                    SmiStsLink;
+  UINTN                         SmiStsBucket;
+  ///
+  /// Registration sequence number, the active record registered first is dispatched first
+  ///
+  UINTN                         RegisterOrder;
+  ///
   /// Status and Enable bit description
   ///
   PCH_SMM_SOURCE_DESC           SrcDesc;
@@ -458,6 +468,15 @@ struct _DATABASE_RECORD {
 
 #define DATABASE_RECORD_FROM_LINK(_record)  CR (_record, DATABASE_RECORD, Link, DATABASE_RECORD_SIGNATURE)
 #define DATABASE_RECORD_FROM_CHILDCONTEXT(_record)  CR (_record, DATABASE_RECORD, ChildContext, DATABASE_RECORD_SIGNATURE)
+#define DATABASE_RECORD_FROM_SMI_STS_LINK(_record)  CR (_record, DATABASE_RECORD, SmiStsLink, DATABASE_RECORD_SIGNATURE)
+
+///
+/// Besides CallbackDataBase every record is kept in one SMI_STS bucket, selected by the
+/// top level PMC SMI_STS bit of its source. Records without such bit are kept in the last
+/// bucket, which is checked on every SMI.
+///
+#define PCH_SMM_SMI_STS_BUCKET_OTHER  32
+#define PCH_SMM_SMI_STS_BUCKET_COUNT  (PCH_SMM_SMI_STS_BUCKET_OTHER + 1)
 
 ///
 /// HOOKING INTO THE ARCHITECTURE
@@ -589,6 +608,8 @@ typedef struct {
   EFI_HANDLE                  SmiHandle;
   EFI_HANDLE                  InstallMultProtHandle;
   PCH_SMM_QUALIFIED_PROTOCOL  Protocols[PCH_SMM_PROTOCOL_TYPE_MAX];
+  LIST_ENTRY                  SmiStsBuckets[PCH_SMM_SMI_STS_BUCKET_COUNT];
+  UINTN                       NextRegisterOrder;
 } PRIVATE_DATA;
 
 extern PRIVATE_DATA           mPrivateData;
@@ -611,6 +632,17 @@ SmmCoreInsertRecord (
   OUT EFI_HANDLE                        *DispatchHandle
   );
 
+/**
+  The internal function used to remove a database record from the database
+  and from its SMI_STS bucket. The record is not freed.
+
+  @param[in]  Record                    Record to remove from database.
+**/
+VOID
+SmmCoreRemoveRecord (
+  IN  DATABASE_RECORD                   *Record
+  );
+
 /**
   Get the Sleep type
 
@@ -1028,4 +1060,28 @@ PchGpiSmiUnRegister (
   IN       EFI_HANDLE                      DispatchHandle
   );
 
+/**
+  Add one sample to the latency entry of given SMI source or handler.
+
+  @param[in] Kind                 PCH_SMI_LATENCY_KIND_SOURCE or PCH_SMI_LATENCY_KIND_HANDLER
+  @param[in] ProtocolType         Protocol type of the dispatched record
+  @param[in] Id                   PCH_SMI_LATENCY_SOURCE_ID for a source, handler address for a handler
+  @param[in] StartTsc             TSC value at the start of the measured interval
+**/
+VOID
+PchSmmLatencyRecord (
+  IN UINT32                       Kind,
+  IN PCH_SMM_PROTOCOL_TYPE        ProtocolType,
+  IN UINT64                       Id,
+  IN UINT64                       StartTsc
+  );
+
+/**
+  Register the SMM communicate handler of the SMI latency data.
+**/
+VOID
+PchSmmLatencyInit (
+  VOID
+  );
+
 #endif
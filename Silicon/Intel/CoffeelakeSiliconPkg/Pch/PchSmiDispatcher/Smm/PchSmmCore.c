@@ -14,6 +14,7 @@
 #include <Register/PchRegsGpio.h>
 #include <Register/PchRegsPmc.h>
 #include <Register/PchRegsLpc.h>
+#include <Guid/PchSmiLatency.h>
 
 //
 // MODULE / GLOBAL DATA
@@ -219,6 +220,7 @@ InitializePchSmmDispatcher (
 {
   EFI_STATUS           Status;
   VOID                 *SmmReadyToLockRegistration;
+  UINTN                Index;
 
   //
   // Access ACPI Base Addresses Register
@@ -244,6 +246,9 @@ InitializePchSmmDispatcher (
   // Initialize Callback DataBase
   //
   InitializeListHead (&mPrivateData.CallbackDataBase);
+  for (Index = 0; Index < PCH_SMM_SMI_STS_BUCKET_COUNT; Index++) {
+    InitializeListHead (&mPrivateData.SmiStsBuckets[Index]);
+  }
 
   //
   // Enable SMIs on the PCH now that we have a callback
@@ -259,6 +264,9 @@ InitializePchSmmDispatcher (
   InstallIoTrap (ImageHandle);
   InstallEspiSmi (ImageHandle);
   InstallPchSmmPeriodicTimerControlProtocol (mPrivateData.InstallMultProtHandle);
+  if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+    PchSmmLatencyInit ();
+  }
 
   //
   // Register EFI_SMM_READY_TO_LOCK_PROTOCOL_GUID notify function.
@@ -273,6 +281,32 @@ InitializePchSmmDispatcher (
   return EFI_SUCCESS;
 }
 
+/**
+  Get the SMI_STS bucket for a source description.
+
+  The bucket only depends on the PMC SMI_STS bit of the source, so equal
+  sources are always kept in the same bucket and dispatching can look for
+  all the records of the active source in a single bucket.
+
+  @param[in] SrcDesc                    Pointer to the PCH SMI source description
+
+  @retval Index of the SMI_STS bucket
+**/
+STATIC
+UINTN
+SmmCoreGetSmiStsBucket (
+  IN CONST PCH_SMM_SOURCE_DESC          *SrcDesc
+  )
+{
+  if ((SrcDesc->PmcSmiSts.Reg.Type == ACPI_ADDR_TYPE) &&
+      (SrcDesc->PmcSmiSts.Reg.Data.acpi == R_ACPI_IO_SMI_STS) &&
+      (SrcDesc->PmcSmiSts.Bit < PCH_SMM_SMI_STS_BUCKET_OTHER)) {
+    return SrcDesc->PmcSmiSts.Bit;
+  }
+
+  return PCH_SMM_SMI_STS_BUCKET_OTHER;
+}
+
 /**
   The internal function used to create and insert a database record
 
@@ -308,8 +342,12 @@ SmmCoreInsertRecord (
 
   //
   // After ensuring the source of event is not null, we will insert the record into the database
+  // and into the SMI_STS bucket used by the dispatcher
   //
+  Record->SmiStsBucket  = SmmCoreGetSmiStsBucket (&Record->SrcDesc);
+  Record->RegisterOrder = mPrivateData.NextRegisterOrder++;
   InsertTailList (&mPrivateData.CallbackDataBase, &Record->Link);
+  InsertTailList (&mPrivateData.SmiStsBuckets[Record->SmiStsBucket], &Record->SmiStsLink);
 
   //
   // Child's handle will be the address linked list link in the record
@@ -319,6 +357,21 @@ SmmCoreInsertRecord (
   return EFI_SUCCESS;
 }
 
+/**
+  The internal function used to remove a database record from the database
+  and from its SMI_STS bucket. The record is not freed.
+
+  @param[in]  Record                    Record to remove from database.
+**/
+VOID
+SmmCoreRemoveRecord (
+  IN  DATABASE_RECORD                   *Record
+  )
+{
+  RemoveEntryList (&Record->Link);
+  RemoveEntryList (&Record->SmiStsLink);
+}
+
 /**
   Unregister a child SMI source dispatch function with a parent SMM driver
 
@@ -570,7 +623,7 @@ PchSmmCoreUnRegister (
     return EFI_INVALID_PARAMETER;
   }
 
-  RemoveEntryList (&RecordToDelete->Link);
+  SmmCoreRemoveRecord (RecordToDelete);
 
   //
   // Loop through all the souces in record linked list to see if any source enable is equal.
@@ -648,6 +701,59 @@ ClearPendingSmiStatus (
   }
 }
 
+/**
+  Find the first registered database record with an active source.
+
+  Only the SMI_STS buckets whose bit is set in SmiStsValue and the bucket of
+  sources without a top level SMI_STS bit are searched. Records are kept in
+  registration order in each bucket, so the first active record of every
+  bucket is a candidate and the one registered first is returned, as when
+  the whole database is searched in order.
+
+  @param[in] SciEn                      Indicate if SCI is enabled or not
+  @param[in] SmiEnValue                 Value from R_ACPI_IO_SMI_EN
+  @param[in] SmiStsValue                Value from R_ACPI_IO_SMI_STS
+
+  @retval NULL                          No registered source is active
+  @retval Others                        Record of the active source
+**/
+STATIC
+DATABASE_RECORD *
+SmmCoreFindActiveRecord (
+  IN BOOLEAN          SciEn,
+  IN UINT32           SmiEnValue,
+  IN UINT32           SmiStsValue
+  )
+{
+  UINTN               Bucket;
+  DATABASE_RECORD     *RecordInDb;
+  DATABASE_RECORD     *ActiveRecord;
+  LIST_ENTRY          *LinkInDb;
+
+  ActiveRecord = NULL;
+  for (Bucket = 0; Bucket < PCH_SMM_SMI_STS_BUCKET_COUNT; Bucket++) {
+    if ((Bucket != PCH_SMM_SMI_STS_BUCKET_OTHER) &&
+        ((SmiStsValue & (1u << Bucket)) == 0)) {
+      continue;
+    }
+
+    LinkInDb = GetFirstNode (&mPrivateData.SmiStsBuckets[Bucket]);
+    while (!IsNull (&mPrivateData.SmiStsBuckets[Bucket], LinkInDb)) {
+      RecordInDb = DATABASE_RECORD_FROM_SMI_STS_LINK (LinkInDb);
+      if ((ActiveRecord != NULL) && (RecordInDb->RegisterOrder > ActiveRecord->RegisterOrder)) {
+        break;
+      }
+      if (SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
+        ActiveRecord = RecordInDb;
+        break;
+      }
+      LinkInDb = GetNextNode (&mPrivateData.SmiStsBuckets[Bucket], LinkInDb);
+    }
+  }
+
+  return ActiveRecord;
+}
+
 /**
   The callback function to handle subsequent SMIs.  This callback will be called by SmmCoreDispatcher.
 
@@ -677,9 +783,14 @@ PchSmmCoreDispatcher (
   BOOLEAN             SxChildWasDispatched;
 
   DATABASE_RECORD     *RecordInDb;
-  LIST_ENTRY          *LinkInDb;
+  LIST_ENTRY          *Bucket;
   DATABASE_RECORD     *RecordToExhaust;
   LIST_ENTRY          *LinkToExhaust;
+  PCH_SMM_CLEAR_SOURCE ClearSource;
+  PCH_SMM_PROTOCOL_TYPE SourceType;
+  UINT64              SourceStartTsc;
+  UINT64              HandlerStartTsc;
+  UINT64              HandlerId;
 
   PCH_SMM_CONTEXT     Context;
   VOID                *CommBuffer;
@@ -720,8 +831,10 @@ PchSmmCoreDispatcher (
     //
     while ((!EosSet) && (EscapeCount > 0)) {
       EscapeCount--;
-
-      LinkInDb = GetFirstNode (&mPrivateData.CallbackDataBase);
+      SourceStartTsc = 0;
+      if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+        SourceStartTsc = AsmReadTsc ();
+      }
 
       //
       // Cache SciEn, SmiEnValue and SmiStsValue to determine if source is active
@@ -730,147 +843,151 @@ PchSmmCoreDispatcher (
       SmiEnValue  = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_EN));
       SmiStsValue = IoRead32 ((UINTN) (mAcpiBaseAddr + R_ACPI_IO_SMI_STS));
 
-      while (!IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
-        RecordInDb = DATABASE_RECORD_FROM_LINK (LinkInDb);
+      //
+      // look for the first active source
+      //
+      RecordInDb = SmmCoreFindActiveRecord (SciEn, SmiEnValue, SmiStsValue);
+      if (RecordInDb == NULL) {
+        //
+        // No active source, clear pending SMI status and try to clear EOS
+        //
+        ClearPendingSmiStatus (SmiStsValue, SciEn);
+        EosSet = PchSmmSetAndCheckEos ();
+        continue;
+      }
 
+      //
+      // We found a source. If this is a sleep type, we have to go to
+      // appropriate sleep state anyway.No matter there is sleep child or not
+      //
+      if (RecordInDb->ProtocolType == SxType) {
+        SxChildWasDispatched = TRUE;
+      }
+      //
+      // "cache" the source description and don't query I/O anymore
+      //
+      CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
+      ClearSource   = RecordInDb->ClearSource;
+      SourceType    = RecordInDb->ProtocolType;
+      Bucket        = &mPrivateData.SmiStsBuckets[RecordInDb->SmiStsBucket];
+      LinkToExhaust = &RecordInDb->SmiStsLink;
+
+      //
+      // exhaust the rest of the bucket looking for the same source, all the records
+      // with the same source are kept in one bucket
+      //
+      while (!IsNull (Bucket, LinkToExhaust)) {
+        RecordToExhaust = DATABASE_RECORD_FROM_SMI_STS_LINK (LinkToExhaust);
         //
-        // look for the first active source
+        // RecordToExhaust->SmiStsLink might be removed (unregistered) by Callback function, and then the
+        // system will hang in ASSERT() while calling GetNextNode().
+        // To prevent the issue, we need to get next record in bucket here (before Callback function).
         //
-        if (!SourceIsActive (&RecordInDb->SrcDesc, SciEn, SmiEnValue, SmiStsValue)) {
-          //
-          // Didn't find the source yet, keep looking
-          //
-          LinkInDb = GetNextNode (&mPrivateData.CallbackDataBase, &RecordInDb->Link);
+        LinkToExhaust = GetNextNode (Bucket, &RecordToExhaust->SmiStsLink);
 
+        if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
           //
-          // if it's the last one, try to clear EOS
+          // These source descriptions are equal, so this callback should be
+          // dispatched.
           //
-          if (IsNull (&mPrivateData.CallbackDataBase, LinkInDb)) {
+          if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
             //
-            // Clear pending SMI status before EOS
+            // This child requires that we get a calling context from
+            // hardware and compare that context to the one supplied
+            // by the child.
             //
-            ClearPendingSmiStatus (SmiStsValue, SciEn);
-            EosSet = PchSmmSetAndCheckEos ();
-          }
-        } else {
-          //
-          // We found a source. If this is a sleep type, we have to go to
-          // appropriate sleep state anyway.No matter there is sleep child or not
-          //
-          if (RecordInDb->ProtocolType == SxType) {
-            SxChildWasDispatched = TRUE;
-          }
-          //
-          // "cache" the source description and don't query I/O anymore
-          //
-          CopyMem ((VOID *) &ActiveSource, (VOID *) &(RecordInDb->SrcDesc), sizeof (PCH_SMM_SOURCE_DESC));
-          LinkToExhaust = LinkInDb;
+            ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
 
-          //
-          // exhaust the rest of the queue looking for the same source
-          //
-          while (!IsNull (&mPrivateData.CallbackDataBase, LinkToExhaust)) {
-            RecordToExhaust = DATABASE_RECORD_FROM_LINK (LinkToExhaust);
             //
-            // RecordToExhaust->Link might be removed (unregistered) by Callback function, and then the
-            // system will hang in ASSERT() while calling GetNextNode().
-            // To prevent the issue, we need to get next record in DB here (before Callback function).
+            // Make sure contexts match before dispatching event to child
             //
-            LinkToExhaust = GetNextNode (&mPrivateData.CallbackDataBase, &RecordToExhaust->Link);
+            RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
+            ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
 
-            if (CompareSources (&RecordToExhaust->SrcDesc, &ActiveSource)) {
+          } else {
+            //
+            // This child doesn't require any more calling context beyond what
+            // it supplied in registration.  Simply pass back what it gave us.
+            //
+            Context       = RecordToExhaust->ChildContext;
+            ContextsMatch = TRUE;
+          }
+
+          if (ContextsMatch) {
+            if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
               //
-              // These source descriptions are equal, so this callback should be
-              // dispatched.
+              // For PCH SMI dispatch protocols
               //
-              if (RecordToExhaust->ContextFunctions.GetContext != NULL) {
-                //
-                // This child requires that we get a calling context from
-                // hardware and compare that context to the one supplied
-                // by the child.
-                //
-                ASSERT (RecordToExhaust->ContextFunctions.CmpContext != NULL);
-
-                //
-                // Make sure contexts match before dispatching event to child
-                //
-                RecordToExhaust->ContextFunctions.GetContext (RecordToExhaust, &Context);
-                ContextsMatch = RecordToExhaust->ContextFunctions.CmpContext (&Context, &RecordToExhaust->ChildContext);
-
-              } else {
-                //
-                // This child doesn't require any more calling context beyond what
-                // it supplied in registration.  Simply pass back what it gave us.
-                //
-                Context       = RecordToExhaust->ChildContext;
-                ContextsMatch = TRUE;
-              }
-
-              if (ContextsMatch) {
-                if (RecordToExhaust->ProtocolType == PchSmiDispatchType) {
+              PchSmiTypeCallbackDispatcher (RecordToExhaust);
+            } else {
+              //
+              // For EFI standard SMI dispatch protocols
+              //
+              if (RecordToExhaust->Callback != NULL) {
+                if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
                   //
-                  // For PCH SMI dispatch protocols
+                  // This callback function needs CommBuffer and CommBufferSize.
+                  // Get those from child and then pass to callback function.
                   //
-                  PchSmiTypeCallbackDispatcher (RecordToExhaust);
+                  RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
                 } else {
                   //
-                  // For EFI standard SMI dispatch protocols
+                  // Child doesn't support the CommBuffer and CommBufferSize.
+                  // Just pass NULL value to callback function.
                   //
-                  if (RecordToExhaust->Callback != NULL) {
-                    if (RecordToExhaust->ContextFunctions.GetCommBuffer != NULL) {
-                      //
-                      // This callback function needs CommBuffer and CommBufferSize.
-                      // Get those from child and then pass to callback function.
-                      //
-                      RecordToExhaust->ContextFunctions.GetCommBuffer (RecordToExhaust, &CommBuffer, &CommBufferSize);
-                    } else {
-                      //
-                      // Child doesn't support the CommBuffer and CommBufferSize.
-                      // Just pass NULL value to callback function.
-                      //
-                      CommBuffer     = NULL;
-                      CommBufferSize = 0;
-                    }
-
-                    PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                    RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
-                    PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
-                    if (RecordToExhaust->ProtocolType == SxType) {
-                      SxChildWasDispatched = TRUE;
-                    }
-                  } else {
-                    ASSERT (FALSE);
-                  }
+                  CommBuffer     = NULL;
+                  CommBufferSize = 0;
+                }
+
+                HandlerStartTsc = 0;
+                HandlerId       = (UINT64) (UINTN) RecordToExhaust->Callback;
+                if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+                  HandlerStartTsc = AsmReadTsc ();
                 }
+                PERF_START_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+                RecordToExhaust->Callback ((EFI_HANDLE) & RecordToExhaust->Link, &Context, CommBuffer, &CommBufferSize);
+                PERF_END_EX (NULL, "SmmFunction", NULL, AsmReadTsc (), RecordToExhaust->ProtocolType);
+                if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+                  PchSmmLatencyRecord (PCH_SMI_LATENCY_KIND_HANDLER, RecordToExhaust->ProtocolType, HandlerId, HandlerStartTsc);
+                }
+                if (RecordToExhaust->ProtocolType == SxType) {
+                  SxChildWasDispatched = TRUE;
+                }
+              } else {
+                ASSERT (FALSE);
               }
             }
           }
-
-          if (RecordInDb->ClearSource == NULL) {
-            //
-            // Clear the SMI associated w/ the source using the default function
-            //
-            PchSmmClearSource (&ActiveSource);
-          } else {
-            //
-            // This source requires special handling to clear
-            //
-            RecordInDb->ClearSource (&ActiveSource);
-          }
-          //
-          // Clear pending SMI status before EOS
-          //
-          ClearPendingSmiStatus (SmiStsValue, SciEn);
-          //
-          // Also, try to clear EOS
-          //
-          EosSet = PchSmmSetAndCheckEos ();
-          //
-          // Queue is empty, reset the search
-          //
-          break;
         }
       }
+
+      if (ClearSource == NULL) {
+        //
+        // Clear the SMI associated w/ the source using the default function
+        //
+        PchSmmClearSource (&ActiveSource);
+      } else {
+        //
+        // This source requires special handling to clear
+        //
+        ClearSource (&ActiveSource);
+      }
+      if (FeaturePcdGet (PcdSmiLatencyHistogramEnable)) {
+        PchSmmLatencyRecord (
+          PCH_SMI_LATENCY_KIND_SOURCE,
+          SourceType,
+          PCH_SMI_LATENCY_SOURCE_ID (ActiveSource.Sts[0].Reg.Type, ActiveSource.Sts[0].Reg.Data.raw, ActiveSource.Sts[0].Bit),
+          SourceStartTsc
+          );
+      }
+      //
+      // Clear pending SMI status before EOS
+      //
+      ClearPendingSmiStatus (SmiStsValue, SciEn);
+      //
+      // Also, try to clear EOS
+      //
+      EosSet = PchSmmSetAndCheckEos ();
     }
   }
   //
@@ -0,0 +1,188 @@
+/** @file
+  SMI latency histograms of the PCH SMI dispatcher.
+
+  Every dispatched SMI source and every called child handler gets an entry
+  in a fixed size table in SMRAM. The table can be read with the read only
+  SMM communicate interface described in Guid/PchSmiLatency.h.
+
+  Copyright (c) 2026 Intel Corporation. All rights reserved. <BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+**/
+
+#include "PchSmm.h"
+#include <Library/SmmMemLib.h>
+#include <Guid/PchSmiLatency.h>
+
+GLOBAL_REMOVE_IF_UNREFERENCED PCH_SMI_LATENCY_ENTRY  mSmiLatencyEntries[PCH_SMI_LATENCY_MAX_ENTRIES];
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32                 mSmiLatencyEntryCount;
+GLOBAL_REMOVE_IF_UNREFERENCED UINT32                 mSmiLatencyDroppedCount;
+
+/**
+  Add one sample to the latency entry of given SMI source or handler.
+
+  @param[in] Kind                 PCH_SMI_LATENCY_KIND_SOURCE or PCH_SMI_LATENCY_KIND_HANDLER
+  @param[in] ProtocolType         Protocol type of the dispatched record
+  @param[in] Id                   PCH_SMI_LATENCY_SOURCE_ID for a source, handler address for a handler
+  @param[in] StartTsc             TSC value at the start of the measured interval
+**/
+VOID
+PchSmmLatencyRecord (
+  IN UINT32                       Kind,
+  IN PCH_SMM_PROTOCOL_TYPE        ProtocolType,
+  IN UINT64                       Id,
+  IN UINT64                       StartTsc
+  )
+{
+  UINT64                          Ticks;
+  UINT32                          Index;
+  INTN                            Bucket;
+  PCH_SMI_LATENCY_ENTRY           *Entry;
+
+  Ticks = AsmReadTsc () - StartTsc;
+
+  for (Index = 0; Index < mSmiLatencyEntryCount; Index++) {
+    Entry = &mSmiLatencyEntries[Index];
+    if ((Entry->Id == Id) && (Entry->Kind == Kind) && (Entry->ProtocolType == (UINT32) ProtocolType)) {
+      break;
+    }
+  }
+
+  if (Index == mSmiLatencyEntryCount) {
+    if (mSmiLatencyEntryCount == PCH_SMI_LATENCY_MAX_ENTRIES) {
+      mSmiLatencyDroppedCount++;
+      return;
+    }
+    Entry               = &mSmiLatencyEntries[mSmiLatencyEntryCount++];
+    Entry->Kind         = Kind;
+    Entry->ProtocolType = (UINT32) ProtocolType;
+    Entry->Id           = Id;
+  }
+
+  Bucket = HighBitSet64 (Ticks);
+  if (Bucket < 0) {
+    Bucket = 0;
+  } else if (Bucket >= PCH_SMI_LATENCY_HISTOGRAM_BUCKETS) {
+    Bucket = PCH_SMI_LATENCY_HISTOGRAM_BUCKETS - 1;
+  }
+
+  Entry->Count++;
+  Entry->TotalTicks += Ticks;
+  if (Ticks > Entry->MaxTicks) {
+    Entry->MaxTicks = Ticks;
+  }
+  if (Entry->Histogram[Bucket] != MAX_UINT32) {
+    Entry->Histogram[Bucket]++;
+  }
+}
+
+/**
+  SMM communicate handler returning the collected SMI latency data.
+
+  @param[in]     DispatchHandle   The unique handle assigned to this handler by SmiHandlerRegister().
+  @param[in]     Context          Points to an optional handler context which was specified when the
+                                  handler was registered.
+  @param[in,out] CommBuffer       A pointer to a collection of data in memory that will
+                                  be conveyed from a non-SMM environment into an SMM environment.
+  @param[in,out] CommBufferSize   The size of the CommBuffer.
+
+  @retval EFI_SUCCESS             The interrupt was handled and quiesced. No other handlers
+                                  should still be called.
+**/
+EFI_STATUS
+EFIAPI
+PchSmmLatencyCommunicateHandler (
+  IN     EFI_HANDLE               DispatchHandle,
+  IN     CONST VOID               *Context         OPTIONAL,
+  IN OUT VOID                     *CommBuffer      OPTIONAL,
+  IN OUT UINTN                    *CommBufferSize  OPTIONAL
+  )
+{
+  UINTN                               TempCommBufferSize;
+  PCH_SMI_LATENCY_PARAMETER_HEADER    *Header;
+  PCH_SMI_LATENCY_PARAMETER_GET_INFO  *GetInfo;
+  PCH_SMI_LATENCY_PARAMETER_GET_DATA  GetData;
+  UINTN                               EntryCount;
+
+  //
+  // If input is invalid, stop processing this SMI
+  //
+  if ((CommBuffer == NULL) || (CommBufferSize == NULL)) {
+    return EFI_SUCCESS;
+  }
+
+  TempCommBufferSize = *CommBufferSize;
+  if (TempCommBufferSize < sizeof (PCH_SMI_LATENCY_PARAMETER_HEADER)) {
+    DEBUG ((DEBUG_ERROR, "PchSmmLatencyCommunicateHandler: SMM communication buffer size invalid!\n"));
+    return EFI_SUCCESS;
+  }
+
+  if (!SmmIsBufferOutsideSmmValid ((UINTN) CommBuffer, TempCommBufferSize)) {
+    DEBUG ((DEBUG_ERROR, "PchSmmLatencyCommunicateHandler: SMM communication buffer in SMRAM or overflow!\n"));
+    return EFI_SUCCESS;
+  }
+
+  Header               = (PCH_SMI_LATENCY_PARAMETER_HEADER *) CommBuffer;
+  Header->ReturnStatus = (UINT64) -1;
+
+  switch (Header->Command) {
+    case PCH_SMI_LATENCY_COMMAND_GET_INFO:
+      if (TempCommBufferSize != sizeof (PCH_SMI_LATENCY_PARAMETER_GET_INFO)) {
+        DEBUG ((DEBUG_ERROR, "PchSmmLatencyCommunicateHandler: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+      GetInfo               = (PCH_SMI_LATENCY_PARAMETER_GET_INFO *) CommBuffer;
+      GetInfo->EntryCount   = mSmiLatencyEntryCount;
+      GetInfo->DroppedCount = mSmiLatencyDroppedCount;
+      Header->ReturnStatus  = 0;
+      break;
+
+    case PCH_SMI_LATENCY_COMMAND_GET_DATA:
+      if (TempCommBufferSize < sizeof (PCH_SMI_LATENCY_PARAMETER_GET_DATA)) {
+        DEBUG ((DEBUG_ERROR, "PchSmmLatencyCommunicateHandler: SMM communication buffer size invalid!\n"));
+        return EFI_SUCCESS;
+      }
+      //
+      // Work on a copy of the request, the communicate buffer can be changed outside of SMM
+      //
+      CopyMem (&GetData, CommBuffer, sizeof (GetData));
+      if (GetData.FirstEntry > mSmiLatencyEntryCount) {
+        Header->ReturnStatus = (UINT64) (INT64) (INTN) EFI_INVALID_PARAMETER;
+        break;
+      }
+
+      EntryCount = (TempCommBufferSize - sizeof (PCH_SMI_LATENCY_PARAMETER_GET_DATA)) / sizeof (PCH_SMI_LATENCY_ENTRY);
+      EntryCount = MIN (EntryCount, GetData.EntryCount);
+      EntryCount = MIN (EntryCount, mSmiLatencyEntryCount - GetData.FirstEntry);
+
+      CopyMem (
+        (PCH_SMI_LATENCY_PARAMETER_GET_DATA *) CommBuffer + 1,
+        &mSmiLatencyEntries[GetData.FirstEntry],
+        EntryCount * sizeof (PCH_SMI_LATENCY_ENTRY)
+        );
+      ((PCH_SMI_LATENCY_PARAMETER_GET_DATA *) CommBuffer)->EntryCount = (UINT32) EntryCount;
+      Header->ReturnStatus = 0;
+      break;
+
+    default:
+      break;
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Register the SMM communicate handler of the SMI latency data.
+**/
+VOID
+PchSmmLatencyInit (
+  VOID
+  )
+{
+  EFI_STATUS                      Status;
+  EFI_HANDLE                      Handle;
+
+  Handle = NULL;
+  Status = gSmst->SmiHandlerRegister (PchSmmLatencyCommunicateHandler, &gPchSmiLatencyGuid, &Handle);
+  ASSERT_EFI_ERROR (Status);
+}
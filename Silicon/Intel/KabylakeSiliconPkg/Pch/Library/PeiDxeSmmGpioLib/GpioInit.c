@@ -130,22 +130,35 @@ GpioDwRegValueFromGpioConfig (
     return;
   }
   //
-  // Update value to be programmed in HOSTSW_OWN register
+  // Records of one group are merged in table order, so the pad bit is
+  // cleared before a record sets it: a later record for the same pad
+  // replaces the value of an earlier one instead of being OR-ed into it.
   //
-  DwRegsValues[DwNum].HostSoftOwnRegMask |= (GpioConfig->HostSoftPadOwn & 0x1) << PadBitPosition;
-  DwRegsValues[DwNum].HostSoftOwnReg |= (GpioConfig->HostSoftPadOwn >> 0x1) << PadBitPosition;
 
   //
-  // Update value to be programmed in GPI_GPE_EN register
+  // Update value to be programmed in HOSTSW_OWN register
   //
-  DwRegsValues[DwNum].GpiGpeEnRegMask |= (GpioConfig->InterruptConfig & 0x1) << PadBitPosition;
-  DwRegsValues[DwNum].GpiGpeEnReg |= ((GpioConfig->InterruptConfig & GpioIntSci) >> 3) << PadBitPosition;
+  if ((GpioConfig->HostSoftPadOwn & 0x1) != 0) {
+    DwRegsValues[DwNum].HostSoftOwnRegMask |= 0x1 << PadBitPosition;
+    DwRegsValues[DwNum].HostSoftOwnReg &= ~(0x1 << PadBitPosition);
+    DwRegsValues[DwNum].HostSoftOwnReg |= (GpioConfig->HostSoftPadOwn >> 0x1) << PadBitPosition;
+  }
 
-  //
-  // Update value to be programmed in GPI_NMI_EN register
-  //
-  DwRegsValues[DwNum].GpiNmiEnRegMask |= (GpioConfig->InterruptConfig & 0x1) << PadBitPosition;
-  DwRegsValues[DwNum].GpiNmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntNmi) >> 1) << PadBitPosition;
+  if ((GpioConfig->InterruptConfig & 0x1) != 0) {
+    //
+    // Update value to be programmed in GPI_GPE_EN register
+    //
+    DwRegsValues[DwNum].GpiGpeEnRegMask |= 0x1 << PadBitPosition;
+    DwRegsValues[DwNum].GpiGpeEnReg &= ~(0x1 << PadBitPosition);
+    DwRegsValues[DwNum].GpiGpeEnReg |= ((GpioConfig->InterruptConfig & GpioIntSci) >> 3) << PadBitPosition;
+
+    //
+    // Update value to be programmed in GPI_NMI_EN register
+    //
+    DwRegsValues[DwNum].GpiNmiEnRegMask |= 0x1 << PadBitPosition;
+    DwRegsValues[DwNum].GpiNmiEnReg &= ~(0x1 << PadBitPosition);
+    DwRegsValues[DwNum].GpiNmiEnReg |= ((GpioConfig->InterruptConfig & GpioIntNmi) >> 1) << PadBitPosition;
+  }
 
   //
   // Update information on Pad Configuration Lock
@@ -158,9 +171,47 @@ GpioDwRegValueFromGpioConfig (
   DwRegsValues[DwNum].PadsToLockTx |= ((GpioConfig->LockConfig >> 0x2) & 0x1) << PadBitPosition;
 }
 
+/**
+  Program GPIO register with masked value.
+  Register is not accessed at all if there is nothing to change in it and
+  it is written without a read if all bits are to be changed.
+
+  @param[in] Address        Register address
+  @param[in] Mask           Bitmask of register bits to be changed
+  @param[in] Value          Value for register bits set in Mask
+
+  @retval None
+**/
+STATIC
+VOID
+GpioWriteRegMasked (
+  IN UINTN                  Address,
+  IN UINT32                 Mask,
+  IN UINT32                 Value
+  )
+{
+  if ((Mask == 0) && (Value == 0)) {
+    return;
+  }
+
+  if (Mask == MAX_UINT32) {
+    MmioWrite32 (Address, Value);
+  } else {
+    MmioAndThenOr32 (Address, ~Mask, Value);
+  }
+}
+
 /**
   This SKL PCH specific procedure will initialize multiple SKL PCH GPIO pins
 
+  The whole table is first checked without writing any register, then the
+  groups it uses are programmed in the order they first appear in the table.
+  Each group is programmed in one go: all its PADCFG registers are written
+  and its HOSTSW_OWN, GPE_EN, NMI_EN and lock registers are written once.
+  Pads of one group do not need to be adjacent in the table; records of a
+  group are applied in table order so a later record for the same pad still
+  overrides an earlier one.
+
   @param[in] NumberofItem               Number of GPIO pads to be updated
   @param[in] GpioInitTableAddress       GPIO initialization table
 
@@ -188,6 +239,11 @@ GpioConfigureSklPch (
   GPIO_INIT_CONFIG     *GpioData;
   GPIO_GROUP           Group;
   UINT32               GroupIndex;
+  UINT32               GroupsToConfigure;
+  UINT32               GroupOrder[V_PCH_GPIO_GROUP_MAX];
+  UINT32               GroupCount;
+  UINT32               GroupOrderIndex;
+  UINT32               PadsNotOwned[V_PCH_GPIO_GROUP_MAX][GPIO_DW_REG_NUMBER];
   UINT32               PadNumber;
   PCH_SERIES           PchSeries;
 
@@ -199,8 +255,14 @@ GpioConfigureSklPch (
   GpioGroupOffset = GpioGetLowestGroup ();
   NumberOfGroups = GpioGetNumberOfGroups ();
 
-  Index = 0;
-  while (Index < NumberOfItems) {
+  //
+  // Validate the whole table before any register is touched and
+  // collect groups which are going to be configured, in table order
+  //
+  GroupsToConfigure = 0;
+  GroupCount        = 0;
+  ZeroMem (PadsNotOwned, sizeof (PadsNotOwned));
+  for (Index = 0; Index < NumberOfItems; Index++) {
 
     GpioData   = &GpioInitTableAddress[Index];
     Group      = GpioGetGroupFromGpioPad (GpioData->GpioPad);
@@ -229,43 +291,63 @@ GpioConfigureSklPch (
       return EFI_INVALID_PARAMETER;
     }
 
+    //
+    // Check if legal pin number
+    //
+    if (PadNumber >= GpioGroupInfo[GroupIndex].PadPerGroup) {
+      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Pin number (%d) exceeds possible range for group %d\n", PadNumber, GroupIndex));
+      return EFI_INVALID_PARAMETER;
+    }
+
+    if (GPIO_GET_DW_NUM (PadNumber) >= GPIO_DW_REG_NUMBER) {
+      ASSERT (FALSE);
+      return EFI_UNSUPPORTED;
+    }
+
+    DEBUG_CODE_BEGIN ();
+    //
+    // Check if selected GPIO Pad is not owned by CSME/ISH
+    //
+    GpioGetPadOwnership (GpioData->GpioPad, &PadOwnVal);
+
+    if (PadOwnVal != GpioPadOwnHost) {
+      DEBUG ((DEBUG_ERROR, "GPIO ERROR: Accessing pad not owned by host (Group=%d, Pad=%d)!\n", GroupIndex, PadNumber));
+      DEBUG ((DEBUG_ERROR, "** Please make sure the GPIO usage in sync between CSME and BIOS configuration. \n"));
+      DEBUG ((DEBUG_ERROR, "** All the GPIO occupied by CSME should not do any configuration by BIOS.\n"));
+      PadsNotOwned[GroupIndex][GPIO_GET_DW_NUM (PadNumber)] |= 0x1 << GPIO_GET_PAD_POSITION (PadNumber);
+    }
+    DEBUG_CODE_END ();
+
+    if ((GroupsToConfigure & (0x1 << GroupIndex)) == 0) {
+      GroupsToConfigure |= 0x1 << GroupIndex;
+      GroupOrder[GroupCount++] = GroupIndex;
+    }
+  }
+
+  for (GroupOrderIndex = 0; GroupOrderIndex < GroupCount; GroupOrderIndex++) {
+
+    GroupIndex = GroupOrder[GroupOrderIndex];
+
     ZeroMem (DwRegsValues, sizeof (DwRegsValues));
     //
-    // Loop through pads for one group. If pad belongs to a different group then
-    // break and move to register programming.
+    // Loop through all pads of one group and program their PADCFG registers.
+    // DW registers values are accumulated and programmed after that.
     //
-    while (Index < NumberOfItems) {
+    for (Index = 0; Index < NumberOfItems; Index++) {
 
       GpioData   = &GpioInitTableAddress[Index];
       if (GroupIndex != GpioGetGroupIndexFromGpioPad (GpioData->GpioPad)) {
-        //if next pad is from different group then break loop
-        break;
+        continue;
       }
 
       PadNumber  = GpioGetPadNumberFromGpioPad (GpioData->GpioPad);
-      //
-      // Check if legal pin number
-      //
-      if (PadNumber >= GpioGroupInfo[GroupIndex].PadPerGroup) {
-        DEBUG ((DEBUG_ERROR, "GPIO ERROR: Pin number (%d) exceeds possible range for group %d\n", PadNumber, GroupIndex));
-        return EFI_INVALID_PARAMETER;
-      }
 
-      DEBUG_CODE_BEGIN ();
       //
-      // Check if selected GPIO Pad is not owned by CSME/ISH
+      // Skip pads found not owned by host while validating the table
       //
-      GpioGetPadOwnership (GpioData->GpioPad, &PadOwnVal);
-
-      if (PadOwnVal != GpioPadOwnHost) {
-        DEBUG ((DEBUG_ERROR, "GPIO ERROR: Accessing pad not owned by host (Group=%d, Pad=%d)!\n", GroupIndex, PadNumber));
-        DEBUG ((DEBUG_ERROR, "** Please make sure the GPIO usage in sync between CSME and BIOS configuration. \n"));
-        DEBUG ((DEBUG_ERROR, "** All the GPIO occupied by CSME should not do any configuration by BIOS.\n"));
-        //Move to next item
-        Index++;
+      if ((PadsNotOwned[GroupIndex][GPIO_GET_DW_NUM (PadNumber)] & (0x1 << GPIO_GET_PAD_POSITION (PadNumber))) != 0) {
         continue;
       }
-      DEBUG_CODE_END ();
 
       ZeroMem (PadCfgDwReg, sizeof (PadCfgDwReg));
       ZeroMem (PadCfgDwRegMask, sizeof (PadCfgDwRegMask));
@@ -291,20 +373,16 @@ GpioConfigureSklPch (
       PadCfgReg = PAD_CFG_SIZE * PadNumber + GpioGroupInfo[GroupIndex].PadCfgOffset;
 
       //
-      // Write PADCFG DW0 register
+      // Write PADCFG DW0 and DW1 registers
       //
-      MmioAndThenOr32 (
+      GpioWriteRegMasked (
         PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg),
-        ~PadCfgDwRegMask[0],
+        PadCfgDwRegMask[0],
         PadCfgDwReg[0]
         );
-
-      //
-      // Write PADCFG DW1 register
-      //
-      MmioAndThenOr32 (
+      GpioWriteRegMasked (
         PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, PadCfgReg + 0x4),
-        ~PadCfgDwRegMask[1],
+        PadCfgDwRegMask[1],
         PadCfgDwReg[1]
         );
 
@@ -316,9 +394,6 @@ GpioConfigureSklPch (
         &GpioData->GpioConfig,
         DwRegsValues
         );
-
-      //Move to next item
-      Index++;
     }
 
     for (DwNum = 0; DwNum <= GPIO_GET_DW_NUM (GpioGroupInfo[GroupIndex].PadPerGroup); DwNum++) {
@@ -326,9 +401,9 @@ GpioConfigureSklPch (
       // Write HOSTSW_OWN registers
       //
       if (GpioGroupInfo[GroupIndex].HostOwnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].HostOwnOffset + DwNum * 0x4),
-          ~DwRegsValues[DwNum].HostSoftOwnRegMask,
+          DwRegsValues[DwNum].HostSoftOwnRegMask,
           DwRegsValues[DwNum].HostSoftOwnReg
           );
       }
@@ -337,9 +412,9 @@ GpioConfigureSklPch (
       // Write GPI_GPE_EN registers
       //
       if (GpioGroupInfo[GroupIndex].GpiGpeEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].GpiGpeEnOffset + DwNum * 0x4),
-          ~DwRegsValues[DwNum].GpiGpeEnRegMask,
+          DwRegsValues[DwNum].GpiGpeEnRegMask,
           DwRegsValues[DwNum].GpiGpeEnReg
           );
       }
@@ -348,9 +423,9 @@ GpioConfigureSklPch (
       // Write GPI_NMI_EN registers
       //
       if (GpioGroupInfo[GroupIndex].NmiEnOffset != NO_REGISTER_FOR_PROPERTY) {
-        MmioAndThenOr32 (
+        GpioWriteRegMasked (
           PCH_PCR_ADDRESS (GpioGroupInfo[GroupIndex].Community, GpioGroupInfo[GroupIndex].NmiEnOffset + DwNum * 0x4),
-          ~DwRegsValues[DwNum].GpiNmiEnRegMask,
+          DwRegsValues[DwNum].GpiNmiEnRegMask,
           DwRegsValues[DwNum].GpiNmiEnReg
           );
       } else if (DwRegsValues[DwNum].GpiNmiEnReg != 0x0) {
@@ -478,6 +553,8 @@ GpioClearAllGpioInterrupts (
   GpioPad and PadMode.
   Some GpioPads are configured and switched to native mode by RC, those include:
   SerialIo pins, ISH pins, ClkReq Pins
+  Pads which belong to the same group are programmed together, so records in the table
+  do not need to be ordered by group.
 
   @param[in] NumberofItem               Number of GPIO pads to be updated
   @param[in] GpioInitTableAddress       GPIO initialization table
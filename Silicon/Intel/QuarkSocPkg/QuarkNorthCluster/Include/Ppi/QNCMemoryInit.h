@@ -29,6 +29,11 @@ VOID
 
 typedef struct _PEI_QNC_MEMORY_INIT_PPI {
   PEI_QNC_MEMORY_INIT     MrcStart;
+  //
+  // Completes the memory init/test MrcStart() left running when
+  // MRCDATA->async_mem_init is set. MRCDATA->status is valid after it.
+  //
+  PEI_QNC_MEMORY_INIT     MrcComplete;
 }PEI_QNC_MEMORY_INIT_PPI;
 
 extern EFI_GUID gQNCMemoryInitPpiGuid;
@@ -0,0 +1,380 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Command line front end of the host MRC simulation.
+ *
+ * Runs Mrc() against the simulated platform and reports, per MemInit()
+ * step, the number of sideband accesses, DRAM commands, DQS samples and
+ * HTE tests together with the simulated execution time.
+ *
+ ***************************************************************************/
+#include "MrcSim.h"
+#include "vpi_user.h"
+
+// Names of MemInit() init[] table entries
+static const char *SimStepNames[] =
+{
+  "clear_self_refresh",             // 0
+  "prog_ddr_timing_control",        // 1
+  "prog_decode_before_jedec",       // 2
+  "perform_ddr_reset",              // 3
+  "ddrphy_init",                    // 4
+  "perform_jedec_init",             // 5
+  "set_ddr_init_complete",          // 6
+  "restore_timings",                // 7
+  "default_timings",                // 8
+  "rcvn_cal",                       // 9
+  "wr_level",                       // 10
+  "prog_page_ctrl",                 // 11
+  "rd_train",                       // 12
+  "wr_train",                       // 13
+  "store_timings",                  // 14
+  "enable_scrambling",              // 15
+  "prog_ddr_control",               // 16
+  "prog_dra_drb",                   // 17
+  "perform_wake",                   // 18
+  "change_refresh_period",          // 19
+  "set_auto_refresh",               // 20
+  "ecc_enable",                     // 21
+  "memory_test",                    // 22
+  "lock_registers",                 // 23
+  "MrcWait (async completion)",     // 24
+};
+
+#define SIM_STEP_MRC_WAIT 24
+
+static uint32_t SimLastPostCode;
+
+// MRC debug output, see lprint.c
+int vpi_vprintf(
+    char *format,
+    va_list ap)
+{
+  return vprintf(format, ap);
+}
+
+void SimStepBegin(
+    uint32_t step)
+{
+  SimCur = &SimStats[(step < SIM_MAX_STEPS) ? step : SIM_NO_STEP];
+  SimCur->calls++;
+}
+
+void SimStepEnd(
+    uint32_t step)
+{
+  SimCur = &SimStats[SIM_NO_STEP];
+}
+
+void SimPostCode(
+    uint8_t major,
+    uint8_t minor)
+{
+  SimLastPostCode = (major << 8) | minor;
+
+  if (major == 0xEE)
+  {
+    printf("ERROR: MRC failed with post code 0x%04X\n", SimLastPostCode);
+    exit(1);
+  }
+}
+
+// Run the MRC, with async_mem_init set also wait for the memory test
+static void SimRunMrc(
+    MRCParams_t *mrc_params)
+{
+  Mrc(mrc_params);
+
+  if (mrc_params->async_mem_init)
+  {
+    SimStepBegin(SIM_STEP_MRC_WAIT);
+    MrcWait(mrc_params);
+    SimStepEnd(SIM_STEP_MRC_WAIT);
+  }
+}
+
+// Galileo like single rank DDR3-800 configuration
+static void SimDefaultParams(
+    MRCParams_t *mrc_params)
+{
+  memset(mrc_params, 0, sizeof(*mrc_params));
+
+  mrc_params->boot_mode = bmCold;
+  mrc_params->dram_width = x8;
+  mrc_params->ddr_speed = DDRFREQ_800;
+  mrc_params->ddr_type = DDR3;
+  mrc_params->ecc_enables = 0;
+  mrc_params->scrambling_enables = 1;
+  mrc_params->rank_enables = 1;
+  mrc_params->channel_enables = 1;
+  mrc_params->channel_width = x16;
+  mrc_params->address_mode = 0;
+
+  mrc_params->refresh_rate = 3;
+  mrc_params->sr_temp_range = 0;
+  mrc_params->ron_value = 0;
+  mrc_params->rtt_nom_value = 2;
+  mrc_params->rd_odt_value = 0;
+
+  mrc_params->params.DENSITY = 1;
+  mrc_params->params.tCL = 6;
+  mrc_params->params.tRAS = 37500;
+  mrc_params->params.tWTR = 10000;
+  mrc_params->params.tRRD = 10000;
+  mrc_params->params.tFAW = 40000;
+}
+
+static void SimReport(
+    bool csv)
+{
+  SimStats_t total;
+  uint32_t i;
+
+  memset(&total, 0, sizeof(total));
+
+  if (csv)
+  {
+    printf("step,name,calls,sb_reads,sb_writes,dram_cmds,dqs_samples,hte_runs,hte_lines,delay_ns,time_ns\n");
+  }
+  else
+  {
+    printf("%-4s %-26s %5s %8s %8s %6s %8s %6s %10s %12s\n",
+        "step", "name", "calls", "sb_rd", "sb_wr", "dram", "dqs", "hte", "hte_lines", "time_us");
+  }
+
+  for (i = 0; i <= SIM_MAX_STEPS; i++)
+  {
+    SimStats_t *s = &SimStats[i];
+    const char *name = (i < MCOUNT(SimStepNames)) ? SimStepNames[i] : "(outside steps)";
+
+    if (s->calls == 0 && s->time_ps == 0)
+    {
+      continue;
+    }
+
+    total.calls += s->calls;
+    total.sb_reads += s->sb_reads;
+    total.sb_writes += s->sb_writes;
+    total.dram_cmds += s->dram_cmds;
+    total.dqs_samples += s->dqs_samples;
+    total.hte_runs += s->hte_runs;
+    total.hte_lines += s->hte_lines;
+    total.delay_ps += s->delay_ps;
+    total.time_ps += s->time_ps;
+
+    if (csv)
+    {
+      printf("%u,%s,%u,%u,%u,%u,%u,%u,%llu,%llu,%llu\n", i, name, s->calls,
+          s->sb_reads, s->sb_writes, s->dram_cmds, s->dqs_samples, s->hte_runs,
+          s->hte_lines, s->delay_ps / 1000, s->time_ps / 1000);
+    }
+    else
+    {
+      printf("%-4u %-26s %5u %8u %8u %6u %8u %6u %10llu %12.1f\n", i, name, s->calls,
+          s->sb_reads, s->sb_writes, s->dram_cmds, s->dqs_samples, s->hte_runs,
+          s->hte_lines, s->time_ps / 1e6);
+    }
+  }
+
+  if (csv)
+  {
+    printf("total,total,%u,%u,%u,%u,%u,%u,%llu,%llu,%llu\n", total.calls,
+        total.sb_reads, total.sb_writes, total.dram_cmds, total.dqs_samples, total.hte_runs,
+        total.hte_lines, total.delay_ps / 1000, total.time_ps / 1000);
+  }
+  else
+  {
+    printf("%-4s %-26s %5u %8u %8u %6u %8u %6u %10llu %12.1f\n", "", "total", total.calls,
+        total.sb_reads, total.sb_writes, total.dram_cmds, total.dqs_samples, total.hte_runs,
+        total.hte_lines, total.time_ps / 1e6);
+  }
+}
+
+static void SimUsage(
+    const char *name)
+{
+  printf("Usage: %s [options]\n"
+      "  --boot cold|fast|warm|s3  boot path, non cold paths restore the timings of a cold run\n"
+      "  --ranks 1|2               number of populated ranks\n"
+      "  --dram-width 8|16         DRAM device width\n"
+      "  --speed 800|1066          DDR3 speed\n"
+      "  --ecc                     enable ECC\n"
+      "  --async                   complete the memory test in MrcWait()\n"
+      "  --eye key[.lane]=value    change the eye model, keys:\n"
+      "                            rcvn_edge wdqs_offset wdq_offset rdqs_center vref_center\n"
+      "                            wdq_half rdqs_half vref_half jitter seed\n"
+      "  --mmio-ns N               cost of one MMIO access (default 250)\n"
+      "  --hte-line-ns N           cost of one HTE cache line transfer (default 40)\n"
+      "  --hte-setup-ns N          fixed cost of one HTE test (default 1000)\n"
+      "  --limit-ms N              simulated time watchdog (default 60000, 0 for none)\n"
+      "  --check N                 fail if a trained delay is more than N codes off the model\n"
+      "  --csv                     print the report as CSV\n"
+      "  --debug MASK              MRC DpfPrintMask (default 0)\n",
+      name);
+}
+
+int main(
+    int argc,
+    char *argv[])
+{
+  static MRCParams_t mrc_params;
+  MrcTimings_t timings;
+  uint32_t boot_mode = bmCold;
+  uint32_t debug_mask = 0;
+  int32_t tolerance = -1;
+  bool csv = false;
+  int errors = 0;
+  int i;
+
+  SimDefaultParams(&mrc_params);
+  SimEyeDefaults();
+  SimCost.mmio_ps = 250000;
+  SimCost.hte_line_ps = 40000;
+  SimCost.hte_setup_ps = 1000000;
+  SimCost.limit_ps = 60000ULL * 1000000000ULL;
+
+  for (i = 1; i < argc; i++)
+  {
+    const char *opt = argv[i];
+    const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+    bool used = true;
+
+    if (strcmp(opt, "--ecc") == 0)
+    {
+      mrc_params.ecc_enables = 1;
+      continue;
+    }
+    if (strcmp(opt, "--async") == 0)
+    {
+      mrc_params.async_mem_init = 1;
+      continue;
+    }
+    if (strcmp(opt, "--csv") == 0)
+    {
+      csv = true;
+      continue;
+    }
+    if (strcmp(opt, "--help") == 0 || strcmp(opt, "-h") == 0)
+    {
+      SimUsage(argv[0]);
+      return 0;
+    }
+
+    if (val == NULL)
+    {
+      printf("ERROR: missing value of %s\n", opt);
+      return 1;
+    }
+
+    if (strcmp(opt, "--boot") == 0)
+    {
+      if (strcmp(val, "cold") == 0) boot_mode = bmCold;
+      else if (strcmp(val, "fast") == 0) boot_mode = bmFast;
+      else if (strcmp(val, "warm") == 0) boot_mode = bmWarm;
+      else if (strcmp(val, "s3") == 0) boot_mode = bmS3;
+      else used = false;
+    }
+    else if (strcmp(opt, "--ranks") == 0)
+    {
+      mrc_params.rank_enables = (atoi(val) == 2) ? 3 : 1;
+    }
+    else if (strcmp(opt, "--dram-width") == 0)
+    {
+      mrc_params.dram_width = (atoi(val) == 16) ? x16 : x8;
+    }
+    else if (strcmp(opt, "--speed") == 0)
+    {
+      mrc_params.ddr_speed = (atoi(val) == 1066) ? DDRFREQ_1066 : DDRFREQ_800;
+    }
+    else if (strcmp(opt, "--eye") == 0)
+    {
+      used = (SimEyeSet(val) == 0);
+    }
+    else if (strcmp(opt, "--mmio-ns") == 0)
+    {
+      SimCost.mmio_ps = atoi(val) * 1000;
+    }
+    else if (strcmp(opt, "--hte-line-ns") == 0)
+    {
+      SimCost.hte_line_ps = atoi(val) * 1000;
+    }
+    else if (strcmp(opt, "--hte-setup-ns") == 0)
+    {
+      SimCost.hte_setup_ps = atoi(val) * 1000;
+    }
+    else if (strcmp(opt, "--limit-ms") == 0)
+    {
+      SimCost.limit_ps = strtoull(val, NULL, 0) * 1000000000ULL;
+    }
+    else if (strcmp(opt, "--check") == 0)
+    {
+      tolerance = atoi(val);
+    }
+    else if (strcmp(opt, "--debug") == 0)
+    {
+      debug_mask = strtoul(val, NULL, 0);
+    }
+    else
+    {
+      SimUsage(argv[0]);
+      return 1;
+    }
+
+    if (!used)
+    {
+      printf("ERROR: invalid value of %s: %s\n", opt, val);
+      return 1;
+    }
+    i++;
+  }
+
+  SimParams = &mrc_params;
+  SimReset();
+
+  // non cold boot paths need the timings saved by a cold boot
+  if (boot_mode != bmCold)
+  {
+    DpfPrintMask = 0;
+    SimRunMrc(&mrc_params);
+    if (mrc_params.status != MRC_SUCCESS)
+    {
+      printf("ERROR: cold boot failed with status %u\n", mrc_params.status);
+      return 1;
+    }
+
+    timings = mrc_params.timings;
+    SimReset();
+    mrc_params.status = 0;
+    mrc_params.mem_size = 0;
+    mrc_params.timings = timings;
+    mrc_params.boot_mode = boot_mode;
+  }
+
+  DpfPrintMask = debug_mask;
+  SimRunMrc(&mrc_params);
+
+  SimReport(csv);
+
+  if (mrc_params.status != MRC_SUCCESS)
+  {
+    printf("ERROR: MRC status %u\n", mrc_params.status);
+    errors++;
+  }
+
+  if (tolerance >= 0)
+  {
+    errors += SimEyeCheck(&mrc_params, tolerance);
+  }
+
+  if (!csv)
+  {
+    printf("boot %s, memory %u MB, last post code 0x%04X, %s\n",
+        (boot_mode == bmCold) ? "cold" : (boot_mode == bmFast) ? "fast" : (boot_mode == bmWarm) ? "warm" : "s3",
+        mrc_params.mem_size >> 20, SimLastPostCode, errors ? "FAILED" : "PASSED");
+  }
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Host side simulation of the Quark memory reference code.
+ *
+ * The MRC is built in its SIM configuration for the build host. The
+ * sideband/MMIO accesses and delays end up in the harness, which keeps
+ * a register file for all sideband ports and a simple model of the DRAM
+ * eye behind the DQS samplers and the HTE (Hardware Test Engine).
+ *
+ ***************************************************************************/
+#ifndef _MRC_SIM_H_
+#define _MRC_SIM_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// core_types.h defines size_t for the 32-bit MRC, keep the host one here
+#define size_t mrc_size_t
+#include "mrc.h"
+#include "memory_options.h"
+#include "meminit_utils.h"
+#include "io.h"
+#undef size_t
+
+#define SIM_MAX_STEPS   32          // number of entries in MemInit() init[] table
+#define SIM_NO_STEP     SIM_MAX_STEPS
+
+#define SIM_HTE_MEMINIT 0           // HteMemInit() pass
+#define SIM_HTE_BASIC   1           // BasicWriteReadHTE() (coarse check)
+#define SIM_HTE_STRESS  2           // WriteStressBitLanesHTE()
+#define SIM_HTE_MEMOP   3           // HteMemOp() single read or write
+
+// Counters collected per MemInit() step
+typedef struct SimStats_s
+{
+  uint32_t calls;                   // number of times the step was executed
+  uint32_t sb_reads;                // sideband register reads
+  uint32_t sb_writes;               // sideband register writes
+  uint32_t dram_cmds;               // DRAM/wake/suspend commands
+  uint32_t dqs_samples;             // DQTRAINSTS reads (rcvn/wdqs sampling)
+  uint32_t hte_runs;                // HTE tests started
+  uint64_t hte_lines;               // cache lines transferred by the HTE
+  uint64_t delay_ps;                // time spent in delay_n()
+  uint64_t time_ps;                 // total simulated time
+} SimStats_t;
+
+// Cost model of the simulated platform
+typedef struct SimCost_s
+{
+  uint32_t mmio_ps;                 // one MMIO access (sideband packet takes 2-3)
+  uint32_t hte_line_ps;             // one cache line transfer by the HTE
+  uint32_t hte_setup_ps;            // fixed cost of each HTE test
+  uint64_t limit_ps;                // watchdog, 0 for none
+} SimCost_t;
+
+// DRAM eye model, values in PI codes (1/128 CLK) unless specified otherwise
+typedef struct SimEye_s
+{
+  int32_t  rcvn_edge[NUM_BYTE_LANES];   // first DQS rising edge of a read burst
+  int32_t  wdqs_offset[NUM_BYTE_LANES]; // CK rising edge at the DRAM relative to WCLK
+  int32_t  wdq_offset[NUM_BYTE_LANES];  // write eye center relative to WDQS-QRTR_CLK
+  int32_t  wdq_half;                    // half width of the write eye
+  int32_t  rdqs_center[NUM_BYTE_LANES]; // read eye center (RDQS code)
+  int32_t  rdqs_half;                   // half width of the read eye (RDQS codes)
+  int32_t  vref_center[NUM_BYTE_LANES]; // read eye center (VREF code)
+  int32_t  vref_half;                   // half height of the read eye (VREF codes)
+  int32_t  jitter;                      // random shrink of the eyes per test (codes)
+  uint32_t seed;                        // jitter seed
+} SimEye_t;
+
+extern SimStats_t  SimStats[SIM_MAX_STEPS + 1];
+extern SimStats_t *SimCur;
+extern SimCost_t   SimCost;
+extern SimEye_t    SimEye;
+extern MRCParams_t *SimParams;
+
+// mrc.c
+void Mrc(MRCParams_t *mrc_params);
+void MrcWait(MRCParams_t *mrc_params);
+
+// SimSideband.c
+void SimReset(void);
+uint32_t SimRegRead(uint32_t port, uint32_t reg);
+void SimRegWrite(uint32_t port, uint32_t reg, uint32_t data);
+void SimQuiet(int enter);
+void SimAddTime(uint64_t ps);
+
+// SimEyeModel.c
+void SimEyeDefaults(void);
+int SimEyeSet(const char *assignment);
+uint32_t SimEyeDqsSample(uint8_t bl_grp);
+uint32_t SimEyeTest(uint32_t kind);
+int SimEyeCheck(MRCParams_t *mrc_params, int32_t tolerance);
+
+#endif // _MRC_SIM_H_
@@ -0,0 +1,23 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Forced include of the MRC sources in the host simulation build.
+ *
+ * hte.c uses the EDK II base types, which hte.h only defines for non GCC
+ * builds, and SIM builds use the C library memset()/memcpy().
+ *
+ ***************************************************************************/
+#ifndef _MRC_SIM_SHIM_H_
+#define _MRC_SIM_SHIM_H_
+
+typedef unsigned int   UINT32;
+typedef unsigned short UINT16;
+typedef unsigned char  UINT8;
+
+void *memset(void *dst, int c, __SIZE_TYPE__ n);
+void *memcpy(void *dst, const void *src, __SIZE_TYPE__ n);
+
+#endif // _MRC_SIM_SHIM_H_
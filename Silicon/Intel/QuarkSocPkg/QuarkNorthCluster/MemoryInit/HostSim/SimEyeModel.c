@@ -0,0 +1,351 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * DRAM eye model of the host MRC simulation.
+ *
+ * The model answers the two questions the training algorithms ask the
+ * hardware: what the DQS sampler sees at the current RCVN/WDQS delay
+ * (DQTRAINSTS) and which byte lanes fail an HTE test at the current
+ * delays. Delays are read back with the MRC get_xxx() functions so the
+ * model always sees what the registers have been programmed to.
+ *
+ * The model is a deliberately simple approximation:
+ * - RCVN: the read burst is 4 DQS clocks starting at rcvn_edge, the DQS
+ *   samples 1 during the first half of each clock. Reads are good when
+ *   RCVN is within half a clock of the preamble (rcvn_edge - HALF_CLK).
+ * - WDQS: CK seen at the DRAM is 1 during the first half of a clock
+ *   starting at WCLK + wdqs_offset. Writes are good when WDQS is within
+ *   half a clock of that edge.
+ * - Read eye: a diamond in the RDQS/VREF plane.
+ * - Write eye: an interval of WDQ around the expected data center.
+ *
+ * Channels and ranks are not modelled separately, Quark has one channel
+ * and the MRC programs the same delay registers for both ranks.
+ *
+ ***************************************************************************/
+#include "MrcSim.h"
+
+SimEye_t SimEye;
+
+static const char *SimEyeLaneKeys[] =
+{
+  "rcvn_edge", "wdqs_offset", "wdq_offset", "rdqs_center", "vref_center"
+};
+
+static const char *SimEyeGlobalKeys[] =
+{
+  "wdq_half", "rdqs_half", "vref_half", "jitter", "seed"
+};
+
+// Load the default eye, based on a Galileo class board
+void SimEyeDefaults(
+    void)
+{
+  static const SimEye_t defaults =
+  {
+    { 420, 428, 436, 444 },         // rcvn_edge
+    {  40,  48,  56,  64 },         // wdqs_offset
+    {   0,   4,  -4,   2 },         // wdq_offset
+    24,                             // wdq_half
+    {  32,  30,  34,  31 },         // rdqs_center
+    14,                             // rdqs_half
+    {  32,  34,  30,  33 },         // vref_center
+    24,                             // vref_half
+    0,                              // jitter
+    1                               // seed
+  };
+
+  SimEye = defaults;
+}
+
+static int32_t *SimEyeField(
+    const char *key,
+    int32_t *lanes)
+{
+  uint32_t i;
+
+  for (i = 0; i < MCOUNT(SimEyeLaneKeys); i++)
+  {
+    if (strcmp(key, SimEyeLaneKeys[i]) == 0)
+    {
+      *lanes = NUM_BYTE_LANES;
+      switch (i)
+      {
+      case 0: return SimEye.rcvn_edge;
+      case 1: return SimEye.wdqs_offset;
+      case 2: return SimEye.wdq_offset;
+      case 3: return SimEye.rdqs_center;
+      default: return SimEye.vref_center;
+      }
+    }
+  }
+
+  for (i = 0; i < MCOUNT(SimEyeGlobalKeys); i++)
+  {
+    if (strcmp(key, SimEyeGlobalKeys[i]) == 0)
+    {
+      *lanes = 1;
+      switch (i)
+      {
+      case 0: return &SimEye.wdq_half;
+      case 1: return &SimEye.rdqs_half;
+      case 2: return &SimEye.vref_half;
+      case 3: return &SimEye.jitter;
+      default: return (int32_t *)&SimEye.seed;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// Apply "key=value" or "key.lane=value", per lane keys without lane set all lanes.
+// Returns 0 on success.
+int SimEyeSet(
+    const char *assignment)
+{
+  char key[32];
+  const char *eq = strchr(assignment, '=');
+  const char *dot;
+  char *end;
+  int32_t *field;
+  int32_t lanes;
+  int32_t lane = -1;
+  long value;
+  size_t len;
+
+  if (eq == NULL)
+  {
+    return -1;
+  }
+
+  dot = memchr(assignment, '.', eq - assignment);
+  len = (dot ? dot : eq) - assignment;
+  if (len >= sizeof(key))
+  {
+    return -1;
+  }
+  memcpy(key, assignment, len);
+  key[len] = 0;
+
+  field = SimEyeField(key, &lanes);
+  if (field == NULL)
+  {
+    return -1;
+  }
+
+  if (dot)
+  {
+    lane = strtol(dot + 1, &end, 0);
+    if (end != eq || lane < 0 || lane >= lanes)
+    {
+      return -1;
+    }
+  }
+
+  value = strtol(eq + 1, &end, 0);
+  if (*end != 0)
+  {
+    return -1;
+  }
+
+  if (lane >= 0)
+  {
+    field[lane] = (int32_t)value;
+  }
+  else
+  {
+    for (lane = 0; lane < lanes; lane++)
+    {
+      field[lane] = (int32_t)value;
+    }
+  }
+  return 0;
+}
+
+static int32_t SimAbs(
+    int32_t x)
+{
+  return (x < 0) ? -x : x;
+}
+
+// (x mod FULL_CLK) in 0..FULL_CLK-1
+static int32_t SimPhase(
+    int32_t x)
+{
+  return ((x % FULL_CLK) + FULL_CLK) % FULL_CLK;
+}
+
+static int32_t SimJitter(
+    void)
+{
+  if (SimEye.jitter <= 0)
+  {
+    return 0;
+  }
+  SimEye.seed = SimEye.seed * 1103515245 + 12345;
+  return (SimEye.seed >> 16) % (SimEye.jitter + 1);
+}
+
+// CK rising edge at the DRAM as seen by WDQS of given lane
+static int32_t SimWdqsTarget(
+    uint8_t bl)
+{
+  return (int32_t)get_wclk(0, 0) + SimEye.wdqs_offset[bl];
+}
+
+static uint32_t SimRcvnSample(
+    uint8_t bl)
+{
+  int32_t d = (int32_t)get_rcvn(0, 0, bl) - SimEye.rcvn_edge[bl];
+
+  // outside of the burst DQS is parked low
+  if (d < 0 || d >= 4 * FULL_CLK)
+  {
+    return 0;
+  }
+  return (SimPhase(d) < HALF_CLK) ? 1 : 0;
+}
+
+static uint32_t SimWdqsSample(
+    uint8_t bl)
+{
+  int32_t d = (int32_t)get_wdqs(0, 0, bl) - SimWdqsTarget(bl);
+
+  return (SimPhase(d) < HALF_CLK) ? 1 : 0;
+}
+
+static bool SimReadCoarseOk(
+    uint8_t bl)
+{
+  int32_t d = (int32_t)get_rcvn(0, 0, bl) - (SimEye.rcvn_edge[bl] - HALF_CLK);
+
+  return SimAbs(d) < HALF_CLK;
+}
+
+static bool SimWriteCoarseOk(
+    uint8_t bl)
+{
+  int32_t d = (int32_t)get_wdqs(0, 0, bl) - SimWdqsTarget(bl);
+
+  return SimAbs(d) < HALF_CLK;
+}
+
+static bool SimReadEyeOk(
+    uint8_t bl)
+{
+  int32_t rh = SimEye.rdqs_half - SimJitter();
+  int32_t vh = SimEye.vref_half - SimJitter();
+  int32_t dx = SimAbs((int32_t)get_rdqs(0, 0, bl) - SimEye.rdqs_center[bl]);
+  int32_t dy = SimAbs((int32_t)get_vref(0, bl) - SimEye.vref_center[bl]);
+
+  if (rh <= 0 || vh <= 0)
+  {
+    return false;
+  }
+  return (dx * vh + dy * rh) <= (rh * vh);
+}
+
+static bool SimWriteEyeOk(
+    uint8_t bl)
+{
+  int32_t half = SimEye.wdq_half - SimJitter();
+  int32_t center = SimWdqsTarget(bl) - QRTR_CLK + SimEye.wdq_offset[bl];
+
+  return SimAbs((int32_t)get_wdq(0, 0, bl) - center) <= half;
+}
+
+static uint32_t SimLanes(
+    void)
+{
+  return (SimParams->channel_width == x16) ? (NUM_BYTE_LANES / 2) : NUM_BYTE_LANES;
+}
+
+// DQTRAINSTS content of given byte lane group, BIT1/BIT0 RCVN and BIT9/BIT8 WDQS samples of BL0/BL1
+uint32_t SimEyeDqsSample(
+    uint8_t bl_grp)
+{
+  uint32_t ret = 0;
+  uint8_t bl0 = bl_grp * 2;
+  uint8_t bl1 = bl_grp * 2 + 1;
+
+  SimQuiet(1);
+  ret |= SimRcvnSample(bl0) ? BIT1 : 0;
+  ret |= SimRcvnSample(bl1) ? BIT0 : 0;
+  ret |= SimWdqsSample(bl0) ? BIT9 : 0;
+  ret |= SimWdqsSample(bl1) ? BIT8 : 0;
+  SimQuiet(0);
+
+  return ret;
+}
+
+// Byte lane failure mask of an HTE test, bit per lane
+uint32_t SimEyeTest(
+    uint32_t kind)
+{
+  uint32_t fail = 0;
+  uint8_t bl;
+
+  SimQuiet(1);
+  for (bl = 0; bl < SimLanes(); bl++)
+  {
+    bool ok = SimReadCoarseOk(bl) && SimWriteCoarseOk(bl);
+
+    if (ok && kind != SIM_HTE_BASIC)
+    {
+      ok = SimReadEyeOk(bl) && SimWriteEyeOk(bl);
+    }
+    if (!ok)
+    {
+      fail |= 1 << bl;
+    }
+  }
+  SimQuiet(0);
+
+  return fail;
+}
+
+// Compare the trained delays with the model, returns number of lanes out of tolerance
+int SimEyeCheck(
+    MRCParams_t *mrc_params,
+    int32_t tolerance)
+{
+  int errors = 0;
+  uint8_t bl;
+
+  SimQuiet(1);
+  for (bl = 0; bl < SimLanes(); bl++)
+  {
+    int32_t exp[5];
+    int32_t got[5];
+    uint32_t i;
+
+    exp[0] = SimEye.rcvn_edge[bl] - HALF_CLK;
+    got[0] = get_rcvn(0, 0, bl);
+    exp[1] = SimWdqsTarget(bl);
+    got[1] = get_wdqs(0, 0, bl);
+    exp[2] = SimWdqsTarget(bl) - QRTR_CLK + SimEye.wdq_offset[bl];
+    got[2] = get_wdq(0, 0, bl);
+    exp[3] = SimEye.rdqs_center[bl];
+    got[3] = get_rdqs(0, 0, bl);
+    exp[4] = SimEye.vref_center[bl];
+    got[4] = get_vref(0, bl);
+
+    for (i = 0; i < MCOUNT(exp); i++)
+    {
+      static const char *names[] = { "rcvn", "wdqs", "wdq", "rdqs", "vref" };
+
+      if (SimAbs(got[i] - exp[i]) > tolerance)
+      {
+        printf("CHECK: lane %d %s trained %d expected %d\n", bl, names[i], got[i], exp[i]);
+        errors++;
+      }
+    }
+  }
+  SimQuiet(0);
+
+  return errors;
+}
@@ -0,0 +1,324 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Sideband, MMIO and delay back end of the host MRC simulation.
+ *
+ * platform.c calls SimMmio32Read()/SimMmio32Write()/SimDelayClk() in SIM
+ * builds. Sideband accesses are decoded from the SB_HADR/SB_DATA/SB_PACKET
+ * writes into a sparse register file, a few registers are special cased
+ * so the MRC polling loops complete and the HTE/DQS results come from
+ * the eye model.
+ *
+ ***************************************************************************/
+#include "MrcSim.h"
+
+#define SIM_REG_HASH_SIZE   4096    // power of 2, must exceed number of registers used
+
+#define SIM_PS_PER_CLK      1250    // delay_n() converts to 800MHz clocks
+
+typedef struct SimReg_s
+{
+  uint32_t key;                     // port << 24 | register
+  uint32_t data;
+  bool     used;
+} SimReg_t;
+
+SimStats_t  SimStats[SIM_MAX_STEPS + 1];
+SimStats_t *SimCur = &SimStats[SIM_NO_STEP];
+SimCost_t   SimCost;
+MRCParams_t *SimParams;
+
+static SimReg_t SimRegs[SIM_REG_HASH_SIZE];
+
+static uint32_t SimHadr;            // SB_HADR_REG latch
+static uint32_t SimData;            // SB_DATA_REG latch
+static int      SimQuietLevel;      // accesses done by the model are not accounted
+static uint32_t SimSavedHadr;
+static uint32_t SimSavedData;
+
+// Clear the register file and the statistics, keeps the cost and eye model
+void SimReset(
+    void)
+{
+  memset(SimRegs, 0, sizeof(SimRegs));
+  memset(SimStats, 0, sizeof(SimStats));
+  SimCur = &SimStats[SIM_NO_STEP];
+  SimHadr = 0;
+  SimData = 0;
+}
+
+void SimQuiet(
+    int enter)
+{
+  if (enter)
+  {
+    if (SimQuietLevel++ == 0)
+    {
+      SimSavedHadr = SimHadr;
+      SimSavedData = SimData;
+    }
+  }
+  else
+  {
+    if (--SimQuietLevel == 0)
+    {
+      SimHadr = SimSavedHadr;
+      SimData = SimSavedData;
+    }
+  }
+}
+
+void SimAddTime(
+    uint64_t ps)
+{
+  uint64_t total = 0;
+  uint32_t i;
+
+  if (SimQuietLevel)
+  {
+    return;
+  }
+
+  SimCur->time_ps += ps;
+
+  if (SimCost.limit_ps)
+  {
+    for (i = 0; i <= SIM_MAX_STEPS; i++)
+    {
+      total += SimStats[i].time_ps;
+    }
+    if (total > SimCost.limit_ps)
+    {
+      printf("ERROR: simulated time limit exceeded, training does not converge\n");
+      exit(2);
+    }
+  }
+}
+
+static SimReg_t *SimLookup(
+    uint32_t key)
+{
+  uint32_t i = (key * 2654435761U) >> 20;
+
+  for (;;)
+  {
+    SimReg_t *reg = &SimRegs[i & (SIM_REG_HASH_SIZE - 1)];
+
+    if (!reg->used || reg->key == key)
+    {
+      return reg;
+    }
+    i++;
+  }
+}
+
+static bool SimIsDqTrainSts(
+    uint32_t reg,
+    uint8_t *bl_grp)
+{
+  uint8_t grp;
+
+  for (grp = 0; grp < NUM_BYTE_LANES / 2; grp++)
+  {
+    if (reg == DQTRAINSTS + grp * DDRIODQ_BL_OFFSET)
+    {
+      *bl_grp = grp;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t SimRegRead(
+    uint32_t port,
+    uint32_t reg)
+{
+  SimReg_t *entry;
+  uint8_t bl_grp;
+
+  if (port == DDRPHY && SimIsDqTrainSts(reg, &bl_grp))
+  {
+    if (!SimQuietLevel)
+    {
+      SimCur->dqs_samples++;
+    }
+    return SimEyeDqsSample(bl_grp);
+  }
+
+  entry = SimLookup(port << 24 | reg);
+  return entry->used ? entry->data : 0;
+}
+
+static void SimHteRun(
+    uint32_t ctrl)
+{
+  uint32_t cmd = SimRegRead(HTE, 0x00020020);
+  uint32_t kind;
+  uint64_t lines;
+  uint32_t fail = 0;
+
+  if (ctrl & 0x10000000)
+  {
+    // victim/aggressor stress, LoopCount iterations of 8 line write+read
+    kind = SIM_HTE_STRESS;
+    lines = 2 * 8 * (uint64_t)((ctrl >> 16) & 0xFFF);
+  }
+  else if ((ctrl & 0x00100000) != 0)
+  {
+    // full memory pass of HteMemInit()
+    kind = SIM_HTE_MEMINIT;
+    lines = (uint64_t)SimRegRead(HTE, 0x00020022) + 1;
+  }
+  else if (cmd == 0x01B10021)
+  {
+    kind = SIM_HTE_BASIC;
+    lines = 2;
+  }
+  else
+  {
+    kind = SIM_HTE_MEMOP;
+    lines = 1;
+  }
+
+  // only the read passes of HteMemInit() and the compare tests report errors
+  if (kind != SIM_HTE_MEMOP && !(kind == SIM_HTE_MEMINIT && (cmd & 0x00100000)))
+  {
+    fail = SimEyeTest(kind);
+  }
+
+  SimRegWrite(HTE, 0x000200A7, fail << 8);
+  SimRegWrite(HTE, 0x00020011, ctrl & ~BIT8);
+
+  if (!SimQuietLevel)
+  {
+    SimCur->hte_runs++;
+    SimCur->hte_lines += lines;
+    SimAddTime(SimCost.hte_setup_ps + lines * SimCost.hte_line_ps);
+  }
+}
+
+void SimRegWrite(
+    uint32_t port,
+    uint32_t reg,
+    uint32_t data)
+{
+  SimReg_t *entry;
+  uint8_t ch;
+
+  // DDRPHY command/clock alignment completes immediately
+  if (port == DDRPHY)
+  {
+    for (ch = 0; ch < NUM_CHANNELS; ch++)
+    {
+      if (reg == CMDCLKALIGNREG0 + ch * DDRIOCCC_CH_OFFSET)
+      {
+        data &= ~BIT24;
+      }
+    }
+  }
+
+  entry = SimLookup(port << 24 | reg);
+  entry->used = true;
+  entry->key = port << 24 | reg;
+  entry->data = data;
+
+  // HTE test start
+  if (port == HTE && reg == 0x00020011 && (data & BIT8))
+  {
+    SimHteRun(data);
+  }
+}
+
+static void SimPacket(
+    uint32_t packet)
+{
+  uint32_t opcode = packet >> SB_OPCODE_OFFSET;
+  uint32_t port = (packet >> SB_PORT_OFFSET) & 0xFF;
+  uint32_t reg = (SimHadr & 0xFFFFFF00) | ((packet >> SB_REG_OFFEST) & 0xFF);
+
+  switch (opcode)
+  {
+  case SB_REG_READ_OPCODE:
+  case SB_DDRIO_REG_READ_OPCODE:
+    SimData = SimRegRead(port, reg);
+    if (!SimQuietLevel)
+    {
+      SimCur->sb_reads++;
+    }
+    break;
+
+  case SB_REG_WRITE_OPCODE:
+  case SB_DDRIO_REG_WRITE_OPCODE:
+    if (!SimQuietLevel)
+    {
+      SimCur->sb_writes++;
+    }
+    SimRegWrite(port, reg, SimData);
+    break;
+
+  case SB_DRAM_CMND_OPCODE:
+  case SB_WAKE_CMND_OPCODE:
+  case SB_SUSPEND_CMND_OPCODE:
+    if (!SimQuietLevel)
+    {
+      SimCur->dram_cmds++;
+    }
+    break;
+
+  default:
+    printf("WARNING: unknown sideband opcode 0x%02X\n", opcode);
+    break;
+  }
+}
+
+void SimMmio32Write(
+    uint32_t be,
+    uint32_t address,
+    uint32_t data)
+{
+  if (address == PCIADDR(0,0,0,SB_HADR_REG))
+  {
+    SimHadr = data;
+  }
+  else if (address == PCIADDR(0,0,0,SB_DATA_REG))
+  {
+    SimData = data;
+  }
+  else if (address == PCIADDR(0,0,0,SB_PACKET_REG))
+  {
+    SimPacket(data);
+  }
+
+  SimAddTime(SimCost.mmio_ps);
+}
+
+void SimMmio32Read(
+    uint32_t be,
+    uint32_t address,
+    uint32_t *data)
+{
+  if (address == PCIADDR(0,0,0,SB_DATA_REG))
+  {
+    *data = SimData;
+  }
+  else
+  {
+    // memory and other MMIO reads as 0
+    *data = 0;
+  }
+
+  SimAddTime(SimCost.mmio_ps);
+}
+
+void SimDelayClk(
+    uint32_t x2clk)
+{
+  if (!SimQuietLevel)
+  {
+    SimCur->delay_ps += (uint64_t)x2clk * SIM_PS_PER_CLK;
+  }
+  SimAddTime((uint64_t)x2clk * SIM_PS_PER_CLK);
+}
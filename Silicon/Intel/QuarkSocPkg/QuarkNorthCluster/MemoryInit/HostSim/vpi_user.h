@@ -0,0 +1,18 @@
+/************************************************************************
+ *
+ * Copyright (c) 2026 Intel Corporation.
+ *
+* SPDX-License-Identifier: BSD-2-Clause-Patent
+ *
+ * Replacement of the Verilog VPI header used by lprint.c in SIM builds,
+ * the host simulation prints the MRC debug output to stdout.
+ *
+ ***************************************************************************/
+#ifndef _VPI_USER_H_
+#define _VPI_USER_H_
+
+#include <stdarg.h>
+
+int vpi_vprintf(char *format, va_list ap);
+
+#endif // _VPI_USER_H_
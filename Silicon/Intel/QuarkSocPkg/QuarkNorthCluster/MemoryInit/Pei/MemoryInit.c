@@ -13,7 +13,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "MemoryInit.h"
 
 static PEI_QNC_MEMORY_INIT_PPI mPeiQNCMemoryInitPpi =
-{ MrcStart };
+{ MrcStart, MrcComplete };
 
 static EFI_PEI_PPI_DESCRIPTOR PpiListPeiQNCMemoryInit =
 {
@@ -23,6 +23,7 @@ static EFI_PEI_PPI_DESCRIPTOR PpiListPeiQNCMemoryInit =
 };
 
 void Mrc( MRCParams_t *MrcData);
+void MrcWait( MRCParams_t *MrcData);
 
 /**
 
@@ -57,3 +58,13 @@ MrcStart(
 
   Mrc(MrcData);
 }
+
+VOID
+EFIAPI
+MrcComplete(
+    IN OUT MRCParams_t *MrcData
+    )
+{
+
+  MrcWait(MrcData);
+}
@@ -32,4 +32,10 @@ MrcStart (
   IN OUT MRCParams_t  *MrcData
   );
 
+VOID
+EFIAPI
+MrcComplete (
+  IN OUT MRCParams_t  *MrcData
+  );
+
 #endif
@@ -56,13 +56,30 @@ STATIC UINT32 CheckHteErrors(
   return isbR32m(HTE, 0x000200A7);
 }
 
-STATIC VOID WaitForHteComplete(
+STATIC UINT8 IsHteBusy(
     VOID)
 /*++
 
  Routine Description:
 
- This function waits until HTE finishes
+ This function checks if HTE is still running a test
+
+ Returns:
+
+ Non zero while the test is running
+
+ --*/
+{
+  return (0 != (isbR32m(HTE, 0x00020012) & BIT30));
+}
+
+STATIC VOID AckHteComplete(
+    VOID)
+/*++
+
+ Routine Description:
+
+ This function acknowledges completion of the last HTE test
 
  Returns:
 
@@ -72,6 +89,26 @@ STATIC VOID WaitForHteComplete(
 {
   UINT32 Tmp;
 
+  Tmp = isbR32m(HTE, 0x00020011);
+  Tmp = Tmp | BIT9;
+  Tmp = Tmp & ~(BIT13 | BIT12);
+  isbW32m(HTE, 0x00020011, Tmp);
+}
+
+STATIC VOID WaitForHteComplete(
+    VOID)
+/*++
+
+ Routine Description:
+
+ This function waits until HTE finishes
+
+ Returns:
+
+ None
+
+ --*/
+{
   ENTERFN();
 
   //
@@ -82,12 +119,9 @@ STATIC VOID WaitForHteComplete(
 #ifdef SIM
     MySimStall (35000); // 35 ns delay
 #endif
-  } while (0 != (isbR32m(HTE, 0x00020012) & BIT30));
+  } while (IsHteBusy());
 
-  Tmp = isbR32m(HTE, 0x00020011);
-  Tmp = Tmp | BIT9;
-  Tmp = Tmp & ~(BIT13 | BIT12);
-  isbW32m(HTE, 0x00020011, Tmp);
+  AckHteComplete();
 
   LEAVEFN();
 }
@@ -117,7 +151,53 @@ STATIC VOID ClearHteErrorRegisters(
   isbW32m(HTE, 0x000200A1, Tmp);
 }
 
-UINT32 HteMemInit(
+STATIC VOID HteMemInitPass(
+    UINT8 Pass)
+/*++
+
+ Routine Description:
+
+ Starts one pass of the HteMemInit() sequence, even passes write the
+ memory, odd passes read it back.
+
+ Arguments:
+
+ Pass: pass number, 0 to 3.
+
+ Returns:
+
+ None
+
+ --*/
+{
+  DPF(D_INFO, ".");
+
+  if (Pass == 0)
+  {
+    isbW32m(HTE, 0x00020061, 0x00000000);
+    isbW32m(HTE, 0x00020020, 0x00110010);
+  }
+  else if (Pass == 1)
+  {
+    isbW32m(HTE, 0x00020061, 0x00000000);
+    isbW32m(HTE, 0x00020020, 0x00010010);
+  }
+  else if (Pass == 2)
+  {
+    isbW32m(HTE, 0x00020061, 0x00010100);
+    isbW32m(HTE, 0x00020020, 0x00110010);
+  }
+  else
+  {
+    isbW32m(HTE, 0x00020061, 0x00010100);
+    isbW32m(HTE, 0x00020020, 0x00010010);
+  }
+
+  isbW32m(HTE, 0x00020011, 0x00111000);
+  isbW32m(HTE, 0x00020011, 0x00111100);
+}
+
+UINT32 HteMemInitStart(
     MRC_PARAMS *CurrentMrcData,
     UINT8 MemInitFlag,
     UINT8 HaltHteEngineOnError)
@@ -126,12 +206,8 @@ UINT32 HteMemInit(
 
  Routine Description:
 
- Uses HW HTE engine to initialize or test all memory attached to a given DUNIT.
- If MemInitFlag is 1, this routine writes 0s to all memory locations to initialize
- ECC.
- If MemInitFlag is 0, this routine will send an 5AA55AA5 pattern to all memory
- locations on the RankMask and then read it back.  Then it sends an A55AA55A
- pattern to all memory locations on the RankMask and reads it back.
+ Starts the HteMemInit() sequence without waiting for it, each pass
+ covers the whole memory and HteMemInitPoll() starts the next one.
 
  Arguments:
 
@@ -141,17 +217,11 @@ UINT32 HteMemInit(
  running to see how many errors are found.
 
  Returns:
- Errors register showing HTE failures.
- Also prints out which rank failed the HTE test if failure occurs.
- For rank detection to work, the address map must be left in its default
- state.  If MRC changes the address map, this function must be modified
- to change it back to default at the beginning, then restore it at the end.
+ 0 when started, 0xFFFFFFFF for invalid MemInitFlag.
 
  --*/
 {
   UINT32 Offset;
-  UINT8 TestNum;
-  UINT8 i;
 
   //
   // Clear out the error registers at the start of each memory
@@ -182,10 +252,10 @@ UINT32 HteMemInit(
   switch (MemInitFlag)
   {
   case MrcMemInit:
-    TestNum = 1; // Only 1 write pass through memory is needed to initialize ECC.
+    CurrentMrcData->hte_pass_count = 1; // Only 1 write pass through memory is needed to initialize ECC.
     break;
   case MrcMemTest:
-    TestNum = 4; // Write/read then write/read with inverted pattern.
+    CurrentMrcData->hte_pass_count = 4; // Write/read then write/read with inverted pattern.
     break;
   default:
     DPF(D_INFO, "Unknown parameter for MemInitFlag: %d\n", MemInitFlag);
@@ -194,53 +264,112 @@ UINT32 HteMemInit(
   }
 
   DPF(D_INFO, "HteMemInit");
-  for (i = 0; i < TestNum; i++)
-  {
-    DPF(D_INFO, ".");
+  CurrentMrcData->hte_pass = 0;
+  HteMemInitPass(0);
 
-    if (i == 0)
-    {
-      isbW32m(HTE, 0x00020061, 0x00000000);
-      isbW32m(HTE, 0x00020020, 0x00110010);
-    }
-    else if (i == 1)
+  return 0;
+}
+
+UINT8 HteMemInitPoll(
+    MRC_PARAMS *CurrentMrcData,
+    UINT32 *Result)
+
+/*++
+
+ Routine Description:
+
+ Advances the sequence started by HteMemInitStart(), does not wait.
+
+ Arguments:
+
+ CurrentMrcData: Host struture for all MRC global data.
+ Result: on completion the errors register showing HTE failures.
+
+ Returns:
+ 0 while the sequence is running, 1 when it completed.
+
+ --*/
+{
+  UINT8 Pass;
+
+  if (CurrentMrcData->hte_pass < CurrentMrcData->hte_pass_count)
+  {
+    if (IsHteBusy())
     {
-      isbW32m(HTE, 0x00020061, 0x00000000);
-      isbW32m(HTE, 0x00020020, 0x00010010);
+      return 0;
     }
-    else if (i == 2)
+    AckHteComplete();
+
+    Pass = (UINT8) CurrentMrcData->hte_pass++;
+
+    //
+    // If this was a READ pass, check for errors and stop immediately if any.
+    //
+    if (((Pass % 2) == 1) && CheckHteErrors())
     {
-      isbW32m(HTE, 0x00020061, 0x00010100);
-      isbW32m(HTE, 0x00020020, 0x00110010);
+      CurrentMrcData->hte_pass = CurrentMrcData->hte_pass_count;
     }
-    else
+
+    if (CurrentMrcData->hte_pass < CurrentMrcData->hte_pass_count)
     {
-      isbW32m(HTE, 0x00020061, 0x00010100);
-      isbW32m(HTE, 0x00020020, 0x00010010);
+      HteMemInitPass((UINT8) CurrentMrcData->hte_pass);
+      return 0;
     }
 
-    isbW32m(HTE, 0x00020011, 0x00111000);
-    isbW32m(HTE, 0x00020011, 0x00111100);
+    DPF(D_INFO, "done\n");
+  }
 
-    WaitForHteComplete();
+  *Result = CheckHteErrors();
+  return 1;
+}
 
-    //
-    // If this is a READ pass, check for errors at the end.
-    //
-    if ((i % 2) == 1)
-    {
-      //
-      // Return immediately if  error.
-      //
-      if (CheckHteErrors())
-      {
-        break;
-      }
-    }
+UINT32 HteMemInit(
+    MRC_PARAMS *CurrentMrcData,
+    UINT8 MemInitFlag,
+    UINT8 HaltHteEngineOnError)
+
+/*++
+
+ Routine Description:
+
+ Uses HW HTE engine to initialize or test all memory attached to a given DUNIT.
+ If MemInitFlag is 1, this routine writes 0s to all memory locations to initialize
+ ECC.
+ If MemInitFlag is 0, this routine will send an 5AA55AA5 pattern to all memory
+ locations on the RankMask and then read it back.  Then it sends an A55AA55A
+ pattern to all memory locations on the RankMask and reads it back.
+
+ Arguments:
+
+ CurrentMrcData: Host struture for all MRC global data.
+ MemInitFlag: 0 for memtest, 1 for meminit.
+ HaltHteEngineOnError:  Halt the HTE engine on first error observed, or keep
+ running to see how many errors are found.
+
+ Returns:
+ Errors register showing HTE failures.
+ Also prints out which rank failed the HTE test if failure occurs.
+ For rank detection to work, the address map must be left in its default
+ state.  If MRC changes the address map, this function must be modified
+ to change it back to default at the beginning, then restore it at the end.
+
+ --*/
+{
+  UINT32 Result;
+
+  if (HteMemInitStart(CurrentMrcData, MemInitFlag, HaltHteEngineOnError) != 0)
+  {
+    return 0xFFFFFFFF;
   }
 
-  DPF(D_INFO, "done\n", i);
-  return CheckHteErrors();
+  do
+  {
+#ifdef SIM
+    MySimStall (35000); // 35 ns delay
+#endif
+  } while (!HteMemInitPoll(CurrentMrcData, &Result));
+
+  return Result;
 }
 
 STATIC UINT16 BasicDataCompareHte(
@@ -44,6 +44,17 @@ HteMemInit(
     UINT8 MemInitFlag,
     UINT8 HaltHteEngineOnError);
 
+UINT32
+HteMemInitStart(
+    MRC_PARAMS *CurrentMrcData,
+    UINT8 MemInitFlag,
+    UINT8 HaltHteEngineOnError);
+
+UINT8
+HteMemInitPoll(
+    MRC_PARAMS *CurrentMrcData,
+    UINT32 *Result);
+
 UINT16
 BasicWriteReadHTE(
     MRC_PARAMS *CurrentMrcData,
@@ -1348,6 +1348,135 @@ static uint32_t check_rw_coarse(
   return result;
 }
 
+#ifdef ADAPTIVE_EYE_SEARCH
+// Adaptive eye edge search used by rd_train and wr_train.
+// A failing byte lane is moved EYE_SEARCH_COARSE_STEP codes towards the eye until it passes,
+// then the edge is found by bisecting the last failing and the first passing code.
+// All byte lanes are searched in parallel so one check_bls_ex() serves every lane.
+// The edge found is the one of the 1 code linear search as long as the failing region
+// has no passing hole of EYE_SEARCH_COARSE_STEP codes or more. A lane reaching the limit
+// is searched again code by code, so an eye narrower than the coarse step is not missed.
+#define EYE_SEARCH_COARSE_STEP 4
+
+#define EYE_SEARCH_COARSE 0 // stepping by EYE_SEARCH_COARSE_STEP until the lane passes
+#define EYE_SEARCH_FINE   1 // bisecting between "fail" and "pass"
+#define EYE_SEARCH_DONE   2 // edge found, lane is at the first passing code
+
+typedef struct eye_search_s
+{
+  uint8_t state;      // EYE_SEARCH_xxx
+  bool has_fail;      // "fail" and "start" are valid
+  uint8_t step;       // coarse step size
+  uint32_t start;     // first failing code
+  uint32_t fail;      // failing code closest to the eye
+  uint32_t pass;      // passing code closest to the edge
+} eye_search_t;
+
+static void eye_search_init(
+    eye_search_t *search)
+{
+  search->state = EYE_SEARCH_COARSE;
+  search->has_fail = false;
+  search->step = EYE_SEARCH_COARSE_STEP;
+  search->start = 0;
+  search->fail = 0;
+  search->pass = 0;
+}
+
+// Returns true when every byte lane is at its final code.
+static bool eye_search_done(
+    eye_search_t *search,
+    uint8_t num_lanes)
+{
+  uint8_t bl_i;
+
+  for (bl_i = 0; bl_i < num_lanes; bl_i++)
+  {
+    if (search[bl_i].state != EYE_SEARCH_DONE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the next code to test after bisection step.
+static uint32_t eye_search_bisect(
+    eye_search_t *search)
+{
+  uint32_t distance;
+
+  distance = (search->pass > search->fail) ? (search->pass - search->fail) : (search->fail - search->pass);
+  if (distance <= 1)
+  {
+    search->state = EYE_SEARCH_DONE;
+    return search->pass;
+  }
+  search->state = EYE_SEARCH_FINE;
+  return (search->pass + search->fail) / 2;
+}
+
+// The byte lane passed at "code", returns the next code to test.
+static uint32_t eye_search_pass(
+    eye_search_t *search,
+    uint32_t code)
+{
+  if (search->state == EYE_SEARCH_DONE)
+  {
+    return code;
+  }
+  search->pass = code;
+  if (!search->has_fail)
+  {
+    // passing from the very first code, nothing to refine
+    search->state = EYE_SEARCH_DONE;
+    return code;
+  }
+  return eye_search_bisect(search);
+}
+
+// The byte lane failed at "code", returns the next code to test.
+// "inward" is true when the eye is at higher codes than "code".
+// "limit" is the last code accepted by the caller; a lane failing at "limit" is moved one code
+// past it, so the caller detects the collapsed eye the same way as with 1 code steps.
+static uint32_t eye_search_fail(
+    eye_search_t *search,
+    uint32_t code,
+    bool inward,
+    uint32_t limit)
+{
+  uint32_t distance;
+
+  if (!search->has_fail)
+  {
+    search->start = code;
+  }
+  search->fail = code;
+  search->has_fail = true;
+  if (search->state == EYE_SEARCH_FINE)
+  {
+    return eye_search_bisect(search);
+  }
+
+  // an edge found before can fail again with the final settings of the other lanes
+  search->state = EYE_SEARCH_COARSE;
+  if (inward ? (code >= limit) : (code <= limit))
+  {
+    if (search->step > 1)
+    {
+      // the eye may be narrower than the coarse step, search again code by code
+      search->step = 1;
+      search->fail = search->start;
+      return inward ? (search->start + 1) : (search->start - 1);
+    }
+    return inward ? (code + 1) : (code - 1);
+  }
+  distance = inward ? (limit - code) : (code - limit);
+  distance = MMIN(distance, search->step);
+  return inward ? (code + distance) : (code - distance);
+}
+#endif // ADAPTIVE_EYE_SEARCH
+
 // wr_level:
 // POST_CODE[major] == 0x06
 //
@@ -1580,6 +1709,11 @@ static void rd_train(
   uint32_t address; // target address for "check_bls_ex()"
   uint32_t result; // result of "check_bls_ex()"
   uint32_t bl_mask; // byte lane mask for "result" checking
+#ifdef ADAPTIVE_EYE_SEARCH
+  eye_search_t search[NUM_BYTE_LANES]; // RDQS edge search state
+  bool search_done; // all byte lanes were at their final RDQS when tested
+  uint32_t limit; // last RDQS code before the eye is considered too small
+#endif // ADAPTIVE_EYE_SEARCH
 #ifdef R2R_SHARING
   uint32_t final_delay[NUM_CHANNELS][NUM_BYTE_LANES]; // used to find placement for rank2rank sharing configs
   uint32_t num_ranks_enabled = 0; // used to find placement for rank2rank sharing configs
@@ -1674,13 +1808,36 @@ static void rd_train(
               // request HTE reconfiguration
               mrc_params->hte_setup = 1;
 
+#ifdef ADAPTIVE_EYE_SEARCH
+              for (bl_i = 0; bl_i < (NUM_BYTE_LANES / bl_divisor); bl_i++)
+              {
+                eye_search_init(&search[bl_i]);
+              } // bl_i loop
+#endif // ADAPTIVE_EYE_SEARCH
+
               // test the settings
               do
               {
+#ifdef ADAPTIVE_EYE_SEARCH
+                search_done = eye_search_done(search, (NUM_BYTE_LANES / bl_divisor));
+#endif // ADAPTIVE_EYE_SEARCH
 
                 // result[07:00] == failing byte lane (MAX 8)
                 result = check_bls_ex( mrc_params, address);
 
+#ifdef ADAPTIVE_EYE_SEARCH
+                // refine the edge of the passing byte lanes
+                for (bl_i = 0; bl_i < (NUM_BYTE_LANES / bl_divisor); bl_i++)
+                {
+                  if ((result & (bl_mask << bl_i)) == 0)
+                  {
+                    x_coordinate[side_x][side_y][channel_i][rank_i][bl_i] =
+                        (uint8_t) eye_search_pass(&search[bl_i], x_coordinate[side_x][side_y][channel_i][rank_i][bl_i]);
+                    set_rdqs(channel_i, rank_i, bl_i, x_coordinate[side_x][side_y][channel_i][rank_i][bl_i]);
+                  }
+                } // bl_i loop
+#endif // ADAPTIVE_EYE_SEARCH
+
                 // check for failures
                 if (result & 0xFF)
                 {
@@ -1690,6 +1847,18 @@ static void rd_train(
                     if (result & (bl_mask << bl_i))
                     {
                       // adjust the RDQS values accordingly
+#ifdef ADAPTIVE_EYE_SEARCH
+                      if (side_x == L)
+                      {
+                        limit = MMIN((RDQS_MAX - MIN_RDQS_EYE), (x_coordinate[R][side_y][channel_i][rank_i][bl_i] - 1));
+                      }
+                      else
+                      {
+                        limit = MMAX((RDQS_MIN + MIN_RDQS_EYE), (x_coordinate[L][side_y][channel_i][rank_i][bl_i] + 1));
+                      }
+                      x_coordinate[side_x][side_y][channel_i][rank_i][bl_i] = (uint8_t) eye_search_fail(&search[bl_i],
+                          x_coordinate[side_x][side_y][channel_i][rank_i][bl_i], (side_x == L), limit);
+#else
                       if (side_x == L)
                       {
                         x_coordinate[L][side_y][channel_i][rank_i][bl_i] += RDQS_STEP;
@@ -1698,6 +1867,7 @@ static void rd_train(
                       {
                         x_coordinate[R][side_y][channel_i][rank_i][bl_i] -= RDQS_STEP;
                       }
+#endif // ADAPTIVE_EYE_SEARCH
                       // check that we haven't closed the RDQS_EYE too much
                       if ((x_coordinate[L][side_y][channel_i][rank_i][bl_i] > (RDQS_MAX - MIN_RDQS_EYE)) ||
                           (x_coordinate[R][side_y][channel_i][rank_i][bl_i] < (RDQS_MIN + MIN_RDQS_EYE))
@@ -1731,6 +1901,9 @@ static void rd_train(
                           // reset the X coordinate to begin the search at the new VREF
                           x_coordinate[side_x][side_y][channel_i][rank_i][bl_i] =
                               (side_x == L) ? (RDQS_MIN) : (RDQS_MAX);
+#ifdef ADAPTIVE_EYE_SEARCH
+                          eye_search_init(&search[bl_i]);
+#endif // ADAPTIVE_EYE_SEARCH
                         }
                       }
                       // update the RDQS setting
@@ -1738,7 +1911,11 @@ static void rd_train(
                     } // if bl_i failed
                   } // bl_i loop
                 } // at least 1 byte lane failed
+#ifdef ADAPTIVE_EYE_SEARCH
+              } while ((result & 0xFF) || !search_done); // stop when all byte lanes pass at their final RDQS
+#else
               } while (result & 0xFF);
+#endif // ADAPTIVE_EYE_SEARCH
             } // if rank is enabled
           } // rank_i loop
         } // if channel is enabled
@@ -1907,6 +2084,11 @@ static void wr_train(
   uint32_t address; // target address for "check_bls_ex()"
   uint32_t result; // result of "check_bls_ex()"
   uint32_t bl_mask; // byte lane mask for "result" checking
+#ifdef ADAPTIVE_EYE_SEARCH
+  eye_search_t search[NUM_BYTE_LANES]; // WDQ edge search state
+  bool search_done; // all byte lanes were at their final WDQ when tested
+  uint32_t limit; // last WDQ code before the eye is closed
+#endif // ADAPTIVE_EYE_SEARCH
 #ifdef R2R_SHARING
   uint32_t final_delay[NUM_CHANNELS][NUM_BYTE_LANES]; // used to find placement for rank2rank sharing configs
   uint32_t num_ranks_enabled = 0; // used to find placement for rank2rank sharing configs
@@ -2004,9 +2186,19 @@ static void wr_train(
             // request HTE reconfiguration
             mrc_params->hte_setup = 1;
 
+#ifdef ADAPTIVE_EYE_SEARCH
+            for (bl_i = 0; bl_i < (NUM_BYTE_LANES / bl_divisor); bl_i++)
+            {
+              eye_search_init(&search[bl_i]);
+            } // bl_i loop
+#endif // ADAPTIVE_EYE_SEARCH
+
             // check the settings
             do
             {
+#ifdef ADAPTIVE_EYE_SEARCH
+              search_done = eye_search_done(search, (NUM_BYTE_LANES / bl_divisor));
+#endif // ADAPTIVE_EYE_SEARCH
 
 #ifdef SIM
               // need restore memory to idle state as write can be in bad sync
@@ -2015,6 +2207,17 @@ static void wr_train(
 
               // result[07:00] == failing byte lane (MAX 8)
               result = check_bls_ex( mrc_params, address);
+#ifdef ADAPTIVE_EYE_SEARCH
+              // refine the edge of the passing byte lanes
+              for (bl_i = 0; bl_i < (NUM_BYTE_LANES / bl_divisor); bl_i++)
+              {
+                if ((result & (bl_mask << bl_i)) == 0)
+                {
+                  delay[side_i][channel_i][rank_i][bl_i] = eye_search_pass(&search[bl_i], delay[side_i][channel_i][rank_i][bl_i]);
+                  set_wdq(channel_i, rank_i, bl_i, delay[side_i][channel_i][rank_i][bl_i]);
+                }
+              } // bl_i loop
+#endif // ADAPTIVE_EYE_SEARCH
               // check for failures
               if (result & 0xFF)
               {
@@ -2023,6 +2226,11 @@ static void wr_train(
                 {
                   if (result & (bl_mask << bl_i))
                   {
+#ifdef ADAPTIVE_EYE_SEARCH
+                    limit = (side_i == L) ? (delay[R][channel_i][rank_i][bl_i] - 1) : (delay[L][channel_i][rank_i][bl_i] + 1);
+                    delay[side_i][channel_i][rank_i][bl_i] = eye_search_fail(&search[bl_i],
+                        delay[side_i][channel_i][rank_i][bl_i], (side_i == L), limit);
+#else
                     if (side_i == L)
                     {
                       delay[L][channel_i][rank_i][bl_i] += WDQ_STEP;
@@ -2031,6 +2239,7 @@ static void wr_train(
                     {
                       delay[R][channel_i][rank_i][bl_i] -= WDQ_STEP;
                     }
+#endif // ADAPTIVE_EYE_SEARCH
                     // check for algorithm failure
                     if (delay[L][channel_i][rank_i][bl_i] != delay[R][channel_i][rank_i][bl_i])
                     {
@@ -2046,7 +2255,11 @@ static void wr_train(
                   } // if bl_i failed
                 } // bl_i loop
               } // at least 1 byte lane failed
+#ifdef ADAPTIVE_EYE_SEARCH
+            } while ((result & 0xFF) || !search_done); // stop when all byte lanes pass at their final WDQ
+#else
             } while (result & 0xFF); // stop when all byte lanes pass
+#endif // ADAPTIVE_EYE_SEARCH
           } // if rank is enabled
         } // rank_i loop
       } // if channel is enabled
@@ -2157,6 +2370,61 @@ static void set_auto_refresh(
   return;
 }
 
+// Wait for the HTE memory init/test started by mem_init_start(),
+// memory test result is indicated in mrc_params->status.
+static void mem_init_wait(
+    MRCParams_t *mrc_params)
+{
+  uint32_t result;
+
+  if (mrc_params->mem_init_pending == 0) return;
+
+  ENTERFN();
+
+  while (!HteMemInitPoll(mrc_params, &result))
+  {
+#ifdef SIM
+    delay_n(35);
+#endif
+  }
+  select_memory_manager(mrc_params);
+  mrc_params->mem_init_pending = 0;
+
+  if (mrc_params->mem_test_pending)
+  {
+    mrc_params->mem_test_pending = 0;
+    DPF(D_INFO, "Memory test result %x\n", result);
+    mrc_params->status = ((result == 0) ? MRC_SUCCESS : MRC_E_MEMTEST);
+  }
+
+  LEAVEFN();
+}
+
+// Start HTE memory init/test over the whole memory. Unless asynchronous
+// completion was requested (async_mem_init) it is waited for right away,
+// otherwise MemInitComplete() waits for it and locks the registers.
+// If it cannot be started the failure is indicated in mrc_params->status.
+static void mem_init_start(
+    MRCParams_t *mrc_params,
+    uint8_t mem_init_flag)
+{
+  select_hte(mrc_params);
+  if (HteMemInitStart(mrc_params, mem_init_flag, MrcHaltHteEngineOnError) != 0)
+  {
+    DPF(D_ERROR, "HTE memory init/test not started, flag %d\n", mem_init_flag);
+    select_memory_manager(mrc_params);
+    mrc_params->status = MRC_E_MEMTEST;
+    return;
+  }
+  mrc_params->mem_init_pending = 1;
+  mrc_params->mem_test_pending = (mem_init_flag == MrcMemTest);
+
+  if (mrc_params->async_mem_init == 0)
+  {
+    mem_init_wait(mrc_params);
+  }
+}
+
 // Depending on configuration enables ECC support.
 // Available memory size is decresed, and updated with 0s
 // in order to clear error status. Address mode 2 forced.
@@ -2197,12 +2465,12 @@ static void ecc_enable(
   // Assume 8 bank memory, one bank is gone for ECC
   mrc_params->mem_size -= mrc_params->mem_size / 8;
 
-  // For S3 resume memory content has to be preserved
-  if (mrc_params->boot_mode != bmS3)
+  // For S3 resume memory content has to be preserved.
+  // Cold and fast boot run memory_test() next, its write passes cover
+  // every line and initialise the ECC as well.
+  if (mrc_params->boot_mode == bmWarm)
   {
-    select_hte(mrc_params);
-    HteMemInit(mrc_params, MrcMemInit, MrcHaltHteEngineOnError);
-    select_memory_manager(mrc_params);
+    mem_init_start(mrc_params, MrcMemInit);
   }
 
   LEAVEFN();
@@ -2215,6 +2483,9 @@ static void lock_registers(
 {
   RegDCO Dco;
 
+  // HTE still running, locked by MemInitComplete()
+  if (mrc_params->mem_init_pending) return;
+
   ENTERFN();
 
   Dco.raw = isbR32m(MCU, DCO);
@@ -2293,11 +2564,17 @@ static void cpu_write(void)
 }
 
 
+// Data pattern of given step at given address, "pat" holds the
+// 32 dword pattern of steps 1-4.
+#define CPU_TEST_DAT(step, pat, adr) \
+  (((step) == 0) ? (adr) : (pat)[((adr) >> 2) & 0x1f])
+
 static void cpu_memory_test(
     MRCParams_t *mrc_params)
 {
   uint32_t result = 0;
-  uint32_t val, dat, adr, adr0, step, limit;
+  uint32_t val, dat, adr, adr0, step, limit, i;
+  uint32_t pat[32];
   uint64_t my_tsc;
 
   ENTERFN();
@@ -2311,28 +2588,33 @@ static void cpu_memory_test(
   {
     DPF(D_INFO, "Mem test step %d starting from %xh\n", step, adr0);
 
+    // patterns of steps 1-4 repeat every 32 dwords
+    for (i = 0; i < 32; i++)
+    {
+      if (step == 1)      pat[i] = (1 << i);
+      else if (step == 2) pat[i] = ~(1 << i);
+      else if (step == 3) pat[i] = 0x5555AAAA;
+      else                pat[i] = 0xAAAA5555;
+    }
+
+    // Quark has no SIMD stores, write a full 16 byte cache line per
+    // iteration to keep the bus busy and the loop overhead low
     my_tsc = read_tsc();
-    for (adr = adr0; adr < limit; adr += sizeof(uint32_t))
+    for (adr = adr0; adr < limit; adr += 4 * sizeof(uint32_t))
     {
-      if (step == 0)      dat = adr;
-      else if (step == 1) dat = (1 << ((adr >> 2) & 0x1f));
-      else if (step == 2) dat = ~(1 << ((adr >> 2) & 0x1f));
-      else if (step == 3) dat = 0x5555AAAA;
-      else if (step == 4) dat = 0xAAAA5555;
+      uint32_t *p = (uint32_t*) adr;
 
-      *(uint32_t*) adr = dat;
+      p[0] = CPU_TEST_DAT(step, pat, adr);
+      p[1] = CPU_TEST_DAT(step, pat, adr + 4);
+      p[2] = CPU_TEST_DAT(step, pat, adr + 8);
+      p[3] = CPU_TEST_DAT(step, pat, adr + 12);
     }
     DPF(D_INFO, "Write time %llXh\n", read_tsc() - my_tsc);
 
     my_tsc = read_tsc();
     for (adr = adr0; adr < limit; adr += sizeof(uint32_t))
     {
-      if (step == 0)      dat = adr;
-      else if (step == 1) dat = (1 << ((adr >> 2) & 0x1f));
-      else if (step == 2) dat = ~(1 << ((adr >> 2) & 0x1f));
-      else if (step == 3) dat = 0x5555AAAA;
-      else if (step == 4) dat = 0xAAAA5555;
-
+      dat = CPU_TEST_DAT(step, pat, adr);
       val = *(uint32_t*) adr;
 
       if (val != dat)
@@ -2355,16 +2637,11 @@ static void cpu_memory_test(
 static void memory_test(
   MRCParams_t *mrc_params)
 {
-  uint32_t result = 0;
-
   ENTERFN();
 
-  select_hte(mrc_params);
-  result = HteMemInit(mrc_params, MrcMemTest, MrcHaltHteEngineOnError);
-  select_memory_manager(mrc_params);
+  mem_init_wait(mrc_params);
+  mem_init_start(mrc_params, MrcMemTest);
 
-  DPF(D_INFO, "Memory test result %x\n", result);
-  mrc_params->status = ((result == 0) ? MRC_SUCCESS : MRC_E_MEMTEST);
   LEAVEFN();
 }
 
@@ -2622,7 +2899,13 @@ void MemInit(
       post_code(major, minor);
 
       my_tsc = read_tsc();
+#ifdef HOST_SIM
+      SimStepBegin(i);
+#endif
       init[i].init_fn(mrc_params);
+#ifdef HOST_SIM
+      SimStepEnd(i);
+#endif
       DPF(D_TIME, "Execution time %llX", read_tsc() - my_tsc);
     }
   }
@@ -2636,3 +2919,18 @@ void MemInit(
   LEAVEFN();
   return;
 }
+
+// Complete the memory init/test left running by MemInit() when
+// async_mem_init was set, and lock the MCU registers.
+void MemInitComplete(
+    MRCParams_t *mrc_params)
+{
+  if (mrc_params->mem_init_pending == 0) return;
+
+  ENTERFN();
+
+  mem_init_wait(mrc_params);
+  lock_registers(mrc_params);
+
+  LEAVEFN();
+}
@@ -10,6 +10,7 @@
 
 // function prototypes
 void MemInit(MRCParams_t *mrc_params);
+void MemInitComplete(MRCParams_t *mrc_params);
 
 typedef void (*MemInitFn_t)(MRCParams_t *mrc_params);
 
@@ -1290,6 +1290,11 @@ void post_code(
   // send message to UART
   DPF(D_INFO, "POST: 0x%01X%02X\n", major, minor);
 
+#ifdef HOST_SIM
+  // let the host harness track progress and stop on error
+  SimPostCode(major, minor);
+#endif
+
   // error check:
   if (major == 0xEE)
   {
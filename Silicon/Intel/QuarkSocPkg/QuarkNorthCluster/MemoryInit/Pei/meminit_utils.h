@@ -26,6 +26,7 @@
 
 #define MCEIL(num,den) ((uint8_t)((num+den-1)/den))
 #define MMAX(a,b)      ((((int32_t)(a))>((int32_t)(b)))?(a):(b))
+#define MMIN(a,b)      ((((int32_t)(a))<((int32_t)(b)))?(a):(b))
 #define MCOUNT(a)      (sizeof(a)/sizeof(*a))
 
 typedef enum ALGOS_enum {
@@ -83,6 +84,13 @@ void store_timings(MRCParams_t *mrc_params);
 void restore_timings(MRCParams_t *mrc_params);
 void default_timings(MRCParams_t *mrc_params);
 
+#ifdef HOST_SIM
+// Hooks provided by the host simulation harness (HostSim)
+void SimStepBegin(uint32_t step);
+void SimStepEnd(uint32_t step);
+void SimPostCode(uint8_t major, uint8_t minor);
+#endif
+
 #ifndef SIM
 //
 // Map memset() and memcpy() to BaseMemoryLib functions
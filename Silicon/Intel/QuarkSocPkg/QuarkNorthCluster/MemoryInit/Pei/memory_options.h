@@ -18,7 +18,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 //#define MRC_SV              // enable some validation opitons
 
-#if defined (SIM) || defined(EMU)
+#if (defined (SIM) || defined(EMU)) && !defined (HOST_SIM)
 #define QUICKSIM              // reduce execution time using shorter rd/wr sequences
 #endif
 
@@ -37,6 +37,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //#define RX_EYE_CHECK          // enable the RD_TRAIN eye check
 #define HMC_TEST              // enable Host to Memory Clock Alignment
 #define R2R_SHARING           // enable multi-rank support via rank2rank sharing
+#define ADAPTIVE_EYE_SEARCH   // coarse step + bisection edge search in RD_TRAIN/WR_TRAIN instead of 1 code steps
 
 #define FORCE_16BIT_DDRIO     // disable signals not used in 16bit mode of DDRIO
 
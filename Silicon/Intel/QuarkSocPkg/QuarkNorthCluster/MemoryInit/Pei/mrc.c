@@ -38,3 +38,17 @@ void Mrc( MRCParams_t *mrc_params)
   return;
 }
 
+//
+// Completes memory initialisation left running by Mrc() when
+// mrc_params->async_mem_init is set, mrc_params->status is valid after it.
+//
+void MrcWait( MRCParams_t *mrc_params)
+{
+  ENTERFN();
+
+  MemInitComplete(mrc_params);
+
+  LEAVEFN();
+  return;
+}
+
@@ -136,6 +136,9 @@ typedef struct MRCParams_s
   uint32_t menu_after_mrc : 1;
   uint32_t power_down_disable :1;
   uint32_t tune_rcvn :1;
+  uint32_t async_mem_init :1;   // input: memory init/test is completed by MrcComplete()
+  uint32_t mem_init_pending :1; // HTE memory init/test started but not completed
+  uint32_t mem_test_pending :1; // pending HTE sequence is the memory test
 
   uint32_t channel_size[NUM_CHANNELS];
   uint32_t column_bits[NUM_CHANNELS];
@@ -143,6 +146,9 @@ typedef struct MRCParams_s
 
   uint32_t mrs1;                // register content saved during training
 
+  uint32_t hte_pass;            // HteMemInitStart() progress
+  uint32_t hte_pass_count;
+
   //
   // Output
   //
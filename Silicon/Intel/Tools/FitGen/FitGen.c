@@ -272,6 +272,49 @@ typedef struct {
 
 FIT_TABLE_CONTEXT   gFitTableContext = {0};
 
+//
+// Index of all FFS files found in a buffer, sorted by file name. It lets the
+// GUID lookups done for every command line argument avoid rescanning the whole
+// FD for FV headers and walking every FV again.
+//
+typedef struct {
+  EFI_GUID  Name;
+  UINT32    Order;     // Position in FV walk order, first match wins
+  UINT8     *Fv;
+  UINT32    FvLength;
+  UINT8     *Data;
+  UINT32    Size;
+} FFS_INDEX_ENTRY;
+
+typedef struct {
+  UINT8            *Buffer;
+  UINTN            Size;
+  UINT32           Count;
+  UINT32           MaxCount;
+  FFS_INDEX_ENTRY  *Entries;
+} FFS_INDEX;
+
+#define MAX_FFS_INDEX  8
+
+FFS_INDEX           mFfsIndex[MAX_FFS_INDEX];
+UINTN               mFfsIndexNext;
+
+#ifndef _WIN32
+//
+// Input files are mapped copy-on-write rather than read into memory, so that
+// only the parts of a large FD which are actually touched get paged in.
+//
+#define MAX_MAPPED_INPUT_FILE  0x40
+
+typedef struct {
+  UINT8   *Base;
+  UINTN   Length;
+  UINT8   *Data;
+} MAPPED_INPUT_FILE;
+
+MAPPED_INPUT_FILE   mMappedInputFile[MAX_MAPPED_INPUT_FILE];
+#endif
+
 unsigned int
 xtoi (
   char  *str
@@ -438,6 +481,153 @@ CheckPath (
   return TRUE;
 }
 
+VOID
+FreeFfsIndex (
+  IN UINT8  *Buffer,
+  IN UINTN  Length
+  )
+/*++
+
+Routine Description:
+
+  Drop the FFS indexes of buffers starting within a memory range
+
+Arguments:
+
+  Buffer        - Start of the memory range, NULL to drop every index
+  Length        - Length of the memory range
+
+--*/
+{
+  UINTN  Index;
+
+  for (Index = 0; Index < MAX_FFS_INDEX; Index++) {
+    if ((mFfsIndex[Index].Buffer != NULL) &&
+        ((Buffer == NULL) ||
+         ((mFfsIndex[Index].Buffer >= Buffer) &&
+          (mFfsIndex[Index].Buffer < Buffer + Length)))) {
+      free (mFfsIndex[Index].Entries);
+      memset (&mFfsIndex[Index], 0, sizeof (FFS_INDEX));
+    }
+  }
+}
+
+#ifndef _WIN32
+BOOLEAN
+MapInputFile (
+  IN  FILE    *FpIn,
+  IN  UINT32  FileSize,
+  OUT UINT8   **FileData,
+  OUT UINT8   **FileBufferRaw OPTIONAL
+  )
+/*++
+
+Routine Description:
+
+  Map input file into memory, with the same layout ReadInputFile allocates
+
+Arguments:
+
+  FpIn          - The input file
+  FileSize      - The input file size
+  FileData      - The input file data, aligned on 64K.
+  FileBufferRaw - The start of the mapping, to be freed by FreeInputFile.
+
+Returns:
+
+  TRUE          - The file is mapped
+  FALSE         - The file could not be mapped, it has to be read
+
+--*/
+{
+  UINTN  Slot;
+  UINTN  Length;
+  UINT8  *Base;
+  UINT8  *Data;
+
+  if (FileSize == 0) {
+    return FALSE;
+  }
+
+  for (Slot = 0; Slot < MAX_MAPPED_INPUT_FILE; Slot++) {
+    if (mMappedInputFile[Slot].Base == NULL) {
+      break;
+    }
+  }
+  if (Slot == MAX_MAPPED_INPUT_FILE) {
+    return FALSE;
+  }
+
+  //
+  // Reserve zero filled slack the way the allocation in ReadInputFile does,
+  // then place the file on the first 64K boundary inside it.
+  //
+  Length = FileSize + 0x10000;
+  Base = mmap (NULL, Length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (Base == MAP_FAILED) {
+    return FALSE;
+  }
+  Data = Base + (0x10000 - ((UINTN)Base & 0x0FFFF));
+  if (mmap (Data, FileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fileno (FpIn), 0) == MAP_FAILED) {
+    munmap (Base, Length);
+    return FALSE;
+  }
+
+  mMappedInputFile[Slot].Base   = Base;
+  mMappedInputFile[Slot].Length = Length;
+  mMappedInputFile[Slot].Data   = Data;
+
+  *FileData = Data;
+  if (FileBufferRaw != NULL) {
+    *FileBufferRaw = Base;
+  }
+  return TRUE;
+}
+#endif
+
+VOID
+FreeInputFile (
+  IN VOID  *Buffer
+  )
+/*++
+
+Routine Description:
+
+  Free a buffer returned by ReadInputFile, or allocated by malloc
+
+Arguments:
+
+  Buffer        - FileBufferRaw, or FileData if no FileBufferRaw was requested
+
+--*/
+{
+#ifndef _WIN32
+  UINTN  Slot;
+
+  for (Slot = 0; Slot < MAX_MAPPED_INPUT_FILE; Slot++) {
+    if ((Buffer != NULL) &&
+        ((Buffer == mMappedInputFile[Slot].Base) || (Buffer == mMappedInputFile[Slot].Data))) {
+      FreeFfsIndex (mMappedInputFile[Slot].Base, mMappedInputFile[Slot].Length);
+      munmap (mMappedInputFile[Slot].Base, mMappedInputFile[Slot].Length);
+      memset (&mMappedInputFile[Slot], 0, sizeof (MAPPED_INPUT_FILE));
+      return;
+    }
+  }
+#endif
+
+  if (Buffer == NULL) {
+    return;
+  }
+
+  //
+  // The length of a buffer read into memory is not known here. Drop every
+  // FFS index, so that none is found again for a later allocation at the
+  // same address.
+  //
+  FreeFfsIndex (NULL, 0);
+  free (Buffer);
+}
+
 STATUS
 ReadInputFile (
   IN CHAR8    *FileName,
@@ -456,7 +646,8 @@ Arguments:
   FileName      - The input file name
   FileData      - The input file data, the memory is aligned.
   FileSize      - The input file size
-  FileBufferRaw - The memory to hold input file data. The caller must free the memory.
+  FileBufferRaw - The memory to hold input file data. The caller must free the memory
+                  with FreeInputFile, or FileData if FileBufferRaw is NULL.
 
 Returns:
 
@@ -493,6 +684,14 @@ Returns:
   //
   fseek (FpIn, 0, SEEK_END);
   *FileSize = ftell (FpIn);
+
+#ifndef _WIN32
+  if (MapInputFile (FpIn, *FileSize, FileData, FileBufferRaw)) {
+    fclose (FpIn);
+    return STATUS_SUCCESS;
+  }
+#endif
+
   //
   // Read the contents of input file to memory buffer
   //
@@ -601,50 +800,73 @@ FindNextFvHeader (
   return NULL;
 }
 
-UINT8  *
-FindFileFromFvByGuid (
+int
+CompareFfsIndexEntry (
+  CONST VOID  *Left,
+  CONST VOID  *Right
+  )
+{
+  CONST FFS_INDEX_ENTRY  *LeftEntry;
+  CONST FFS_INDEX_ENTRY  *RightEntry;
+  int                    Result;
+
+  LeftEntry  = (CONST FFS_INDEX_ENTRY *)Left;
+  RightEntry = (CONST FFS_INDEX_ENTRY *)Right;
+
+  Result = memcmp (&LeftEntry->Name, &RightEntry->Name, sizeof (EFI_GUID));
+  if (Result != 0) {
+    return Result;
+  }
+  return (LeftEntry->Order < RightEntry->Order) ? -1 : (LeftEntry->Order > RightEntry->Order);
+}
+
+FFS_INDEX *
+GetFfsIndex (
   IN UINT8     *FvBuffer,
-  IN UINT32    FvSize,
-  IN EFI_GUID  *Guid,
-  OUT UINT32   *FileSize
+  IN UINT32    FvSize
   )
 /*++
 
 Routine Description:
 
-  Find File with GUID in an FV
+  Get the index of all FFS files of the FVs in a buffer, building it on first use.
+  The FVs are walked once, in the same order a GUID search would walk them.
 
 Arguments:
 
   FvBuffer       - FV binary buffer
   FvSize         - FV size
-  Guid           - File GUID value to be searched
-  FileSize       - Guid File size
 
 Returns:
 
-  FileLocation   - Guid File location.
-  NULL           - Guid File is not found.
+  FfsIndex       - Index of the FFS files in the buffer
+  NULL           - No memory to build the index
 
 --*/
 {
+  FFS_INDEX                   *FfsIndex;
+  FFS_INDEX_ENTRY             *Entries;
   EFI_FIRMWARE_VOLUME_HEADER  *FvHeader;
   EFI_FFS_FILE_HEADER         *FileHeader;
   UINT64                      FvLength;
-  EFI_GUID                    *TempGuid;
-  UINT8                       *FixPoint;
+  UINTN                       Index;
   UINTN                       Offset;
   UINTN                       FileLength;
   UINTN                       FileOccupiedSize;
 
-  //
-  // Find the FFS file
-  //
-  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader (FvBuffer, FvSize);
-  if (NULL == FvHeader) {
-    return NULL;
+  for (Index = 0; Index < MAX_FFS_INDEX; Index++) {
+    if ((mFfsIndex[Index].Buffer == FvBuffer) && (mFfsIndex[Index].Size == FvSize)) {
+      return &mFfsIndex[Index];
+    }
   }
-  while (TRUE) {
+
+  FfsIndex = &mFfsIndex[mFfsIndexNext];
+  mFfsIndexNext = (mFfsIndexNext + 1) % MAX_FFS_INDEX;
+  free (FfsIndex->Entries);
+  memset (FfsIndex, 0, sizeof (FFS_INDEX));
+
+  FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader (FvBuffer, FvSize);
+  while (FvHeader != NULL) {
     FvLength         = FvHeader->FvLength;
 
     //
@@ -656,55 +878,155 @@ Returns:
     Offset           = (UINTN) FileHeader - (UINTN) FvHeader;
 
     while (Offset < FvLength) {
-      TempGuid = (EFI_GUID *)&(FileHeader->Name);
       FileLength = (*(UINT32 *)(FileHeader->Size)) & 0x00FFFFFF;
       FileOccupiedSize = GETOCCUPIEDSIZE(FileLength, 8);
-      if ((CompareGuid (TempGuid, Guid)) == 0) {
-        //
-        // Good! Find it.
-        //
-        FixPoint = ((UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER));
+
+      if (FfsIndex->Count == FfsIndex->MaxCount) {
+        FfsIndex->MaxCount = (FfsIndex->MaxCount == 0) ? 0x100 : FfsIndex->MaxCount * 2;
+        Entries = realloc (FfsIndex->Entries, FfsIndex->MaxCount * sizeof (FFS_INDEX_ENTRY));
+        if (Entries == NULL) {
+          Error (NULL, 0, 0, "No sufficient memory to allocate!", NULL);
+          free (FfsIndex->Entries);
+          memset (FfsIndex, 0, sizeof (FFS_INDEX));
+          return NULL;
+        }
+        FfsIndex->Entries = Entries;
+      }
+
+      Entries = &FfsIndex->Entries[FfsIndex->Count];
+      memcpy (&Entries->Name, &FileHeader->Name, sizeof (EFI_GUID));
+      Entries->Order    = FfsIndex->Count;
+      Entries->Fv       = (UINT8 *)FvHeader;
+      Entries->FvLength = (UINT32)FvLength;
+      Entries->Data     = (UINT8 *)FileHeader + sizeof(EFI_FFS_FILE_HEADER);
+      Entries->Size     = (UINT32)(FileLength - sizeof(EFI_FFS_FILE_HEADER));
+#if (PI_SPECIFICATION_VERSION < 0x00010000)
+      if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
+        Entries->Size -= sizeof(EFI_FFS_FILE_TAIL);
+      }
+#endif
+      FfsIndex->Count++;
+
+      if (FileOccupiedSize == 0) {
         //
-        // Find the position of file module, the offset
-        // between the position and the end of FvRecovery.fv file
-        // should not exceed 128kB to prevent reset vector from
-        // outside legacy E and F segment
+        // Corrupted file header, the rest of the FV can not be walked
         //
-        if ((UINTN)FvHeader + FvLength - (UINTN)FixPoint > 0x20000) {
-  //        printf ("WARNING: The position of file module is not in E and F segment!\n");
-  //        return NULL;
-        }
-        *FileSize = FileLength - sizeof(EFI_FFS_FILE_HEADER);
-  #if (PI_SPECIFICATION_VERSION < 0x00010000)
-        if (FileHeader->Attributes & FFS_ATTRIB_TAIL_PRESENT) {
-          *FileSize -= sizeof(EFI_FFS_FILE_TAIL);
-        }
-  #endif
-        return FixPoint;
+        break;
       }
       FileHeader = (EFI_FFS_FILE_HEADER *)((UINTN)FileHeader + FileOccupiedSize);
       Offset = (UINTN) FileHeader - (UINTN) FvHeader;
     }
 
     //
-    // Not found, check next FV
+    // Next FV
     //
     if ((UINTN)FvBuffer + FvSize > (UINTN)FvHeader + FvLength) {
       FvHeader = (EFI_FIRMWARE_VOLUME_HEADER *)FindNextFvHeader ((UINT8 *)FvHeader + (UINTN)FvLength, (UINTN)FvBuffer + FvSize - ((UINTN)FvHeader + (UINTN)FvLength));
-      if (FvHeader == NULL) {
-        break;
-      }
     } else {
       break;
     }
   }
 
+  qsort (FfsIndex->Entries, FfsIndex->Count, sizeof (FFS_INDEX_ENTRY), CompareFfsIndexEntry);
+
+  FfsIndex->Buffer = FvBuffer;
+  FfsIndex->Size   = FvSize;
+  return FfsIndex;
+}
+
+FFS_INDEX_ENTRY *
+FindFfsIndexEntry (
+  IN FFS_INDEX  *FfsIndex,
+  IN EFI_GUID   *Guid
+  )
+/*++
+
+Routine Description:
+
+  Find the first FFS file with GUID in an FFS index. Files with the same GUID
+  follow it in the index, in FV walk order.
+
+Arguments:
+
+  FfsIndex       - FFS index
+  Guid           - File GUID value to be searched
+
+Returns:
+
+  Entry          - First index entry of the file
+  NULL           - Guid File is not found.
+
+--*/
+{
+  UINT32  Low;
+  UINT32  High;
+  UINT32  Middle;
+
   //
-  // Not found
+  // Lower bound, so that the first file in walk order is found
   //
+  Low  = 0;
+  High = FfsIndex->Count;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (memcmp (&FfsIndex->Entries[Middle].Name, Guid, sizeof (EFI_GUID)) < 0) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  if ((Low < FfsIndex->Count) &&
+      (memcmp (&FfsIndex->Entries[Low].Name, Guid, sizeof (EFI_GUID)) == 0)) {
+    return &FfsIndex->Entries[Low];
+  }
   return NULL;
 }
 
+UINT8  *
+FindFileFromFvByGuid (
+  IN UINT8     *FvBuffer,
+  IN UINT32    FvSize,
+  IN EFI_GUID  *Guid,
+  OUT UINT32   *FileSize
+  )
+/*++
+
+Routine Description:
+
+  Find File with GUID in an FV
+
+Arguments:
+
+  FvBuffer       - FV binary buffer
+  FvSize         - FV size
+  Guid           - File GUID value to be searched
+  FileSize       - Guid File size
+
+Returns:
+
+  FileLocation   - Guid File location.
+  NULL           - Guid File is not found.
+
+--*/
+{
+  FFS_INDEX        *FfsIndex;
+  FFS_INDEX_ENTRY  *Entry;
+
+  FfsIndex = GetFfsIndex (FvBuffer, FvSize);
+  if (FfsIndex == NULL) {
+    return NULL;
+  }
+
+  Entry = FindFfsIndexEntry (FfsIndex, Guid);
+  if (Entry == NULL) {
+    return NULL;
+  }
+
+  *FileSize = Entry->Size;
+  return Entry->Data;
+}
+
 BOOLEAN
 IsGuidData (
   IN CHAR8     *StringData,
@@ -1581,7 +1903,7 @@ Returns:
     }
 
     if (MicrocodeFileBufferRaw != NULL) {
-      free ((VOID *)MicrocodeFileBufferRaw);
+      FreeInputFile ((VOID *)MicrocodeFileBufferRaw);
       MicrocodeFileBufferRaw = NULL;
     }
   }
@@ -1636,7 +1958,7 @@ Returns:
       if (Status == STATUS_SUCCESS) {
         if (FileSize >= 0x80000000) {
           Error (NULL, 0, 0, "-O Parameter incorrect, FileSize too large!", NULL);
-          free (FileBuffer);
+          FreeInputFile (FileBuffer);
           return 0;
         }
         //
@@ -1677,7 +1999,7 @@ Returns:
         if (Status == STATUS_SUCCESS) {
           if (FileSize >= 0x80000000) {
             Error (NULL, 0, 0, "-O Parameter incorrect, FileSize too large!", NULL);
-            free (FileBuffer);
+            FreeInputFile (FileBuffer);
             return 0;
           }
           //
@@ -1734,7 +2056,7 @@ Returns:
     }
     if (gFitTableContext.OptionalModuleNumber >= MAX_OPTIONAL_ENTRY) {
       Error (NULL, 0, 0, "-O Parameter incorrect, Too many Optional Module!", NULL);
-      free (FileBuffer);
+      FreeInputFile (FileBuffer);
       return 0;
     }
     gFitTableContext.OptionalModule[gFitTableContext.OptionalModuleNumber].Type = Type;
@@ -2033,7 +2355,7 @@ Returns:
         }
       }
       memcpy (OptionalModuleAddress, gFitTableContext.OptionalModule[Index].Buffer, gFitTableContext.OptionalModule[Index].Size);
-      free (gFitTableContext.OptionalModule[Index].Buffer);
+      FreeInputFile (gFitTableContext.OptionalModule[Index].Buffer);
       gFitTableContext.OptionalModule[Index].Address = MEMORY_TO_FLASH (OptionalModuleAddress, FvBuffer, FvSize);
     }
     //
@@ -2898,7 +3220,18 @@ Returns:
   //
   // Open the output FvRecovery.fv file
   //
-  if ((FpOut = fopen (FileName, "w+b")) == NULL) {
+#ifndef _WIN32
+  //
+  // The output may be the input file, still mapped as FileData. Truncating it
+  // up front would discard the pages not written yet, so trim it afterwards.
+  //
+  if ((FpOut = fopen (FileName, "r+b")) == NULL) {
+    FpOut = fopen (FileName, "w+b");
+  }
+#else
+  FpOut = fopen (FileName, "w+b");
+#endif
+  if (FpOut == NULL) {
     Error (NULL, 0, 0, "Unable to open file", "%s", FileName);
     return STATUS_ERROR;
   }
@@ -2911,6 +3244,15 @@ Returns:
     return STATUS_ERROR;
   }
 
+#ifndef _WIN32
+  fflush (FpOut);
+  if (ftruncate (fileno (FpOut), FileSize) != 0) {
+    Error (NULL, 0, 0, "Write output file error!", NULL);
+    fclose (FpOut);
+    return STATUS_ERROR;
+  }
+#endif
+
   //
   // Close the output FvRecovery.fv file
   //
@@ -2942,41 +3284,32 @@ Returns:
 
 --*/
 {
-  UINT8                         *FileBuffer = NULL;
+  FFS_INDEX                     *FfsIndex;
+  FFS_INDEX_ENTRY               *Entry;
   UINT32                        FvRecoveryFileSize =0;
   EFI_GUID                      VTFGuid = EFI_FFS_VOLUME_TOP_FILE_GUID;
-  UINT32                        FvLength;
-  UINT32                        FileLength;
 
   *FvRecovery = NULL;
-  FileBuffer = FindNextFvHeader (FdBuffer, FdFileSize);
-  if (FileBuffer == NULL) {
+
+  //
+  // The FD index walks the same FVs as a walk from one FV header to the next,
+  // take the last FV holding a VTF.
+  //
+  FfsIndex = GetFfsIndex (FdBuffer, FdFileSize);
+  if (FfsIndex == NULL) {
     return 0;
   }
 
-  while ((UINTN)FileBuffer < (UINTN)FdBuffer + FdFileSize) {
-    FvLength         = (UINT32)((EFI_FIRMWARE_VOLUME_HEADER *)FileBuffer)->FvLength;
-
-    if (FindFileFromFvByGuid (FileBuffer, FvLength, &VTFGuid, &FileLength) != NULL) {
-      //
-      // Found the VTF
-      //
-      FvRecoveryFileSize = FvLength;
-      *FvRecovery = FileBuffer;
-    }
-
+  Entry = FindFfsIndexEntry (FfsIndex, &VTFGuid);
+  while ((Entry != NULL) &&
+         (Entry < FfsIndex->Entries + FfsIndex->Count) &&
+         (memcmp (&Entry->Name, &VTFGuid, sizeof (EFI_GUID)) == 0)) {
     //
-    // Next fv
+    // Found the VTF
     //
-    FileBuffer = (UINT8 *)FileBuffer + FvLength;
-    if ((UINTN)FileBuffer >= (UINTN)FdBuffer + FdFileSize) {
-      break;
-    }
-    FileBuffer = FindNextFvHeader (FileBuffer, (UINTN)FdBuffer + FdFileSize - (UINTN)FileBuffer);
-    if (FileBuffer == NULL) {
-      break;
-    }
-
+    FvRecoveryFileSize = Entry->FvLength;
+    *FvRecovery = Entry->Fv;
+    Entry++;
   }
 
   //
@@ -3257,7 +3590,7 @@ Returns:
 
 exitFunc:
   if (FileBufferRaw != NULL) {
-    free ((VOID *)FileBufferRaw);
+    FreeInputFile ((VOID *)FileBufferRaw);
   }
   return Status;
 }
@@ -3326,7 +3659,7 @@ Returns:
 
 exitFunc:
   if (FileBufferRaw != NULL) {
-    free ((VOID *)FileBufferRaw);
+    FreeInputFile ((VOID *)FileBufferRaw);
   }
   return Status;
 }
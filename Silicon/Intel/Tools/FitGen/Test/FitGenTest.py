@@ -0,0 +1,671 @@
+## @file
+# Benchmark and regression test harness for the FitGen utility.
+#
+# Synthetic FD images are generated for a set of scenarios (multiple FVs,
+# microcode patches, startup ACM, BIOS info, policy and port records), FitGen
+# is run on each of them and every byte it changed in the image is compared
+# with the golden file of the scenario. Wall time and peak RSS of every FitGen
+# run are reported, so that FitGen changes can be checked on a build host
+# without a BIOS tree.
+#
+# Copyright (c) 2026, Intel Corporation. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+'''
+FitGenTest
+'''
+
+import os
+import sys
+
+def Launcher ():
+  '''
+  Run the FitGen command lines read from stdin, one per line with tab separated
+  arguments, and answer with the exit code, wall time, peak RSS and output of
+  each. On Linux the peak RSS of a child covers the memory of the process it
+  was forked from, so FitGen is launched from this small process rather than
+  from the harness holding the FD images.
+  '''
+  import time
+  Input  = sys.stdin.buffer
+  Output = sys.stdout.buffer
+  for Line in Input:
+    Arguments = Line.rstrip (b'\n').decode ('utf-8').split ('\t')
+    Read, Write = os.pipe ()
+    Start = time.perf_counter ()
+    Pid = os.fork ()
+    if Pid == 0:
+      os.close (Read)
+      os.dup2 (Write, 1)
+      os.dup2 (Write, 2)
+      try:
+        os.execv (Arguments[0], Arguments)
+      finally:
+        os._exit (127)
+    os.close (Write)
+    Text = b''
+    while True:
+      Data = os.read (Read, 0x10000)
+      if not Data:
+        break
+      Text += Data
+    os.close (Read)
+    Pid, Status, Usage = os.wait4 (Pid, 0)
+    Wall = time.perf_counter () - Start
+    Output.write (b'%d %d %d %d\n' % (os.waitstatus_to_exitcode (Status), int (Wall * 1e9), Usage.ru_maxrss, len (Text)))
+    Output.write (Text)
+    Output.flush ()
+  return 0
+
+if __name__ == '__main__' and sys.argv[1:] == ['--launcher']:
+  sys.exit (Launcher ())
+
+import argparse
+import random
+import shutil
+import struct
+import subprocess
+import tempfile
+import time
+import uuid
+
+#
+# Globals for help information
+#
+__prog__      = 'FitGenTest'
+__version__   = '%s Version %s' % (__prog__, '0.1 ')
+__copyright__ = 'Copyright (c) 2026, Intel Corporation. All rights reserved.'
+__usage__     = '%s [options] [scenario ...]' % (__prog__)
+
+GOLDEN_DIR = os.path.join (os.path.dirname (os.path.abspath (__file__)), 'Golden')
+
+#
+# PI definitions
+#
+FFS2_FILE_SYSTEM_GUID   = uuid.UUID ('8c8ce578-8a3d-4f1c-9935-896185c32dd3')
+VTF_FILE_GUID           = uuid.UUID ('1ba0062e-c779-4582-8566-336ae8f78f09')
+PAD_FILE_GUID           = uuid.UUID ('ffffffff-ffff-ffff-ffff-ffffffffffff')
+FV_HEADER_LENGTH        = 0x48
+FV_ATTRIBUTES           = 0x0004FEFF
+FV_BLOCK_SIZE           = 0x1000
+FFS_HEADER_LENGTH       = 0x18
+FFS_FIXED_CHECKSUM      = 0xAA
+FFS_STATE               = 0xF8
+EFI_FV_FILETYPE_RAW     = 0x01
+EFI_FV_FILETYPE_FREEFORM = 0x02
+EFI_FV_FILETYPE_PEIM    = 0x06
+EFI_FV_FILETYPE_DRIVER  = 0x07
+EFI_FV_FILETYPE_PAD     = 0xF0
+
+#
+# FIT definitions
+#
+FIT_TABLE_POINTER_OFFSET    = 0x40
+FIT_TABLE_TYPE_MICROCODE    = 1
+FIT_TABLE_TYPE_STARTUP_ACM  = 2
+FIT_TABLE_TYPE_BIOS_MODULE  = 7
+FIT_TABLE_TYPE_TXT_POLICY   = 10
+FIT_TABLE_TYPE_KEY_MANIFEST = 11
+FIT_TABLE_TYPE_BOOT_POLICY_MANIFEST = 12
+FIT_TABLE_TYPE_BIOS_DATA_AREA = 13
+BIOS_INFO_MICROCODE_WHOLE_REGION = 0x10
+MICROCODE_ALIGNMENT         = 0x800
+MICROCODE_SLOT_SIZE         = 0x4000
+
+#
+# Scenarios. Sizes are in bytes, every scenario is generated from its seed.
+#
+#   FdSize        - size of the FD image, the last FV ends at 4GB
+#   FvCount       - number of FVs, the first holds the microcode, the last is
+#                   FvRecovery with the ACM, BIOS info, policies and the VTF
+#   FilesPerFv    - number of filler FFS files in every FV
+#   Microcode     - number of microcode patches
+#   Acm           - TRUE to put a startup ACM in FvRecovery
+#   Policies      - number of policy FFS files in FvRecovery
+#   Mode          - how FitGen learns the layout:
+#                     'Guid'     - -S/-U/-O with FFS GUIDs, -B ranges
+#                     'BiosInfo' - everything from a $BIOSIF$ file (-I)
+#                     'Slot'     - -I with a microcode region and -L slots
+#
+SCENARIOS = [
+  {
+    'Name':       'Minimal',
+    'Seed':       1,
+    'FdSize':     0x100000,
+    'FvCount':    2,
+    'FilesPerFv': 8,
+    'Microcode':  1,
+    'Acm':        False,
+    'Policies':   0,
+    'Mode':       'Guid',
+  },
+  {
+    'Name':       'GuidRecords',
+    'Seed':       2,
+    'FdSize':     0x400000,
+    'FvCount':    4,
+    'FilesPerFv': 64,
+    'Microcode':  8,
+    'Acm':        True,
+    'Policies':   3,
+    'Mode':       'Guid',
+  },
+  {
+    'Name':       'BiosInfo',
+    'Seed':       3,
+    'FdSize':     0x800000,
+    'FvCount':    6,
+    'FilesPerFv': 128,
+    'Microcode':  16,
+    'Acm':        True,
+    'Policies':   2,
+    'Mode':       'BiosInfo',
+  },
+  {
+    'Name':       'MicrocodeSlots',
+    'Seed':       4,
+    'FdSize':     0x400000,
+    'FvCount':    8,
+    'FilesPerFv': 64,
+    'Microcode':  6,
+    'Acm':        True,
+    'Policies':   1,
+    'Mode':       'Slot',
+  },
+  {
+    'Name':       'Large',
+    'Seed':       5,
+    'FdSize':     0x2000000,
+    'FvCount':    16,
+    'FilesPerFv': 1024,
+    'Microcode':  24,
+    'Acm':        True,
+    'Policies':   4,
+    'Mode':       'Guid',
+  },
+]
+
+SCENARIO_KEYS = ['Seed', 'FdSize', 'FvCount', 'FilesPerFv', 'Microcode', 'Acm', 'Policies', 'Mode']
+
+def Align (Value, Alignment):
+  return (Value + Alignment - 1) & ~(Alignment - 1)
+
+def Checksum8 (Data):
+  return (0x100 - (sum (Data) & 0xFF)) & 0xFF
+
+def Checksum16 (Data):
+  Sum = sum (struct.unpack ('<%dH' % (len (Data) // 2), Data))
+  return (0x10000 - (Sum & 0xFFFF)) & 0xFFFF
+
+def MakeGuid (Random):
+  return uuid.UUID (bytes = Random.randbytes (16), version = 4)
+
+def FfsFile (Guid, Type, Data):
+  Size = FFS_HEADER_LENGTH + len (Data)
+  if Size > 0xFFFFFF:
+    raise ValueError ('FFS file too large')
+  Header = bytearray (struct.pack ('<16sBBBB3sB', Guid.bytes_le, 0, 0, Type, 0, Size.to_bytes (3, 'little'), 0))
+  Header[0x10] = Checksum8 (Header[:0x17])
+  Header[0x11] = FFS_FIXED_CHECKSUM
+  Header[0x17] = FFS_STATE
+  return bytes (Header) + Data
+
+class Fv:
+  '''An FV being laid out, FFS files are 8 byte aligned and the tail is free space.'''
+  def __init__ (self, Size):
+    self.Size  = Size
+    self.Files = bytearray ()
+
+  def Free (self):
+    return self.Size - FV_HEADER_LENGTH - len (self.Files)
+
+  def Offset (self):
+    return FV_HEADER_LENGTH + len (self.Files)
+
+  def AddFile (self, Guid, Type, Data, DataAlignment = 8):
+    #
+    # Pad so that the file data lands on the requested alignment
+    #
+    Offset = self.Offset ()
+    if (Offset + FFS_HEADER_LENGTH) % DataAlignment != 0:
+      PadSize = Align (Offset + 2 * FFS_HEADER_LENGTH, DataAlignment) - FFS_HEADER_LENGTH - Offset
+      self.Files += FfsFile (PAD_FILE_GUID, EFI_FV_FILETYPE_PAD, b'\xFF' * (PadSize - FFS_HEADER_LENGTH))
+    File = FfsFile (Guid, Type, Data)
+    Offset = self.Offset ()
+    if len (File) > self.Free ():
+      raise ValueError ('FV too small for the scenario')
+    self.Files += File
+    self.Files += b'\xFF' * (Align (len (self.Files), 8) - len (self.Files))
+    return Offset + FFS_HEADER_LENGTH
+
+  def Image (self):
+    Header = bytearray (struct.pack (
+               '<16s16sQ4sIHHHBBIIII',
+               b'\x00' * 16,
+               FFS2_FILE_SYSTEM_GUID.bytes_le,
+               self.Size,
+               b'_FVH',
+               FV_ATTRIBUTES,
+               FV_HEADER_LENGTH,
+               0,
+               0,
+               0,
+               2,
+               self.Size // FV_BLOCK_SIZE,
+               FV_BLOCK_SIZE,
+               0,
+               0
+               ))
+    struct.pack_into ('<H', Header, 0x32, Checksum16 (Header))
+    return bytes (Header) + bytes (self.Files) + b'\xFF' * self.Free ()
+
+def MicrocodePatch (Random, Index):
+  TotalSize = 0x400 * Random.randint (2, 12) + 0x30
+  DataSize  = TotalSize - 0x30
+  Header = struct.pack (
+             '<IIIIIIIII12s',
+             1,                                  # HeaderVersion
+             0x100 + Index,                      # UpdateRevision
+             0x01012026,                         # Date
+             0x000906E0 + Index,                 # ProcessorSignature
+             0,                                  # Checksum
+             1,                                  # LoaderRevision
+             1 << (Index % 8),                   # ProcessorFlags
+             DataSize,
+             TotalSize,
+             b'\x00' * 12
+             )
+  Body   = bytearray (Header + Random.randbytes (DataSize))
+  struct.pack_into ('<I', Body, 16, (0x100000000 - sum (struct.unpack ('<%dI' % (TotalSize // 4), Body))) & 0xFFFFFFFF)
+  return bytes (Body) + b'\xFF' * (Align (TotalSize, MICROCODE_ALIGNMENT) - TotalSize)
+
+def StartupAcm (Random):
+  #
+  # A chipset ACM that passes FitGen's ACM checks: no key size override, the
+  # information table follows the scratch area.
+  #
+  KeySize     = 64
+  ScratchSize = 2 * KeySize + 15
+  Size        = 0x4000
+  Acm = bytearray (b'\x00' * Size)
+  struct.pack_into (
+    '<HHIIHHIIIHHIIIIII',
+    Acm,
+    0,
+    2,                                           # ModuleType: chipset ACM
+    1,                                           # ModuleSubType: execute at reset
+    0xE0,                                        # HeaderLen
+    0x00000000,                                  # HeaderVersion
+    0xB00C,                                      # ChipsetID
+    0,                                           # Flags
+    0x00008086,                                  # ModuleVendor
+    0x20260101,                                  # Date
+    Size // 4,
+    1,                                           # TxtSvn
+    1,                                           # SeSvn
+    0, 0, 0, 0, 0, 0
+    )
+  struct.pack_into ('<II', Acm, 120, KeySize, ScratchSize)
+  InfoOffset = 128 + KeySize * 4 + 4 + 256 + ScratchSize * 4
+  ChipsetIdList = InfoOffset + 44
+  struct.pack_into (
+    '<IIIIBBHIIIIB3sI',
+    Acm,
+    InfoOffset,
+    0x7FC03AAA, 0x18DB46A7, 0x8F69AC2E, 0x5A7F418D,
+    0,                                           # ChipsetACMType: BIOS
+    3,                                           # Version
+    44,
+    ChipsetIdList,
+    0, 0, 0,
+    1,
+    b'\x00\x00\x00',
+    0
+    )
+  struct.pack_into ('<IIHHH6s', Acm, ChipsetIdList, 1, 1, 0x8086, 0xA140 + Random.randint (0, 15), 0, b'\x00' * 6)
+  return bytes (Acm)
+
+def FlashAddress (Scenario, Offset):
+  return 0x100000000 - Scenario['FdSize'] + Offset
+
+class Fd:
+  '''Synthetic FD image of a scenario and the FitGen arguments describing it.'''
+  def __init__ (self, Scenario):
+    self.Scenario = Scenario
+    self.Random   = random.Random (Scenario['Seed'])
+    self.Arguments = []
+    self.Build ()
+
+  def Filler (self, TheFv, Count):
+    for Index in range (Count):
+      Size = self.Random.choice ([0x40, 0x100, 0x400, 0x800, 0x1000])
+      Data = self.Random.randbytes (Size)
+      TheFv.AddFile (MakeGuid (self.Random), self.Random.choice ([EFI_FV_FILETYPE_PEIM, EFI_FV_FILETYPE_DRIVER]), Data)
+
+  def Build (self):
+    Scenario = self.Scenario
+    FdSize   = Scenario['FdSize']
+    FvCount  = Scenario['FvCount']
+    FvSize   = (FdSize // FvCount) & ~(FV_BLOCK_SIZE - 1)
+    Fvs      = [Fv (FvSize) for Index in range (FvCount - 1)]
+    Fvs.append (Fv (FdSize - FvSize * (FvCount - 1)))
+    FvBase   = [FvSize * Index for Index in range (FvCount)]
+    Recovery = Fvs[-1]
+    RecoveryBase = FvBase[-1]
+
+    #
+    # Microcode FV: a single RAW file with all patches, 2KB aligned
+    #
+    MicrocodeGuid = MakeGuid (self.Random)
+    if Scenario['Mode'] == 'Slot':
+      #
+      # Every patch takes a slot, the free space after them is split into
+      # empty slots, so nothing else may live in the microcode FV.
+      #
+      SlotSize = MICROCODE_SLOT_SIZE
+      Patches  = b''.join (MicrocodePatch (self.Random, Index).ljust (SlotSize, b'\xFF') for Index in range (Scenario['Microcode']))
+      Fvs[0].AddFile (MicrocodeGuid, EFI_FV_FILETYPE_RAW, Patches, MICROCODE_ALIGNMENT)
+    else:
+      Patches  = b''.join (MicrocodePatch (self.Random, Index) for Index in range (Scenario['Microcode']))
+      Fvs[0].AddFile (MicrocodeGuid, EFI_FV_FILETYPE_RAW, Patches, MICROCODE_ALIGNMENT)
+      self.Filler (Fvs[0], Scenario['FilesPerFv'] // 4)
+
+    for Index in range (1, FvCount):
+      self.Filler (Fvs[Index], Scenario['FilesPerFv'])
+
+    #
+    # FvRecovery: ACM, policies, BIOS info, free space and the VTF at 4GB.
+    #
+    AcmGuid = MakeGuid (self.Random)
+    if Scenario['Acm']:
+      AcmOffset = RecoveryBase + Recovery.AddFile (AcmGuid, EFI_FV_FILETYPE_RAW, StartupAcm (self.Random), 0x1000)
+      AcmSize   = 0x4000
+
+    Policies = []
+    for Index in range (Scenario['Policies']):
+      Type = [FIT_TABLE_TYPE_KEY_MANIFEST, FIT_TABLE_TYPE_BOOT_POLICY_MANIFEST][Index % 2]
+      Data = self.Random.randbytes (self.Random.choice ([0x240, 0x400, 0x7C0]))
+      Guid = MakeGuid (self.Random)
+      Offset = RecoveryBase + Recovery.AddFile (Guid, EFI_FV_FILETYPE_RAW, Data, 0x10)
+      Policies.append ((Type, Guid, Offset, len (Data), 0x100 + Index))
+
+    #
+    # IBB: the whole of FvRecovery, and the first filler FV
+    #
+    BiosModules = [(RecoveryBase, Recovery.Size), (FvBase[1], FvSize)] if FvCount > 2 else [(RecoveryBase, Recovery.Size)]
+
+    BiosInfoGuid = MakeGuid (self.Random)
+    if Scenario['Mode'] in ('BiosInfo', 'Slot'):
+      Entries = []
+      if Scenario['Acm']:
+        Entries.append (struct.pack ('<BBHIQ', FIT_TABLE_TYPE_STARTUP_ACM, 0, 0x100, AcmSize, FlashAddress (Scenario, AcmOffset)))
+      Entries.append (struct.pack ('<BBHIQ', FIT_TABLE_TYPE_MICROCODE, BIOS_INFO_MICROCODE_WHOLE_REGION, 0x100, FvSize, FlashAddress (Scenario, 0)))
+      for Base, Size in BiosModules:
+        Entries.append (struct.pack ('<BBHIQ', FIT_TABLE_TYPE_BIOS_MODULE, 0, 0x100, Size, FlashAddress (Scenario, Base)))
+      for Type, Guid, Offset, Size, Version in Policies:
+        Entries.append (struct.pack ('<BBHIQ', Type, 0, Version, Size, FlashAddress (Scenario, Offset)))
+      #
+      # TXT policy as port record: index/data port 0x70/0x71, width 1, bit 0, index 0x20
+      #
+      Entries.append (struct.pack ('<BBHIQ', FIT_TABLE_TYPE_TXT_POLICY, 0, 0, 0, 0x00710070 | (0x00200001 << 32)))
+      BiosInfo = b'$BIOSIF$' + struct.pack ('<II', len (Entries), 0) + b''.join (Entries)
+      Recovery.AddFile (BiosInfoGuid, EFI_FV_FILETYPE_FREEFORM, BiosInfo, 0x10)
+
+    self.Filler (Recovery, Scenario['FilesPerFv'] // 8)
+
+    #
+    # Free space below the VTF is a pad file, the VTF ends at the top of FvRecovery
+    # and leaves the FIT pointer blank.
+    #
+    Vtf = bytearray (b'\x90' * 0x1F0) + bytearray (b'\xEB\xFE' + b'\x90' * 14)
+    Vtf[len (Vtf) - FIT_TABLE_POINTER_OFFSET:len (Vtf) - FIT_TABLE_POINTER_OFFSET + 8] = b'\xFF' * 8
+    VtfFileSize = FFS_HEADER_LENGTH + len (Vtf)
+    PadSize = Recovery.Free () - VtfFileSize
+    if PadSize < 0x10000:
+      raise ValueError ('FvRecovery too small for the scenario')
+    Recovery.Files += FfsFile (PAD_FILE_GUID, EFI_FV_FILETYPE_PAD, b'\xFF' * (PadSize - FFS_HEADER_LENGTH))
+    Recovery.AddFile (VTF_FILE_GUID, EFI_FV_FILETYPE_FREEFORM, bytes (Vtf))
+
+    self.Image = b''.join (TheFv.Image () for TheFv in Fvs)
+    assert len (self.Image) == FdSize
+
+    #
+    # FitGen arguments after the input and output file
+    #
+    Arguments = ['-F', '0x%x' % FIT_TABLE_POINTER_OFFSET]
+    if Scenario['Mode'] == 'Guid':
+      if Scenario['Acm']:
+        Arguments += ['-S', str (AcmGuid)]
+      for Base, Size in BiosModules:
+        Arguments += ['-B', '0x%x' % FlashAddress (Scenario, Base), '0x%x' % Size]
+      Arguments += ['-U', str (MicrocodeGuid)]
+      for Type, Guid, Offset, Size, Version in Policies:
+        Arguments += ['-O', '0x%x' % Type, str (Guid), '-V', '0x%x' % Version]
+      Arguments += ['-O', '0x%x' % FIT_TABLE_TYPE_BIOS_DATA_AREA, 'RESERVE', '0x400']
+      Arguments += ['-P', '0x%x' % FIT_TABLE_TYPE_TXT_POLICY, '0x70', '0x71', '0x1', '0x0', '0x20', '-V', '0x0']
+    elif Scenario['Mode'] == 'BiosInfo':
+      Arguments += ['-I', str (BiosInfoGuid)]
+    else:
+      Arguments += ['-L', '0x%x' % SlotSize, str (MicrocodeGuid), '-I', str (BiosInfoGuid)]
+    self.Arguments = Arguments
+
+def ChangedRows (Input, Output):
+  '''16 byte rows of Output that differ from Input, as (offset, bytes).'''
+  Result = []
+  for Block in range (0, len (Input), 0x1000):
+    if Input[Block:Block + 0x1000] == Output[Block:Block + 0x1000]:
+      continue
+    for Row in range (Block, min (Block + 0x1000, len (Input)), 0x10):
+      if Input[Row:Row + 0x10] != Output[Row:Row + 0x10]:
+        Result.append ((Row, Output[Row:Row + 0x10]))
+  return Result
+
+def GoldenText (Scenario, Rows, View):
+  Lines = ['# %s' % Scenario['Name']]
+  Lines.append ('# ' + ' '.join ('%s=%s' % (Key, Scenario[Key]) for Key in SCENARIO_KEYS))
+  Lines.append ('[Image]')
+  for Offset, Data in Rows:
+    Lines.append ('%08X %s' % (Offset, ' '.join ('%02X' % Byte for Byte in Data)))
+  #
+  # FitView output, without the utility banner
+  #
+  Lines.append ('[View]')
+  View = View.splitlines ()
+  while View and not View[0].startswith ('#'):
+    View = View[1:]
+  Lines += [Line.rstrip () for Line in View]
+  return '\n'.join (Lines) + '\n'
+
+class FitGenRunner:
+  '''Runs FitGen and measures its wall time and peak RSS.'''
+  def __init__ (self, FitGen):
+    self.FitGen   = FitGen
+    self.Launcher = None
+    if hasattr (os, 'fork') and hasattr (os, 'wait4'):
+      self.Launcher = subprocess.Popen (
+                        [sys.executable, '-S', os.path.abspath (__file__), '--launcher'],
+                        stdin = subprocess.PIPE,
+                        stdout = subprocess.PIPE
+                        )
+
+  def Close (self):
+    if self.Launcher is not None:
+      self.Launcher.stdin.close ()
+      self.Launcher.wait ()
+
+  def Run (self, Arguments):
+    '''Run FitGen, return (exit code, output, wall seconds, peak RSS in KB).'''
+    if self.Launcher is None:
+      #
+      # No fork (): time only
+      #
+      Start   = time.perf_counter ()
+      Process = subprocess.run ([self.FitGen] + Arguments, stdout = subprocess.PIPE, stderr = subprocess.STDOUT)
+      Wall    = time.perf_counter () - Start
+      return Process.returncode, Process.stdout.decode ('utf-8', 'replace'), Wall, 0
+
+    self.Launcher.stdin.write (('\t'.join ([self.FitGen] + Arguments) + '\n').encode ('utf-8'))
+    self.Launcher.stdin.flush ()
+    ExitCode, Wall, Rss, Length = [int (Field) for Field in self.Launcher.stdout.readline ().split ()]
+    Output = self.Launcher.stdout.read (Length)
+    return ExitCode, Output.decode ('utf-8', 'replace'), Wall / 1e9, Rss
+
+def RunTimed (Runner, Arguments, Options, Prepare = None):
+  '''Run FitGen Options.Repeat times, return the output of the last run and the fastest run.'''
+  Best = None
+  for Iteration in range (Options.Repeat):
+    if Prepare is not None:
+      Prepare ()
+    ExitCode, Output, Wall, Rss = Runner.Run (Arguments)
+    if Options.Verbose:
+      print (' '.join ([Runner.FitGen] + Arguments))
+      print (Output)
+    if ExitCode != 0:
+      print (Output)
+      return ExitCode, Output, Wall, Rss
+    if Best is None or Wall < Best[0]:
+      Best = (Wall, Rss)
+  return 0, Output, Best[0], Best[1]
+
+def RunScenario (Runner, Scenario, WorkDir, Options):
+  '''Generate, FitGen and FitView a scenario, return (result, FitGen wall, FitGen RSS, FitView wall, FitView RSS).'''
+  TheFd      = Fd (Scenario)
+  InputFile  = os.path.join (WorkDir, '%s.fd' % Scenario['Name'])
+  OutputFile = os.path.join (WorkDir, '%s.Fit.fd' % Scenario['Name'])
+  with open (InputFile, 'wb') as File:
+    File.write (TheFd.Image)
+
+  def Prepare ():
+    if Options.InPlace:
+      shutil.copyfile (InputFile, OutputFile)
+    elif os.path.exists (OutputFile):
+      os.remove (OutputFile)
+
+  if Options.InPlace:
+    Arguments = ['-D', OutputFile, OutputFile] + TheFd.Arguments
+  else:
+    Arguments = ['-D', InputFile, OutputFile] + TheFd.Arguments
+  ExitCode, Output, Wall, Rss = RunTimed (Runner, Arguments, Options, Prepare)
+  if ExitCode != 0:
+    return 'FAIL (FitGen exit %d)' % ExitCode, Wall, Rss, 0, 0
+
+  ExitCode, View, ViewWall, ViewRss = RunTimed (Runner, ['-view', OutputFile, '-F', '0x%x' % FIT_TABLE_POINTER_OFFSET], Options)
+  if ExitCode != 0:
+    return 'FAIL (FitView exit %d)' % ExitCode, Wall, Rss, ViewWall, ViewRss
+
+  with open (OutputFile, 'rb') as File:
+    OutputImage = File.read ()
+  if len (OutputImage) != len (TheFd.Image):
+    return 'FAIL (size 0x%x)' % len (OutputImage), Wall, Rss, ViewWall, ViewRss
+
+  Text   = GoldenText (Scenario, ChangedRows (TheFd.Image, OutputImage), View)
+  Golden = os.path.join (Options.GoldenDir, '%s.txt' % Scenario['Name'])
+  Result = 'PASS'
+  if Options.UpdateGolden:
+    with open (Golden, 'w', newline = '\r\n') as File:
+      File.write (Text)
+    Result = 'UPDATED'
+  elif not os.path.exists (Golden):
+    Result = 'NO GOLDEN'
+  else:
+    with open (Golden, 'r') as File:
+      Expected = File.read ()
+    if Expected.splitlines ()[:2] != Text.splitlines ()[:2]:
+      #
+      # Scenario parameters were overridden on the command line
+      #
+      Result = 'PASS (no golden)'
+    elif Expected != Text:
+      Actual = os.path.join (WorkDir, '%s.txt' % Scenario['Name'])
+      with open (Actual, 'w') as File:
+        File.write (Text)
+      Result = 'FAIL (golden mismatch, see %s)' % Actual
+  return Result, Wall, Rss, ViewWall, ViewRss
+
+def FindFitGen ():
+  Name = 'FitGen.exe' if sys.platform == 'win32' else 'FitGen'
+  Path = shutil.which (Name)
+  if Path is None and 'EDK_TOOLS_BIN' in os.environ:
+    Path = shutil.which (Name, path = os.environ['EDK_TOOLS_BIN'])
+  if Path is None and 'EDK_TOOLS_PATH' in os.environ:
+    for Bin in ['BinWrappers/PosixLike', 'Source/C/bin', 'Bin/Win32']:
+      Path = shutil.which (Name, path = os.path.join (os.environ['EDK_TOOLS_PATH'], Bin))
+      if Path is not None:
+        break
+  return Path
+
+def Main ():
+  Parser = argparse.ArgumentParser (prog = __prog__, usage = __usage__, description = __copyright__)
+  Parser.add_argument ('--version', action = 'version', version = __version__)
+  Parser.add_argument ('Scenarios', nargs = '*', help = 'Scenarios to run, all if none. Available: %s' % ', '.join (Scenario['Name'] for Scenario in SCENARIOS))
+  Parser.add_argument ('-t', '--fitgen', dest = 'FitGen', help = 'FitGen executable, searched in PATH and EDK_TOOLS_PATH if not given')
+  Parser.add_argument ('-g', '--golden-dir', dest = 'GoldenDir', default = GOLDEN_DIR, help = 'Golden file directory')
+  Parser.add_argument ('-w', '--work-dir', dest = 'WorkDir', help = 'Keep the generated images in this directory')
+  Parser.add_argument ('-u', '--update-golden', dest = 'UpdateGolden', action = 'store_true', help = 'Write the golden files from this FitGen')
+  Parser.add_argument ('-r', '--repeat', dest = 'Repeat', type = int, default = 1, help = 'Runs per scenario, the fastest one is reported')
+  Parser.add_argument ('-i', '--in-place', dest = 'InPlace', action = 'store_true', help = 'Use the same file as FitGen input and output')
+  Parser.add_argument ('-s', '--set', dest = 'Set', action = 'append', default = [], metavar = 'KEY=VALUE',
+                       help = 'Override a scenario parameter, e.g. FdSize=0x4000000 or FilesPerFv=4096')
+  Parser.add_argument ('-v', '--verbose', dest = 'Verbose', action = 'store_true', help = 'Print the FitGen command lines and output')
+  Options = Parser.parse_args ()
+
+  FitGen = Options.FitGen or FindFitGen ()
+  if FitGen is None or not os.path.exists (FitGen):
+    print ('FitGen not found, use --fitgen')
+    return 1
+
+  Scenarios = SCENARIOS
+  if Options.Scenarios:
+    Scenarios = [Scenario for Scenario in SCENARIOS if Scenario['Name'] in Options.Scenarios]
+    if len (Scenarios) != len (set (Options.Scenarios)):
+      print ('Unknown scenario in %s' % ', '.join (Options.Scenarios))
+      return 1
+
+  Overrides = {}
+  for Set in Options.Set:
+    Key, Value = Set.split ('=', 1)
+    if Key not in SCENARIO_KEYS:
+      print ('Unknown scenario parameter %s' % Key)
+      return 1
+    Overrides[Key] = Value if Key == 'Mode' else (Value.lower () in ('1', 'true')) if Key == 'Acm' else int (Value, 0)
+
+  WorkDir = Options.WorkDir or tempfile.mkdtemp (prefix = 'FitGenTest')
+  os.makedirs (WorkDir, exist_ok = True)
+  Runner = FitGenRunner (os.path.abspath (FitGen))
+
+  #
+  # FitGen printing its usage gives the floor of the measurements
+  #
+  ExitCode, Output, Wall, Rss = Runner.Run ([])
+  print ('FitGen: %s' % Runner.FitGen)
+  print ('Baseline (no arguments): %.1f ms, %d KB peak RSS' % (Wall * 1000, Rss))
+  print ('')
+
+  Failed = 0
+  print ('%-16s %-10s %6s %10s %12s %10s %12s  %s' % ('Scenario', 'FdSize', 'Files', 'Gen (ms)', 'Gen RSS (KB)', 'View (ms)', 'View RSS(KB)', 'Result'))
+  try:
+    for Scenario in Scenarios:
+      Scenario = dict (Scenario, **Overrides)
+      Result, Wall, Rss, ViewWall, ViewRss = RunScenario (Runner, Scenario, WorkDir, Options)
+      if Result.startswith ('FAIL'):
+        Failed += 1
+      print ('%-16s 0x%-8x %6d %10.1f %12d %10.1f %12d  %s' % (
+        Scenario['Name'],
+        Scenario['FdSize'],
+        Scenario['FvCount'] * Scenario['FilesPerFv'],
+        Wall * 1000,
+        Rss,
+        ViewWall * 1000,
+        ViewRss,
+        Result
+        ))
+  finally:
+    Runner.Close ()
+    if Options.WorkDir is None:
+      shutil.rmtree (WorkDir, ignore_errors = True)
+
+  return 1 if Failed else 0
+
+if __name__ == '__main__':
+  sys.exit (Main ())
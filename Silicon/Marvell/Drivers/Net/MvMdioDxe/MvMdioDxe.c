@@ -15,6 +15,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/IoLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/PcdLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -83,34 +84,40 @@ MdioWaitValid (
   return EFI_SUCCESS;
 }
 
+STATIC
+VOID
+MdioTrace (
+  IN UINT32 PhyAddr,
+  IN UINT32 RegOff,
+  IN MARVELL_MDIO_OP_TYPE Type,
+  IN UINT32 Data,
+  IN UINT64 StartTicks
+  )
+{
+  STATIC CONST CHAR8 *OpNames[] = { "rd", "wr", "rmw", "delay" };
+
+  DEBUG((DEBUG_INFO, "MdioDxe: PHY 0x%x reg 0x%02x %a 0x%04x %Lu ns\n",
+    PhyAddr, RegOff, OpNames[Type], Data,
+    GetTimeInNanoSecond (GetPerformanceCounter () - StartTicks)));
+}
+
+/*
+ * Issue a single SMI transaction on an idle bus and wait
+ * for its completion, leaving the bus idle again.
+ */
 STATIC
 EFI_STATUS
-MdioOperation (
-  IN CONST MARVELL_MDIO_PROTOCOL *This,
+MdioIssue (
+  IN UINTN MdioBase,
   IN UINT32 PhyAddr,
-  IN UINT32 MdioIndex,
   IN UINT32 RegOff,
   IN BOOLEAN Write,
   IN OUT UINT32 *Data
   )
 {
-  UINTN MdioBase = This->BaseAddresses[MdioIndex];
   UINT32 MdioReg;
   EFI_STATUS Status;
 
-  Status = MdioCheckParam (PhyAddr, RegOff);
-  if (EFI_ERROR(Status)) {
-    DEBUG((DEBUG_ERROR, "MdioDxe: wrong parameters\n"));
-    return Status;
-  }
-
-  /* wait till the SMI is not busy */
-  Status = MdioWaitReady (MdioBase);
-  if (EFI_ERROR(Status)) {
-    DEBUG((DEBUG_ERROR, "MdioDxe: MdioWaitReady error\n"));
-    return Status;
-  }
-
   /* fill the phy addr and reg offset and write opcode and data */
   MdioReg = (PhyAddr << MVEBU_SMI_DEV_ADDR_OFFS)
       | (RegOff << MVEBU_SMI_REG_ADDR_OFFS);
@@ -138,6 +145,50 @@ MdioOperation (
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+MdioOperation (
+  IN CONST MARVELL_MDIO_PROTOCOL *This,
+  IN UINT32 PhyAddr,
+  IN UINT32 MdioIndex,
+  IN UINT32 RegOff,
+  IN BOOLEAN Write,
+  IN OUT UINT32 *Data
+  )
+{
+  UINTN MdioBase = This->BaseAddresses[MdioIndex];
+  UINT64 StartTicks = 0;
+  EFI_STATUS Status;
+
+  Status = MdioCheckParam (PhyAddr, RegOff);
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_ERROR, "MdioDxe: wrong parameters\n"));
+    return Status;
+  }
+
+  if (FixedPcdGetBool (PcdMdioTraceLatency)) {
+    StartTicks = GetPerformanceCounter ();
+  }
+
+  /* wait till the SMI is not busy */
+  Status = MdioWaitReady (MdioBase);
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_ERROR, "MdioDxe: MdioWaitReady error\n"));
+    return Status;
+  }
+
+  Status = MdioIssue (MdioBase, PhyAddr, RegOff, Write, Data);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+
+  if (FixedPcdGetBool (PcdMdioTraceLatency)) {
+    MdioTrace (PhyAddr, RegOff, Write ? MdioOpWrite : MdioOpRead, *Data, StartTicks);
+  }
+
+  return EFI_SUCCESS;
+}
+
 STATIC
 EFI_STATUS
 MvMdioRead (
@@ -181,6 +232,92 @@ MvMdioWrite (
             );
 }
 
+STATIC
+EFI_STATUS
+EFIAPI
+MvMdioTransfer (
+  IN CONST MARVELL_MDIO_PROTOCOL *This,
+  IN UINT32 PhyAddr,
+  IN UINT32 MdioIndex,
+  IN OUT MARVELL_MDIO_OP *Ops,
+  IN UINTN OpCount
+  )
+{
+  UINTN MdioBase;
+  UINT64 StartTicks = 0;
+  UINT32 Data;
+  UINTN Index;
+  EFI_STATUS Status;
+
+  if (MdioIndex >= This->ControllerCount || (Ops == NULL && OpCount != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  /* Validate the whole batch up front, so that it is never applied partially */
+  for (Index = 0; Index < OpCount; Index++) {
+    if (Ops[Index].Type > MdioOpDelay) {
+      DEBUG((DEBUG_ERROR, "MdioDxe: invalid operation %d\n", Ops[Index].Type));
+      return EFI_INVALID_PARAMETER;
+    }
+
+    Status = MdioCheckParam (PhyAddr, Ops[Index].RegOff);
+    if (EFI_ERROR(Status)) {
+      DEBUG((DEBUG_ERROR, "MdioDxe: wrong parameters\n"));
+      return Status;
+    }
+  }
+
+  MdioBase = This->BaseAddresses[MdioIndex];
+
+  /* Each transaction below completes with the SMI idle, so wait only once */
+  Status = MdioWaitReady (MdioBase);
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_ERROR, "MdioDxe: MdioWaitReady error\n"));
+    return Status;
+  }
+
+  for (Index = 0; Index < OpCount; Index++) {
+    if (FixedPcdGetBool (PcdMdioTraceLatency)) {
+      StartTicks = GetPerformanceCounter ();
+    }
+
+    switch (Ops[Index].Type) {
+    case MdioOpRead:
+      Status = MdioIssue (MdioBase, PhyAddr, Ops[Index].RegOff, FALSE, &Ops[Index].Data);
+      Data = Ops[Index].Data;
+      break;
+    case MdioOpWrite:
+      Data = Ops[Index].Data;
+      Status = MdioIssue (MdioBase, PhyAddr, Ops[Index].RegOff, TRUE, &Data);
+      break;
+    case MdioOpModify:
+      Status = MdioIssue (MdioBase, PhyAddr, Ops[Index].RegOff, FALSE, &Data);
+      if (EFI_ERROR(Status)) {
+        break;
+      }
+      Data = (Data & ~Ops[Index].Mask) | Ops[Index].Data;
+      Status = MdioIssue (MdioBase, PhyAddr, Ops[Index].RegOff, TRUE, &Data);
+      break;
+    case MdioOpDelay:
+    default:
+      Data = Ops[Index].Data;
+      gBS->Stall (Data);
+      break;
+    }
+
+    if (EFI_ERROR(Status)) {
+      DEBUG((DEBUG_ERROR, "MdioDxe: operation %lu of %lu failed\n", (UINT64)Index, (UINT64)OpCount));
+      return Status;
+    }
+
+    if (FixedPcdGetBool (PcdMdioTraceLatency)) {
+      MdioTrace (PhyAddr, Ops[Index].RegOff, Ops[Index].Type, Data, StartTicks);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
 EFI_STATUS
 EFIAPI
 MvMdioDxeInitialise (
@@ -230,6 +367,7 @@ MvMdioDxeInitialise (
   Mdio->ControllerCount = MdioBoardDesc->MdioDevCount;
   Mdio->Read = MvMdioRead;
   Mdio->Write = MvMdioWrite;
+  Mdio->Transfer = MvMdioTransfer;
 
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &Handle,
@@ -43,6 +43,44 @@ STATIC MV_PHY_DEVICE MvPhyDevices[] = {
   { 0, NULL }
 };
 
+//
+// Marvell Release Notes - Alaska 88E1510/88E1518/88E1512 Rev A0,
+// Errata Section 3.1 - needed in SGMII mode.
+//
+STATIC MARVELL_MDIO_OP Mv1512SgmiiInitTable[] = {
+  /* Select page 0xff and update configuration registers */
+  MDIO_OP_WRITE (22, 0x00ff),
+  MDIO_OP_WRITE (17, 0x214B),
+  MDIO_OP_WRITE (16, 0x2144),
+  MDIO_OP_WRITE (17, 0x0C28),
+  MDIO_OP_WRITE (16, 0x2146),
+  MDIO_OP_WRITE (17, 0xB233),
+  MDIO_OP_WRITE (16, 0x214D),
+  MDIO_OP_WRITE (17, 0xCC0C),
+  MDIO_OP_WRITE (16, 0x2159),
+  /* Reset page selection and select page 0x12 */
+  MDIO_OP_WRITE (22, 0x0000),
+  MDIO_OP_WRITE (22, 0x0012),
+  /* Write HWCFG_MODE = SGMII to Copper */
+  MDIO_OP_MODIFY (20, 0x0007, 0x0001),
+  /* Phy reset - necessary after changing mode */
+  MDIO_OP_MODIFY (20, 0x8000, 0x8000),
+  /* Reset page selection */
+  MDIO_OP_WRITE (22, 0x0000),
+  MDIO_OP_DELAY (100),
+};
+
+STATIC
+EFI_STATUS
+MvPhyTransfer (
+  IN PHY_DEVICE *PhyDev,
+  IN OUT MARVELL_MDIO_OP *Ops,
+  IN UINTN OpCount
+  )
+{
+  return Mdio->Transfer (Mdio, PhyDev->Addr, PhyDev->MdioIndex, Ops, OpCount);
+}
+
 EFI_STATUS
 MvPhyStatus (
   IN CONST MARVELL_PHY_PROTOCOL *This,
@@ -54,12 +92,19 @@ MvPhyReset (
   IN PHY_DEVICE *PhyDev
   )
 {
-  UINT32 Reg = 0;
+  MARVELL_MDIO_OP Ops[] = {
+    MDIO_OP_MODIFY (MII_BMCR, BMCR_RESET, BMCR_RESET),
+    MDIO_OP_READ (MII_BMCR),
+  };
+  UINT32 Reg;
   INTN timeout = TIMEOUT;
+  EFI_STATUS Status;
 
-  Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMCR, &Reg);
-  Reg |= BMCR_RESET;
-  Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMCR, Reg);
+  Status = MvPhyTransfer (PhyDev, Ops, ARRAY_SIZE (Ops));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  Reg = Ops[1].Data;
 
   while ((Reg & BMCR_RESET) && timeout--) {
     Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMCR, &Reg);
@@ -80,29 +125,36 @@ MvPhyM88e1111sConfig (
   IN PHY_DEVICE *PhyDev
   )
 {
+  MARVELL_MDIO_OP Ops[2];
   UINT32 Reg;
+  EFI_STATUS Status;
 
   if ((PhyDev->Connection == PHY_CONNECTION_RGMII) ||
       (PhyDev->Connection == PHY_CONNECTION_RGMII_ID) ||
       (PhyDev->Connection == PHY_CONNECTION_RGMII_RXID) ||
       (PhyDev->Connection == PHY_CONNECTION_RGMII_TXID)) {
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_CR, &Reg);
+    Ops[0].Type = MdioOpModify;
+    Ops[0].RegOff = MIIM_88E1111_PHY_EXT_CR;
+    Ops[0].Mask = MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY;
 
     if ((PhyDev->Connection == PHY_CONNECTION_RGMII) ||
       (PhyDev->Connection == PHY_CONNECTION_RGMII_ID)) {
-      Reg |= (MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY);
+      Ops[0].Data = MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY;
     } else if (PhyDev->Connection == PHY_CONNECTION_RGMII_RXID) {
-      Reg &= ~MIIM_88E1111_TX_DELAY;
-      Reg |= MIIM_88E1111_RX_DELAY;
-    } else if (PhyDev->Connection == PHY_CONNECTION_RGMII_TXID) {
-      Reg &= ~MIIM_88E1111_RX_DELAY;
-      Reg |= MIIM_88E1111_TX_DELAY;
+      Ops[0].Data = MIIM_88E1111_RX_DELAY;
+    } else {
+      Ops[0].Data = MIIM_88E1111_TX_DELAY;
     }
 
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_CR, Reg);
+    Ops[1].Type = MdioOpRead;
+    Ops[1].RegOff = MIIM_88E1111_PHY_EXT_SR;
 
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, &Reg);
+    Status = MvPhyTransfer (PhyDev, Ops, 2);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
+    Reg = Ops[1].Data;
     Reg &= ~(MIIM_88E1111_HWCFG_MODE_MASK);
 
     if (Reg & MIIM_88E1111_HWCFG_FIBER_COPPER_RES)
@@ -114,46 +166,68 @@ MvPhyM88e1111sConfig (
   }
 
   if (PhyDev->Connection == PHY_CONNECTION_SGMII) {
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, &Reg);
+    Ops[0].Type = MdioOpModify;
+    Ops[0].RegOff = MIIM_88E1111_PHY_EXT_SR;
+    Ops[0].Mask = MIIM_88E1111_HWCFG_MODE_MASK | MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
+    Ops[0].Data = MIIM_88E1111_HWCFG_MODE_SGMII_NO_CLK |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
 
-    Reg &= ~(MIIM_88E1111_HWCFG_MODE_MASK);
-    Reg |= MIIM_88E1111_HWCFG_MODE_SGMII_NO_CLK;
-    Reg |= MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
-
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, Reg);
+    Status = MvPhyTransfer (PhyDev, Ops, 1);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
   if (PhyDev->Connection == PHY_CONNECTION_RTBI) {
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_CR, &Reg);
-    Reg |= (MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_CR, Reg);
-
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, &Reg);
-    Reg &= ~(MIIM_88E1111_HWCFG_MODE_MASK |
-      MIIM_88E1111_HWCFG_FIBER_COPPER_RES);
-    Reg |= 0x7 | MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, Reg);
+    Ops[0].Type = MdioOpModify;
+    Ops[0].RegOff = MIIM_88E1111_PHY_EXT_CR;
+    Ops[0].Mask = MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY;
+    Ops[0].Data = MIIM_88E1111_RX_DELAY | MIIM_88E1111_TX_DELAY;
+
+    Ops[1].Type = MdioOpModify;
+    Ops[1].RegOff = MIIM_88E1111_PHY_EXT_SR;
+    Ops[1].Mask = MIIM_88E1111_HWCFG_MODE_MASK |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_RES |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
+    Ops[1].Data = 0x7 | MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
+
+    Status = MvPhyTransfer (PhyDev, Ops, 2);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
     /* Soft reset */
-    MvPhyReset (PhyDev);
+    Status = MvPhyReset (PhyDev);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
 
-    Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, &Reg);
-    Reg &= ~(MIIM_88E1111_HWCFG_MODE_MASK |
-      MIIM_88E1111_HWCFG_FIBER_COPPER_RES);
-    Reg |= MIIM_88E1111_HWCFG_MODE_COPPER_RTBI |
-      MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MIIM_88E1111_PHY_EXT_SR, Reg);
+    Ops[0].Type = MdioOpModify;
+    Ops[0].RegOff = MIIM_88E1111_PHY_EXT_SR;
+    Ops[0].Mask = MIIM_88E1111_HWCFG_MODE_MASK |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_RES |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
+    Ops[0].Data = MIIM_88E1111_HWCFG_MODE_COPPER_RTBI |
+                  MIIM_88E1111_HWCFG_FIBER_COPPER_AUTO;
+
+    Status = MvPhyTransfer (PhyDev, Ops, 1);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
-  Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMCR, &Reg);
-  Reg |= (BMCR_ANENABLE | BMCR_ANRESTART);
-  Reg &= ~BMCR_ISOLATE;
-  Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMCR, Reg);
+  Ops[0].Type = MdioOpModify;
+  Ops[0].RegOff = MII_BMCR;
+  Ops[0].Mask = BMCR_ANENABLE | BMCR_ANRESTART | BMCR_ISOLATE;
+  Ops[0].Data = BMCR_ANENABLE | BMCR_ANRESTART;
 
-  /* Soft reset */
-  MvPhyReset (PhyDev);
+  Status = MvPhyTransfer (PhyDev, Ops, 1);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
-  return EFI_SUCCESS;
+  /* Soft reset */
+  return MvPhyReset (PhyDev);
 }
 
 EFI_STATUS
@@ -275,30 +349,6 @@ MvPhyConfigureAutonegotiation (
   return EFI_SUCCESS;
 }
 
-STATIC
-VOID
-MvPhy1512WriteBits (
-  IN PHY_DEVICE *PhyDev,
-  IN UINT8 RegNum,
-  IN UINT16 Offset,
-  IN UINT16 Len,
-  IN UINT16 Data)
-{
-  UINT32 Reg, Mask;
-
-  if ((Len + Offset) >= 16)
-    Mask = 0 - (1 << Offset);
-  else
-    Mask = (1 << (Len + Offset)) - (1 << Offset);
-
-  Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, RegNum, &Reg);
-
-  Reg &= ~Mask;
-  Reg |= Data << Offset;
-
-  Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, RegNum, Reg);
-}
-
 STATIC
 EFI_STATUS
 MvPhyInit1512 (
@@ -309,36 +359,16 @@ MvPhyInit1512 (
   EFI_STATUS Status;
 
   if (PhyDev->Connection == PHY_CONNECTION_SGMII) {
-    /* Select page 0xff and update configuration registers according to
-     * Marvell Release Notes - Alaska 88E1510/88E1518/88E1512 Rev A0,
-     * Errata Section 3.1 - needed in SGMII mode.
-     */
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 22, 0x00ff);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 17, 0x214B);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 16, 0x2144);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 17, 0x0C28);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 16, 0x2146);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 17, 0xB233);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 16, 0x214D);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 17, 0xCC0C);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 16, 0x2159);
-
-    /* Reset page selection and select page 0x12 */
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 22, 0x0000);
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 22, 0x0012);
-
-    /* Write HWCFG_MODE = SGMII to Copper */
-    MvPhy1512WriteBits(PhyDev, 20, 0, 3, 1);
-
-    /* Phy reset - necessary after changing mode */
-    MvPhy1512WriteBits(PhyDev, 20, 15, 1, 1);
-
-    /* Reset page selection */
-    Mdio->Write (Mdio, PhyDev->Addr, PhyDev->MdioIndex, 22, 0x0000);
-    gBS->Stall(100);
+    Status = MvPhyTransfer (PhyDev, Mv1512SgmiiInitTable, ARRAY_SIZE (Mv1512SgmiiInitTable));
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
   }
 
-  MvPhyM88e1111sConfig (PhyDev);
+  Status = MvPhyM88e1111sConfig (PhyDev);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
   /* autonegotiation on startup is not always required */
   if (!PcdGetBool (PcdPhyStartupAutoneg))
@@ -370,7 +400,10 @@ MvPhyInit1112 (
 {
   EFI_STATUS Status;
 
-  MvPhyM88e1111sConfig (PhyDevice);
+  Status = MvPhyM88e1111sConfig (PhyDevice);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
 
   if (PcdGetBool (PcdPhyStartupAutoneg)) {
     Status = MvPhyConfigureAutonegotiation (PhyDevice);
@@ -411,7 +444,7 @@ MvPhyInit (
   /* Verify correctness of PHY <-> MDIO assignment */
   if ((MdioDeviceTable[MdioIndex] == 0) ||
       (MdioIndex >= Mdio->ControllerCount)) {
-    DEBUG ((DEBUG_ERROR, "MvPhyDxe: Incorrect Mdio controller assignment for PHY#%d", PhyIndex));
+    DEBUG ((DEBUG_ERROR, "MvPhyDxe: Incorrect Mdio controller assignment for PHY#%u", PhyIndex));
     return EFI_INVALID_PARAMETER;
   }
 
@@ -419,7 +452,7 @@ MvPhyInit (
   PhyId = DeviceIds[PhyIndex];
   if (PhyId >= MV_PHY_DEVICE_ID_MAX) {
     DEBUG ((DEBUG_ERROR,
-      "%a, Incorrect PHY ID (0x%x) for PHY#%d\n",
+      "%a, Incorrect PHY ID (0x%x) for PHY#%u\n",
       __FUNCTION__,
       PhyId,
       PhyIndex));
@@ -432,7 +465,7 @@ MvPhyInit (
   PhyDev->Connection = PhyConnection;
   PhyDev->MdioIndex = MdioIndex;
   DEBUG ((DEBUG_INFO,
-    "MvPhyDxe: MdioIndex is %d, PhyAddr is %d, connection %d\n",
+    "MvPhyDxe: MdioIndex is %u, PhyAddr is %u, connection %d\n",
     PhyDev->MdioIndex,
     PhyDev->Addr,
     PhyConnection));
@@ -447,10 +480,19 @@ MvPhyStatus (
   IN PHY_DEVICE  *PhyDev
   )
 {
+  /* Link status is latched low, the second read returns the current state */
+  MARVELL_MDIO_OP Ops[] = {
+    MDIO_OP_READ (MII_BMSR),
+    MDIO_OP_READ (MII_BMSR),
+  };
   UINT32 Data;
+  EFI_STATUS Status;
 
-  Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMSR, &Data);
-  Mdio->Read (Mdio, PhyDev->Addr, PhyDev->MdioIndex, MII_BMSR, &Data);
+  Status = MvPhyTransfer (PhyDev, Ops, ARRAY_SIZE (Ops));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+  Data = Ops[1].Data;
 
   if ((Data & BMSR_LSTATUS) == 0) {
     PhyDev->LinkUp = FALSE;
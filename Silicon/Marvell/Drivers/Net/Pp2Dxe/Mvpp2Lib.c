@@ -2868,6 +2868,15 @@ Mvpp2InterruptsUnmask (
         );
 }
 
+/* Unmask only the Rx queue occupancy interrupts of the Port */
+VOID
+Mvpp2RxqInterruptsUnmask (
+  IN PP2DXE_PORT *Port
+  )
+{
+  Mvpp2Write (Port->Priv, MVPP2_ISR_RX_TX_MASK_REG(Port->Id), MVPP2_CAUSE_RXQ_OCCUP_DESC_ALL_MASK);
+}
+
 /* MAC configuration routines */
 
 STATIC
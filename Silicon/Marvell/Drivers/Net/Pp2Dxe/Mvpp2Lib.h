@@ -151,6 +151,11 @@ Mvpp2InterruptsUnmask (
   IN VOID *arg
   );
 
+VOID
+Mvpp2RxqInterruptsUnmask (
+  IN PP2DXE_PORT *Port
+  );
+
 VOID
 Mvpp2PortEnable (
   IN PP2DXE_PORT *Port
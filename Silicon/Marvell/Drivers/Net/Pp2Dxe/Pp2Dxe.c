@@ -18,7 +18,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/IoLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
+#include <Library/NetPerfAdapterInfoLib.h>
 #include <Library/PcdLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -28,6 +30,17 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #define ReturnUnlock(tpl, status) do { gBS->RestoreTPL (tpl); return (status); } while(0)
 
+/* Same as ReturnUnlock, also accounting the time spent at raised TPL */
+#define ReturnUnlockTimed(ctx, tpl, ticks, status) do {                     \
+          (ctx)->RaisedTplTicks += GetPerformanceCounter () - (ticks);      \
+          ReturnUnlock (tpl, status);                                       \
+        } while(0)
+
+STATIC EFI_HARDWARE_INTERRUPT_PROTOCOL *mInterrupt;
+
+/* Ports with interrupt driven Rx notification, indexed by instance */
+STATIC PP2DXE_CONTEXT *mPp2RxInterruptContexts[PP2DXE_MAX_INSTANCES];
+
 STATIC PP2_DEVICE_PATH Pp2DevicePathTemplate = {
   {
     {
@@ -515,6 +528,132 @@ Pp2DxePhyInitialize (
   return EFI_SUCCESS;
 }
 
+/*
+ * Rx interrupt handler, called at TPL_HIGH_LEVEL. The occupied descriptor
+ * cause is level sensitive, so keep it masked until Receive drains the queue
+ * and only record that there is work to do.
+ */
+STATIC
+VOID
+EFIAPI
+Pp2DxeRxInterruptHandler (
+  IN HARDWARE_INTERRUPT_SOURCE Source,
+  IN EFI_SYSTEM_CONTEXT SystemContext
+  )
+{
+  PP2DXE_CONTEXT *Pp2Context;
+  INTN Index;
+
+  for (Index = 0; Index < PP2DXE_MAX_INSTANCES; Index++) {
+    Pp2Context = mPp2RxInterruptContexts[Index];
+    if (Pp2Context == NULL || Pp2Context->RxInterrupt != Source) {
+      continue;
+    }
+
+    Mvpp2InterruptsMask (&Pp2Context->Port);
+    Pp2Context->RxPending = TRUE;
+    gBS->SignalEvent (Pp2Context->Snp.WaitForPacket);
+  }
+
+  mInterrupt->EndOfInterrupt (mInterrupt, Source);
+}
+
+STATIC
+VOID
+Pp2DxeRxInterruptArm (
+  IN PP2DXE_CONTEXT *Pp2Context
+  )
+{
+  PP2DXE_PORT *Port = &Pp2Context->Port;
+  MVPP2_RX_QUEUE *Rxq = &Port->Rxqs[0];
+  EFI_STATUS Status;
+  BOOLEAN Shared = FALSE;
+  INTN Index;
+
+  if (Pp2Context->RxInterrupt == 0 || Pp2Context->RxInterruptEnabled) {
+    /* Rx is polled by the network stack */
+    return;
+  }
+
+  if (Pp2Context->Instance >= PP2DXE_MAX_INSTANCES) {
+    DEBUG((DEBUG_WARN, "Pp2Dxe%d: too many instances, polling Rx\n", Pp2Context->Instance));
+    return;
+  }
+
+  if (mInterrupt == NULL) {
+    Status = gBS->LocateProtocol (&gHardwareInterruptProtocolGuid, NULL, (VOID **)&mInterrupt);
+    if (EFI_ERROR(Status)) {
+      DEBUG((DEBUG_WARN, "Pp2Dxe%d: no interrupt controller, polling Rx\n", Pp2Context->Instance));
+      return;
+    }
+  }
+
+  /* Several ports may be wired to the same interrupt line */
+  for (Index = 0; Index < PP2DXE_MAX_INSTANCES; Index++) {
+    if (mPp2RxInterruptContexts[Index] != NULL &&
+        mPp2RxInterruptContexts[Index]->RxInterrupt == Pp2Context->RxInterrupt) {
+      Shared = TRUE;
+      break;
+    }
+  }
+
+  if (!Shared) {
+    Status = mInterrupt->RegisterInterruptSource (mInterrupt,
+                           Pp2Context->RxInterrupt,
+                           Pp2DxeRxInterruptHandler);
+    if (EFI_ERROR(Status)) {
+      DEBUG((DEBUG_WARN, "Pp2Dxe%d: cannot register Rx interrupt %d, polling Rx\n",
+        Pp2Context->Instance, (UINT32)Pp2Context->RxInterrupt));
+      return;
+    }
+  }
+
+  /* Raise the interrupt as soon as a single packet is received */
+  Mvpp2RxPktsCoalSet (Port, Rxq, 1);
+  Mvpp2RxTimeCoalSet (Port, Rxq, 0);
+
+  Pp2Context->RxPending = FALSE;
+  Pp2Context->RxIdlePolls = 0;
+  Pp2Context->RxInterruptEnabled = TRUE;
+  mPp2RxInterruptContexts[Pp2Context->Instance] = Pp2Context;
+
+  Mvpp2Write (Port->Priv, MVPP2_ISR_RX_TX_CAUSE_REG(Port->Id), 0);
+  Mvpp2RxqInterruptsUnmask (Port);
+  Mvpp2InterruptsEnable (Port, 0x1);
+}
+
+/*
+ * WaitForPacket notify function. With the Rx interrupt armed the pending
+ * flag is set by the interrupt handler, otherwise the Rx queue is checked.
+ */
+STATIC
+VOID
+EFIAPI
+Pp2SnpWaitForPacket (
+  IN EFI_EVENT Event,
+  IN VOID *Context
+  )
+{
+  PP2DXE_CONTEXT *Pp2Context = Context;
+  PP2DXE_PORT *Port = &Pp2Context->Port;
+
+  if (Pp2Context->Snp.Mode->State != EfiSimpleNetworkInitialized ||
+      !Pp2Context->LateInitialized) {
+    return;
+  }
+
+  if (Pp2Context->RxInterruptEnabled) {
+    if (Pp2Context->RxPending) {
+      gBS->SignalEvent (Event);
+    }
+    return;
+  }
+
+  if (Mvpp2RxqReceived (Port, Port->Rxqs[0].Id) > 0) {
+    gBS->SignalEvent (Event);
+  }
+}
+
 EFI_STATUS
 EFIAPI
 Pp2DxeSnpInitialize (
@@ -565,7 +704,13 @@ Pp2DxeSnpInitialize (
   }
 
   Status = Pp2DxeLateInitialize(Pp2Context);
-  ReturnUnlock (SavedTpl, Status);
+  if (EFI_ERROR(Status)) {
+    ReturnUnlock (SavedTpl, Status);
+  }
+
+  Pp2DxeRxInterruptArm (Pp2Context);
+
+  ReturnUnlock (SavedTpl, EFI_SUCCESS);
 }
 
 EFI_STATUS
@@ -643,8 +788,29 @@ Pp2DxeHalt (
   PP2DXE_CONTEXT *Pp2Context = Context;
   PP2DXE_PORT *Port = &Pp2Context->Port;
   MVPP2_SHARED *Mvpp2Shared = Pp2Context->Port.Priv;
+  BOOLEAN Shared = FALSE;
   INTN Index;
 
+  if (Pp2Context->RxInterruptEnabled) {
+    mPp2RxInterruptContexts[Pp2Context->Instance] = NULL;
+    Pp2Context->RxInterruptEnabled = FALSE;
+    Mvpp2InterruptsMask (Port);
+    Mvpp2InterruptsDisable (Port, 0x1);
+
+    /* Leave the line enabled while other ports still rely on it */
+    for (Index = 0; Index < PP2DXE_MAX_INSTANCES; Index++) {
+      if (mPp2RxInterruptContexts[Index] != NULL &&
+          mPp2RxInterruptContexts[Index]->RxInterrupt == Pp2Context->RxInterrupt) {
+        Shared = TRUE;
+        break;
+      }
+    }
+
+    if (!Shared) {
+      mInterrupt->DisableInterruptSource (mInterrupt, Pp2Context->RxInterrupt);
+    }
+  }
+
   if (Mvpp2Shared->BmEnabled) {
     for (Index = 0; Index < MVPP2_MAX_PORT; Index++) {
       Mvpp2BmStop(Mvpp2Shared, Index);
@@ -825,6 +991,8 @@ Pp2SnpGetStatus (
   if (!Pp2Context->Initialized)
     ReturnUnlock(SavedTpl, EFI_NOT_READY);
 
+  Pp2Context->PerfCounters.StatusPolls++;
+
   LinkUp = Port->AlwaysUp ? TRUE : MvGop110PortIsLinkUp(Port);
 
   if (LinkUp != Snp->Mode->MediaPresent) {
@@ -864,6 +1032,7 @@ Pp2SnpTransmit (
   UINT16 EtherType;
   UINT32 State = This->Mode->State;
   EFI_TPL SavedTpl;
+  UINT64 TplTicks;
 
   if (This == NULL || Buffer == NULL) {
     DEBUG((DEBUG_ERROR, "Pp2Dxe: NULL Snp or Buffer\n"));
@@ -877,24 +1046,25 @@ Pp2SnpTransmit (
   }
 
   SavedTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  TplTicks = GetPerformanceCounter ();
 
   /* Check that driver was started and initialised */
   if (State != EfiSimpleNetworkInitialized) {
     switch (State) {
     case EfiSimpleNetworkStopped:
       DEBUG((DEBUG_WARN, "Pp2Dxe%d: not started\n", Pp2Context->Instance));
-      ReturnUnlock (SavedTpl, EFI_NOT_STARTED);
+      ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_NOT_STARTED);
     case EfiSimpleNetworkStarted:
     /* Fall through */
     default:
       DEBUG((DEBUG_ERROR, "Pp2Dxe%d: wrong state\n", Pp2Context->Instance));
-      ReturnUnlock (SavedTpl, EFI_DEVICE_ERROR);
+      ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_DEVICE_ERROR);
     }
   }
 
   if (!This->Mode->MediaPresent) {
     DEBUG((DEBUG_ERROR, "Pp2Dxe: link not ready\n"));
-    ReturnUnlock(SavedTpl, EFI_NOT_READY);
+    ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_NOT_READY);
   }
 
   EtherType = HTONS (*EtherTypePtr);
@@ -904,7 +1074,7 @@ Pp2SnpTransmit (
 
   if (!TxDesc) {
     DEBUG((DEBUG_ERROR, "No tx descriptor to use\n"));
-    ReturnUnlock(SavedTpl, EFI_OUT_OF_RESOURCES);
+    ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_OUT_OF_RESOURCES);
   }
 
   if (HeaderSize != 0) {
@@ -938,10 +1108,14 @@ Pp2SnpTransmit (
    */
   PollingCount = 0;
   TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
+  Pp2Context->PerfCounters.TxRingOccupancySum += TxSent;
+  Pp2Context->PerfCounters.TxRingOccupancyMax =
+    MAX (Pp2Context->PerfCounters.TxRingOccupancyMax, (UINT64)TxSent);
   do {
+    Pp2Context->PerfCounters.PollIterations++;
     if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
       DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
+      ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_TIMEOUT);
     }
     TxSent = Mvpp2AggrTxqPendDescNumGet(Mvpp2Shared, 0);
   } while (TxSent);
@@ -950,9 +1124,10 @@ Pp2SnpTransmit (
   PollingCount = 0;
   TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
   while (!TxSent) {
+    Pp2Context->PerfCounters.PollIterations++;
     if (PollingCount++ > MVPP2_TX_SEND_MAX_POLLING_COUNT) {
       DEBUG((DEBUG_ERROR, "Pp2Dxe: transmit polling failed\n"));
-      ReturnUnlock(SavedTpl, EFI_TIMEOUT);
+      ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_TIMEOUT);
     }
     TxSent = Mvpp2TxqSentDescProc(Port, &Port->Txqs[0]);
   }
@@ -961,8 +1136,9 @@ Pp2SnpTransmit (
    * At this point TxSent has increased - HW sent the packet
    * Add buffer to completion queue and return.
    */
+  Pp2Context->PerfCounters.TxPackets++;
   Status = QueueInsert (Pp2Context, Buffer);
-  ReturnUnlock (SavedTpl, Status);
+  ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, Status);
 }
 
 EFI_STATUS
@@ -984,6 +1160,7 @@ Pp2SnpReceive (
   UINTN PhysAddr, VirtAddr;
   EFI_STATUS Status = EFI_SUCCESS;
   EFI_TPL SavedTpl;
+  UINT64 TplTicks;
   UINT32 StatusReg;
   INTN PoolId;
   UINTN PktLength;
@@ -995,10 +1172,36 @@ Pp2SnpReceive (
   ASSERT (Rxq != NULL);
 
   SavedTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  TplTicks = GetPerformanceCounter ();
+  Pp2Context->PerfCounters.RxPolls++;
+
+  /* Nothing arrived since the queue was last drained, skip the MMIO poll */
+  if (!Pp2DxeRxPollNeeded (Pp2Context->RxInterruptEnabled,
+         Pp2Context->RxPending, &Pp2Context->RxIdlePolls)) {
+    ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_NOT_READY);
+  }
+
   ReceivedPackets = Mvpp2RxqReceived(Port, Rxq->Id);
 
+  if (ReceivedPackets > 0 && Pp2Context->RxInterruptEnabled &&
+      !Pp2Context->RxPending) {
+    /* The Rx interrupt was lost, drain the queue before rearming it */
+    DEBUG((DEBUG_VERBOSE, "Pp2Dxe%d: Rx found by fallback poll\n", Pp2Context->Instance));
+    Mvpp2InterruptsMask (Port);
+    Pp2Context->RxPending = TRUE;
+  }
+
   if (ReceivedPackets == 0) {
-    ReturnUnlock(SavedTpl, EFI_NOT_READY);
+    if (Pp2Context->RxInterruptEnabled) {
+      /*
+       * Queue drained, rearm the interrupt. A packet racing with the unmask
+       * keeps the level sensitive occupancy cause asserted.
+       */
+      Pp2Context->RxPending = FALSE;
+      Mvpp2Write (Mvpp2Shared, MVPP2_ISR_RX_TX_CAUSE_REG(Port->Id), 0);
+      Mvpp2RxqInterruptsUnmask (Port);
+    }
+    ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_NOT_READY);
   }
 
   /* Process one packet per call */
@@ -1020,12 +1223,16 @@ Pp2SnpReceive (
   if (PktLength > *BufferSize) {
     *BufferSize = PktLength;
     DEBUG((DEBUG_ERROR, "Pp2Dxe: buffer too small\n"));
-    ReturnUnlock(SavedTpl, EFI_BUFFER_TOO_SMALL);
+    ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, EFI_BUFFER_TOO_SMALL);
   }
 
   CopyMem (Buffer, (VOID*) (PhysAddr + 2), PktLength);
   *BufferSize = PktLength;
 
+  Pp2Context->PerfCounters.RxPackets++;
+  Pp2Context->PerfCounters.Copies++;
+  Pp2Context->PerfCounters.CopyBytes += PktLength;
+
   if (HeaderSize != NULL) {
     *HeaderSize = Pp2Context->Snp.Mode->MediaHeaderSize;
   }
@@ -1057,7 +1264,7 @@ drop:
   /* Update counters with 1 packet received and 1 packet refilled */
   Mvpp2RxqStatusUpdate(Port, Rxq->Id, 1, 1);
 
-  ReturnUnlock(SavedTpl, Status);
+  ReturnUnlockTimed (Pp2Context, SavedTpl, TplTicks, Status);
 }
 
 EFI_STATUS
@@ -1098,6 +1305,18 @@ Pp2DxeSnpInstall (
 
   Pp2Context->Snp.Mode = SnpMode;
 
+  Status = gBS->CreateEvent (
+                 EVT_NOTIFY_WAIT,
+                 TPL_NOTIFY,
+                 Pp2SnpWaitForPacket,
+                 Pp2Context,
+                 &Pp2Context->Snp.WaitForPacket
+               );
+  if (EFI_ERROR(Status)) {
+    DEBUG((DEBUG_ERROR, "Failed to create WaitForPacket event.\n"));
+    return Status;
+  }
+
   /* Install protocol */
   Status = gBS->InstallMultipleProtocolInterfaces (
       &Handle,
@@ -1154,6 +1373,14 @@ Pp2AipGetInformation (
     return EFI_INVALID_PARAMETER;
   }
 
+  Pp2Context = INSTANCE_FROM_AIP (This);
+
+  Status = NetPerfAipGetInformation (InformationType, &Pp2Context->PerfCounters,
+             Pp2Context->RaisedTplTicks, InformationBlock, InformationBlockSize);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (!CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_UNSUPPORTED;
   }
@@ -1166,8 +1393,6 @@ Pp2AipGetInformation (
   *InformationBlock = AdapterInfo;
   *InformationBlockSize = sizeof (EFI_ADAPTER_INFO_MEDIA_STATE);
 
-  Pp2Context = INSTANCE_FROM_AIP (This);
-
   Status = Pp2Context->Snp.GetStatus (&(Pp2Context->Snp), NULL, NULL);
   if (Status == EFI_NOT_READY){
     AdapterInfo->MediaState = EFI_NOT_READY;
@@ -1217,10 +1442,21 @@ Pp2AipSetInformation (
   IN  UINTN                             InformationBlockSize
   )
 {
+  PP2DXE_CONTEXT                *Pp2Context;
+  EFI_STATUS                     Status;
+
   if (This == NULL || InformationBlock == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  Pp2Context = INSTANCE_FROM_AIP (This);
+
+  Status = NetPerfAipSetInformation (InformationType, &Pp2Context->PerfCounters,
+             &Pp2Context->RaisedTplTicks);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_WRITE_PROTECTED;
   }
@@ -1263,15 +1499,7 @@ Pp2AipGetSupportedTypes (
     return EFI_INVALID_PARAMETER;
   }
 
-  *InfoTypesBuffer = AllocatePool (sizeof (EFI_GUID));
-  if (*InfoTypesBuffer == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  *InfoTypesBufferCount = 1;
-  CopyGuid (*InfoTypesBuffer, &gEfiAdapterInfoMediaStateGuid);
-
-  return EFI_SUCCESS;
+  return NetPerfAipGetSupportedTypes (InfoTypesBuffer, InfoTypesBufferCount);
 }
 
 STATIC
@@ -1282,6 +1510,7 @@ Pp2DxeParsePortPcd (
   )
 {
   UINT8 *PortIds, *GopIndexes, *PhyConnectionTypes, *AlwaysUp, *Speed, *PhyIndexes;
+  UINT32 *RxInterrupts;
 
   PortIds = PcdGetPtr (PcdPp2PortIds);
   GopIndexes = PcdGetPtr (PcdPp2GopIndexes);
@@ -1302,6 +1531,12 @@ Pp2DxeParsePortPcd (
   Pp2Context->Port.PhyIndex = PhyIndexes[Index];
   Pp2Context->Port.AlwaysUp = AlwaysUp[Index];
   Pp2Context->Port.Speed = Speed[Index];
+
+  /* Optional, ports without an Rx interrupt assigned are polled */
+  RxInterrupts = PcdGetPtr (PcdPp2RxInterrupts);
+  if (PcdGetSize (PcdPp2RxInterrupts) >= (Index + 1) * sizeof (UINT32)) {
+    Pp2Context->RxInterrupt = ReadUnaligned32 (&RxInterrupts[Index]);
+  }
 }
 
 STATIC
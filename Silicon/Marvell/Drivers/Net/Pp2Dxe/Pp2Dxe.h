@@ -8,10 +8,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef __PP2_DXE_H__
 #define __PP2_DXE_H__
 
+#include <Guid/NetPerfCountersAdapterInfo.h>
+
 #include <Protocol/AdapterInformation.h>
 #include <Protocol/Cpu.h>
 #include <Protocol/DevicePath.h>
 #include <Protocol/DriverBinding.h>
+#include <Protocol/HardwareInterrupt.h>
 #include <Protocol/Ip4.h>
 #include <Protocol/Ip6.h>
 #include <Protocol/MvPhy.h>
@@ -29,9 +32,13 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/UefiLib.h>
 
 #include "Mvpp2LibHw.h"
+#include "Pp2RxPoll.h"
 
 #define MVPP2_MAX_PORT  3
 
+/* One SNP instance per entry of the port to controller mapping */
+#define PP2DXE_MAX_INSTANCES  FixedPcdGetSize (PcdPp2Port2Controller)
+
 #define PP2DXE_SIGNATURE                    SIGNATURE_32('P', 'P', '2', 'D')
 #define INSTANCE_FROM_AIP(a)                CR((a), PP2DXE_CONTEXT, Aip, PP2DXE_SIGNATURE)
 #define INSTANCE_FROM_SNP(a)                CR((a), PP2DXE_CONTEXT, Snp, PP2DXE_SIGNATURE)
@@ -341,6 +348,12 @@ typedef struct {
   EFI_EVENT                   EfiExitBootServicesEvent;
   PP2_DEVICE_PATH             *DevicePath;
   EFI_ADAPTER_INFORMATION_PROTOCOL Aip;
+  NET_PERF_COUNTERS_ADAPTER_INFO PerfCounters;
+  UINT64                      RaisedTplTicks;
+  HARDWARE_INTERRUPT_SOURCE   RxInterrupt;
+  BOOLEAN                     RxInterruptEnabled;
+  volatile BOOLEAN            RxPending;
+  UINTN                       RxIdlePolls;
 } PP2DXE_CONTEXT;
 
 /* Inline helpers */
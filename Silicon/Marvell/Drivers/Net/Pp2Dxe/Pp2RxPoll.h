@@ -0,0 +1,47 @@
+/********************************************************************************
+Copyright (C) 2026 Marvell International Ltd.
+
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+*******************************************************************************/
+
+#ifndef __PP2_RX_POLL_H__
+#define __PP2_RX_POLL_H__
+
+#include <Base.h>
+
+/*
+ * With the Rx interrupt armed, Receive only reads the Rx queue once the
+ * interrupt handler flagged it. A lost interrupt would leave the port deaf,
+ * so the queue is polled anyway after this many idle Receive calls.
+ */
+#define PP2DXE_RX_FALLBACK_POLL  64
+
+/*
+ * Decide whether Receive has to read the Rx queue occupancy. Ports without
+ * an Rx interrupt are always polled. Ports with one are polled when the
+ * interrupt is pending, and every PP2DXE_RX_FALLBACK_POLL-th idle call.
+ */
+STATIC
+inline
+BOOLEAN
+Pp2DxeRxPollNeeded (
+  IN     BOOLEAN RxInterruptEnabled,
+  IN     BOOLEAN RxPending,
+  IN OUT UINTN   *RxIdlePolls
+  )
+{
+  if (!RxInterruptEnabled || RxPending) {
+    *RxIdlePolls = 0;
+    return TRUE;
+  }
+
+  if (++(*RxIdlePolls) < PP2DXE_RX_FALLBACK_POLL) {
+    return FALSE;
+  }
+
+  *RxIdlePolls = 0;
+  return TRUE;
+}
+
+#endif
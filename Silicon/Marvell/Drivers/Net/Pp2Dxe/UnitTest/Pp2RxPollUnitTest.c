@@ -0,0 +1,202 @@
+/** @file
+  Host based unit tests of the Pp2Dxe Rx poll decision.
+
+  A port with an armed Rx interrupt must still poll its Rx queue now and
+  then, so that a lost interrupt does not leave it deaf.
+
+  Copyright (C) 2026 Marvell International Ltd.
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/DebugLib.h>
+#include <Library/UnitTestLib.h>
+
+#include "../Pp2RxPoll.h"
+
+#define UNIT_TEST_APP_NAME     "Pp2Dxe Rx Poll Unit Tests"
+#define UNIT_TEST_APP_VERSION  "1.0"
+
+/**
+  A port without an Rx interrupt polls the queue on every call.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+PolledPortTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  IdlePolls;
+  UINTN  Call;
+
+  IdlePolls = 0;
+  for (Call = 0; Call < 2 * PP2DXE_RX_FALLBACK_POLL; Call++) {
+    UT_ASSERT_TRUE (Pp2DxeRxPollNeeded (FALSE, FALSE, &IdlePolls));
+    UT_ASSERT_EQUAL (IdlePolls, 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A pending Rx interrupt polls the queue and restarts the idle count.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+PendingInterruptTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  IdlePolls;
+
+  IdlePolls = PP2DXE_RX_FALLBACK_POLL - 2;
+  UT_ASSERT_TRUE (Pp2DxeRxPollNeeded (TRUE, TRUE, &IdlePolls));
+  UT_ASSERT_EQUAL (IdlePolls, 0);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  With the interrupt armed and nothing pending, the queue is only polled on
+  every PP2DXE_RX_FALLBACK_POLL-th call, over and over.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+FallbackPollTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  IdlePolls;
+  UINTN  Round;
+  UINTN  Call;
+
+  IdlePolls = 0;
+  for (Round = 0; Round < 3; Round++) {
+    for (Call = 1; Call < PP2DXE_RX_FALLBACK_POLL; Call++) {
+      UT_ASSERT_FALSE (Pp2DxeRxPollNeeded (TRUE, FALSE, &IdlePolls));
+    }
+
+    UT_ASSERT_TRUE (Pp2DxeRxPollNeeded (TRUE, FALSE, &IdlePolls));
+    UT_ASSERT_EQUAL (IdlePolls, 0);
+  }
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  An interrupt arriving between fallback polls delays the next fallback poll
+  by a full interval.
+
+  @param[in]  Context    Unused.
+
+  @retval UNIT_TEST_PASSED             The test passed.
+  @retval UNIT_TEST_ERROR_TEST_FAILED  The test failed.
+**/
+STATIC
+UNIT_TEST_STATUS
+EFIAPI
+InterruptRestartsIntervalTest (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINTN  IdlePolls;
+  UINTN  Call;
+
+  IdlePolls = 0;
+  for (Call = 1; Call < PP2DXE_RX_FALLBACK_POLL / 2; Call++) {
+    UT_ASSERT_FALSE (Pp2DxeRxPollNeeded (TRUE, FALSE, &IdlePolls));
+  }
+
+  UT_ASSERT_TRUE (Pp2DxeRxPollNeeded (TRUE, TRUE, &IdlePolls));
+
+  for (Call = 1; Call < PP2DXE_RX_FALLBACK_POLL; Call++) {
+    UT_ASSERT_FALSE (Pp2DxeRxPollNeeded (TRUE, FALSE, &IdlePolls));
+  }
+
+  UT_ASSERT_TRUE (Pp2DxeRxPollNeeded (TRUE, FALSE, &IdlePolls));
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialize the unit test framework, suite, and unit tests for the Rx poll
+  decision and run them.
+
+  @retval EFI_SUCCESS           All test cases were dispatched.
+  @retval EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      RxPollSuite;
+
+  Framework = NULL;
+
+  DEBUG ((DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION));
+
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  Status = CreateUnitTestSuite (&RxPollSuite, Framework, "Rx Poll Tests", "Marvell.Pp2Dxe.RxPoll", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for Rx poll tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  AddTestCase (RxPollSuite, "Port without Rx interrupt always polls", "Polled", PolledPortTest, NULL, NULL, NULL);
+  AddTestCase (RxPollSuite, "Pending Rx interrupt polls", "Pending", PendingInterruptTest, NULL, NULL, NULL);
+  AddTestCase (RxPollSuite, "Lost Rx interrupt is covered by the fallback poll", "Fallback", FallbackPollTest, NULL, NULL, NULL);
+  AddTestCase (RxPollSuite, "Rx interrupt restarts the fallback interval", "Restart", InterruptRestartsIntervalTest, NULL, NULL, NULL);
+
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework != NULL) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+**/
+int
+main (
+  int   argc,
+  char  *argv[]
+  )
+{
+  return UnitTestingEntry ();
+}
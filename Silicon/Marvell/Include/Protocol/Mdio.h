@@ -32,11 +32,47 @@ EFI_STATUS
   IN UINT32 Data
   );
 
+typedef enum {
+  MdioOpRead,     /* Data = register value */
+  MdioOpWrite,    /* register = Data */
+  MdioOpModify,   /* register = (register & ~Mask) | Data */
+  MdioOpDelay     /* stall for Data microseconds */
+} MARVELL_MDIO_OP_TYPE;
+
+typedef struct {
+  MARVELL_MDIO_OP_TYPE Type;
+  UINT32 RegOff;
+  UINT32 Data;
+  UINT32 Mask;
+} MARVELL_MDIO_OP;
+
+#define MDIO_OP_READ(Reg)               { MdioOpRead, (Reg), 0, 0 }
+#define MDIO_OP_WRITE(Reg, Val)         { MdioOpWrite, (Reg), (Val), 0 }
+#define MDIO_OP_MODIFY(Reg, Msk, Val)   { MdioOpModify, (Reg), (Val), (Msk) }
+#define MDIO_OP_DELAY(Usec)             { MdioOpDelay, 0, (Usec), 0 }
+
+/*
+ * Execute OpCount operations on a single PHY back to back. The bus is
+ * checked for being idle once, after which every operation waits only for
+ * its own completion. Read results are stored in the Data field of the
+ * operation. Processing stops at the first failing operation.
+ */
+typedef
+EFI_STATUS
+(EFIAPI *MARVELL_MDIO_TRANSFER) (
+  IN CONST MARVELL_MDIO_PROTOCOL *This,
+  IN UINT32 PhyAddr,
+  IN UINT32 MdioIndex,
+  IN OUT MARVELL_MDIO_OP *Ops,
+  IN UINTN OpCount
+  );
+
 struct _MARVELL_MDIO_PROTOCOL {
   MARVELL_MDIO_READ Read;
   MARVELL_MDIO_WRITE Write;
   UINTN *BaseAddresses;
   UINTN ControllerCount;
+  MARVELL_MDIO_TRANSFER Transfer;
 };
 
 extern EFI_GUID gMarvellMdioProtocolGuid;
@@ -640,6 +640,8 @@ SnpGetStatus (
   // Find the LanDriver structure
   LanDriver = INSTANCE_FROM_SNP_THIS (Snp);
 
+  LanDriver->PerfCounters.StatusPolls++;
+
   ogma_err = ogma_clean_tx_desc_ring (LanDriver->Handle,
                                       OGMA_DESC_RING_ID_NRM_TX);
 
@@ -700,6 +702,7 @@ SnpTransmit (
   ogma_err_t          ogma_err;
   UINT16              Proto;
   pfdep_pkt_handle_t  pkt_handle;
+  UINT64              TplTicks;
 
   // Check preliminaries
   if ((Snp == NULL) || (BufAddr == NULL)) {
@@ -716,8 +719,12 @@ SnpTransmit (
   pkt_handle->Buffer = BufAddr;
   pkt_handle->RecycleForTx = TRUE;
 
+  // Find the LanDriver structure
+  LanDriver = INSTANCE_FROM_SNP_THIS (Snp);
+
   // Serialize access to data and registers
   SavedTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  TplTicks = GetPerformanceCounter ();
 
   // Check that driver was started and initialised
   switch (Snp->Mode->State) {
@@ -735,28 +742,6 @@ SnpTransmit (
     ReturnUnlock (EFI_DEVICE_ERROR);
   }
 
-  // Find the LanDriver structure
-  LanDriver = INSTANCE_FROM_SNP_THIS (Snp);
-
-  ogma_err = ogma_clear_desc_ring_irq_status (LanDriver->Handle,
-                                              OGMA_DESC_RING_ID_NRM_TX,
-                                              OGMA_CH_IRQ_REG_EMPTY);
-  if (ogma_err != OGMA_ERR_OK) {
-    DEBUG ((DEBUG_ERROR,
-      "NETSEC: ogma_clear_desc_ring_irq_status failed with error code: %d\n",
-      (INT32)ogma_err));
-    ReturnUnlock (EFI_DEVICE_ERROR);
-  }
-
-  ogma_err = ogma_clean_tx_desc_ring (LanDriver->Handle,
-                                      OGMA_DESC_RING_ID_NRM_TX);
-  if (ogma_err != OGMA_ERR_OK) {
-    DEBUG ((DEBUG_ERROR,
-      "NETSEC: ogma_clean_tx_desc_ring failed with error code: %d\n",
-      (INT32)ogma_err));
-    ReturnUnlock (EFI_DEVICE_ERROR);
-  }
-
   // Ensure header is correct size if non-zero
   if (HdrSize) {
     if (HdrSize != Snp->Mode->MediaHeaderSize) {
@@ -794,6 +779,7 @@ SnpTransmit (
   if (EFI_ERROR (Status)) {
     goto ExitUnlock;
   }
+  LanDriver->PerfCounters.DmaMaps++;
 
   scat_info.addr        = BufAddr;
   scat_info.len         = BufSize;
@@ -803,11 +789,35 @@ SnpTransmit (
   tx_pkt_ctrl.pass_through_flag     = OGMA_TRUE;
   tx_pkt_ctrl.target_desc_ring_id   = OGMA_DESC_RING_ID_GMAC;
 
-  // check empty slot
-  do {
+  //
+  // Only reclaim completed descriptors once the TX ring runs out of free
+  // slots, so that back-to-back transmits are queued to the hardware without
+  // touching the completion registers for every single packet. Completed
+  // buffers are also reclaimed by SnpGetStatus () and SnpReceive ().
+  //
+  for (;;) {
     tx_avail_num = ogma_get_tx_avail_num (LanDriver->Handle,
                                           OGMA_DESC_RING_ID_NRM_TX);
-  } while (tx_avail_num < SCAT_NUM);
+    if (tx_avail_num >= SCAT_NUM) {
+      break;
+    }
+
+    LanDriver->PerfCounters.PollIterations++;
+
+    ogma_clear_desc_ring_irq_status (LanDriver->Handle,
+                                     OGMA_DESC_RING_ID_NRM_TX,
+                                     OGMA_CH_IRQ_REG_EMPTY);
+
+    ogma_err = ogma_clean_tx_desc_ring (LanDriver->Handle,
+                                        OGMA_DESC_RING_ID_NRM_TX);
+    if (ogma_err != OGMA_ERR_OK) {
+      DmaUnmap (pkt_handle->Mapping);
+      DEBUG ((DEBUG_ERROR,
+        "NETSEC: ogma_clean_tx_desc_ring failed with error code: %d\n",
+        (INT32)ogma_err));
+      ReturnUnlock (EFI_DEVICE_ERROR);
+    }
+  }
 
   // send
   ogma_err = ogma_set_tx_pkt_data (LanDriver->Handle,
@@ -832,12 +842,21 @@ SnpTransmit (
   //
   InsertTailList (&LanDriver->TxBufferList, &pkt_handle->Link);
 
+  LanDriver->PerfCounters.TxPackets++;
+  LanDriver->PerfCounters.TxRingOccupancySum +=
+    FixedPcdGet16 (PcdEncTxDescNum) - tx_avail_num + SCAT_NUM;
+  LanDriver->PerfCounters.TxRingOccupancyMax =
+    MAX (LanDriver->PerfCounters.TxRingOccupancyMax,
+         (UINT64)(FixedPcdGet16 (PcdEncTxDescNum) - tx_avail_num + SCAT_NUM));
+
+  LanDriver->RaisedTplTicks += GetPerformanceCounter () - TplTicks;
   gBS->RestoreTPL (SavedTpl);
   return EFI_SUCCESS;
 
   // Restore TPL and return
 ExitUnlock:
   FreePool (pkt_handle);
+  LanDriver->RaisedTplTicks += GetPerformanceCounter () - TplTicks;
   gBS->RestoreTPL (SavedTpl);
   return Status;
 }
@@ -866,14 +885,19 @@ SnpReceive (
   ogma_frag_info_t    rx_data;
   ogma_uint16         len;
   pfdep_pkt_handle_t  pkt_handle;
+  UINT64              TplTicks;
 
   // Check preliminaries
   if ((Snp == NULL) || (Data == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
+  // Find the LanDriver structure
+  LanDriver = INSTANCE_FROM_SNP_THIS (Snp);
+
   // Serialize access to data and registers
   SavedTpl = gBS->RaiseTPL (TPL_CALLBACK);
+  TplTicks = GetPerformanceCounter ();
 
   // Check that driver was started and initialised
   switch (Snp->Mode->State) {
@@ -891,8 +915,7 @@ SnpReceive (
     ReturnUnlock (EFI_DEVICE_ERROR);
   }
 
-  // Find the LanDriver structure
-  LanDriver = INSTANCE_FROM_SNP_THIS (Snp);
+  LanDriver->PerfCounters.RxPolls++;
 
   if (ogma_get_rx_num (LanDriver->Handle, OGMA_DESC_RING_ID_NRM_RX) > 0) {
 
@@ -906,12 +929,24 @@ SnpReceive (
       ReturnUnlock (EFI_DEVICE_ERROR);
     }
 
-    DmaUnmap (pkt_handle->Mapping);
-    pkt_handle->Mapping = NULL;
+    //
+    // Buffers taken from the persistent RX pool stay mapped for the lifetime
+    // of the driver, and are handed back to the pool by pfdep_free_pkt_buf ()
+    // below. Only buffers allocated outside of the pool need to be unmapped
+    // before the CPU may access their contents.
+    //
+    if (!pkt_handle->Persistent) {
+      DmaUnmap (pkt_handle->Mapping);
+      pkt_handle->Mapping = NULL;
+    }
 
     CopyMem (Data, (VOID *)rx_data.addr, len);
     *BuffSize = len;
 
+    LanDriver->PerfCounters.RxPackets++;
+    LanDriver->PerfCounters.Copies++;
+    LanDriver->PerfCounters.CopyBytes += len;
+
     pfdep_free_pkt_buf (LanDriver->Handle, rx_data.len, rx_data.addr,
       rx_data.phys_addr, PFDEP_TRUE, pkt_handle);
   } else {
@@ -936,6 +971,7 @@ SnpReceive (
 
   // Restore TPL and return
 ExitUnlock:
+  LanDriver->RaisedTplTicks += GetPerformanceCounter () - TplTicks;
   gBS->RestoreTPL (SavedTpl);
   return Status;
 }
@@ -950,14 +986,23 @@ NetsecAipGetInformation (
   OUT UINTN                             *InformationBlockSize
   )
 {
-  EFI_ADAPTER_INFO_MEDIA_STATE  *AdapterInfo;
-  NETSEC_DRIVER                 *LanDriver;
+  EFI_ADAPTER_INFO_MEDIA_STATE    *AdapterInfo;
+  NETSEC_DRIVER                   *LanDriver;
+  EFI_STATUS                      Status;
 
   if (This == NULL || InformationBlock == NULL ||
       InformationBlockSize == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  LanDriver = INSTANCE_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipGetInformation (InformationType, &LanDriver->PerfCounters,
+             LanDriver->RaisedTplTicks, InformationBlock, InformationBlockSize);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (!CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_UNSUPPORTED;
   }
@@ -970,7 +1015,6 @@ NetsecAipGetInformation (
   *InformationBlock = AdapterInfo;
   *InformationBlockSize = sizeof (EFI_ADAPTER_INFO_MEDIA_STATE);
 
-  LanDriver = INSTANCE_FROM_AIP_THIS (This);
   if (LanDriver->Snp.Mode->MediaPresent) {
     AdapterInfo->MediaState = EFI_SUCCESS;
   } else {
@@ -990,10 +1034,21 @@ NetsecAipSetInformation (
   IN  UINTN                             InformationBlockSize
   )
 {
+  NETSEC_DRIVER   *LanDriver;
+  EFI_STATUS      Status;
+
   if (This == NULL || InformationBlock == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
+  LanDriver = INSTANCE_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipSetInformation (InformationType, &LanDriver->PerfCounters,
+             &LanDriver->RaisedTplTicks);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
     return EFI_WRITE_PROTECTED;
   }
@@ -1010,24 +1065,12 @@ NetsecAipGetSupportedTypes (
   OUT UINTN                             *InfoTypesBufferCount
   )
 {
-  EFI_GUID    *Guid;
-
   if (This == NULL || InfoTypesBuffer == NULL ||
       InfoTypesBufferCount == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  Guid = AllocatePool (sizeof *Guid);
-  if (Guid == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  CopyGuid (Guid, &gEfiAdapterInfoMediaStateGuid);
-
-  *InfoTypesBuffer      = Guid;
-  *InfoTypesBufferCount = 1;
-
-  return EFI_SUCCESS;
+  return NetPerfAipGetSupportedTypes (InfoTypesBuffer, InfoTypesBufferCount);
 }
 
 EFI_STATUS
@@ -1121,8 +1164,8 @@ NetsecInit (
   // Mac address is changeable
   SnpMode->MacAddressChangeable = TRUE;
 
-  // We can only transmit one packet at a time
-  SnpMode->MultipleTxSupported = FALSE;
+  // Up to PcdEncTxDescNum packets may be queued on the TX ring at a time
+  SnpMode->MultipleTxSupported = TRUE;
 
   // MediaPresent checks for cable connection and partner link
   SnpMode->MediaPresentSupported = TRUE;
@@ -1151,6 +1194,7 @@ NetsecInit (
     DEBUG ((DEBUG_ERROR, "%a: InstallMultipleProtocolInterfaces failed - %r\n",
       __FUNCTION__, Status));
     ogma_terminate (LanDriver->Handle);
+    pfdep_release_pkt_pool ();
     goto CloseDeviceProtocol;
   }
   return EFI_SUCCESS;
@@ -1198,6 +1242,7 @@ NetsecRelease (
   }
 
   ogma_terminate (LanDriver->Handle);
+  pfdep_release_pkt_pool ();
 
   gBS->CloseEvent (LanDriver->ExitBootEvent);
 
@@ -10,6 +10,7 @@
 #ifndef __NETSEC_DXE_H_
 #define __NETSEC_DXE_H_
 
+#include <Guid/NetPerfCountersAdapterInfo.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/DevicePathLib.h>
@@ -17,6 +18,8 @@
 #include <Library/IoLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
+#include <Library/NetPerfAdapterInfoLib.h>
+#include <Library/TimerLib.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/UefiLib.h>
 
@@ -65,6 +68,10 @@ typedef struct {
   EFI_EVENT                         PhyStatusEvent;
 
   NON_DISCOVERABLE_DEVICE           *Dev;
+
+  // Data path performance counters, exposed via the Aip
+  NET_PERF_COUNTERS_ADAPTER_INFO    PerfCounters;
+  UINT64                            RaisedTplTicks;
 } NETSEC_DRIVER;
 
 #define NETSEC_SIGNATURE            SIGNATURE_32('n', 't', 's', 'c')
@@ -55,11 +55,13 @@ typedef enum pfdep_err_e {
 
 
 typedef struct {
-    LIST_ENTRY  Link;
-    VOID        *Buffer;
-    VOID        *Mapping;
-    BOOLEAN     RecycleForTx;
-    BOOLEAN     Released;
+    LIST_ENTRY            Link;
+    VOID                  *Buffer;
+    VOID                  *Mapping;
+    EFI_PHYSICAL_ADDRESS  PhysAddr;
+    BOOLEAN               RecycleForTx;
+    BOOLEAN               Released;
+    BOOLEAN               Persistent;
 } PACKET_HANDLE;
 
 typedef VOID *pfdep_dev_handle_t;
@@ -143,6 +145,10 @@ void pfdep_free_pkt_buf (
     pfdep_pkt_handle_t pkt_handle
     );
 
+void pfdep_release_pkt_pool (
+    void
+    );
+
 static __inline pfdep_err_t pfdep_init_hard_lock(pfdep_hard_lock_t *hard_lock_p)
 {
     (void)hard_lock_p; /* suppress compiler warning */
@@ -13,7 +13,6 @@
 #include <Library/DmaLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
-#include <Library/SynchronizationLib.h>
 
 /**********************************************************************
  * Variable definitions
@@ -96,14 +95,109 @@ pfdep_dma_free (
 }
 
 //
-// On the receive path, we allocate a new packet and link it into the RX ring
-// before returning the received packet to the caller. This means we perform
-// one allocation and one free operation for each buffer received.
-// So let's cache a single packet, and get rid of most of the alloc/free
-// overhead on the RX path.
+// The receive ring is refilled with a fresh packet buffer every time a packet
+// is taken off it, and the SDK returns every buffer it is done with through
+// pfdep_free_pkt_buf (). Rather than allocating, mapping, unmapping and freeing
+// a buffer for each received packet, carve the packet buffers out of DMA-able
+// chunks that are mapped once as common buffers, and keep the spare buffers on
+// a free list. In the steady state, the RX path performs no allocations and no
+// DMA map/unmap operations at all.
 //
-STATIC pfdep_pkt_handle_t mSparePacketBuffer;
-STATIC UINT32 mSparePacketBufferSize;
+#define PKT_POOL_CHUNK_BUFFERS      32
+
+typedef struct {
+  LIST_ENTRY            Link;
+  VOID                  *Base;
+  UINTN                 NumPages;
+  VOID                  *Mapping;
+  PACKET_HANDLE         Handles[PKT_POOL_CHUNK_BUFFERS];
+} PKT_POOL_CHUNK;
+
+STATIC LIST_ENTRY mPktPoolChunks = INITIALIZE_LIST_HEAD_VARIABLE (mPktPoolChunks);
+STATIC LIST_ENTRY mPktPoolFreeList = INITIALIZE_LIST_HEAD_VARIABLE (mPktPoolFreeList);
+STATIC UINT32     mPktPoolBufferSize;
+
+STATIC
+pfdep_err_t
+PktPoolGrow (
+  IN  UINT32                    len
+  )
+{
+  EFI_STATUS            Status;
+  PKT_POOL_CHUNK        *Chunk;
+  EFI_PHYSICAL_ADDRESS  DeviceAddress;
+  UINTN                 Stride;
+  UINTN                 NumBytes;
+  UINTN                 Index;
+
+  Stride = ALIGN_VALUE (len, mCpu->DmaBufferAlignment);
+
+  Chunk = AllocateZeroPool (sizeof *Chunk);
+  if (Chunk == NULL) {
+    return PFDEP_ERR_ALLOC;
+  }
+
+  Chunk->NumPages = EFI_SIZE_TO_PAGES (Stride * PKT_POOL_CHUNK_BUFFERS);
+  Status = DmaAllocateBuffer (EfiBootServicesData, Chunk->NumPages,
+             &Chunk->Base);
+  if (EFI_ERROR (Status)) {
+    goto FreeChunk;
+  }
+
+  NumBytes = EFI_PAGES_TO_SIZE (Chunk->NumPages);
+  Status = DmaMap (MapOperationBusMasterCommonBuffer, Chunk->Base, &NumBytes,
+             &DeviceAddress, &Chunk->Mapping);
+  if (EFI_ERROR (Status)) {
+    goto FreeBuffer;
+  }
+  if (NumBytes < Stride * PKT_POOL_CHUNK_BUFFERS) {
+    DmaUnmap (Chunk->Mapping);
+    goto FreeBuffer;
+  }
+
+  for (Index = 0; Index < PKT_POOL_CHUNK_BUFFERS; Index++) {
+    Chunk->Handles[Index].Buffer     = (UINT8 *)Chunk->Base + Index * Stride;
+    Chunk->Handles[Index].PhysAddr   = DeviceAddress + Index * Stride;
+    Chunk->Handles[Index].Persistent = TRUE;
+    InsertTailList (&mPktPoolFreeList, &Chunk->Handles[Index].Link);
+  }
+
+  InsertTailList (&mPktPoolChunks, &Chunk->Link);
+  return PFDEP_ERR_OK;
+
+FreeBuffer:
+  DmaFreeBuffer (Chunk->NumPages, Chunk->Base);
+
+FreeChunk:
+  FreePool (Chunk);
+  return PFDEP_ERR_ALLOC;
+}
+
+/**
+  Release all packet buffers owned by the persistent packet pool. This must
+  only be called after all buffers have been returned to the pool, i.e., after
+  the descriptor rings have been torn down by ogma_terminate ().
+
+**/
+VOID
+pfdep_release_pkt_pool (
+  VOID
+  )
+{
+  PKT_POOL_CHUNK        *Chunk;
+
+  while (!IsListEmpty (&mPktPoolChunks)) {
+    Chunk = BASE_CR (GetFirstNode (&mPktPoolChunks), PKT_POOL_CHUNK, Link);
+    RemoveEntryList (&Chunk->Link);
+
+    DmaUnmap (Chunk->Mapping);
+    DmaFreeBuffer (Chunk->NumPages, Chunk->Base);
+    FreePool (Chunk);
+  }
+
+  InitializeListHead (&mPktPoolFreeList);
+  mPktPoolBufferSize = 0;
+}
 
 pfdep_err_t
 pfdep_alloc_pkt_buf (
@@ -116,22 +210,42 @@ pfdep_alloc_pkt_buf (
 {
   EFI_STATUS    Status;
   UINTN         NumBytes;
+  LIST_ENTRY    *Link;
 
-  NumBytes = ALIGN_VALUE (len, mCpu->DmaBufferAlignment);
+  //
+  // All RX buffers are allocated with the same size, so the first request
+  // determines the size of the buffers in the pool.
+  //
+  if (mPktPoolBufferSize == 0) {
+    mPktPoolBufferSize = len;
+  }
 
-  if (InterlockedCompareExchange32 (&mSparePacketBufferSize, len, 0) == len) {
-    *pkt_handle_p = mSparePacketBuffer;
-  } else {
-    *pkt_handle_p = AllocateZeroPool (NumBytes + sizeof(PACKET_HANDLE) +
-                                      (mCpu->DmaBufferAlignment - 8));
-    if (*pkt_handle_p == NULL) {
+  if (len == mPktPoolBufferSize) {
+    if (IsListEmpty (&mPktPoolFreeList) &&
+        PktPoolGrow (len) != PFDEP_ERR_OK) {
       return PFDEP_ERR_ALLOC;
     }
 
-    (*pkt_handle_p)->Buffer = ALIGN_POINTER (*pkt_handle_p + 1,
-                                             mCpu->DmaBufferAlignment);
+    Link = GetFirstNode (&mPktPoolFreeList);
+    RemoveEntryList (Link);
+
+    *pkt_handle_p = BASE_CR (Link, PACKET_HANDLE, Link);
+    *addr_p       = (*pkt_handle_p)->Buffer;
+    *phys_addr_p  = (*pkt_handle_p)->PhysAddr;
+    return PFDEP_ERR_OK;
+  }
+
+  NumBytes = ALIGN_VALUE (len, mCpu->DmaBufferAlignment);
+
+  *pkt_handle_p = AllocateZeroPool (NumBytes + sizeof(PACKET_HANDLE) +
+                                    (mCpu->DmaBufferAlignment - 8));
+  if (*pkt_handle_p == NULL) {
+    return PFDEP_ERR_ALLOC;
   }
 
+  (*pkt_handle_p)->Buffer = ALIGN_POINTER (*pkt_handle_p + 1,
+                                           mCpu->DmaBufferAlignment);
+
   *addr_p = (*pkt_handle_p)->Buffer;
   Status = DmaMap (MapOperationBusMasterWrite, *addr_p, &NumBytes, phys_addr_p,
              &(*pkt_handle_p)->Mapping);
@@ -156,14 +270,22 @@ pfdep_free_pkt_buf (
     return;
   }
 
+  //
+  // Put pool buffers back at the head of the free list, so that the most
+  // recently used (and therefore most likely cache hot) buffer is handed out
+  // first.
+  //
+  if (pkt_handle->Persistent) {
+    InsertHeadList (&mPktPoolFreeList, &pkt_handle->Link);
+    return;
+  }
+
   if (pkt_handle->Mapping != NULL) {
     DmaUnmap (pkt_handle->Mapping);
   }
 
   if (pkt_handle->RecycleForTx) {
       pkt_handle->Released = TRUE;
-  } else if (!InterlockedCompareExchange32 (&mSparePacketBufferSize, 0, len)) {
-    mSparePacketBuffer = pkt_handle;
   } else {
     FreePool (pkt_handle);
   }
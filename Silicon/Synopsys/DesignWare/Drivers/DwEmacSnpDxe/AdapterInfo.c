@@ -0,0 +1,116 @@
+/** @file
+
+  Copyright (c) 2026, Arm Limited. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DwEmacSnpDxe.h"
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/NetPerfAdapterInfoLib.h>
+
+STATIC
+EFI_STATUS
+EFIAPI
+DwEmacAipGetInformation (
+  IN  EFI_ADAPTER_INFORMATION_PROTOCOL  *This,
+  IN  EFI_GUID                          *InformationType,
+  OUT VOID                              **InformationBlock,
+  OUT UINTN                             *InformationBlockSize
+  )
+{
+  EFI_ADAPTER_INFO_MEDIA_STATE    *AdapterInfo;
+  SIMPLE_NETWORK_DRIVER           *Snp;
+  EFI_STATUS                      Status;
+
+  if (This == NULL || InformationBlock == NULL ||
+      InformationBlockSize == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Snp = INSTANCE_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipGetInformation (InformationType, &Snp->PerfCounters,
+             Snp->RaisedTplTicks, InformationBlock, InformationBlockSize);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
+  if (!CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  AdapterInfo = AllocateZeroPool (sizeof (EFI_ADAPTER_INFO_MEDIA_STATE));
+  if (AdapterInfo == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  *InformationBlock = AdapterInfo;
+  *InformationBlockSize = sizeof (EFI_ADAPTER_INFO_MEDIA_STATE);
+
+  if (Snp->SnpMode.MediaPresent) {
+    AdapterInfo->MediaState = EFI_SUCCESS;
+  } else {
+    AdapterInfo->MediaState = EFI_NOT_READY;
+  }
+
+  return EFI_SUCCESS;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+DwEmacAipSetInformation (
+  IN  EFI_ADAPTER_INFORMATION_PROTOCOL  *This,
+  IN  EFI_GUID                          *InformationType,
+  IN  VOID                              *InformationBlock,
+  IN  UINTN                             InformationBlockSize
+  )
+{
+  SIMPLE_NETWORK_DRIVER  *Snp;
+  EFI_STATUS             Status;
+
+  if (This == NULL || InformationBlock == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  Snp = INSTANCE_FROM_AIP_THIS (This);
+
+  Status = NetPerfAipSetInformation (InformationType, &Snp->PerfCounters,
+             &Snp->RaisedTplTicks);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
+  if (CompareGuid (InformationType, &gEfiAdapterInfoMediaStateGuid)) {
+    return EFI_WRITE_PROTECTED;
+  }
+
+  return EFI_UNSUPPORTED;
+}
+
+STATIC
+EFI_STATUS
+EFIAPI
+DwEmacAipGetSupportedTypes (
+  IN  EFI_ADAPTER_INFORMATION_PROTOCOL  *This,
+  OUT EFI_GUID                          **InfoTypesBuffer,
+  OUT UINTN                             *InfoTypesBufferCount
+  )
+{
+  if (This == NULL || InfoTypesBuffer == NULL ||
+      InfoTypesBufferCount == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  return NetPerfAipGetSupportedTypes (InfoTypesBuffer, InfoTypesBufferCount);
+}
+
+CONST EFI_ADAPTER_INFORMATION_PROTOCOL gDwEmacAdapterInfoTemplate = {
+  DwEmacAipGetInformation,
+  DwEmacAipSetInformation,
+  DwEmacAipGetSupportedTypes,
+};
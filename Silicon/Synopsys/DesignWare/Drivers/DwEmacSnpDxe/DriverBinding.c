@@ -192,6 +192,12 @@ DriverStart (
 
   EfiInitializeLock (&Snp->Lock, TPL_CALLBACK);
 
+  // The driver data lives in uninitialised pages
+  ZeroMem (&Snp->PerfCounters, sizeof (Snp->PerfCounters));
+  Snp->RaisedTplTicks = 0;
+
+  CopyMem (&Snp->Aip, &gDwEmacAdapterInfoTemplate, sizeof (Snp->Aip));
+
   // Initialize pointers
   SnpMode = &Snp->SnpMode;
   Snp->Snp.Mode = SnpMode;
@@ -281,6 +287,7 @@ DriverStart (
   Status = gBS->InstallMultipleProtocolInterfaces (
                   &Controller,
                   &gEfiSimpleNetworkProtocolGuid, &(Snp->Snp),
+                  &gEfiAdapterInformationProtocolGuid, &(Snp->Aip),
                   &gEfiDevicePathProtocolGuid, DevicePath,
                   NULL
                   );
@@ -329,6 +336,8 @@ DriverStop (
                   Controller,
                   &gEfiSimpleNetworkProtocolGuid,
                   &Snp->Snp,
+                  &gEfiAdapterInformationProtocolGuid,
+                  &Snp->Aip,
                   NULL);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a (): UninstallMultipleProtocolInterfaces: %r\n", __FUNCTION__, Status));
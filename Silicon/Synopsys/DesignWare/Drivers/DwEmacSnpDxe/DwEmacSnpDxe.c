@@ -20,6 +20,7 @@
 #include <Library/MemoryAllocationLib.h>
 #include <Library/NetLib.h>
 #include <Library/DmaLib.h>
+#include <Library/TimerLib.h>
 
 /**
   Change the state of a network interface from "stopped" to "started."
@@ -827,6 +828,8 @@ SnpGetStatus (
     return EFI_NOT_STARTED;
   }
 
+  Snp->PerfCounters.StatusPolls++;
+
   // Update the media status
   Status = PhyLinkAdjustEmacConfig (&Snp->PhyDriver, Snp->MacBase);
   if (EFI_ERROR(Status)) {
@@ -929,6 +932,7 @@ SnpTransmit (
   EFI_STATUS                 Status;
   UINTN                      BufferSizeBuf;
   EFI_PHYSICAL_ADDRESS       TxBufferAddrMap;
+  UINT64                     LockTicks;
 
   BufferSizeBuf = ETH_BUFSIZE;
   EthernetPacket = Data;
@@ -938,17 +942,21 @@ SnpTransmit (
   if (EFI_ERROR (EfiAcquireLockOrFail (&Snp->Lock))) {
     return EFI_ACCESS_DENIED;
   }
+  LockTicks = GetPerformanceCounter ();
 
   if ((Snp->MaxRecycledTxBuf + SNP_TX_BUFFER_INCREASE) >= SNP_MAX_TX_BUFFER_NUM) {
-    return EFI_NOT_READY;
+    Status = EFI_NOT_READY;
+    goto ReleaseLock;
   }
 
   // Check preliminaries
   if ((This == NULL) || (Data == NULL)) {
-    return EFI_INVALID_PARAMETER;
+    Status = EFI_INVALID_PARAMETER;
+    goto ReleaseLock;
   }
   if (Snp->SnpMode.State != EfiSimpleNetworkInitialized) {
-    return EFI_NOT_STARTED;
+    Status = EFI_NOT_STARTED;
+    goto ReleaseLock;
   }
 
   Snp->MacDriver.TxCurrentDescriptorNum = Snp->MacDriver.TxNextDescriptorNum;
@@ -960,17 +968,20 @@ SnpTransmit (
   // Ensure header is correct size if non-zero
   if (HdrSize) {
     if (HdrSize != Snp->SnpMode.MediaHeaderSize) {
-      return EFI_INVALID_PARAMETER;
+      Status = EFI_INVALID_PARAMETER;
+      goto ReleaseLock;
     }
 
     if ((DstAddr == NULL) || (Protocol == NULL)) {
-      return EFI_INVALID_PARAMETER;
+      Status = EFI_INVALID_PARAMETER;
+      goto ReleaseLock;
     }
   }
 
   // Ensure buffer size is valid
   if (BuffSize < Snp->SnpMode.MediaHeaderSize) {
-    return EFI_BUFFER_TOO_SMALL;
+    Status = EFI_BUFFER_TOO_SMALL;
+    goto ReleaseLock;
   }
 
   if (HdrSize) {
@@ -998,10 +1009,14 @@ SnpTransmit (
              &BufferSizeBuf, &TxBufferAddrMap, &Snp->MappingTxbuf);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a () for Txbuffer: %r\n", __FUNCTION__, Status));
-    return Status;
+    goto ReleaseLock;
   }
   TxDescriptorMap->Addr = TxBufferAddrMap;
 
+  Snp->PerfCounters.Copies++;
+  Snp->PerfCounters.CopyBytes += BuffSize;
+  Snp->PerfCounters.DmaMaps++;
+
   TxDescriptor->Tdes1 = (BuffSize << TDES1_SIZE1SHFT) &
                          TDES1_SIZE1MASK;
 
@@ -1024,7 +1039,8 @@ SnpTransmit (
   } else {
     Tmp = AllocatePool (sizeof (UINT64) * (Snp->MaxRecycledTxBuf + SNP_TX_BUFFER_INCREASE));
     if (Tmp == NULL) {
-      return EFI_DEVICE_ERROR;
+      Status = EFI_DEVICE_ERROR;
+      goto ReleaseLock;
     }
     CopyMem (Tmp, Snp->RecycledTxBuf, sizeof (UINT64) * Snp->RecycledTxBufCount);
     FreePool (Snp->RecycledTxBuf);
@@ -1036,8 +1052,14 @@ SnpTransmit (
   EmacDmaStart (Snp->MacBase);
 
   DmaUnmap (Snp->MappingTxbuf);
+
+  Snp->PerfCounters.TxPackets++;
+  Status = EFI_SUCCESS;
+
+ReleaseLock:
+  Snp->RaisedTplTicks += GetPerformanceCounter () - LockTicks;
   EfiReleaseLock (&Snp->Lock);
-  return EFI_SUCCESS;
+  return Status;
 }
 
 /**
@@ -1114,6 +1136,7 @@ SnpReceive (
   UINTN                      *RxBufferAddr;
   EFI_PHYSICAL_ADDRESS       RxBufferAddrMap;
   EFI_STATUS                 Status;
+  UINT64                     LockTicks;
 
   BufferSizeBuf = ETH_BUFSIZE;
 
@@ -1131,6 +1154,9 @@ SnpReceive (
   if (EFI_ERROR (EfiAcquireLockOrFail (&Snp->Lock))) {
     return EFI_ACCESS_DENIED;
   }
+  LockTicks = GetPerformanceCounter ();
+
+  Snp->PerfCounters.RxPolls++;
 
   Snp->MacDriver.RxCurrentDescriptorNum = Snp->MacDriver.RxNextDescriptorNum;
   DescNum = Snp->MacDriver.RxCurrentDescriptorNum;
@@ -1143,17 +1169,20 @@ SnpReceive (
 
   DescriptorStatus = RxDescriptor->Tdes0;
   if (DescriptorStatus & ((UINT32)RDES0_OWN)) {
+    Status = EFI_NOT_READY;
     goto ReleaseLock;
   }
 
   if (DescriptorStatus & RDES0_SAF) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: Source Address Filter Fail\n"));
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto ReleaseLock;
   }
 
   if (DescriptorStatus & RDES0_AFM) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: Destination Address Filter Fail\n"));
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto ReleaseLock;
   }
 
   if (DescriptorStatus & RDES0_ES) {
@@ -1187,18 +1216,21 @@ SnpReceive (
     if (DescriptorStatus & RDES0_CE) {
       DEBUG ((DEBUG_WARN, "SNP:DXE: Rx Descritpor Status Error: CRC Error\n"));
     }
-    return EFI_DEVICE_ERROR;
+    Status = EFI_DEVICE_ERROR;
+    goto ReleaseLock;
   }
 
   Length = (DescriptorStatus >> RDES0_FL_SHIFT) & RDES0_FL_MASK;
   if (!Length) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Error: Invalid Frame Packet length \r\n"));
-    return EFI_NOT_READY;
+    Status = EFI_NOT_READY;
+    goto ReleaseLock;
   }
   // Check buffer size
   if (*BuffSize < Length) {
     DEBUG ((DEBUG_WARN, "SNP:DXE: Error: Buffer size is too small\n"));
-    return EFI_BUFFER_TOO_SMALL;
+    Status = EFI_BUFFER_TOO_SMALL;
+    goto ReleaseLock;
   }
   *BuffSize = Length;
 
@@ -1210,6 +1242,10 @@ SnpReceive (
 
   CopyMem (RawData, (VOID *)RxBufferAddr, *BuffSize);
 
+  Snp->PerfCounters.RxPackets++;
+  Snp->PerfCounters.Copies++;
+  Snp->PerfCounters.CopyBytes += *BuffSize;
+
   if (DstAddr != NULL) {
     Dst.Addr[0] = RawData[0];
     Dst.Addr[1] = RawData[1];
@@ -1243,9 +1279,10 @@ SnpReceive (
              &BufferSizeBuf, &RxBufferAddrMap, &Snp->MacDriver.RxBufNum[DescNum].Mapping);
   if (EFI_ERROR (Status)) {
     DEBUG ((DEBUG_ERROR, "%a () for Rxbuffer: %r\n", __FUNCTION__, Status));
-    return Status;
+    goto ReleaseLock;
   }
   Snp->MacDriver.RxBufNum[DescNum].AddrMap = RxBufferAddrMap;
+  Snp->PerfCounters.DmaMaps++;
   RxDescriptorMap->Addr = Snp->MacDriver.RxBufNum[DescNum].AddrMap;
 
   RxDescriptor->Tdes0 |= (UINT32)RDES0_OWN;
@@ -1257,12 +1294,11 @@ SnpReceive (
     DescNum = 0;
   }
   Snp->MacDriver.RxNextDescriptorNum = DescNum;
-
-  EfiReleaseLock (&Snp->Lock);
-  return EFI_SUCCESS;
+  Status = EFI_SUCCESS;
 
 ReleaseLock:
+  Snp->RaisedTplTicks += GetPerformanceCounter () - LockTicks;
   EfiReleaseLock (&Snp->Lock);
-  return EFI_NOT_READY;
+  return Status;
 }
 
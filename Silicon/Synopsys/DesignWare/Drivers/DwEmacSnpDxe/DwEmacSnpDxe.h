@@ -17,11 +17,14 @@
 #define DWEMAC_SNP_DXE_H__
 
 // Protocols used by this driver
+#include <Protocol/AdapterInformation.h>
 #include <Protocol/SimpleNetwork.h>
 #include <Protocol/ComponentName2.h>
 #include <Protocol/DevicePath.h>
 #include <Protocol/NonDiscoverableDevice.h>
 
+#include <Guid/NetPerfCountersAdapterInfo.h>
+
 #include <Library/UefiLib.h>
 
 #include "PhyDxeUtil.h"
@@ -48,6 +51,13 @@ typedef struct {
   // EFI Snp statistics instance
   EFI_NETWORK_STATISTICS                 Stats;
 
+  // Adapter Information protocol
+  EFI_ADAPTER_INFORMATION_PROTOCOL       Aip;
+
+  // Data path performance counters, exposed via the Aip
+  NET_PERF_COUNTERS_ADAPTER_INFO         PerfCounters;
+  UINT64                                 RaisedTplTicks;
+
   EMAC_DRIVER                            MacDriver;
   PHY_DRIVER                             PhyDriver;
 
@@ -74,8 +84,11 @@ typedef struct {
 extern EFI_COMPONENT_NAME_PROTOCOL       gSnpComponentName;
 extern EFI_COMPONENT_NAME2_PROTOCOL      gSnpComponentName2;
 
+extern CONST EFI_ADAPTER_INFORMATION_PROTOCOL gDwEmacAdapterInfoTemplate;
+
 #define SNP_DRIVER_SIGNATURE             SIGNATURE_32('A', 'S', 'N', 'P')
 #define INSTANCE_FROM_SNP_THIS(a)        CR(a, SIMPLE_NETWORK_DRIVER, Snp, SNP_DRIVER_SIGNATURE)
+#define INSTANCE_FROM_AIP_THIS(a)        CR(a, SIMPLE_NETWORK_DRIVER, Aip, SNP_DRIVER_SIGNATURE)
 #define SNP_TX_BUFFER_INCREASE           32
 #define SNP_MAX_TX_BUFFER_NUM            65536
 #define DESC_NUM                         10